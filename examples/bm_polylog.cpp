@@ -20,221 +20,139 @@
 
   -------------------------------------------------------------------
 */
+#include <ctime>
+#include <vector>
+#include <functional>
+
 #include <o2scl/test_mgr.h>
-#include <o2scl/inte_adapt_cern.h>
 #include <o2scl/polylog.h>
+#include <o2scl/fermi_dirac_vec.h>
 
-#include <boost/multiprecision/number.hpp>
-#include <boost/multiprecision/cpp_dec_float.hpp>
-#include <boost/multiprecision/mpfr.hpp>
+/*
+  This program measures the throughput of the Fermi-Dirac integrals
+  computed one argument at a time with GSL and with the piecewise
+  polynomial approximations in fermi_dirac_integ_vec, both for
+  single arguments and for entire arrays. It also reports the
+  maximum relative deviation from the GSL values.
+*/
 
 using namespace std;
 using namespace o2scl;
 
-typedef
-boost::multiprecision::number<boost::multiprecision::cpp_dec_float<25> >
-cpp_dec_float_25;
+/// The number of arguments in the array
+static const size_t n_arg=100000;
 
-typedef
-boost::multiprecision::number<boost::multiprecision::cpp_dec_float<35> >
-cpp_dec_float_35;
+/// The number of passes through the array
+static const size_t n_rep=20;
 
-typedef boost::multiprecision::cpp_dec_float_50 cpp_dec_float_50;
-typedef boost::multiprecision::mpfr_float_50 mpfr_float_50;
+/** \brief Time \c n_rep evaluations of \c f and return the number
+    of evaluations per second
+*/
+double rate(std::function<void()> f) {
+  clock_t t1=clock();
+  for(size_t k=0;k<n_rep;k++) f();
+  clock_t t2=clock();
+  double sec=((double)(t2-t1))/CLOCKS_PER_SEC;
+  if (sec<=0.0) sec=1.0/CLOCKS_PER_SEC;
+  return ((double)(n_arg*n_rep))/sec;
+}
 
-typedef
-boost::multiprecision::number<boost::multiprecision::cpp_dec_float<75> >
-cpp_dec_float_75;
+/** \brief Benchmark one order, given the GSL function \c fg,
+    the single-argument function \c fs, and the array function
+    \c fv
+*/
+void bench(test_mgr &t, string label, const vector<double> &mu,
+           std::function<double(double)> fg,
+           std::function<double(double)> fs,
+           std::function<void(size_t,const vector<double> &,
+                              vector<double> &)> fv) {
+  
+  vector<double> r_gsl(n_arg), r_s(n_arg), r_v(n_arg);
+  
+  double rg=rate([&]() {
+    for(size_t i=0;i<n_arg;i++) r_gsl[i]=fg(mu[i]);
+  });
+  double rs=rate([&]() {
+    for(size_t i=0;i<n_arg;i++) r_s[i]=fs(mu[i]);
+  });
+  double rv=rate([&]() { fv(n_arg,mu,r_v); });
+
+  double dev=0.0;
+  for(size_t i=0;i<n_arg;i++) {
+    dev=max(dev,fabs(r_v[i]-r_gsl[i])/fabs(r_gsl[i]));
+  }
+  
+  cout.width(5);
+  cout << label << " " << rg << " " << rs << " " << rv << " "
+       << rv/rg << " " << dev << endl;
+  t.test_rel(dev,0.0,1.0e-13,((string)"gsl vs. vec ")+label);
 
-typedef boost::multiprecision::cpp_dec_float_100 cpp_dec_float_100;
-typedef boost::multiprecision::mpfr_float_100 mpfr_float_100;
+  return;
+}
 
 int main(void) {
 
   cout.setf(ios::scientific);
+  cout.precision(3);
   
   test_mgr t;
   t.set_output_level(1);
-  
-  gen_test_number<> gn;
-  gen_test_number<long double> gn_ld;
-  gen_test_number<cpp_dec_float_25> gn_cdf25;
-  
-  gn.set_radix(1.4);
-  gn_ld.set_radix(1.4);
-  gn_cdf25.set_radix(1.4);
-  
-  fermi_dirac_integ_bf<double,30,40,50,cpp_dec_float_25,
-                       cpp_dec_float_35,cpp_dec_float_50> fdib;
-  // double is typically 1.0e-15, so we keep an extra two digits 
-  fdib.set_tol(1.0e-17);
-
-  fermi_dirac_integ_bf<long double,30,40,50,cpp_dec_float_25,
-                       cpp_dec_float_35,cpp_dec_float_50> fdib2;
-  // long double is typically 1.0e-18, but we do two digits larger
-  fdib2.set_tol(1.0e-20);
-  
-  fermi_dirac_integ_bf<long double,30,40,50,cpp_dec_float_25,
-                       cpp_dec_float_35,mpfr_float_50> fdib2b;
-  // long double is typically 1.0e-18, but we do two digits larger
-  fdib2.set_tol(1.0e-20);
-  
-  fermi_dirac_integ_bf<cpp_dec_float_25,30,40,50,cpp_dec_float_35,
-                       cpp_dec_float_50,cpp_dec_float_75> fdib3;
-  // cpp_dec_float_25 is typically 1.0e-25, but we do two digits larger
-  fdib3.set_tol(1.0e-27);
 
-  fermi_dirac_integ_bf<cpp_dec_float_25,30,40,50,cpp_dec_float_35,
-                       mpfr_float_50,mpfr_float_100> fdib3b;
-  // cpp_dec_float_25 is typically 1.0e-25, but we do two digits larger
-  fdib3b.set_tol(1.0e-29);
+  fermi_dirac_integ_gsl fdig;
+  fermi_dirac_integ_vec fdv;
 
-  bessel_K_exp_integ_gsl bkeg;
-  
-  bessel_K_exp_integ_bf<double,30,40,50,cpp_dec_float_25,
-                        cpp_dec_float_35,cpp_dec_float_50> bkeb;
-  // double is typically 1.0e-15, so we keep an extra two digits 
-  bkeb.set_tol(1.0e-17);
-
-  bessel_K_exp_integ_bf<long double,30,40,50,cpp_dec_float_25,
-                        cpp_dec_float_35,cpp_dec_float_50> bkeb2;
-  // long double is typically 1.0e-18, but we do two digits larger
-  bkeb2.set_tol(1.0e-20);
-  
-  bessel_K_exp_integ_bf<cpp_dec_float_25,30,40,50,cpp_dec_float_35,
-                        cpp_dec_float_50,cpp_dec_float_75> bkeb3;
-  // cpp_dec_float_25 is typically 1.0e-25, but we do two digits larger
-  bkeb3.set_tol(1.0e-27);
-
-  if (false) {
-
-    double x;
-    long double x_ld;
-    cpp_dec_float_25 x_cdf25;
-    
-    for(size_t i=1;i<100;i++) {
-    
-      if (i==1) {
-        x=0;
-        x_ld=0;
-        x_cdf25=0;
-      }
-
-      if (i!=1) {
-        x=-x;
-        x_ld=-x_ld;
-        x_cdf25=-x_cdf25;
-      }
-      
-      if (i%2==0) {
-        x+=6;
-        x_ld+=6;
-        x_cdf25+=6;
-      }
-      
-      double res, err;
-      int method, method2, method3, method2b, method3b;
-      int iret=fdib.calc_1o2_ret_full(x,res,err,method);
-    
-      long double res_ld, err_ld, res_ldb, err_ldb;
-      int iret2=fdib2.calc_1o2_ret_full(x_ld,res_ld,err_ld,method2);
-      int iret2b=fdib2b.calc_1o2_ret_full(x_ld,res_ldb,err_ldb,method2b);
-    
-      cpp_dec_float_25 res_cdf25, err_cdf25;
-      cpp_dec_float_25 res_cdf25b, err_cdf25b;
-      int iret3=fdib3.calc_1o2_ret_full(x_cdf25,res_cdf25,err_cdf25,method3);
-      int iret3b=fdib3b.calc_1o2_ret_full(x_cdf25,res_cdf25b,err_cdf25b,
-                                          method3b);
-    
-      cout.width(4);
-      cout << i << " ";
-      cout.setf(ios::showpos);
-      
-      cout << x << " ";
-      cout.unsetf(ios::showpos);
-      cout << iret << " " << method << " "
-           << dtos(res,0) << " " << dtos(err,0) << endl;
-      t.test_gen(iret==0,"double ret");
-      t.test_abs(err/res,0.0,1.0e-15,"double prec");
-      
-      cout << "                   ";
-      cout << iret2 << " " << method2 << " "
-           << dtos(res_ld,0) << " " << dtos(err_ld,0) << endl;
-      t.test_gen(iret2==0,"long double ret");
-      t.test_abs<long double>(err_ld/res_ld,0.0,1.0e-18,"long double prec");
-      
-      cout << "                   ";
-      cout << iret2b << " " << method2b << " "
-           << dtos(res_ldb,0) << " " << dtos(err_ldb,0) << endl;
-      t.test_gen(iret2==0,"long double ret 2b");
-      t.test_abs<long double>(err_ldb/res_ldb,0.0,1.0e-18,
-                              "long double prec 2b");
-      
-      cout << "                   ";
-      cout << iret3 << " " << method3 << " "
-           << dtos(res_cdf25,0) << " " << dtos(err_cdf25,0) << endl;
-      t.test_gen(iret3==0,"cdf25 ret");
-      t.test_abs_boost<cpp_dec_float_25>(err_cdf25/res_cdf25,
-                                         0.0,1.0e-25,"cdf25 prec");
-      cout << "                   ";
-      cout << iret3b << " " << method3b << " "
-           << dtos(res_cdf25b,0) << " " << dtos(err_cdf25b,0) << endl;
-      t.test_gen(iret3b==0,"cdf25 ret 3b");
-      t.test_abs_boost<cpp_dec_float_25>(err_cdf25b/res_cdf25b,
-                                         0.0,1.0e-25,"cdf25 prec 3b");
-    }
-    cout << endl;
+  // A set of arguments spanning the nondegenerate, intermediate,
+  // and degenerate regions, in an order which does not favor
+  // branch prediction in the scalar functions
+  vector<double> mu(n_arg);
+  for(size_t i=0;i<n_arg;i++) {
+    mu[i]=-30.0+90.0*((double)((i*7919)%n_arg))/((double)n_arg);
   }
   
-  gn.reset();
-  gn_ld.reset();
-  gn_cdf25.reset();
-
-  for(size_t i=0;i<90;i++) {
-    
-    double x=gn.gen(), res, err;
-    int method, method2, method3;
-    if (x>0.0) {
-      cout << x << " " << bkeg.K1exp(x) << endl;
-      int iret=bkeb.K1exp_ret_full(x,res,err,method);
-      
-      cout.width(4);
-      cout << i << " ";
-      cout.setf(ios::showpos);
-      cout << x << " ";
-      cout.unsetf(ios::showpos);
-      cout << iret << " " << method << " "
-           << dtos(res,0) << " " << dtos(err,0) << endl;
-      t.test_gen(iret==0,"double ret");
-      t.test_abs(err/res,0.0,1.0e-17,"double prec");
-      
-      if (true) {
-        
-        long double x_ld=gn_ld.gen(), res_ld, err_ld;
-        int iret2=bkeb2.K1exp_ret_full(x_ld,res_ld,err_ld,method2);
-        
-        cout << "                   ";
-        cout << iret2 << " " << method2 << " "
-             << dtos(res_ld,0) << " " << dtos(err_ld,0) << endl;
-        t.test_gen(iret2==0,"long double ret");
-        t.test_abs<long double>(err_ld/res_ld,0.0,1.0e-20,"long double prec");
-      }
-
-      if (false) {
-        
-        cpp_dec_float_25 x_cdf25=gn_cdf25.gen(), res_cdf25, err_cdf25;
-        int iret3=bkeb3.K1exp_ret_full(x_cdf25,res_cdf25,err_cdf25,method3);
-        
-        cout << "                   ";
-        cout << iret3 << " " << method3 << " "
-             << dtos(res_cdf25,0) << " " << dtos(err_cdf25,0) << endl;
-        t.test_gen(iret3==0,"cdf25 ret");
-        t.test_abs_boost<cpp_dec_float_25>(err_cdf25/res_cdf25,
-                                           0.0,1.0e-27,"cdf25 prec");
-      }
-    }
+  cout << "Evaluations per second over " << n_arg << " arguments "
+       << "in [-30,60]:" << endl;
+  cout << "order GSL         scalar      array       speedup     "
+       << "max. rel. dev." << endl;
+  
+  bench(t,"-1/2",mu,
+        [&](double y) { return fdig.calc_m1o2(y); },
+        [&](double y) { return fdv.calc_m1o2(y); },
+        [&](size_t n, const vector<double> &y, vector<double> &r) {
+          fdv.calc_m1o2_vec(n,y,r); });
+  bench(t,"1/2",mu,
+        [&](double y) { return fdig.calc_1o2(y); },
+        [&](double y) { return fdv.calc_1o2(y); },
+        [&](size_t n, const vector<double> &y, vector<double> &r) {
+          fdv.calc_1o2_vec(n,y,r); });
+  bench(t,"3/2",mu,
+        [&](double y) { return fdig.calc_3o2(y); },
+        [&](double y) { return fdv.calc_3o2(y); },
+        [&](size_t n, const vector<double> &y, vector<double> &r) {
+          fdv.calc_3o2_vec(n,y,r); });
+  bench(t,"2",mu,
+        [&](double y) { return fdig.calc_2(y); },
+        [&](double y) { return fdv.calc_2(y); },
+        [&](size_t n, const vector<double> &y, vector<double> &r) {
+          fdv.calc_2_vec(n,y,r); });
+  bench(t,"3",mu,
+        [&](double y) { return fdig.calc_3(y); },
+        [&](double y) { return fdv.calc_3(y); },
+        [&](size_t n, const vector<double> &y, vector<double> &r) {
+          fdv.calc_3_vec(n,y,r); });
+
+  // GSL has no order 5/2 function, so compare the array function
+  // with the polylogarithm, using F_{5/2}(mu) = -Gamma(7/2) 
+  // Li_{7/2}(-e^{mu}) at a few points
+  polylog<> pl;
+  vector<double> r5(n_arg);
+  double r5v=rate([&]() { fdv.calc_5o2_vec(n_arg,mu,r5); });
+  double dev5=0.0;
+  for(size_t i=0;i<n_arg;i+=n_arg/200) {
+    double p=-pl.calc(3.5,-exp(mu[i]))*o2scl_const::root_pi*15.0/8.0;
+    dev5=max(dev5,fabs(r5[i]-p)/fabs(p));
   }
-  cout << endl;
+  cout << "  5/2 " << r5v << " " << dev5 << endl;
+  t.test_rel(dev5,0.0,1.0e-13,"polylog vs. vec 5/2");
   
   t.report();
   return 0;
@@ -33,6 +33,10 @@
 // for typeid()
 #include <typeinfo>
 
+#include <map>
+#include <deque>
+#include <typeindex>
+
 #ifdef O2SCL_MULTIP
 
 #include <boost/multiprecision/cpp_dec_float.hpp>
@@ -41,6 +45,16 @@
 #include <boost/multiprecision/mpfr.hpp>
 #endif
 
+// Use the compiler's quadruple precision type (through libquadmath)
+// if it is available, unless O2SCL_NO_FLOAT128 is defined. Boost's
+// float128 requires the GNU extensions, so it is not used with
+// -std=c++XX.
+#if defined (__SIZEOF_FLOAT128__) && !defined (__STRICT_ANSI__) && \
+  !defined (O2SCL_NO_FLOAT128)
+#define O2SCL_SET_FLOAT128
+#include <boost/multiprecision/float128.hpp>
+#endif
+
 #endif
 
 namespace o2scl {
@@ -72,6 +86,20 @@ namespace o2scl {
   typedef boost::multiprecision::number<
     boost::multiprecision::cpp_dec_float<100>> cpp_dec_float_100;
 
+#if defined (O2SCL_SET_FLOAT128) || defined (DOXYGEN)
+  
+  /** \brief Quadruple precision (113-bit significand, about 33
+      decimal digits)
+
+      This typedef is defined only if the compiler supports
+      <tt>__float128</tt> and \c O2SCL_NO_FLOAT128 is not defined.
+      The arithmetic is performed by libquadmath, which is
+      considerably faster than the decimal types above.
+  */
+  typedef boost::multiprecision::float128 float_quad;
+  
+#endif
+  
   // Choose the best floating point type depending on what is
   // available. 7/28/23: I'm currently having problems with mpfr types
   // so they're commented out, however, in the future, this should be
@@ -83,11 +111,20 @@ namespace o2scl {
   //typedef mpfr_50 o2fp_50;
   //typedef mpfr_100 o2fp_100;
   //#else
+  //#endif
+
+  // The first step above long double is quadruple precision if it
+  // is available, since most computations which fail in long double
+  // need only about 30 digits, and cpp_dec_float_25 is orders
+  // of magnitude slower.
+#ifdef O2SCL_SET_FLOAT128
+  typedef float_quad o2fp_25;
+#else
   typedef cpp_dec_float_25 o2fp_25;
+#endif
   typedef cpp_dec_float_35 o2fp_35;
   typedef cpp_dec_float_50 o2fp_50;
   typedef cpp_dec_float_100 o2fp_100;
-  //#endif
   //@}
 
 #else
@@ -251,6 +288,14 @@ namespace o2scl {
       verbose=0;
       tol_rel=-1.0;
       err_nonconv=true;
+      use_cache=false;
+      cache_size=1000;
+      cache_tag=0;
+      remember_tier=false;
+      tier_decay=10;
+      last_tier=-1;
+      mem_tier=-1;
+      mem_count=0;
     }
 
     ~funct_multip_tl() {
@@ -269,6 +314,89 @@ namespace o2scl {
     */
     bool err_nonconv;
     
+    /** \name Result cache and precision memory
+        
+        If \ref use_cache is true, then the results of \ref
+        eval_tol_err() are stored, keyed on the value of \ref
+        cache_tag, the type of the function object, and the argument.
+        A later call with the same key returns the stored value
+        without calling the function, provided that the stored
+        uncertainty is smaller than the requested tolerance. The cache
+        holds at most \ref cache_size results, and the oldest results
+        are removed first. Arguments which cannot be exactly
+        represented as a <tt>long double</tt> are never cached.
+
+        Function objects of different types never share results, but
+        the cache cannot detect a change in the parameters of a
+        function object, e.g. a lambda expression which captures
+        different values in each step of a parameter sweep, or a
+        <tt>std::function</tt> which is reassigned. In this case \ref
+        cache_tag should be set to a different value for each set of
+        parameters.
+
+        If \ref remember_tier is true, then evaluations begin at the
+        precision which succeeded in previous calls rather than at
+        double precision. This is faster when a sequence of nearby
+        arguments all require extended precision. After \ref
+        tier_decay consecutive calls which succeed at the remembered
+        precision, the next call begins at the next lower precision,
+        so the remembered precision decreases again when the function
+        no longer requires it.
+
+        The cache and the value of \ref last_tier are modified even
+        though the evaluation functions are <tt>const</tt>, so an
+        object with either option enabled should not be used by
+        several threads at the same time.
+    */
+    //@{
+    /// If true, store the results (default false)
+    bool use_cache;
+    
+    /// The maximum number of stored results (default 1000)
+    size_t cache_size;
+
+    /** \brief A user-specified value which identifies the function
+        parameters in the cache (default 0)
+    */
+    size_t cache_tag;
+    
+    /** \brief If true, start at the precision which succeeded
+        in previous calls (default false)
+    */
+    bool remember_tier;
+
+    /** \brief The number of calls which succeed at the remembered
+        precision before the remembered precision is lowered
+        (default 10)
+    */
+    size_t tier_decay;
+    
+    /** \brief The precision tier which succeeded in the last call
+
+        This is 1 if the double and long double results agreed, 2 for
+        long double and the 25-digit type, 3 for the 25- and 35-digit
+        types, 4 for the 35- and 50-digit types, and 5 for the 50-
+        and 100-digit types. It is -1 if no evaluation has succeeded.
+        Results taken from the cache do not modify this value.
+    */
+    mutable int last_tier;
+
+    /// Clear the result cache and the precision memory
+    void clear_cache() {
+      cache.clear();
+      cache_order.clear();
+      last_tier=-1;
+      mem_tier=-1;
+      mem_count=0;
+      return;
+    }
+
+    /// Return the number of stored results
+    size_t get_cache_count() const {
+      return cache.size();
+    }
+    //@}
+    
     /** \brief Evaluate the function and return the error estimate
         with the specified tolerance
 
@@ -339,11 +467,28 @@ namespace o2scl {
         
       }
 
+      // Check the cache and choose the first precision tier
+
+      std::type_index ftype=typeid(func_t);
+      if (use_cache && cache_lookup(ftype,x,tol_loc,val,err)) {
+        if (verbose>0) {
+          std::cout << "funct_multip_tl::eval_tol_err() "
+                    << "found cached result:\n  "
+                    << "arg,val,err: " << x << " "
+                    << val << " " << err << std::endl;
+        }
+        return 0;
+      }
+      
+      int tier_start=0;
+      if (remember_tier && mem_tier>0) tier_start=mem_tier-1;
+      
       /// First pass, compare double and long double
 
       bool d_eval=false;
       double x_d=0, y_d=0;
-      if (tol_loc>pow(10.0,-std::numeric_limits<double>::digits10)) {
+      if (tier_start<=0 &&
+          tol_loc>pow(10.0,-std::numeric_limits<double>::digits10)) {
         x_d=static_cast<double>(x);
         y_d=f(x_d);
         d_eval=true;
@@ -351,7 +496,8 @@ namespace o2scl {
       
       bool ld_eval=false;
       long double x_ld=0, y_ld=0;
-      if (tol_loc>pow(10.0,-std::numeric_limits<long double>::digits10)) {
+      if (tier_start<=1 &&
+          tol_loc>pow(10.0,-std::numeric_limits<long double>::digits10)) {
         x_ld=static_cast<long double>(x);
         y_ld=f(x_ld);
         ld_eval=true;
@@ -366,6 +512,7 @@ namespace o2scl {
                       << "double and long double both got zero."
                       << std::endl;
           }
+          record_success(ftype,x,val,err,1);
           return 0;
         }
       
@@ -385,6 +532,7 @@ namespace o2scl {
                 std::cin >> ch;
               }
             }
+            record_success(ftype,x,val,err,1);
             return 0;
           }
         }
@@ -418,8 +566,8 @@ namespace o2scl {
       
       bool cdf25_eval=false;
       fp_25_t x_cdf25=0, y_cdf25=0;
-      if (tol_loc>pow(10.0,-std::numeric_limits
-                      <fp_25_t>::digits10)) {
+      if (tier_start<=2 && tol_loc>pow(10.0,-std::numeric_limits
+                                          <fp_25_t>::digits10)) {
         x_cdf25=static_cast<fp_25_t>(x);
         y_cdf25=f(x_cdf25);
         cdf25_eval=true;
@@ -440,6 +588,7 @@ namespace o2scl {
               std::cin >> ch;
             }
           }
+          record_success(ftype,x,val,err,2);
           return 0;
         }
         if (y_cdf25!=0) {
@@ -460,6 +609,7 @@ namespace o2scl {
                 std::cin >> ch;
               }
             }
+            record_success(ftype,x,val,err,2);
             return 0;
           }
         }
@@ -493,8 +643,8 @@ namespace o2scl {
 
       bool cdf35_eval=false;
       fp_35_t x_cdf35=0, y_cdf35=0;
-      if (tol_loc>pow(10.0,-std::numeric_limits
-                      <fp_35_t>::digits10)) {
+      if (tier_start<=3 && tol_loc>pow(10.0,-std::numeric_limits
+                                          <fp_35_t>::digits10)) {
         x_cdf35=static_cast<fp_35_t>(x);
         y_cdf35=f(x_cdf35);
         cdf35_eval=true;
@@ -515,6 +665,7 @@ namespace o2scl {
               std::cin >> ch;
             }
           }
+          record_success(ftype,x,val,err,3);
           return 0;
         }
         if (y_cdf35!=0) {
@@ -535,6 +686,7 @@ namespace o2scl {
                 std::cin >> ch;
               }
             }
+            record_success(ftype,x,val,err,3);
             return 0;
           }
         }
@@ -568,8 +720,8 @@ namespace o2scl {
       
       bool cdf50_eval=false;
       fp_50_t x_cdf50=0, y_cdf50=0;
-      if (tol_loc>pow(10.0,-std::numeric_limits
-                      <fp_50_t>::digits10)) {
+      if (tier_start<=4 && tol_loc>pow(10.0,-std::numeric_limits
+                                          <fp_50_t>::digits10)) {
         x_cdf50=static_cast<fp_50_t>(x);
         y_cdf50=f(x_cdf50);
         cdf50_eval=true;
@@ -584,6 +736,7 @@ namespace o2scl {
                       << "35-digit and 50-digit both got zero."
                       << std::endl;
           }
+          record_success(ftype,x,val,err,4);
           return 0;
         }
         if (y_cdf50!=0) {
@@ -604,6 +757,7 @@ namespace o2scl {
                 std::cin >> ch;
               }
             }
+            record_success(ftype,x,val,err,4);
             return 0;
           }
         }
@@ -659,6 +813,7 @@ namespace o2scl {
               std::cin >> ch;
             }
           }
+          record_success(ftype,x,val,err,5);
           return 0;
         }
         if (y_cdf100!=0) {
@@ -679,6 +834,7 @@ namespace o2scl {
                 std::cin >> ch;
               }
             }
+            record_success(ftype,x,val,err,5);
             return 0;
           }
         }
@@ -736,6 +892,116 @@ namespace o2scl {
     
       return val;
     }
+
+  protected:
+
+    /// The key for a stored result
+    class cache_key_t {
+    public:
+      /// The value of \ref cache_tag
+      size_t tag;
+      /// The type of the function object
+      std::type_index ftype;
+      /// The argument
+      long double x;
+      cache_key_t(size_t t, std::type_index f, long double a) :
+        tag(t), ftype(f), x(a) {
+      }
+      /// Ordering for \c std::map
+      bool operator<(const cache_key_t &k) const {
+        if (tag!=k.tag) return tag<k.tag;
+        if (ftype!=k.ftype) return ftype<k.ftype;
+        return x<k.x;
+      }
+    };
+    
+    /// A stored result
+    class cache_entry {
+    public:
+      /// The function value
+      fp_100_t val;
+      /// The uncertainty
+      fp_100_t err;
+    };
+
+    /// The stored results
+    mutable std::map<cache_key_t,cache_entry> cache;
+
+    /// The keys in the order they were stored
+    mutable std::deque<cache_key_t> cache_order;
+
+    /// The remembered precision tier
+    mutable int mem_tier;
+
+    /// The number of calls which succeeded at \ref mem_tier
+    mutable size_t mem_count;
+
+    /** \brief If the argument can be stored exactly as a long
+        double, set \c key and return true
+    */
+    template<class fp_t>
+    bool cache_key(const fp_t &x, long double &key) const {
+      key=static_cast<long double>(x);
+      return static_cast<fp_t>(key)==x;
+    }
+    
+    /** \brief Look for a stored result for \c x with an uncertainty
+        smaller than \c tol_loc
+    */
+    template<class fp_t>
+    bool cache_lookup(std::type_index ftype, const fp_t &x, double tol_loc,
+                      fp_t &val, fp_t &err) const {
+      long double key;
+      if (!cache_key(x,key)) return false;
+      typename std::map<cache_key_t,cache_entry>::const_iterator it=
+        cache.find(cache_key_t(cache_tag,ftype,key));
+      if (it==cache.end()) return false;
+      if (it->second.err>=tol_loc) return false;
+      val=static_cast<fp_t>(it->second.val);
+      err=static_cast<fp_t>(it->second.err);
+      return true;
+    }
+
+    /** \brief Record a successful evaluation at tier \c tier
+        and store it in the cache if necessary
+    */
+    template<class fp_t>
+    void record_success(std::type_index ftype, const fp_t &x,
+                        const fp_t &val, const fp_t &err,
+                        int tier) const {
+      last_tier=tier;
+      if (remember_tier) {
+        if (tier>mem_tier) {
+          // A higher precision was required
+          mem_tier=tier;
+          mem_count=0;
+        } else {
+          // Lower the remembered precision after tier_decay
+          // successes
+          mem_count++;
+          if (mem_count>=tier_decay && mem_tier>1) {
+            mem_tier--;
+            mem_count=0;
+          }
+        }
+      }
+      if (!use_cache || cache_size==0) return;
+      long double xkey;
+      if (!cache_key(x,xkey)) return;
+      cache_key_t key(cache_tag,ftype,xkey);
+      if (cache.find(key)==cache.end()) {
+        while (cache.size()>=cache_size) {
+          cache.erase(cache_order.front());
+          cache_order.pop_front();
+        }
+        cache_order.push_back(key);
+      }
+      cache_entry &ce=cache.insert
+        (std::make_pair(key,cache_entry())).first->second;
+      ce.val=static_cast<fp_100_t>(val);
+      ce.err=static_cast<fp_100_t>(err);
+      return;
+    }
       
   };
 
@@ -981,7 +1247,9 @@ namespace o2scl {
           return 0;
         }
         if (y_cdf25!=0) {
-          err=static_cast<fp_t>(abs(y_cdf25-y_ld)/abs(y_cdf25));
+	  fp_25_t temp1=abs(y_cdf25-static_cast<fp_25_t>(y_ld));
+	  fp_25_t temp2=abs(y_cdf25);
+          err=static_cast<fp_t>(temp1/temp2);
           if (err<tol_loc) {
             val=static_cast<fp_t>(y_cdf25);
             if (verbose>0) {
@@ -1049,7 +1317,9 @@ namespace o2scl {
           return 0;
         }
         if (y_cdf35!=0) {
-          err=static_cast<fp_t>(abs(y_cdf35-y_cdf25)/abs(y_cdf35));
+	  fp_35_t temp1=abs(y_cdf35-static_cast<fp_35_t>(y_cdf25));
+	  fp_35_t temp2=abs(y_cdf35);
+          err=static_cast<fp_t>(temp1/temp2);
           if (err<tol_loc) {
             val=static_cast<fp_t>(y_cdf35);
             if (verbose>0) {
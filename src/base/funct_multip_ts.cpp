@@ -43,6 +43,18 @@ public:
   }
 };
 
+class fmc3 {
+public:
+  int count;
+  fmc3() {
+    count=0;
+  }
+  template<class fp_t> fp_t func(fp_t x) {
+    count++;
+    return exp(x);
+  }
+};
+
 class fmc2 {
   
 public:
@@ -129,6 +141,91 @@ int main(void) {
     { return f3.func(tx,f3.param_f(tx)); },1.0e-4,val,err);
     t.test_rel(val,log1p(0.1001),1.0e-15,"funct_multip 3");
   }
+
+  {
+    // A tolerance which requires the first tier above long double,
+    // which is quadruple precision if it is available
+    fmc f2;
+    cpp_dec_float_35 x=1, val, err;
+    x/=10000;
+    funct_multip fm2;
+    fm2.eval_tol_err([f2](auto &&tx) mutable { return f2.func(tx); },
+                     x,val,err,1.0e-28);
+    cpp_dec_float_50 x50=1;
+    x50/=10000;
+    cpp_dec_float_50 exact=log1p(x50);
+    t.test_rel_boost<cpp_dec_float_50>(static_cast<cpp_dec_float_50>(val),
+                                       exact,1.0e-28,"funct_multip tier 1");
+#ifdef O2SCL_SET_FLOAT128
+    t.test_gen(std::numeric_limits<o2fp_25>::digits==113,"float_quad");
+#endif
+  }
+
+  {
+    // Test the result cache and the precision memory
+    fmc3 f3;
+    funct_multip fm3;
+    fm3.use_cache=true;
+    fm3.cache_size=2;
+    long double val, err;
+    auto fl3=[&f3](auto &&tx) { return f3.func(tx); };
+
+    fm3.eval_tol_err(fl3,1.0e-4L,val,err,1.0e-14);
+    t.test_rel<long double>(val,expl(1.0e-4L),1.0e-14,"cache 1");
+    t.test_gen(fm3.last_tier==1,"cache tier 1");
+    int count1=f3.count;
+    
+    // The same argument with a looser tolerance uses the cache
+    fm3.eval_tol_err(fl3,1.0e-4L,val,err,1.0e-10);
+    t.test_gen(f3.count==count1,"cache hit");
+    t.test_rel<long double>(val,expl(1.0e-4L),1.0e-14,"cache 2");
+
+    // A different function type does not use the cached result
+    fmc3 f4;
+    fm3.eval_tol_err([&f4](auto &&tx) { return f4.func(tx); },
+                     1.0e-4L,val,err,1.0e-10);
+    t.test_gen(f4.count>0,"cache function type");
+    
+    // Nor does the same function with a different tag, as in a
+    // parameter sweep
+    fm3.cache_tag=1;
+    fm3.eval_tol_err(fl3,1.0e-4L,val,err,1.0e-10);
+    t.test_gen(f3.count>count1,"cache tag");
+    fm3.cache_tag=0;
+    count1=f3.count;
+    
+    // A tighter tolerance requires new evaluations
+    fm3.eval_tol_err(fl3,1.0e-4L,val,err,1.0e-17);
+    t.test_gen(f3.count>count1,"cache miss");
+    t.test_gen(fm3.last_tier==2,"cache tier 2");
+
+    // The cache size is bounded
+    fm3.eval_tol_err(fl3,2.0e-4L,val,err,1.0e-14);
+    fm3.eval_tol_err(fl3,3.0e-4L,val,err,1.0e-14);
+    t.test_gen(fm3.get_cache_count()==2,"cache size");
+
+    // Start at the last successful tier: only two evaluations
+    // are required
+    fm3.clear_cache();
+    fm3.use_cache=false;
+    fm3.remember_tier=true;
+    fm3.eval_tol_err(fl3,1.0e-4L,val,err,1.0e-17);
+    int count2=f3.count;
+    fm3.eval_tol_err(fl3,2.0e-4L,val,err,1.0e-17);
+    t.test_gen(f3.count==count2+2,"remember tier");
+    t.test_rel<long double>(val,expl(2.0e-4L),1.0e-17,"remember tier val");
+
+    // With a looser tolerance, the remembered tier is lowered
+    // after tier_decay calls
+    fm3.tier_decay=3;
+    fm3.eval_tol_err(fl3,3.0e-4L,val,err,1.0e-10);
+    t.test_gen(fm3.last_tier==2,"tier decay 1");
+    fm3.eval_tol_err(fl3,4.0e-4L,val,err,1.0e-10);
+    t.test_gen(fm3.last_tier==2,"tier decay 2");
+    fm3.eval_tol_err(fl3,5.0e-4L,val,err,1.0e-10);
+    t.test_gen(fm3.last_tier==1,"tier decay 3");
+    t.test_rel<long double>(val,expl(5.0e-4L),1.0e-10,"tier decay val");
+  }
 #endif
   
   t.report();
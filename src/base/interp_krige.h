@@ -29,6 +29,7 @@
 
 #include <iostream>
 #include <string>
+#include <algorithm>
 
 #include <gsl/gsl_sf_erf.h>
 
@@ -71,6 +72,41 @@ namespace o2scl {
     
     /// The integral of the covariance function at x between a and b
     virtual double integ(double x, double a, double b)=0;
+
+    /// \name State-space representation
+    //@{
+    /** \brief The dimension of the state-space representation of
+        the covariance function, or zero if there is none (the
+        default)
+    */
+    virtual size_t ss_dim() {
+      return 0;
+    }
+    
+    /** \brief Compute the transition matrix \c A and the process
+        noise covariance \c Q for a step of size \c dx
+    */
+    virtual void ss_trans(double dx, boost::numeric::ublas::matrix<double> &A,
+                          boost::numeric::ublas::matrix<double> &Q) {
+      O2SCL_ERR("No state-space representation in covar_funct::ss_trans().",
+                o2scl::exc_eunimpl);
+      return;
+    }
+    
+    /// Compute the stationary covariance of the state, \c P
+    virtual void ss_stat(boost::numeric::ublas::matrix<double> &P) {
+      O2SCL_ERR("No state-space representation in covar_funct::ss_stat().",
+                o2scl::exc_eunimpl);
+      return;
+    }
+    
+    /// The variance of the observation noise
+    virtual double ss_noise() {
+      O2SCL_ERR("No state-space representation in covar_funct::ss_noise().",
+                o2scl::exc_eunimpl);
+      return 0.0;
+    }
+    //@}
     
   };
   
@@ -249,6 +285,248 @@ namespace o2scl {
 
   };
 
+  /** \brief Covariance function: 1D Matern function with 
+      half-integer index and a noise term
+
+      The index \f$ \nu \f$ is \f$ 1/2 \f$, \f$ 3/2 \f$, or
+      \f$ 5/2 \f$ for \ref order equal to 0, 1, or 2. With 
+      \f$ r \equiv |x_1-x_2| \f$ and \f$ \lambda \equiv 
+      \sqrt{2 \nu}/L \f$, the covariance function is
+      \f[
+      C(r) = e^{-\lambda r} \left\{ 1, 1+\lambda r,
+      1 + \lambda r + \lambda^2 r^2/3 \right\}
+      \f]
+      plus \f$ 10^{\mathrm{log10\_noise}} \f$ when 
+      \f$ x_1 = x_2 \f$.
+      
+      This covariance function has an exact state-space
+      representation of dimension <tt>order+1</tt>, whose state
+      vector is the function and its first \c order derivatives.
+      This allows \ref interp_krige_optim to interpolate in
+      \f$ {\cal O}(N) \f$ time. The second derivative is not
+      defined at \f$ r=0 \f$ for \ref order equal to 0.
+   */
+  class covar_funct_matern_noise : public covar_funct {
+    
+  protected:
+
+    /// The value of \f$ \lambda \f$
+    double lambda() {
+      if (order==0) return 1.0/len;
+      else if (order==1) return sqrt(3.0)/len;
+      return sqrt(5.0)/len;
+    }
+    
+    /** \brief The integral of the noiseless covariance function
+        from 0 to \c u
+    */
+    double integ_half(double u) {
+      double a=lambda();
+      double ua=fabs(u)*a;
+      double ex=exp(-ua);
+      double ret;
+      if (order==0) {
+        ret=(1.0-ex)/a;
+      } else if (order==1) {
+        ret=(2.0-(2.0+ua)*ex)/a;
+      } else {
+        ret=(8.0-(8.0+5.0*ua+ua*ua)*ex)/a/3.0;
+      }
+      if (u<0.0) return -ret;
+      return ret;
+    }
+    
+  public:
+
+    covar_funct_matern_noise() {
+      order=1;
+      len=1.0;
+      log10_noise=-15.0;
+    }
+    
+    virtual ~covar_funct_matern_noise() {
+    }
+    
+    /** \brief The order of the Matern function, 0, 1, or 2 
+        (default 1)
+    */
+    size_t order;
+    
+    /// Length parameter
+    double len;
+    
+    /// Noise parameter
+    double log10_noise;
+
+    /// Get the number of parameters (always returns 2)
+    virtual size_t get_n_params() {
+      return 2;
+    }
+    
+    /// Set the parameters
+    template<class vec_t>
+    void set_params(vec_t &p) {
+      len=p[0];
+      log10_noise=p[1];
+      return;
+    }
+    
+    /// The covariance function
+    virtual double operator()(double x1, double x2) {
+      double ra=fabs(x1-x2)*lambda();
+      double ret;
+      if (order==0) {
+        ret=exp(-ra);
+      } else if (order==1) {
+        ret=(1.0+ra)*exp(-ra);
+      } else {
+        ret=(1.0+ra+ra*ra/3.0)*exp(-ra);
+      }
+      if (x1==x2) ret+=pow(10.0,log10_noise);
+      return ret;
+    }
+
+    /** \brief The derivative of the covariance function with
+        respect to the first argument
+    */
+    virtual double deriv(double x1, double x2) {
+      double a=lambda();
+      double r=x1-x2;
+      double ex=exp(-a*fabs(r));
+      if (order==0) {
+        if (r==0.0) return 0.0;
+        if (r>0.0) return -a*ex;
+        return a*ex;
+      } else if (order==1) {
+        return -a*a*r*ex;
+      }
+      return -a*a/3.0*r*(1.0+a*fabs(r))*ex;
+    }
+    
+    /** \brief The second derivative of the covariance function with
+        respect to the first argument
+    */
+    virtual double deriv2(double x1, double x2) {
+      double a=lambda();
+      double ra=a*fabs(x1-x2);
+      double ex=exp(-ra);
+      if (order==0) {
+        return a*a*ex;
+      } else if (order==1) {
+        return -a*a*(1.0-ra)*ex;
+      }
+      return -a*a/3.0*(1.0+ra-ra*ra)*ex;
+    }
+
+    /** \brief The integral of the covariance function over 
+        \f$ [a,b] \f$
+    */
+    virtual double integ(double x, double a, double b) {
+      return integ_half(b-x)-integ_half(a-x);
+    }
+
+    /// \name State-space representation
+    //@{
+    /// The dimension of the state-space representation
+    virtual size_t ss_dim() {
+      return order+1;
+    }
+    
+    /** \brief Compute the transition matrix \c A and the process
+        noise covariance \c Q for a step of size \c dx
+
+        The feedback matrix \f$ F \f$ has a single eigenvalue,
+        \f$ -\lambda \f$, so that \f$ N = F + \lambda I \f$ is
+        nilpotent and the matrix exponential is a finite sum.
+        The process noise is \f$ Q = P_{\infty} - A P_{\infty} A^{T}
+        \f$.
+    */
+    virtual void ss_trans(double dx, boost::numeric::ublas::matrix<double> &A,
+                          boost::numeric::ublas::matrix<double> &Q) {
+      
+      size_t d=order+1;
+      double a=lambda();
+      
+      // Construct N=F+lambda*I, whose last row is determined
+      // by the binomial coefficients
+      boost::numeric::ublas::matrix<double> N(d,d), Nk(d,d), T(d,d), P(d,d);
+      static const double binom[3][3]={{1.0,0.0,0.0},{1.0,2.0,0.0},
+                                       {1.0,3.0,3.0}};
+      for(size_t i=0;i<d;i++) {
+        for(size_t j=0;j<d;j++) {
+          N(i,j)=0.0;
+          if (j==i+1) N(i,j)=1.0;
+          if (i==d-1) N(i,j)-=binom[order][j]*pow(a,((double)(d-j)));
+          if (i==j) N(i,j)+=a;
+        }
+      }
+      
+      // A = exp(-a*dx) sum_k (N dx)^k/k!
+      A.resize(d,d);
+      for(size_t i=0;i<d;i++) {
+        for(size_t j=0;j<d;j++) {
+          Nk(i,j)=(i==j ? 1.0 : 0.0);
+          A(i,j)=Nk(i,j);
+        }
+      }
+      for(size_t k=1;k<d;k++) {
+        for(size_t i=0;i<d;i++) {
+          for(size_t j=0;j<d;j++) {
+            T(i,j)=0.0;
+            for(size_t l=0;l<d;l++) {
+              T(i,j)+=Nk(i,l)*N(l,j)*dx/((double)k);
+            }
+          }
+        }
+        Nk=T;
+        A+=Nk;
+      }
+      A*=exp(-a*dx);
+      
+      ss_stat(P);
+      T=prod(A,P);
+      Q=P-prod(T,trans(A));
+      for(size_t i=0;i<d;i++) {
+        for(size_t j=0;j<i;j++) {
+          double avg=(Q(i,j)+Q(j,i))/2.0;
+          Q(i,j)=avg;
+          Q(j,i)=avg;
+        }
+      }
+      
+      return;
+    }
+    
+    /// Compute the stationary covariance of the state, \c P
+    virtual void ss_stat(boost::numeric::ublas::matrix<double> &P) {
+      size_t d=order+1;
+      double a=lambda();
+      P.resize(d,d);
+      for(size_t i=0;i<d;i++) {
+        for(size_t j=0;j<d;j++) {
+          P(i,j)=0.0;
+        }
+      }
+      P(0,0)=1.0;
+      if (order==1) {
+        P(1,1)=a*a;
+      } else if (order==2) {
+        P(1,1)=a*a/3.0;
+        P(0,2)=-a*a/3.0;
+        P(2,0)=-a*a/3.0;
+        P(2,2)=a*a*a*a;
+      }
+      return;
+    }
+    
+    /// The variance of the observation noise
+    virtual double ss_noise() {
+      return pow(10.0,log10_noise);
+    }
+    //@}
+
+  };
+
   /** \brief Covariance function: 1D from strings
    */
   class covar_funct_strings : public covar_funct {
@@ -931,12 +1209,256 @@ namespace o2scl {
     std::function<double(double,double,double)> ffi;
     //@}
 
+    /// The parent class type
+    typedef interp_krige<vec_t,vec2_t,
+                         std::function<double(double,double)>,
+                         std::function<double(double,double,double)>,
+                         mat_t,mat_inv_t> parent_t;
+    
+    /// \name State-space representation
+    //@{
+    /// If true, the state-space solution is used for interpolation
+    bool ss_on;
+
+    /// The data indices sorted in increasing order in \f$ x \f$
+    std::vector<size_t> ss_ix;
+
+    /// The filtered state mean at each point
+    std::vector<ubvector> ss_mf;
+
+    /// The filtered state covariance at each point
+    std::vector<ubmatrix> ss_Pf;
+    
+    /// The smoothed state mean at each point
+    std::vector<ubvector> ss_ms;
+
+    /// The smoothed state covariance at each point
+    std::vector<ubmatrix> ss_Ps;
+
+    /// Return true if the state-space solution should be used
+    bool ss_active() {
+      return state_space && cf->ss_dim()>0;
+    }
+    
+    /** \brief Given the state mean \c m and covariance \c P at 
+        one point, and the smoothed mean \c ms_next and covariance
+        \c Ps_next at a point a distance \c dx to the right,
+        compute the smoothed mean and covariance at the first point
+
+        This is one step of the Rauch-Tung-Striebel smoother. This
+        function returns a non-zero value if the predicted covariance
+        is not positive definite.
+    */
+    int ss_smooth_step(double dx, const ubvector &m, const ubmatrix &P,
+                       const ubvector &ms_next, const ubmatrix &Ps_next,
+                       ubvector &ms, ubmatrix &Ps) const {
+      
+      size_t d=m.size();
+      ubmatrix A, Q;
+      cf->ss_trans(dx,A,Q);
+
+      // The predicted mean and covariance
+      ubvector mp=prod(A,m);
+      ubmatrix PAT=prod(P,trans(A));
+      ubmatrix Pp=prod(A,PAT)+Q;
+
+      // The smoother gain, G = P A^T Pp^{-1}
+      int cret=o2scl_linalg::cholesky_decomp(d,Pp,false);
+      if (cret!=0) return cret;
+      o2scl_linalg::cholesky_invert<ubmatrix>(d,Pp);
+      ubmatrix G=prod(PAT,Pp);
+
+      ms=m+prod(G,ubvector(ms_next-mp));
+      ubmatrix Pp2=prod(A,PAT)+Q;
+      ubmatrix GD=prod(G,ubmatrix(Ps_next-Pp2));
+      Ps=P+prod(GD,trans(G));
+      
+      return 0;
+    }
+
+    /** \brief Compute the Kalman filter and smoother for the
+        current covariance parameters, returning the quality
+        factor for the current \ref mode
+
+        This requires \f$ {\cal O}(N) \f$ operations. The
+        log-marginal likelihood is computed from the innovations of
+        the filter and the leave-one-out predictions are computed
+        from the smoothed states using the relations
+        \f$ K^{-1} f = (y - \mu)/\sigma_n^2 \f$ and
+        \f$ (K^{-1})_{ii} = (\sigma_n^2 - v_i)/\sigma_n^4 \f$ where
+        \f$ \mu_i \f$ and \f$ v_i \f$ are the smoothed mean and
+        variance of the function at point \f$ i \f$.
+    */
+    double qual_fun_ss(int &success) {
+
+      success=0;
+      size_t size=this->sz;
+      size_t d=cf->ss_dim();
+      double R=cf->ss_noise();
+
+      if (ss_ix.size()!=size) {
+        ss_ix.resize(size);
+        for(size_t i=0;i<size;i++) ss_ix[i]=i;
+        const vec_t &xr=*this->px;
+        std::sort(ss_ix.begin(),ss_ix.end(),
+                  [&xr](size_t i1, size_t i2) { return xr[i1]<xr[i2]; });
+      }
+      ss_mf.resize(size);
+      ss_Pf.resize(size);
+      ss_ms.resize(size);
+      ss_Ps.resize(size);
+      
+      // Forward pass: the Kalman filter
+      double lml=0.0;
+      ubvector m(d);
+      ubmatrix P, A, Q;
+      for(size_t i=0;i<d;i++) m[i]=0.0;
+      cf->ss_stat(P);
+      
+      for(size_t k=0;k<size;k++) {
+        size_t ik=ss_ix[k];
+        if (k>0) {
+          cf->ss_trans((*this->px)[ik]-(*this->px)[ss_ix[k-1]],A,Q);
+          m=prod(A,ubvector(m));
+          ubmatrix PAT=prod(P,trans(A));
+          P=prod(A,PAT)+Q;
+        }
+        double yk;
+        if (this->rescaled) {
+          yk=this->y_r[ik];
+        } else {
+          yk=(*this->py)[ik];
+        }
+        double S=P(0,0)+R;
+        if (!(S>0.0)) {
+          success=1;
+          return 1.0e99;
+        }
+        double v=yk-m[0];
+        ubvector gain(d);
+        for(size_t i=0;i<d;i++) gain[i]=P(i,0)/S;
+        m+=gain*v;
+        for(size_t i=0;i<d;i++) {
+          for(size_t j=0;j<d;j++) {
+            P(i,j)-=gain[i]*gain[j]*S;
+          }
+        }
+        lml+=0.5*(v*v/S+log(S));
+        ss_mf[k]=m;
+        ss_Pf[k]=P;
+      }
+
+      // Backward pass: the Rauch-Tung-Striebel smoother
+      ss_ms[size-1]=ss_mf[size-1];
+      ss_Ps[size-1]=ss_Pf[size-1];
+      for(size_t k=size-1;k>0;k--) {
+        double dx=(*this->px)[ss_ix[k]]-(*this->px)[ss_ix[k-1]];
+        int sret=ss_smooth_step(dx,ss_mf[k-1],ss_Pf[k-1],ss_ms[k],
+                                ss_Ps[k],ss_ms[k-1],ss_Ps[k-1]);
+        if (sret!=0) {
+          success=2;
+          return 1.0e99;
+        }
+      }
+
+      if (mode==mode_max_lml) {
+        qual=lml;
+        if (verbose>2) {
+          std::cout << "qual (max_lml, state-space): " << qual << std::endl;
+        }
+        return qual;
+      }
+
+      qual=0.0;
+      for(size_t k=0;k<size;k++) {
+        size_t ik=ss_ix[k];
+        double yact;
+        if (this->rescaled) {
+          yact=this->y_r[ik];
+        } else {
+          yact=(*this->py)[ik];
+        }
+        double den=R-ss_Ps[k](0,0);
+        if (!(den>0.0)) {
+          success=3;
+          return 1.0e99;
+        }
+        double sigma2=R*R/den;
+        double ypred=yact-(yact-ss_ms[k][0])*R/den;
+        if (mode==mode_loo_cv) {
+          qual+=pow(yact-ypred,2.0)/sigma2/2.0;
+          qual+=0.5*log(sigma2);
+        } else if (mode==mode_loo_cv_bf_rel && yact!=0.0) {
+          qual+=pow(yact-ypred,2.0)/yact/yact;
+        } else {
+          qual+=pow(yact-ypred,2.0);
+        }
+      }
+      
+      if (verbose>2) {
+        std::cout << "qual (loo_cv, state-space): " << qual << std::endl;
+      }
+      
+      return qual;
+    }
+
+    /** \brief Compute the posterior mean \c m and covariance
+        \c P of the state at the point \c x0
+    */
+    void ss_point(double x0, ubvector &m, ubmatrix &P) const {
+
+      size_t size=this->sz;
+      const vec_t &xr=*this->px;
+      
+      // Find the first sorted point to the right of x0
+      size_t k=std::upper_bound(ss_ix.begin(),ss_ix.end(),x0,
+                                [&xr](double xx, size_t i) {
+                                  return xx<xr[i]; })-ss_ix.begin();
+      
+      int sret=0;
+      if (k==size) {
+        // Predict forward from the last smoothed state
+        ubmatrix A, Q;
+        cf->ss_trans(x0-xr[ss_ix[size-1]],A,Q);
+        m=prod(A,ss_ms[size-1]);
+        ubmatrix PAT=prod(ss_Ps[size-1],trans(A));
+        P=prod(A,PAT)+Q;
+      } else if (k==0) {
+        // Start from the stationary distribution
+        ubvector m0(ss_ms[0].size());
+        ubmatrix P0;
+        for(size_t i=0;i<m0.size();i++) m0[i]=0.0;
+        cf->ss_stat(P0);
+        sret=ss_smooth_step(xr[ss_ix[0]]-x0,m0,P0,ss_ms[0],ss_Ps[0],m,P);
+      } else {
+        // Predict from the filtered state to the left, and 
+        // then smooth using the state to the right
+        ubmatrix A, Q;
+        cf->ss_trans(x0-xr[ss_ix[k-1]],A,Q);
+        ubvector m0=prod(A,ss_mf[k-1]);
+        ubmatrix PAT=prod(ss_Pf[k-1],trans(A));
+        ubmatrix P0=prod(A,PAT)+Q;
+        sret=ss_smooth_step(xr[ss_ix[k]]-x0,m0,P0,ss_ms[k],ss_Ps[k],m,P);
+      }
+      if (sret!=0) {
+        O2SCL_ERR2("Smoothing step failed in ",
+                   "interp_krige_optim::ss_point().",o2scl::exc_efailed);
+      }
+      
+      return;
+    }
+    //@}
+
   public:
 
     /** \brief Function to optimize the covariance parameters
      */
     double qual_fun(int &success) {
 
+      if (ss_active()) {
+        return qual_fun_ss(success);
+      }
+      
       success=0;
 
       size_t size=this->sz;
@@ -1280,6 +1802,8 @@ namespace o2scl {
       verbose=0;
       mode=mode_loo_cv;
       full_min=false;
+      state_space=true;
+      ss_on=false;
     }
 
     /// \name Function to minimize and various option
@@ -1301,6 +1825,22 @@ namespace o2scl {
     /// Verbosity parameter
     int verbose;
 
+    /** \brief If true, use the state-space representation of 
+        the covariance function when it is available (default true)
+
+        When the covariance function has a state-space
+        representation (see \ref covar_funct::ss_dim() and
+        \ref covar_funct_matern_noise), the optimization and the 
+        interpolation use a Kalman filter and smoother which 
+        require \f$ {\cal O}(N) \f$ operations rather than the 
+        \f$ {\cal O}(N^3) \f$ operations for the dense covariance
+        matrix. The results are the same, except at the data points
+        themselves, where the state-space result does not include
+        the noise term in the covariance between the point and
+        itself. The integral is not available in this case.
+    */
+    bool state_space;
+    
     /// Default minimizer
     mmin_simp2<> def_mmin;
 
@@ -1330,6 +1870,8 @@ namespace o2scl {
       this->px=&x;
       this->py=&y;
       this->sz=size;
+      ss_on=false;
+      ss_ix.clear();
 
       if (this->rescaled) {
         this->mean_y=o2scl::vector_mean(size,y);
@@ -1488,6 +2030,16 @@ namespace o2scl {
       }
       cf->set_params(min_params);
 
+      if (ss_active()) {
+        qual=qual_fun_ss(success);
+        if (success!=0) {
+          O2SCL_ERR2("State-space solution failed in ",
+                     "interp_krige_optim::set().",o2scl::exc_efailed);
+        }
+        ss_on=true;
+        return;
+      }
+      
       ff=std::bind(std::mem_fn<double(double,double)>
                    (&func_t::operator()),cf,
                    std::placeholders::_1,std::placeholders::_2);
@@ -1508,6 +2060,96 @@ namespace o2scl {
       return;
     }
 
+    /// Give the value of the function \f$ y(x=x_0) \f$ .
+    virtual double eval(double x0) const {
+      if (!ss_on) return parent_t::eval(x0);
+      ubvector m;
+      ubmatrix P;
+      ss_point(x0,m,P);
+      if (this->rescaled) {
+        return m[0]*this->std_y+this->mean_y;
+      }
+      return m[0];
+    }
+
+    /// Give the value of the derivative \f$ y^{\prime}(x=x_0) \f$ .
+    virtual double deriv(double x0) const {
+      if (!ss_on) return parent_t::deriv(x0);
+      if (ss_ms[0].size()<2) {
+        O2SCL_ERR2("State-space representation does not include the ",
+                   "derivative in interp_krige_optim::deriv().",
+                   o2scl::exc_eunimpl);
+      }
+      ubvector m;
+      ubmatrix P;
+      ss_point(x0,m,P);
+      if (this->rescaled) {
+        return m[1]*this->std_y;
+      }
+      return m[1];
+    }
+    
+    /** \brief Give the value of the second derivative  
+        \f$ y^{\prime \prime}(x=x_0) \f$
+    */
+    virtual double deriv2(double x0) const {
+      if (!ss_on) return parent_t::deriv2(x0);
+      if (ss_ms[0].size()<3) {
+        O2SCL_ERR2("State-space representation does not include the ",
+                   "second derivative in interp_krige_optim::deriv2().",
+                   o2scl::exc_eunimpl);
+      }
+      ubvector m;
+      ubmatrix P;
+      ss_point(x0,m,P);
+      if (this->rescaled) {
+        return m[2]*this->std_y;
+      }
+      return m[2];
+    }
+
+    /// Give the value of the integral \f$ \int_a^{b}y(x)~dx \f$ .
+    virtual double integ(double a, double b) const {
+      if (ss_on) {
+        O2SCL_ERR2("Integral not available with state-space ",
+                   "representation in interp_krige_optim::integ().",
+                   o2scl::exc_eunimpl);
+      }
+      return parent_t::integ(a,b);
+    }
+    
+    /** \brief Return the interpolation uncertainty from the 
+        Gaussian process
+    */
+    double sigma(double x0) const {
+      if (!ss_on) return parent_t::sigma(x0);
+      ubvector m;
+      ubmatrix P;
+      ss_point(x0,m,P);
+      double sigma=P(0,0)+cf->ss_noise();
+      if (this->rescaled) {
+        sigma*=this->std_y;
+      }
+      return sigma;
+    }
+
+    /** \brief Generate a probability distribution for the interpolation
+        at a specified point
+    */
+    prob_dens_gaussian gen_dist(double x0) const {
+      if (!ss_on) return parent_t::gen_dist(x0);
+      double sig=sigma(x0);
+      if (sig<0.0) sig=0.0;
+      return prob_dens_gaussian(eval(x0),sig);
+    }
+    
+    /** \brief Sample the probability distribution for the interpolation
+        at a specified point
+    */
+    double sample(double x0) const {
+      return gen_dist(x0)();
+    }
+    
     /** \brief Initialize interpolation routine with optional
         rescaling
 
@@ -547,6 +547,65 @@ int main(void) {
            << iqg2.integ(fs,0.0,xt) << endl;
     }
   }
+
+  // ---------------------------------------------------------------
+  // Test the state-space representation of the Matern covariance
+  // functions against the dense covariance matrix
+
+  if (true) {
+
+    cout << "Class interp_krige_optim with Matern covariance." << endl;
+    
+    // Data in decreasing order to test the sorting
+    size_t NM=60;
+    ubvector xm(NM), ym(NM);
+    for(size_t i=0;i<NM;i++) {
+      xm[i]=2.0-((double)i)/((double)(NM-1))*2.0+0.01*sin(i*i);
+      ym[i]=xm[i]*xm[i]*xm[i]*exp(-4.0*xm[i]);
+    }
+    
+    vector<vector<double>> param_lists;
+    param_lists.push_back({0.1,0.3,1.0});
+    param_lists.push_back({-5.0,-4.0});
+
+    for(size_t order=1;order<=2;order++) {
+      
+      covar_funct_matern_noise cfm;
+      cfm.order=order;
+      
+      for(size_t mode=1;mode<=3;mode++) {
+        
+        interp_krige_optim<ubvector,ubvector,
+                           covar_funct_matern_noise> iko_ss, iko_dense;
+        iko_dense.state_space=false;
+        iko_ss.mode=mode;
+        iko_dense.mode=mode;
+        
+        iko_dense.set(NM,xm,ym,cfm,param_lists,true);
+        double len_dense=cfm.len;
+        iko_ss.set(NM,xm,ym,cfm,param_lists,true);
+        t.test_rel(cfm.len,len_dense,1.0e-12,"matern params");
+        
+        int success;
+        t.test_rel(iko_ss.qual_fun(success),
+                   iko_dense.qual_fun(success),1.0e-6,"matern qual");
+        
+        for(double xt=0.05;xt<2.2;xt+=0.3) {
+          t.test_rel(iko_ss.eval(xt),iko_dense.eval(xt),
+                     1.0e-6,"matern eval");
+          t.test_rel(iko_ss.deriv(xt),iko_dense.deriv(xt),
+                     1.0e-6,"matern deriv");
+          t.test_rel(iko_ss.sigma(xt),iko_dense.sigma(xt),
+                     1.0e-4,"matern sigma");
+          if (order==2) {
+            t.test_rel(iko_ss.deriv2(xt),iko_dense.deriv2(xt),
+                       1.0e-5,"matern deriv2");
+          }
+        }
+      }
+    }
+    cout << endl;
+  }
   
   t.report();
 
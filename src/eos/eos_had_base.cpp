@@ -51,6 +51,10 @@ eos_had_base::eos_had_base() {
   sat_mroot=&def_sat_mroot;
 
   err_nonconv=true;
+  sat_props_step=0.02;
+  sat_props_delta=1.0e-3;
+  sat_n0_min=0.08;
+  sat_n0_max=0.24;
 }
 
 double eos_had_base::fcomp(double nb, double delta) {
@@ -314,7 +318,7 @@ int eos_had_base::fn0(double delta, double &nb, double &leoa) {
 
 int eos_had_base::saturation() {
   int sret=fn0(0.0,n0,eoa);
-  if (sret!=0 || n0<0.08 || n0>0.24) {
+  if (sret!=0 || n0<sat_n0_min || n0>sat_n0_max) {
     O2SCL_CONV_RET((((std::string)"Function eos_had_base::saturati")+
                     "on() found an unphysical saturation density ("+
                     o2scl::dtos(n0)+").").c_str(),
@@ -328,6 +332,67 @@ int eos_had_base::saturation() {
   return 0;
 }
 
+int eos_had_base::saturation_properties(eos_had_sat_props &sp) {
+
+  int sret=fn0(0.0,n0,eoa);
+  if (sret!=0 || n0<sat_n0_min || n0>sat_n0_max) {
+    O2SCL_CONV_RET((((std::string)"Function eos_had_base::saturati")+
+                    "on_properties() found an unphysical saturation "+
+                    "density ("+o2scl::dtos(n0)+").").c_str(),
+                   o2scl::exc_efailed,err_nonconv);
+  }
+
+  // The stencil in density. For each point, compute the pressure
+  // of symmetric matter divided by the density squared (the
+  // derivative of the energy per baryon) and the symmetry energy
+  double h=sat_props_step*n0, hd=sat_props_delta;
+  double pn2[5], sym[5];
+  for(int j=-2;j<=2;j++) {
+    double nb=n0+j*h;
+    double pr=calc_pressure_nb(nb,0.0);
+    if (j==0) msom=neutron->ms/neutron->m;
+    // This form doesn't assume that the neutron and proton masses
+    // are equal
+    double dmu_p=calc_dmu_delta(hd,nb);
+    double dmu_m=calc_dmu_delta(-hd,nb);
+    if (!std::isfinite(pr) || !std::isfinite(dmu_p) ||
+        !std::isfinite(dmu_m)) {
+      O2SCL_CONV2_RET("EOS not finite in ",
+                      "eos_had_base::saturation_properties().",
+                      o2scl::exc_efailed,err_nonconv);
+    }
+    pn2[j+2]=pr/nb/nb;
+    sym[j+2]=(dmu_p-dmu_m)/hd/8.0;
+  }
+
+  // Five-point finite differences
+  double d1_pn2=(pn2[0]-8.0*pn2[1]+8.0*pn2[3]-pn2[4])/12.0/h;
+  double d2_pn2=(-pn2[0]+16.0*pn2[1]-30.0*pn2[2]+16.0*pn2[3]-pn2[4])/
+    12.0/h/h;
+  double d1_sym=(sym[0]-8.0*sym[1]+8.0*sym[3]-sym[4])/12.0/h;
+  double d2_sym=(-sym[0]+16.0*sym[1]-30.0*sym[2]+16.0*sym[3]-sym[4])/
+    12.0/h/h;
+  double d3_sym=(-sym[0]+2.0*sym[1]-2.0*sym[3]+sym[4])/2.0/h/h/h;
+
+  // The incompressibility is 9 dP/dn = 9 (n^2 d(P/n^2)/dn + 2 P/n)
+  double P0=pn2[2]*n0*n0;
+  comp=9.0*(n0*n0*d1_pn2+2.0*P0/n0);
+  kprime=27.0*n0*n0*n0*d2_pn2;
+  esym=sym[2];
+
+  sp.n0=n0;
+  sp.eoa=eoa;
+  sp.comp=comp;
+  sp.kprime=kprime;
+  sp.esym=esym;
+  sp.esym_slope=3.0*n0*d1_sym;
+  sp.esym_curve=9.0*n0*n0*d2_sym;
+  sp.esym_skew=27.0*n0*n0*n0*d3_sym;
+  sp.msom=msom;
+  
+  return 0;
+}
+
 void eos_had_base::gradient_qij(fermion &n, fermion &p, thermo &th,
 				double &qnn, double &qnp, double &qpp, 
 				double &dqnndnn, double &dqnndnp,
@@ -41,6 +41,38 @@
 
 namespace o2scl {
 
+  /** \brief Properties of nuclear matter at the saturation density
+
+      This object is filled by \ref
+      eos_had_base::saturation_properties(). The energies are in \f$
+      \mathrm{fm}^{-1} \f$ and the density is in \f$
+      \mathrm{fm}^{-3} \f$.
+  */
+  class eos_had_sat_props {
+    
+  public:
+    
+    /// Saturation density
+    double n0;
+    /// Binding energy (without the rest mass)
+    double eoa;
+    /// Incompressibility, \f$ K \f$
+    double comp;
+    /// Skewness, \f$ K^{\prime} \f$ (see \ref eos_had_base::fkprime())
+    double kprime;
+    /// Symmetry energy, \f$ S \f$
+    double esym;
+    /// Slope of the symmetry energy, \f$ L \f$
+    double esym_slope;
+    /// Curvature of the symmetry energy, \f$ K_{\mathrm{sym}} \f$
+    double esym_curve;
+    /// Skewness of the symmetry energy, \f$ Q_{\mathrm{sym}} \f$
+    double esym_skew;
+    /// Neutron effective mass divided by bare mass
+    double msom;
+    
+  };
+  
   /** \brief Hadronic equation of state [abstract base]
 
       \note This class and all of its children expect the neutron and
@@ -439,6 +471,28 @@ namespace o2scl {
         EOS functions does not converge (default true)
     */
     bool err_nonconv;
+
+    /** \brief The density step for \ref saturation_properties()
+        relative to the saturation density (default 0.02)
+    */
+    double sat_props_step;
+
+    /** \brief The isospin asymmetry step for \ref
+        saturation_properties() (default \f$ 10^{-3} \f$)
+    */
+    double sat_props_delta;
+
+    /** \brief The smallest saturation density accepted by \ref
+        saturation() and \ref saturation_properties() (default 0.08
+        \f$ \mathrm{fm}^{-3} \f$)
+    */
+    double sat_n0_min;
+
+    /** \brief The largest saturation density accepted by \ref
+        saturation() and \ref saturation_properties() (default 0.24
+        \f$ \mathrm{fm}^{-3} \f$)
+    */
+    double sat_n0_max;
     //@}
 
     /// \name Equation of state
@@ -641,16 +695,46 @@ namespace o2scl {
         stored in \ref n0, \ref comp, \ref esym, \ref eoa, \ref msom,
         and \ref kprime, respectively.
 
-        \note If the saturation density is less than \f$
-        0.08~\mathrm{fm}^{-3} \f$ or larger than \f$
-        0.24~\mathrm{fm}^{-3} \f$ then either the error handler is
-        called, or if \ref err_nonconv is false, then a non-zero value
-        is returned.
+        \note If the saturation density is less than \ref
+        sat_n0_min or larger than \ref sat_n0_max then either the
+        error handler is called, or if \ref err_nonconv is false,
+        then a non-zero value is returned.
 
         \future It would be great to provide numerical uncertainties
         in the saturation properties.
     */
     virtual int saturation();
+
+    /** \brief Compute the saturation density and the properties of
+        nuclear matter at that density from one stencil of EOS
+        evaluations
+
+        This function computes the saturation density with \ref
+        fn0() and then evaluates the EOS at the five baryon densities
+        \f$ n_0 (1 + j h) \f$ for \f$ j=-2,\ldots,2 \f$, where \f$ h
+        \f$ is \ref sat_props_step. At each density, the pressure of
+        symmetric matter is computed, and the symmetry energy is
+        computed from \ref calc_dmu_delta() at \f$ \delta = \pm
+        \f$ \ref sat_props_delta. The incompressibility, the
+        skewness, and the slope, curvature, and skewness of the
+        symmetry energy are then obtained from five-point finite
+        differences, so that all of the quantities share the same 15
+        calls to \ref calc_e(), rather than the separate adaptive
+        derivatives used in \ref fcomp(), \ref fkprime(), \ref
+        fesym(), \ref fesym_slope(), \ref fesym_curve(), and \ref
+        fesym_skew(). The first and second derivatives are fourth
+        order in \f$ h \f$ and the third derivatives are second
+        order.
+
+        The results are stored in \c sp and also in \ref n0, \ref
+        eoa, \ref comp, \ref kprime, \ref esym, and \ref msom. 
+
+        \note As in \ref saturation(), if the saturation density is
+        less than \ref sat_n0_min or larger than \ref sat_n0_max
+        then either the error handler is called, or if \ref
+        err_nonconv is false, then a non-zero value is returned.
+    */
+    virtual int saturation_properties(eos_had_sat_props &sp);
     //@}
 
     /// \name Nucleonic matter functions
@@ -1437,6 +1521,86 @@ namespace o2scl {
     virtual int calc_temp_e(fermion &n, fermion &p, double T, 
                             thermo &th);
   };
+
+  /** \brief Compute the saturation properties for many parameter
+      sets in parallel
+
+      For each index \c i from 0 to <tt>n-1</tt>, this function
+      makes a copy of \c e, calls <tt>set_params(i,eos)</tt> with the
+      copy to set the parameters (which should return zero on
+      success), and then calls \ref
+      eos_had_base::saturation_properties(), storing the results in
+      <tt>res[i]</tt> and the return value in <tt>ret[i]</tt>. The
+      indices are divided into \c n_threads contiguous blocks which
+      are computed in parallel if OpenMP is enabled, and each block
+      uses one copy of \c e. The copies have \ref
+      eos_had_base::err_nonconv set to false, and exceptions are
+      caught and reported as \ref o2scl::exc_efailed. The results
+      for parameter sets which failed are set to NaN. This function
+      returns the number of failures.
+
+      The type \c eos_t must have a copy constructor which
+      copies the model parameters.
+  */
+  template<class eos_t, class func_t>
+  size_t saturation_properties_batch
+  (eos_t &e, size_t n, func_t &&set_params,
+   std::vector<eos_had_sat_props> &res, std::vector<int> &ret,
+   size_t n_threads=1) {
+
+    res.resize(n);
+    ret.resize(n);
+    if (n==0) return 0;
+    
+    size_t nt=n_threads;
+#ifndef O2SCL_SET_OPENMP
+    nt=1;
+#endif
+    if (nt==0) nt=1;
+    if (nt>n) nt=n;
+
+    double nan=std::numeric_limits<double>::quiet_NaN();
+    
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+    for(size_t it=0;it<nt;it++) {
+
+      eos_t et(e);
+      et.err_nonconv=false;
+      et.sat_props_step=e.sat_props_step;
+      et.sat_props_delta=e.sat_props_delta;
+      
+      for(size_t i=it*n/nt;i<(it+1)*n/nt;i++) {
+        int r;
+        try {
+          r=set_params(i,et);
+          if (r==0) r=et.saturation_properties(res[i]);
+        } catch (...) {
+          r=o2scl::exc_efailed;
+        }
+        ret[i]=r;
+        if (r!=0) {
+          res[i].n0=nan;
+          res[i].eoa=nan;
+          res[i].comp=nan;
+          res[i].kprime=nan;
+          res[i].esym=nan;
+          res[i].esym_slope=nan;
+          res[i].esym_curve=nan;
+          res[i].esym_skew=nan;
+          res[i].msom=nan;
+        }
+      }
+    }
+
+    size_t n_fail=0;
+    for(size_t i=0;i<n;i++) {
+      if (ret[i]!=0) n_fail++;
+    }
+    
+    return n_fail;
+  }
   
 }
 
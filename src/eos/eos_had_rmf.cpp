@@ -69,6 +69,12 @@ eos_had_rmf::eos_had_rmf() {
   def_mroot.def_jac.set_epsrel(1.0e-4);
   def_sat_mroot.def_jac.set_epsrel(1.0e-4);
   def_mroot.def_jac.set_epsmin(1.0e-15);
+  sweep_jac.set_epsrel(1.0e-4);
+  sweep_jac.set_epsmin(1.0e-15);
+  
+  sweep_max_iter=8;
+  sweep_tol=1.0e-10;
+  sweep_n_jac=0;
   
 }
 
@@ -735,6 +741,224 @@ int eos_had_rmf::calc_temp_e(fermion &ne, fermion &pr, const double T,
   return 0;
 }
 
+int eos_had_rmf::sweep_set(size_t ivar, double val, double nB,
+                           double delta, double T) {
+  if (ivar==0) nB=val;
+  else if (ivar==1) T=val;
+  else delta=val;
+  if (nB<=0.0 || T<0.0 || delta<=-1.0 || delta>=1.0) {
+    return exc_einval;
+  }
+  n_baryon=nB;
+  n_charge=nB*(1.0-delta)/2.0;
+  ce_temp=T;
+  return 0;
+}
+
+int eos_had_rmf::sweep_fun(size_t nv, const ubvector &ex, ubvector &ey,
+                           thermo &th) {
+  if (ce_temp>0.0) {
+    return calc_temp_e_solve_fun(nv,ex,ey,th);
+  }
+  return calc_e_solve_fun(nv,ex,ey,th);
+}
+
+bool eos_had_rmf::sweep_lu(ubvector &x, ubvector &y, ubmatrix &jac,
+                           permutation &p, thermo &th) {
+  
+  if (sweep_fun(5,x,y,th)!=0) return false;
+  sweep_jac(5,x,5,y,jac);
+  sweep_n_jac++;
+  int signum;
+  o2scl_linalg::LU_decomp<ubmatrix,double>(5,jac,p,signum);
+  for(size_t i=0;i<5;i++) {
+    if (jac(i,i)==0.0 || !std::isfinite(jac(i,i))) return false;
+  }
+  return true;
+}
+
+bool eos_had_rmf::sweep_newton(ubvector &x, ubvector &y, ubvector &dx,
+                               const ubmatrix &jac, const permutation &p,
+                               thermo &th) {
+  
+  double res_old=0.0;
+  for(size_t it=0;it<=sweep_max_iter;it++) {
+    if (sweep_fun(5,x,y,th)!=0) return false;
+    double res=0.0;
+    for(size_t i=0;i<5;i++) {
+      if (fabs(y[i])>res) res=fabs(y[i]);
+    }
+    if (res<sweep_tol) return true;
+    // Stop if the convergence is too slow, so that the Jacobian
+    // can be recomputed
+    if (it==sweep_max_iter || (it>0 && res>0.5*res_old)) return false;
+    res_old=res;
+    for(size_t i=0;i<5;i++) y[i]=-y[i];
+    o2scl_linalg::LU_solve(5,jac,p,y,dx);
+    for(size_t i=0;i<5;i++) x[i]+=dx[i];
+  }
+  
+  return false;
+}
+
+int eos_had_rmf::calc_sweep(fermion &ne, fermion &pr, thermo &lth,
+                            std::string var, const ubvector &grid,
+                            double nB, double delta, double T,
+                            std::shared_ptr<table_units<> > results) {
+
+  size_t ivar;
+  if (var=="nb") {
+    ivar=0;
+  } else if (var=="T") {
+    ivar=1;
+  } else if (var=="delta") {
+    ivar=2;
+  } else {
+    O2SCL_ERR2("Variable must be \"nb\", \"T\", or \"delta\" in ",
+               "eos_had_rmf::calc_sweep().",exc_einval);
+  }
+  
+  results->clear();
+  results->line_of_names(((std::string)"nb delta T nn np mun mup ")+
+                         "msn msp sigma omega rho ed pr en");
+  results->line_of_units(((std::string)"1/fm^3 . 1/fm 1/fm^3 1/fm^3 ")+
+                         "1/fm 1/fm 1/fm 1/fm 1/fm 1/fm 1/fm 1/fm^4 "+
+                         "1/fm^4 1/fm^3");
+  sweep_n_jac=0;
+
+  for(size_t k=0;k<grid.size();k++) {
+    if (sweep_set(ivar,grid[k],nB,delta,T)!=0) {
+      O2SCL_ERR2("Invalid density, temperature, or asymmetry in ",
+                 "eos_had_rmf::calc_sweep().",exc_einval);
+    }
+    if (ivar==1 && ce_temp<=0.0) {
+      O2SCL_ERR2("Temperatures must be positive in a temperature ",
+                 "sweep in eos_had_rmf::calc_sweep().",exc_einval);
+    }
+  }
+  
+  ne.non_interacting=false;
+  pr.non_interacting=false;
+  set_n_and_p(ne,pr);
+
+  mm_funct fmf=std::bind
+    (std::mem_fn<int(size_t,const ubvector &,ubvector &,thermo &)>
+     (&eos_had_rmf::sweep_fun),
+     this,std::placeholders::_1,std::placeholders::_2,
+     std::placeholders::_3,std::ref(lth));
+  sweep_jac.set_function(fmf);
+  
+  ubvector x(5), y(5), y2(5), dx(5), x_prev(5), x_pred(5);
+  ubmatrix jac(5,5);
+  permutation p(5);
+  bool jac_valid=false;
+
+  for(size_t k=0;k<grid.size();k++) {
+
+    if (k==0) {
+      
+      // The first point, using the usual solver
+      sweep_set(ivar,grid[0],nB,delta,T);
+      ne.n=n_baryon-n_charge;
+      pr.n=n_charge;
+      double T0=ce_temp;
+      int ret;
+      if (T0>0.0) {
+        ret=calc_temp_e(ne,pr,T0,lth);
+      } else {
+        ret=calc_e(ne,pr,lth);
+      }
+      if (ret!=0) {
+        O2SCL_CONV2_RET("Solver failed at the first point in ",
+                        "eos_had_rmf::calc_sweep().",exc_efailed,
+                        this->err_nonconv);
+      }
+      sweep_set(ivar,grid[0],nB,delta,T);
+      ce_neut_matter=false;
+      ce_prot_matter=false;
+      x[0]=ne.mu;
+      x[1]=pr.mu;
+      x[2]=sigma;
+      x[3]=omega;
+      x[4]=rho;
+      
+    } else {
+      
+      double lam_prev=grid[k-1];
+      double dlam=grid[k]-lam_prev;
+    
+      if (!jac_valid) jac_valid=sweep_lu(x,y,jac,p,lth);
+      
+      // Predictor step along the tangent, using a finite difference
+      // for the derivative of the equations with respect to the
+      // variable
+      x_pred=x;
+      if (jac_valid) {
+        double h=1.0e-7*std::max(fabs(lam_prev),fabs(dlam));
+        int r1=sweep_fun(5,x,y,lth);
+        sweep_set(ivar,lam_prev+h,nB,delta,T);
+        int r2=sweep_fun(5,x,y2,lth);
+        if (r1==0 && r2==0) {
+          for(size_t i=0;i<5;i++) dx[i]=-(y2[i]-y[i])/h;
+          o2scl_linalg::LU_solve(5,jac,p,dx,y);
+          for(size_t i=0;i<5;i++) x_pred[i]=x[i]+dlam*y[i];
+        }
+      }
+      sweep_set(ivar,grid[k],nB,delta,T);
+
+      // Newton corrector with the Jacobian from a previous point,
+      // and then with a new Jacobian if necessary
+      x_prev=x;
+      x=x_pred;
+      bool conv=false;
+      if (jac_valid) conv=sweep_newton(x,y,dx,jac,p,lth);
+      if (!conv) {
+        if (sweep_fun(5,x_pred,y,lth)==0) x=x_pred;
+        else x=x_prev;
+        jac_valid=sweep_lu(x,y,jac,p,lth);
+        if (jac_valid) conv=sweep_newton(x,y,dx,jac,p,lth);
+      }
+      
+      if (!conv) {
+        // Use the full solver, starting from the previous point
+        x=x_prev;
+        bool ent=eos_mroot->err_nonconv;
+        eos_mroot->err_nonconv=false;
+        int ret=eos_mroot->msolve(5,x,fmf);
+        eos_mroot->err_nonconv=ent;
+        jac_valid=false;
+        if (ret!=0) {
+          sigma=x_prev[2];
+          omega=x_prev[3];
+          rho=x_prev[4];
+          std::string s=((std::string)"Solver failed at ")+var+"="+
+            o2scl::dtos(grid[k])+" in eos_had_rmf::calc_sweep().";
+          O2SCL_CONV_RET(s.c_str(),exc_efailed,this->err_nonconv);
+        }
+      }
+    }
+
+    // Final evaluation to store the results in ne, pr, and lth
+    sweep_fun(5,x,y,lth);
+    std::vector<double> line={n_baryon,(n_baryon-2.0*n_charge)/n_baryon,
+                              ce_temp,ne.n,pr.n,ne.mu,pr.mu,ne.ms,pr.ms,
+                              x[2],x[3],x[4],lth.ed,lth.pr,lth.en};
+    results->line_of_data(line);
+    
+    if (verbose>0) {
+      cout << "eos_had_rmf::calc_sweep(): " << var << "=" << grid[k]
+           << " " << x[0] << " " << x[1] << " " << x[2] << " "
+           << x[3] << " " << x[4] << " " << sweep_n_jac << endl;
+    }
+  }
+
+  sigma=x[2];
+  omega=x[3];
+  rho=x[4];
+
+  return 0;
+}
+
 int eos_had_rmf::calc_eq_p(fermion &ne, fermion &pr, double sig, double ome, 
 			   double lrho, double &f1, double &f2, double &f3, 
 			   thermo &lth) {
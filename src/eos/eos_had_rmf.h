@@ -31,6 +31,9 @@
 #include <o2scl/lib_settings.h>
 #include <o2scl/constants.h>
 #include <o2scl/mm_funct.h>
+#include <o2scl/jacobian.h>
+#include <o2scl/lu.h>
+#include <o2scl/table_units.h>
 
 #include <o2scl/part.h>
 #include <o2scl/eos_had_base.h>
@@ -319,6 +322,9 @@ namespace o2scl {
   class eos_had_rmf : public eos_had_temp_pres_base {
 
   public:
+
+    /// The uBlas matrix type
+    typedef boost::numeric::ublas::matrix<double> ubmatrix;
     
     int check_derivs(double &dPds, double &dPdw, double &dPdr,
                      fermion &ne, fermion &pr,
@@ -344,6 +350,26 @@ namespace o2scl {
 
     /// Modifies method of calculating effective masses (default false)
     bool zm_mode;
+
+    /** \brief The maximum number of corrector iterations in \ref
+        calc_sweep() before the Jacobian is recomputed (default 8)
+    */
+    size_t sweep_max_iter;
+
+    /** \brief The tolerance for the corrector in \ref calc_sweep()
+        (default \f$ 10^{-10} \f$)
+
+        The corrector has converged when the absolute values of the
+        residuals of the density equations and the field equations
+        are all smaller than this value. The density equations are
+        relative residuals if \ref calc_e_relative is true.
+    */
+    double sweep_tol;
+
+    /** \brief The number of Jacobian evaluations in the most recent
+        call to \ref calc_sweep()
+    */
+    size_t sweep_n_jac;
     
     /** \brief Verbosity parameter
 
@@ -412,6 +438,10 @@ namespace o2scl {
       this->calc_e_steps=f.calc_e_steps;
       this->calc_e_relative=f.calc_e_relative;
       this->zm_mode=f.zm_mode;
+      this->sweep_max_iter=f.sweep_max_iter;
+      this->sweep_tol=f.sweep_tol;
+      this->sweep_jac.set_epsrel(f.sweep_jac.get_epsrel());
+      this->sweep_jac.set_epsmin(f.sweep_jac.get_epsmin());
       this->verbose=f.verbose;
       this->mnuc=f.mnuc;
       this->ms=f.ms;
@@ -462,6 +492,10 @@ namespace o2scl {
         this->calc_e_steps=f.calc_e_steps;
         this->calc_e_relative=f.calc_e_relative;
         this->zm_mode=f.zm_mode;
+        this->sweep_max_iter=f.sweep_max_iter;
+        this->sweep_tol=f.sweep_tol;
+        this->sweep_jac.set_epsrel(f.sweep_jac.get_epsrel());
+        this->sweep_jac.set_epsmin(f.sweep_jac.get_epsmin());
         this->verbose=f.verbose;
         this->mnuc=f.mnuc;
         this->ms=f.ms;
@@ -585,6 +619,41 @@ namespace o2scl {
     */
     int calc_temp_e(fermion &ne, fermion &pr, double T, 
                     thermo &lth);
+
+    /** \brief Compute the EOS along a sequence of baryon densities,
+        temperatures, or isospin asymmetries, storing the results
+        in \c results
+
+        The variable \c var should be one of <tt>"nb"</tt>,
+        <tt>"T"</tt>, or <tt>"delta"</tt>, and the values of that
+        variable are given in \c grid. The other two quantities are
+        fixed at \c nB (in \f$ \mathrm{fm}^{-3} \f$), \c T (in \f$
+        \mathrm{fm}^{-1} \f$), and \c delta, where \f$ \delta =
+        (n_n-n_p)/n_B \f$ must be between -1 and 1 (exclusive). If
+        the temperature is zero, then \ref calc_e() is used for the
+        first point, otherwise \ref calc_temp_e() is used.
+
+        Each subsequent point begins with a predictor step along the
+        tangent of the solution curve, \f$ dx/d\lambda = -J^{-1}
+        \partial F / \partial \lambda \f$, where \f$ x \f$ contains
+        the chemical potentials and the fields, \f$ F \f$ are the
+        equations solved in \ref calc_e() or \ref calc_temp_e(), and
+        \f$ \lambda \f$ is the variable being swept. This is
+        followed by Newton corrector steps which reuse the
+        LU-decomposed Jacobian \f$ J \f$ from earlier points. The
+        Jacobian is recomputed only when the corrector fails to
+        converge quickly, and if that fails, the solver \ref
+        eos_had_base::eos_mroot is used.
+
+        On exit, \c results has the columns <tt>nb, delta, T, nn, np,
+        mun, mup, msn, msp, sigma, omega, rho, ed, pr, en</tt> and
+        \c ne, \c pr, and \c lth contain the results for the last
+        point.
+    */
+    int calc_sweep(fermion &ne, fermion &pr, thermo &lth,
+                   std::string var, const ubvector &grid, double nB,
+                   double delta, double T,
+                   std::shared_ptr<table_units<> > results);
     //@}
 
     /// \name Saturation properties
@@ -951,6 +1020,33 @@ namespace o2scl {
     /// Temperature storage for calc_temp_e()
     double ce_temp;
 
+    /// Jacobian for calc_sweep()
+    jacobian_gsl<mm_funct,ubvector,ubmatrix> sweep_jac;
+
+    /// The function for calc_sweep()
+    int sweep_fun(size_t nv, const ubvector &ex, ubvector &ey,
+                  thermo &th);
+
+    /** \brief Compute the Jacobian for calc_sweep() at \c x and its
+        LU decomposition, returning false on failure
+    */
+    bool sweep_lu(ubvector &x, ubvector &y, ubmatrix &jac,
+                  permutation &p, thermo &th);
+
+    /** \brief Newton iterations for calc_sweep() with a fixed
+        LU-decomposed Jacobian, returning true on convergence
+    */
+    bool sweep_newton(ubvector &x, ubvector &y, ubvector &dx,
+                      const ubmatrix &jac, const permutation &p,
+                      thermo &th);
+
+    /** \brief Set the baryon density, charge density, and
+        temperature for the value \c val of the variable with index
+        \c ivar for calc_sweep()
+    */
+    int sweep_set(size_t ivar, double val, double nB, double delta,
+                  double T);
+
 #endif
 
   };
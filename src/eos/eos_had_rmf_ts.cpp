@@ -572,6 +572,62 @@ public:
     cout << rmf.fesym_T(0.16,1.0/hc_mev_fm)*hc_mev_fm << endl;
     cout << rmf.fesym_T(0.16,3.0/hc_mev_fm)*hc_mev_fm << endl;
     cout << rmf.fesym_T(0.16,10.0/hc_mev_fm)*hc_mev_fm << endl;
+    cout << endl;
+
+    // -----------------------------------------------------------------
+    // Check calc_sweep() against calc_temp_e() and calc_e()
+    // -----------------------------------------------------------------
+
+    {
+      eos_had_rmf rs, rs2;
+      load_nl3(rs);
+      load_nl3(rs2);
+      fermion ns(939.0/hc_mev_fm,2.0), ps(939.0/hc_mev_fm,2.0);
+      fermion ns2(939.0/hc_mev_fm,2.0), ps2(939.0/hc_mev_fm,2.0);
+      thermo ths, ths2;
+      std::shared_ptr<table_units<> > tab(new table_units<>);
+      ubvector grid(20);
+
+      std::string vars[4]={"nb","T","delta","nb"};
+      for(size_t iv=0;iv<4;iv++) {
+        double T=(iv==3) ? 0.0 : 10.0/hc_mev_fm;
+        for(size_t i=0;i<20;i++) {
+          if (iv==1) {
+            grid[i]=(1.0+29.0*i/19.0)/hc_mev_fm;
+          } else if (iv==2) {
+            grid[i]=-0.5+1.4*i/19.0;
+          } else {
+            grid[i]=0.04+0.36*i/19.0;
+          }
+        }
+        ns.mu=4.8;
+        ps.mu=4.8;
+        int ret=rs.calc_sweep(ns,ps,ths,vars[iv],grid,0.16,0.2,T,tab);
+        t.test_gen(ret==0,"sweep ret. val.");
+        t.test_gen(tab->get_nlines()==20,"sweep lines");
+        if (iv==1) {
+          t.test_gen(rs.sweep_n_jac<10,"sweep Jacobian reuse");
+        }
+        cout << "calc_sweep() " << vars[iv] << ": " << rs.sweep_n_jac
+             << " Jacobian evaluations." << endl;
+
+        for(size_t i=0;i<20;i+=6) {
+          ns2.n=tab->get("nn",i);
+          ps2.n=tab->get("np",i);
+          ns2.mu=4.8;
+          ps2.mu=4.8;
+          if (T>0.0) {
+            rs2.calc_temp_e(ns2,ps2,tab->get("T",i),ths2);
+          } else {
+            rs2.calc_e(ns2,ps2,ths2);
+          }
+          t.test_rel(tab->get("mun",i),ns2.mu,1.0e-8,"sweep mun");
+          t.test_rel(tab->get("mup",i),ps2.mu,1.0e-8,"sweep mup");
+          t.test_rel(tab->get("ed",i),ths2.ed,1.0e-8,"sweep ed");
+          t.test_rel(tab->get("pr",i),ths2.pr,1.0e-6,"sweep pr");
+        }
+      }
+    }
 
     t.report();
 
@@ -175,6 +175,306 @@ int eos_had_skyrme::calc_deriv_e(fermion_deriv &ne, fermion_deriv &pr,
   return calc_deriv_temp_e(ne,pr,0.0,locth,thd);
 }
 
+void eos_had_skyrme_batch::resize_params(size_t np) {
+  t0.resize(np);
+  t1.resize(np);
+  t2.resize(np);
+  t3.resize(np);
+  x0.resize(np);
+  x1.resize(np);
+  x2.resize(np);
+  x3.resize(np);
+  alpha.resize(np);
+  a.resize(np);
+  b.resize(np);
+  return;
+}
+
+void eos_had_skyrme_batch::set_params(size_t ip,
+                                      const eos_had_skyrme &sk) {
+  if (ip>=t0.size()) {
+    O2SCL_ERR2("Index out of range in ",
+               "eos_had_skyrme_batch::set_params().",exc_eindex);
+  }
+  t0[ip]=sk.t0;
+  t1[ip]=sk.t1;
+  t2[ip]=sk.t2;
+  t3[ip]=sk.t3;
+  x0[ip]=sk.x0;
+  x1[ip]=sk.x1;
+  x2[ip]=sk.x2;
+  x3[ip]=sk.x3;
+  alpha[ip]=sk.alpha;
+  a[ip]=sk.a;
+  b[ip]=sk.b;
+  return;
+}
+
+void eos_had_skyrme::batch_kinetic(size_t n, const double *dens,
+                                   const double *ms, const double *T,
+                                   double m, bool inc_rest_mass,
+                                   double *nu, double *ed, double *en,
+                                   fermion_nonrel &nrf_t) {
+
+  fermi_dirac_integ_vec fdv;
+  double eta[batch_block], lft[batch_block], pre[batch_block];
+  double f12[batch_block], fm12[batch_block];
+  bool conv[batch_block];
+  size_t ix[batch_block];
+
+  // Zero temperature expressions. These are also correct at finite
+  // temperature for zero density (see the class documentation).
+  for(size_t k=0;k<n;k++) {
+    double kf=cbrt(3.0*pi2*dens[k]);
+    nu[k]=kf*kf/2.0/ms[k];
+    ed[k]=pow(kf,5.0)/10.0/pi2/ms[k];
+    en[k]=0.0;
+  }
+
+  // Collect the finite temperature points
+  size_t nf=0;
+  for(size_t k=0;k<n;k++) {
+    if (T[k]>0.0 && dens[k]>0.0) {
+      ix[nf]=k;
+      nf++;
+    }
+  }
+
+  if (nf>0) {
+
+    // Initial guess for eta=nu/T from the approximation in
+    // Nilsson (1973)
+    for(size_t j=0;j<nf;j++) {
+      size_t k=ix[j];
+      pre[j]=pow(2.0*ms[k]*T[k],1.5)/2.0/pi2;
+      lft[j]=log(dens[k]/pre[j]);
+      double u=dens[k]/pre[j]/root_pi*2.0;
+      double v=pow(0.75*root_pi*u,2.0/3.0);
+      double lt=-0.5;
+      if (fabs(u-1.0)>1.0e-6) lt=log(u)/(1.0-u*u);
+      eta[j]=lt+v/(1.0+pow(0.24+1.08*v,-2.0));
+      conv[j]=false;
+    }
+
+    // Newton's method for log(F_{1/2}(eta)) on all points at once
+    for(size_t it=0;it<batch_max_iter;it++) {
+      fdv.calc_1o2_vec(nf,eta,f12);
+      fdv.calc_m1o2_vec(nf,eta,fm12);
+      bool done=true;
+      for(size_t j=0;j<nf;j++) {
+        double step=(log(f12[j])-lft[j])*2.0*f12[j]/fm12[j];
+        eta[j]-=step;
+        conv[j]=(fabs(step)<1.0e-10*(1.0+fabs(eta[j])));
+        done=done && conv[j];
+      }
+      if (done) break;
+    }
+
+    // Finish the thermodynamics
+    fdv.calc_3o2_vec(nf,eta,f12);
+    for(size_t j=0;j<nf;j++) {
+      size_t k=ix[j];
+      nu[k]=eta[j]*T[k];
+      ed[k]=f12[j]*pre[j]*T[k];
+      en[k]=(5.0*ed[k]/3.0-nu[k]*dens[k])/T[k];
+    }
+
+    // Use the scalar solver for points which did not converge
+    for(size_t j=0;j<nf;j++) {
+      size_t k=ix[j];
+      if (!conv[j] || !std::isfinite(ed[k])) {
+        fermion f(m,2.0);
+        f.non_interacting=false;
+        f.inc_rest_mass=false;
+        f.n=dens[k];
+        f.ms=ms[k];
+        f.nu=T[k];
+        nrf_t.calc_density(f,T[k]);
+        nu[k]=f.nu;
+        ed[k]=f.ed;
+        en[k]=f.en;
+      }
+    }
+
+  }
+
+  if (inc_rest_mass) {
+    for(size_t k=0;k<n;k++) {
+      nu[k]+=m;
+      ed[k]+=dens[k]*m;
+    }
+  }
+
+  return;
+}
+
+size_t eos_had_skyrme::calc_batch(eos_had_skyrme_batch &bt,
+                                  size_t n_threads) {
+
+  size_t npar=bt.t0.size();
+  size_t npt=bt.nB.size();
+  if (bt.t1.size()!=npar || bt.t2.size()!=npar || bt.t3.size()!=npar ||
+      bt.x0.size()!=npar || bt.x1.size()!=npar || bt.x2.size()!=npar ||
+      bt.x3.size()!=npar || bt.alpha.size()!=npar ||
+      bt.a.size()!=npar || bt.b.size()!=npar) {
+    O2SCL_ERR2("Parameter arrays have different sizes in ",
+               "eos_had_skyrme::calc_batch().",exc_einval);
+  }
+  if (bt.Ye.size()!=npt || bt.T.size()!=npt) {
+    O2SCL_ERR2("Point arrays have different sizes in ",
+               "eos_had_skyrme::calc_batch().",exc_einval);
+  }
+
+  size_t ntot=npar*npt;
+  bt.ed.resize(ntot);
+  bt.pr.resize(ntot);
+  bt.en.resize(ntot);
+  bt.mun.resize(ntot);
+  bt.mup.resize(ntot);
+  bt.msn.resize(ntot);
+  bt.msp.resize(ntot);
+  bt.ret.resize(ntot);
+  if (ntot==0) return 0;
+
+  size_t nt=n_threads;
+#ifndef O2SCL_SET_OPENMP
+  nt=1;
+#endif
+  if (nt==0) nt=1;
+  if (nt>npar) nt=npar;
+
+  double mn=neutron->m, mp=proton->m;
+  bool irn=neutron->inc_rest_mass, irp=proton->inc_rest_mass;
+  double nan=std::numeric_limits<double>::quiet_NaN();
+  size_t n_fail=0;
+
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(static,1) reduction(+:n_fail)
+#endif
+  for(size_t it=0;it<nt;it++) {
+
+    fermion_nonrel nrf_t;
+    double nn[batch_block], np[batch_block], Tk[batch_block];
+    double msn[batch_block], msp[batch_block];
+    double nun[batch_block], nup[batch_block];
+    double edn[batch_block], edp[batch_block];
+    double enn[batch_block], enp[batch_block];
+    bool valid[batch_block];
+
+    for(size_t ip=it*npar/nt;ip<(it+1)*npar/nt;ip++) {
+
+      // Coefficients, as in hamiltonian_coeffs() and eff_mass()
+      double alpha_i=bt.alpha[ip];
+      double ham1=0.5*bt.t0[ip]*(1.0+0.5*bt.x0[ip]);
+      double ham2=-0.5*bt.t0[ip]*(0.5+bt.x0[ip]);
+      double ham3=bt.a[ip]*bt.t3[ip]/6.0*(1.0+0.5*bt.x3[ip]);
+      double ham4=bt.a[ip]*bt.t3[ip]*pow(2.0,alpha_i-2.0)/6.0*
+        (1.0-bt.x3[ip]);
+      double ham5=bt.b[ip]*bt.t3[ip]/12.0*(1.0+0.5*bt.x3[ip]);
+      double ham6=-bt.b[ip]*bt.t3[ip]/12.0*(0.5+bt.x3[ip]);
+      double term=0.25*(bt.t1[ip]*(1.0+bt.x1[ip]/2.0)+
+                        bt.t2[ip]*(1.0+bt.x2[ip]/2.0));
+      double term2=0.25*(bt.t2[ip]*(0.5+bt.x2[ip])-
+                         bt.t1[ip]*(0.5+bt.x1[ip]));
+
+      for(size_t j0=0;j0<npt;j0+=batch_block) {
+
+        size_t nk=npt-j0;
+        if (nk>batch_block) nk=batch_block;
+
+        // Densities and effective masses. Invalid points are
+        // computed at zero density and then discarded.
+        for(size_t k=0;k<nk;k++) {
+          double nb=bt.nB[j0+k], ye=bt.Ye[j0+k];
+          Tk[k]=bt.T[j0+k];
+          valid[k]=(std::isfinite(nb) && std::isfinite(ye) &&
+                    std::isfinite(Tk[k]) && nb>=0.0 && ye>=0.0 &&
+                    ye<=1.0 && Tk[k]>=0.0 && alpha_i>0.0);
+          if (!valid[k]) {
+            nb=0.0;
+            ye=0.0;
+            Tk[k]=0.0;
+          }
+          nn[k]=nb*(1.0-ye);
+          np[k]=nb*ye;
+          msn[k]=mn/(1.0+2.0*(nb*term+nn[k]*term2)*mn);
+          msp[k]=mp/(1.0+2.0*(nb*term+np[k]*term2)*mp);
+          if (msn[k]<0.0 || msp[k]<0.0) {
+            valid[k]=false;
+            nn[k]=0.0;
+            np[k]=0.0;
+            Tk[k]=0.0;
+            msn[k]=mn;
+            msp[k]=mp;
+          }
+        }
+
+        batch_kinetic(nk,nn,msn,Tk,mn,irn,nun,edn,enn,nrf_t);
+        batch_kinetic(nk,np,msp,Tk,mp,irp,nup,edp,enp,nrf_t);
+
+        // The potential part, as in base_thermo()
+        for(size_t k=0;k<nk;k++) {
+          size_t ix=ip*npt+j0+k;
+          double nb=nn[k]+np[k];
+          // The terms with a factor of 1/nb below vanish as nb->0
+          double rnb=(nb>0.0) ? 1.0/nb : 0.0;
+          double na=pow(nb,alpha_i);
+          double npa=pow(np[k],alpha_i);
+          double nna=pow(nn[k],alpha_i);
+          double nsq=nn[k]*nn[k]+np[k]*np[k];
+
+          double ham=edn[k]+edp[k]+ham1*nb*nb+ham2*nsq+
+            ham3*na*nn[k]*np[k]+ham4*(nna*nn[k]*nn[k]+npa*np[k]*np[k])+
+            ham5*nb*nb*na+ham6*nsq*na;
+
+          double gn, gp;
+          if (irn) gn=2.0*msn[k]*(edn[k]-nn[k]*mn);
+          else gn=2.0*msn[k]*edn[k];
+          if (irp) gp=2.0*msp[k]*(edp[k]-np[k]*mp);
+          else gp=2.0*msp[k]*edp[k];
+
+          double common=2.0*ham1*nb+ham5*(2.0+alpha_i)*nb*na;
+          double dhdnn=common+2.0*ham2*nn[k]+
+            ham3*na*np[k]*(alpha_i*nn[k]*rnb+1.0)+
+            ham4*(nna*nn[k]*(2.0+alpha_i))+
+            ham6*(2.0*nn[k]*na+nsq*alpha_i*na*rnb);
+          double dhdnp=common+2.0*ham2*np[k]+
+            ham3*na*nn[k]*(alpha_i*np[k]*rnb+1.0)+
+            ham4*(npa*np[k]*(2.0+alpha_i))+
+            ham6*(2.0*np[k]*na+nsq*alpha_i*na*rnb);
+
+          double mun=nun[k]+dhdnn+(gn+gp)*term+gn*term2;
+          double mup=nup[k]+dhdnp+(gn+gp)*term+gp*term2;
+          double en=enn[k]+enp[k];
+
+          if (valid[k]) {
+            bt.ed[ix]=ham;
+            bt.en[ix]=en;
+            bt.pr[ix]=Tk[k]*en+mun*nn[k]+mup*np[k]-ham;
+            bt.mun[ix]=mun;
+            bt.mup[ix]=mup;
+            bt.msn[ix]=msn[k];
+            bt.msp[ix]=msp[k];
+            bt.ret[ix]=0;
+          } else {
+            bt.ed[ix]=nan;
+            bt.en[ix]=nan;
+            bt.pr[ix]=nan;
+            bt.mun[ix]=nan;
+            bt.mup[ix]=nan;
+            bt.msn[ix]=nan;
+            bt.msp[ix]=nan;
+            bt.ret[ix]=exc_einval;
+            n_fail++;
+          }
+        }
+      }
+    }
+  }
+
+  return n_fail;
+}
+
 double eos_had_skyrme::feoa_symm(double nb) {
   double ret, kr23, beta, t3p;
 
@@ -36,9 +36,84 @@
 #include <o2scl/part.h>
 #include <o2scl/fermion_nonrel.h>
 #include <o2scl/fermion_deriv_nr.h>
+#include <o2scl/fermi_dirac_vec.h>
 
 namespace o2scl {
-  
+
+  class eos_had_skyrme;
+
+  /** \brief Structure-of-arrays storage for batched evaluations
+      of Skyrme models
+
+      This object holds a set of Skyrme parameter sets and a set of
+      points \f$ (n_B,Y_e,T) \f$ for \ref
+      o2scl::eos_had_skyrme::calc_batch() . The parameters are in
+      the internal units of \ref o2scl::eos_had_skyrme (powers of
+      \f$ \mathrm{fm} \f$), and the densities and temperatures are
+      in \f$ \mathrm{fm}^{-3} \f$ and \f$ \mathrm{fm}^{-1} \f$. The
+      proton fraction is \f$ Y_e = n_p/n_B \f$.
+
+      The output arrays have one entry for every combination of
+      parameter set and point, with the entry for parameter set \c
+      ip and point \c j stored at index <tt>ip*n_points()+j</tt>.
+  */
+  class eos_had_skyrme_batch {
+
+  public:
+
+    /// \name Parameter sets
+    //@{
+    std::vector<double> t0, t1, t2, t3, x0, x1, x2, x3, alpha, a, b;
+    //@}
+
+    /// \name Points
+    //@{
+    /// Baryon density
+    std::vector<double> nB;
+    /// Proton fraction
+    std::vector<double> Ye;
+    /// Temperature
+    std::vector<double> T;
+    //@}
+
+    /// \name Output
+    //@{
+    /// Energy density
+    std::vector<double> ed;
+    /// Pressure
+    std::vector<double> pr;
+    /// Entropy density
+    std::vector<double> en;
+    /// Neutron chemical potential
+    std::vector<double> mun;
+    /// Proton chemical potential
+    std::vector<double> mup;
+    /// Neutron effective mass
+    std::vector<double> msn;
+    /// Proton effective mass
+    std::vector<double> msp;
+    /// The return value for each point (zero for success)
+    std::vector<int> ret;
+    //@}
+
+    /// Resize the parameter arrays to hold \c np parameter sets
+    void resize_params(size_t np);
+
+    /// Copy the parameters of \c sk into parameter set \c ip
+    void set_params(size_t ip, const eos_had_skyrme &sk);
+
+    /// Return the number of parameter sets
+    size_t n_params() const {
+      return t0.size();
+    }
+
+    /// Return the number of points
+    size_t n_points() const {
+      return nB.size();
+    }
+
+  };
+
   /** \brief Skyrme hadronic equation of state 
 
       \verbatim embed:rst
@@ -549,7 +624,32 @@ namespace o2scl {
     */
     virtual int calc_deriv_e(fermion_deriv &ne, fermion_deriv &pr,
                              thermo &th, thermo_np_deriv_helm &thd);
-    
+
+    /** \brief Compute the EOS for every combination of parameter
+        set and point in \c bt
+
+        This gives the same results as \ref calc_temp_e() (using the
+        masses and the value of <tt>inc_rest_mass</tt> from \ref
+        eos_had_base::neutron and \ref eos_had_base::proton), but
+        evaluates the points in blocks. At zero temperature the
+        nucleon kinetic terms are computed analytically. At finite
+        temperature the nucleon chemical potentials are obtained by
+        a Newton iteration for all the points in a block at once,
+        using the array functions in \ref
+        o2scl::fermi_dirac_integ_vec. The inner loops have a fixed
+        trip count so that they can be vectorized by the compiler.
+        Points for which the Newton iteration does not converge are
+        recomputed with \ref o2scl::fermion_nonrel_tl::calc_density().
+
+        The parameter sets are divided into \c n_threads contiguous
+        blocks which are computed in parallel if OpenMP is enabled.
+        Points with invalid input, or with a negative effective mass,
+        have their return value set to \ref o2scl::exc_einval and
+        their output set to NaN. This function returns the number of
+        such points and does not call the error handler for them.
+    */
+    size_t calc_batch(eos_had_skyrme_batch &bt, size_t n_threads=1);
+
     /// Return string denoting type ("eos_had_skyrme")
     virtual const char *type() { return "eos_had_skyrme"; }
     //@}
@@ -885,6 +985,28 @@ namespace o2scl {
     double fixn0, fixeoa, fixesym, fixcomp, fixmsom;
     //@}
 
+    /// \name Functions and parameters for calc_batch()
+    //@{
+    /// The number of points processed at once
+    static const size_t batch_block=64;
+
+    /// The maximum number of Newton iterations
+    static const size_t batch_max_iter=40;
+
+    /** \brief Compute the kinetic part for the first \c n nucleons
+        in a block
+
+        This computes the chemical potential \c nu, energy density
+        \c ed, and entropy density \c en of non-relativistic fermions
+        with spin degeneracy 2, mass \c m, and effective masses \c ms
+        at densities \c dens and temperatures \c T.
+    */
+    void batch_kinetic(size_t n, const double *dens, const double *ms,
+                       const double *T, double m, bool inc_rest_mass,
+                       double *nu, double *ed, double *en,
+                       fermion_nonrel &nrf_t);
+    //@}
+
   };
 
 }
@@ -154,6 +154,138 @@ int main(void) {
   t.test_rel(sk.fesym(n0)*hc_mev_fm,30.03,1.0e-4,"esym");
   cout << endl;
 
+  // Compare saturation_properties() with the separate functions
+  // and test the batched version
+  {
+    eos_had_sat_props sp;
+    sk.saturation_properties(sp);
+    t.test_rel(sp.n0,n0,1.0e-8,"sat props n0");
+    t.test_rel(sp.eoa,eoa2,1.0e-8,"sat props eoa");
+    t.test_rel(sp.msom,sk.fmsom(n0),1.0e-8,"sat props msom");
+    t.test_rel(sp.comp,sk.fcomp(n0),1.0e-6,"sat props comp");
+    t.test_rel(sp.esym,sk.fesym(n0),1.0e-6,"sat props esym");
+    t.test_rel(sp.kprime,sk.fkprime(n0),1.0e-3,"sat props kprime");
+    t.test_rel(sp.esym_slope,sk.fesym_slope(n0),1.0e-5,
+               "sat props esym_slope");
+    t.test_rel(sp.esym_curve,sk.fesym_curve(n0),1.0e-3,
+               "sat props esym_curve");
+    // fesym_skew() is a third derivative from nested adaptive
+    // derivatives, which is only accurate to a few percent, so
+    // the stencil is also compared with the result for half the
+    // step size, which is second order and converged to 1e-3
+    cout << "esym_skew: " << sp.esym_skew*hc_mev_fm << " "
+         << sk.fesym_skew(n0)*hc_mev_fm << endl;
+    t.test_rel(sp.esym_skew,sk.fesym_skew(n0),1.0e-1,
+               "sat props esym_skew");
+    double skew_h=sp.esym_skew;
+    sk.sat_props_step/=2.0;
+    sk.saturation_properties(sp);
+    t.test_rel(sp.esym_skew,skew_h,1.0e-3,"sat props esym_skew h/2");
+    sk.sat_props_step*=2.0;
+
+    std::vector<eos_had_sat_props> spv;
+    std::vector<int> retv;
+    size_t n_fail=saturation_properties_batch
+      (sk,4,[](size_t i, eos_had_skyrme &e) {
+        load_skms(e);
+        e.t3*=1.0+0.01*i;
+        return 0;
+      },spv,retv,2);
+    t.test_gen(n_fail==0,"sat props batch");
+    for(size_t i=0;i<4;i++) {
+      eos_had_skyrme sk2;
+      load_skms(sk2);
+      sk2.t3*=1.0+0.01*i;
+      sk2.saturation_properties(sp);
+      t.test_rel(spv[i].n0,sp.n0,1.0e-12,"sat props batch n0");
+      t.test_rel(spv[i].esym_slope,sp.esym_slope,1.0e-12,
+                 "sat props batch esym_slope");
+    }
+    cout << endl;
+  }
+
+  // Compare calc_batch() with calc_temp_e()
+  {
+    eos_had_skyrme sk2;
+    eos_had_skyrme_batch bt;
+    bt.resize_params(3);
+    for(size_t i=0;i<3;i++) {
+      load_skms(sk2);
+      sk2.t3*=1.0+0.02*i;
+      sk2.x0+=0.1*i;
+      bt.set_params(i,sk2);
+    }
+    for(double T=0.0;T<30.1/hc_mev_fm;T+=10.0/hc_mev_fm) {
+      for(double nb=0.01;nb<0.5;nb*=1.6) {
+        for(double ye=0.0;ye<0.51;ye+=0.25) {
+          bt.nB.push_back(nb);
+          bt.Ye.push_back(ye);
+          bt.T.push_back(T);
+        }
+      }
+    }
+    // Zero density, where the potential terms are evaluated in
+    // the limit nB -> 0
+    bt.nB.push_back(0.0);
+    bt.Ye.push_back(0.5);
+    bt.T.push_back(0.0);
+    bt.nB.push_back(0.0);
+    bt.Ye.push_back(0.3);
+    bt.T.push_back(10.0/hc_mev_fm);
+    // An invalid point
+    bt.nB.push_back(0.1);
+    bt.Ye.push_back(1.5);
+    bt.T.push_back(0.0);
+
+    size_t n_fail=sk2.calc_batch(bt,2);
+    t.test_gen(n_fail==3,"batch n_fail");
+
+    fermion n2(939.0/hc_mev_fm,2.0), p2(939.0/hc_mev_fm,2.0);
+    n2.non_interacting=false;
+    p2.non_interacting=false;
+    thermo th2;
+    size_t npt=bt.n_points();
+    double max_dev=0.0;
+    size_t n_ret=0;
+    for(size_t i=0;i<3;i++) {
+      load_skms(sk2);
+      sk2.t3*=1.0+0.02*i;
+      sk2.x0+=0.1*i;
+      for(size_t j=0;j+1<npt;j++) {
+        size_t ix=i*npt+j;
+        if (bt.nB[j]==0.0) {
+          if (bt.ret[ix]!=0) n_ret++;
+          t.test_abs(bt.ed[ix],0.0,1.0e-15,"batch nB=0 ed");
+          t.test_abs(bt.pr[ix],0.0,1.0e-15,"batch nB=0 pr");
+          t.test_gen(std::isfinite(bt.mun[ix]) && std::isfinite(bt.mup[ix]),
+                     "batch nB=0 mu");
+          t.test_rel(bt.msn[ix],sk2.def_neutron.m,1.0e-15,"batch nB=0 msn");
+          continue;
+        }
+        n2.n=bt.nB[j]*(1.0-bt.Ye[j]);
+        p2.n=bt.nB[j]*bt.Ye[j];
+        sk2.calc_temp_e(n2,p2,bt.T[j],th2);
+        if (bt.ret[ix]!=0) n_ret++;
+        max_dev=std::max(max_dev,fabs(bt.ed[ix]-th2.ed)/fabs(th2.ed));
+        max_dev=std::max(max_dev,fabs(bt.pr[ix]-th2.pr)/
+                         (fabs(th2.pr)+fabs(th2.ed)));
+        max_dev=std::max(max_dev,fabs(bt.mun[ix]-n2.mu)/fabs(n2.mu));
+        max_dev=std::max(max_dev,fabs(bt.msp[ix]-p2.ms)/p2.ms);
+        if (p2.n>0.0) {
+          max_dev=std::max(max_dev,fabs(bt.mup[ix]-p2.mu)/fabs(p2.mu));
+        }
+        if (bt.T[j]>0.0) {
+          max_dev=std::max(max_dev,fabs(bt.en[ix]-th2.en)/th2.en);
+        }
+      }
+      t.test_gen(bt.ret[i*npt+npt-1]==exc_einval,"batch invalid");
+    }
+    t.test_gen(n_ret==0,"batch ret");
+    cout << "calc_batch() max. deviation: " << max_dev << endl;
+    t.test_abs(max_dev,0.0,1.0e-9,"batch vs. calc_temp_e");
+    cout << endl;
+  }
+
   cout << "Testing new fractional power of alpha:" << endl;
   t.test_rel(sk.alpha,1.0/6.0,1.0e-12,"frac. alpha");
   cout << endl;
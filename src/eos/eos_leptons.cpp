@@ -30,6 +30,433 @@ using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
 
+eos_leptons_fast_table::eos_leptons_fast_table() {
+  T_min=0.1/hc_mev_fm;
+  T_max=100.0/hc_mev_fm;
+  n_min=1.0e-12;
+  n_max=1.0;
+  T_per_decade=20;
+  n_per_decade=10;
+  upper_limit_fac=60.0;
+  verbose=0;
+  nx=0;
+  ny=0;
+  m_tab=0.0;
+  vit.tol_rel=1.0e-12;
+  vit.tol_abs=0.0;
+  vit.err_nonconv=false;
+}
+
+eos_leptons_fast_table::eos_leptons_fast_table
+(const eos_leptons_fast_table &ft) {
+  vit.tol_rel=1.0e-12;
+  vit.tol_abs=0.0;
+  vit.err_nonconv=false;
+  *this=ft;
+}
+
+eos_leptons_fast_table &eos_leptons_fast_table::operator=
+(const eos_leptons_fast_table &ft) {
+  if (this!=&ft) {
+    T_min=ft.T_min;
+    T_max=ft.T_max;
+    n_min=ft.n_min;
+    n_max=ft.n_max;
+    T_per_decade=ft.T_per_decade;
+    n_per_decade=ft.n_per_decade;
+    upper_limit_fac=ft.upper_limit_fac;
+    verbose=ft.verbose;
+    nx=ft.nx;
+    ny=ft.ny;
+    x0=ft.x0;
+    y0=ft.y0;
+    hx=ft.hx;
+    hy=ft.hy;
+    m_tab=ft.m_tab;
+    table=ft.table;
+  }
+  return *this;
+}
+
+void eos_leptons_fast_table::basis(double z, double h, double b[2][3],
+                                   double db[2][3], double ddb[2][3]) {
+  
+  // The quintic Hermite basis functions for the left end of the
+  // cell, and their derivatives, at z and 1-z
+  double w[2]={z,1.0-z};
+  double psi[2][3], dpsi[2][3], ddpsi[2][3];
+  for(size_t k=0;k<2;k++) {
+    double u=w[k], u2=u*u, u3=u2*u, u4=u3*u, u5=u4*u;
+    psi[k][0]=1.0-10.0*u3+15.0*u4-6.0*u5;
+    psi[k][1]=u-6.0*u3+8.0*u4-3.0*u5;
+    psi[k][2]=0.5*(u2-3.0*u3+3.0*u4-u5);
+    dpsi[k][0]=-30.0*u2+60.0*u3-30.0*u4;
+    dpsi[k][1]=1.0-18.0*u2+32.0*u3-15.0*u4;
+    dpsi[k][2]=0.5*(2.0*u-9.0*u2+12.0*u3-5.0*u4);
+    ddpsi[k][0]=-60.0*u+180.0*u2-120.0*u3;
+    ddpsi[k][1]=-36.0*u+96.0*u2-60.0*u3;
+    ddpsi[k][2]=0.5*(2.0-18.0*u+36.0*u2-20.0*u3);
+  }
+
+  // The basis functions for the right end are obtained by
+  // reflection, with a sign change for the first derivative
+  double hp[3]={1.0,h,h*h};
+  for(size_t a=0;a<3;a++) {
+    double sgn=(a==1) ? -1.0 : 1.0;
+    b[0][a]=psi[0][a]*hp[a];
+    db[0][a]=dpsi[0][a]*hp[a]/h;
+    ddb[0][a]=ddpsi[0][a]*hp[a]/h/h;
+    b[1][a]=sgn*psi[1][a]*hp[a];
+    db[1][a]=-sgn*dpsi[1][a]*hp[a]/h;
+    ddb[1][a]=sgn*ddpsi[1][a]*hp[a]/h/h;
+  }
+  
+  return;
+}
+
+int eos_leptons_fast_table::integrands(double k, std::vector<double> &y,
+                                       double T, double mu, double m) {
+
+  double k2=k*k;
+  double e=sqrt(k2+m*m)/T;
+  double x=mu/T;
+  double c=exp(-e);
+  double zm=e-x, zp=e+x;
+  
+  // The occupation numbers of the particle and antiparticle and
+  // the functions f(1-f)
+  double fm=1.0/(1.0+exp(zm));
+  double fp=1.0/(1.0+exp(zp));
+  double em=exp(-fabs(zm)), ep=exp(-fabs(zp));
+  double hm=em/(1.0+em)/(1.0+em);
+  double hp=ep/(1.0+ep)/(1.0+ep);
+
+  if (y.size()==3) {
+    // The background at mu=0: the pressure, entropy, and dsdT
+    // integrands
+    double f0=1.0/(1.0+exp(e));
+    y[0]=k2*2.0*log1p(c);
+    y[1]=k2*2.0*e*f0;
+    y[2]=-k2*2.0*e/T*f0*(1.0-e*(1.0-f0));
+    return 0;
+  }
+
+  // For small x, the differences between the particle and
+  // antiparticle contributions are computed in a form which
+  // avoids the cancellation
+  double nu, nu_e;
+  if (fabs(x)<1.0) {
+    double den=1.0+c*c+2.0*c*cosh(x);
+    nu=2.0*c*sinh(x)/den;
+    nu_e=-2.0*c*(1.0-c*c)*sinh(x)/den/den;
+  } else {
+    nu=fm-fp;
+    nu_e=hp-hm;
+  }
+  double chi=hm+hp;
+  
+  // The density, dndmu, and dndT integrands
+  y[0]=k2*nu;
+  y[1]=k2*chi;
+  if (y.size()==2) return 0;
+  y[2]=-k2*(e*nu_e+x*chi)/T;
+
+  // The integrand for the pressure relative to mu=0,
+  // log(1+exp(x-e))+log(1+exp(-x-e))-2 log(1+exp(-e)), and its
+  // derivative with respect to e
+  double phi=0.0, phi_e=0.0;
+  if (x!=0.0) {
+    double ax=fabs(x)/2.0, lsh;
+    if (ax<20.0) {
+      lsh=log(sinh(ax));
+    } else {
+      lsh=ax-log(2.0)+log1p(-exp(-2.0*ax));
+    }
+    double lq=log(4.0)-e+2.0*lsh-2.0*log1p(c);
+    if (lq>0.0) {
+      phi=lq+log1p(exp(-lq));
+    } else {
+      phi=log1p(exp(lq));
+    }
+    if (fabs(x)<1.0) {
+      double sh=sinh(x/2.0);
+      phi_e=-4.0*sh*sh*c*(1.0-c)/(1.0+2.0*c*cosh(x)+c*c)/(1.0+c);
+    } else {
+      phi_e=-(fm+fp-2.0/(1.0+exp(e)));
+    }
+  }
+  y[3]=k2*phi;
+  y[4]=-k2*(e*phi_e+x*nu);
+  
+  return 0;
+}
+
+void eos_leptons_fast_table::integ(double T, double mu, double m,
+                                   std::vector<double> &res) {
+
+  size_t nf=res.size();
+  std::vector<double> r2(nf), err(nf);
+  std::function<int(double,std::vector<double> &)> f=
+    [this,T,mu,m](double k, std::vector<double> &y) -> int {
+      return integrands(k,y,T,mu,m);
+    };
+
+  // The upper limit and the Fermi momentum
+  double amu=fabs(mu);
+  double emax=((amu>m) ? amu : m)+upper_limit_fac*T;
+  double ul=sqrt(emax*emax-m*m);
+  if (amu>m && nf!=3) {
+    double kf=sqrt(amu*amu-m*m);
+    vit.integ_err(f,nf,0.0,kf,res,err);
+    vit.integ_err(f,nf,kf,ul,r2,err);
+    for(size_t i=0;i<nf;i++) res[i]+=r2[i];
+  } else {
+    vit.integ_err(f,nf,0.0,ul,res,err);
+  }
+  
+  return;
+}
+
+int eos_leptons_fast_table::solve_mu(double T, double n, double m,
+                                     double g, double &mu) {
+  
+  double pref=g/2.0/pi2;
+  std::vector<double> res(2);
+  
+  // Bracketed Newton's method, using the fact that the density is
+  // an increasing function of the chemical potential
+  double lo=-std::numeric_limits<double>::infinity();
+  double hi=std::numeric_limits<double>::infinity();
+  for(size_t it=0;it<200;it++) {
+    integ(T,mu,m,res);
+    double nx2=pref*res[0], chi=pref*res[1]/T;
+    if (fabs(nx2-n)<1.0e-12*n) return 0;
+    if (nx2<n) lo=mu;
+    else hi=mu;
+    double step=(n-nx2)/chi;
+    double smax=10.0*T;
+    if (0.1*fabs(mu)>smax) smax=0.1*fabs(mu);
+    if (step>smax) step=smax;
+    if (step<-smax) step=-smax;
+    double mu_new=mu+step;
+    if (!(mu_new>lo && mu_new<hi)) {
+      if (std::isfinite(lo) && std::isfinite(hi)) {
+        mu_new=(lo+hi)/2.0;
+      } else if (!(mu_new>lo)) {
+        mu_new=lo+smax;
+      } else {
+        mu_new=hi-smax;
+      }
+    }
+    if (mu_new==mu) return 0;
+    mu=mu_new;
+  }
+  
+  return 1;
+}
+
+void eos_leptons_fast_table::build(double m, double g) {
+
+  x0=log(T_min);
+  y0=log(n_min);
+  nx=((size_t)(ceil(log10(T_max/T_min)*T_per_decade)))+1;
+  ny=((size_t)(ceil(log10(n_max/n_min)*n_per_decade)))+1;
+  if (nx<2 || ny<2) {
+    O2SCL_ERR2("Table must have at least two points in each direction ",
+               "in eos_leptons_fast_table::build().",o2scl::exc_einval);
+  }
+  hx=(log(T_max)-x0)/((double)(nx-1));
+  hy=(log(n_max)-y0)/((double)(ny-1));
+  m_tab=m;
+
+  // The background for each temperature, followed by the 
+  // values at each grid point
+  std::vector<double> tab(nx*3+nx*ny*n_vals);
+  double pref=g/2.0/pi2;
+  double nan=std::numeric_limits<double>::quiet_NaN();
+  
+  std::vector<double> r3(3), r5(5), r5b(5);
+  size_t n_fail=0;
+  double mu_row=0.0;
+  
+  for(size_t i=0;i<nx;i++) {
+    
+    double T=exp(x0+hx*i);
+
+    // The pressure, entropy, and dsdT at mu=0 give the background
+    // free energy and its derivatives
+    integ(T,0.0,m,r3);
+    double P0=pref*T*r3[0];
+    double s0=P0/T+pref*r3[1];
+    double dsdT0=s0/T-P0/T/T+pref*r3[2];
+    tab[i*3]=-P0;
+    tab[i*3+1]=-T*s0;
+    tab[i*3+2]=-T*s0-T*T*dsdT0;
+
+    // The initial guess for the first density, from the
+    // nondegenerate limit or from the previous temperature
+    double mu;
+    if (i==0) {
+      double lnq=log(g*pow(m*T/2.0/pi,1.5))-m/T;
+      double lz=y0-log(2.0)-lnq;
+      if (lz>20.0) mu=T*(lz+log(2.0));
+      else mu=T*asinh(exp(lz));
+    } else {
+      mu=mu_row;
+    }
+    
+    for(size_t j=0;j<ny;j++) {
+      
+      double n=exp(y0+hy*j);
+      double *p=&tab[nx*3+(i*ny+j)*n_vals];
+
+      double mu_guess=mu;
+      int ret=solve_mu(T,n,m,g,mu);
+      if (ret!=0 || !std::isfinite(mu)) {
+        for(size_t k=0;k<n_vals;k++) p[k]=nan;
+        n_fail++;
+        mu=mu_guess;
+        continue;
+      }
+      if (j==0) mu_row=mu;
+
+      // The density derivatives, the pressure and entropy relative
+      // to mu=0, and dsdT from a finite difference of the entropy
+      integ(T,mu,m,r5);
+      double chi=pref*r5[1]/T;
+      double dndT=pref*r5[2];
+      double dP=pref*T*r5[3];
+      double ds=dP/T+pref*r5[4];
+      double dT=1.0e-4*T, ds2[2];
+      for(size_t k=0;k<2;k++) {
+        double T2=T+((k==0) ? dT : -dT);
+        integ(T2,mu,m,r5b);
+        ds2[k]=pref*r5b[3]+pref*r5b[4];
+      }
+      double ddsdT=(ds2[0]-ds2[1])/2.0/dT;
+      
+      double f_nn=1.0/chi;
+      double f_nT=-dndT/chi;
+      double f_TT=-ddsdT+dndT*dndT/chi;
+      p[0]=n*mu-dP;
+      p[1]=-T*ds;
+      p[2]=n*mu;
+      p[3]=-T*ds+T*T*f_TT;
+      p[4]=n*mu+n*n*f_nn;
+      p[5]=n*T*f_nT;
+    }
+  }
+
+  // The higher mixed derivatives from finite differences of F_{xy}
+  double *pt=&tab[nx*3];
+  for(size_t i=0;i<nx;i++) {
+    size_t il=(i==0) ? 0 : i-1;
+    size_t ih=(i==nx-1) ? i : i+1;
+    for(size_t j=0;j<ny;j++) {
+      size_t jl=(j==0) ? 0 : j-1;
+      size_t jh=(j==ny-1) ? j : j+1;
+      double *p=&pt[(i*ny+j)*n_vals];
+      p[6]=(pt[(ih*ny+j)*n_vals+5]-pt[(il*ny+j)*n_vals+5])/
+        (hx*(ih-il));
+      p[7]=(pt[(i*ny+jh)*n_vals+5]-pt[(i*ny+jl)*n_vals+5])/
+        (hy*(jh-jl));
+      p[8]=(pt[(ih*ny+jh)*n_vals+5]-pt[(ih*ny+jl)*n_vals+5]-
+            pt[(il*ny+jh)*n_vals+5]+pt[(il*ny+jl)*n_vals+5])/
+        (hx*(ih-il)*hy*(jh-jl));
+    }
+  }
+
+  if (verbose>0) {
+    std::cout << "eos_leptons_fast_table::build(): " << nx << " by "
+              << ny << " table, " << n_fail << " failed points."
+              << std::endl;
+  }
+  
+  table=std::make_shared<const std::vector<double> >(std::move(tab));
+  
+  return;
+}
+
+bool eos_leptons_fast_table::eval(fermion &f, double T,
+                                  part_deriv_press &pd) const {
+
+  double n=f.n;
+  if (!table || f.m!=m_tab || !f.non_interacting ||
+      !(T>=T_min) || !(T<=T_max) || !(n>=n_min) || !(n<=n_max)) {
+    return false;
+  }
+
+  double x=(log(T)-x0)/hx, y=(log(n)-y0)/hy;
+  size_t i=(size_t)x, j=(size_t)y;
+  if (i>nx-2) i=nx-2;
+  if (j>ny-2) j=ny-2;
+  
+  double bx[2][3], dbx[2][3], ddbx[2][3];
+  double by[2][3], dby[2][3], ddby[2][3];
+  basis(x-i,hx,bx,dbx,ddbx);
+  basis(y-j,hy,by,dby,ddby);
+
+  // The index of the derivative of order a in x and b in y
+  static const size_t ix[3][3]={{0,2,4},{1,5,7},{3,6,8}};
+
+  const std::vector<double> &tab=*table;
+
+  // The background, which depends only on the temperature
+  double F=0.0, Fx=0.0, Fxx=0.0;
+  for(size_t ci=0;ci<2;ci++) {
+    const double *p=&tab[(i+ci)*3];
+    for(size_t a=0;a<3;a++) {
+      F+=bx[ci][a]*p[a];
+      Fx+=dbx[ci][a]*p[a];
+      Fxx+=ddbx[ci][a]*p[a];
+    }
+  }
+  
+  double Fy=0.0, Fyy=0.0, Fxy=0.0;
+  for(size_t ci=0;ci<2;ci++) {
+    for(size_t cj=0;cj<2;cj++) {
+      const double *p=&tab[nx*3+((i+ci)*ny+j+cj)*n_vals];
+      for(size_t a=0;a<3;a++) {
+        for(size_t b=0;b<3;b++) {
+          double d=p[ix[a][b]];
+          F+=bx[ci][a]*by[cj][b]*d;
+          Fx+=dbx[ci][a]*by[cj][b]*d;
+          Fy+=bx[ci][a]*dby[cj][b]*d;
+          Fxx+=ddbx[ci][a]*by[cj][b]*d;
+          Fyy+=bx[ci][a]*ddby[cj][b]*d;
+          Fxy+=dbx[ci][a]*dby[cj][b]*d;
+        }
+      }
+    }
+  }
+  if (!std::isfinite(F) || !std::isfinite(Fxx) || !std::isfinite(Fyy)) {
+    return false;
+  }
+
+  double mu=Fy/n;
+  double en=-Fx/T;
+  double f_nn=(Fyy-Fy)/n/n;
+  double f_nT=Fxy/n/T;
+  double f_TT=(Fxx-Fx)/T/T;
+  
+  f.en=en;
+  f.pr=n*mu-F;
+  if (f.inc_rest_mass) {
+    f.mu=mu;
+    f.ed=F+T*en;
+  } else {
+    f.mu=mu-f.m;
+    f.ed=F+T*en-f.m*n;
+  }
+  f.nu=f.mu;
+  f.ms=f.m;
+  pd.dndmu=1.0/f_nn;
+  pd.dndT=-f_nT/f_nn;
+  pd.dsdT=-f_TT+f_nT*f_nT/f_nn;
+  
+  return true;
+}
+
 eos_leptons::eos_leptons() {
   include_muons=true;
   include_photons=false;
@@ -51,11 +478,23 @@ eos_leptons::eos_leptons() {
   pde_from_density=true;
   verbose=0;
   accuracy=acc_default;
+  fast_mode=false;
+  fast_e_used=false;
 
 }
 
+bool eos_leptons::fast_eval(eos_leptons_fast_table &ft, fermion &f,
+                            part_deriv_press &pd, double T) {
+  if (!fast_mode) return false;
+  if (!ft.is_built()) ft.build(f.m,f.g);
+  return ft.eval(f,T,pd);
+}
+
 int eos_leptons::electron_density(double T) {
 
+  fast_e_used=fast_eval(fast_e,e,ed,T);
+  if (fast_e_used) return 0;
+  
   bool inc_rest_mass=false;
   if (e.inc_rest_mass) {
     
@@ -561,7 +1000,7 @@ int eos_leptons::pair_density(double T) {
   th.pr=e.pr;
   th.en=e.en;
 
-  if (include_deriv) {
+  if (include_deriv && !fast_e_used) {
     fermion_deriv fd;
     fd=e;
     if (accuracy==acc_ld || accuracy==acc_fp_25) {
@@ -577,7 +1016,11 @@ int eos_leptons::pair_density(double T) {
   
   if (include_muons) {
 
-    if (mu.inc_rest_mass) {
+    bool fast_mu_used=fast_eval(fast_mu,mu,mud,T);
+    
+    if (fast_mu_used) {
+      retx=0;
+    } else if (mu.inc_rest_mass) {
       mu.inc_rest_mass=false;
       mu.mu-=mu.m;
       retx=frel.pair_density(mu,T);
@@ -623,7 +1066,7 @@ int eos_leptons::pair_density(double T) {
           
     }
     
-    if (include_deriv) {
+    if (include_deriv && !fast_mu_used) {
       fermion_deriv fd;
       fd=mu;
     if (accuracy==acc_ld || accuracy==acc_fp_25) {
@@ -716,11 +1159,13 @@ int eos_leptons::pair_density_eq(double nq, double T) {
       }
       
       fermion_deriv fd;
-      fd=e;
-      fdrel.pair_mu(fd,T);
-      ed.dndmu=fd.dndmu;
-      ed.dndT=fd.dndT;
-      ed.dsdT=fd.dsdT;
+      if (!fast_e_used) {
+        fd=e;
+        fdrel.pair_mu(fd,T);
+        ed.dndmu=fd.dndmu;
+        ed.dndT=fd.dndT;
+        ed.dsdT=fd.dsdT;
+      }
       fd=mu;
       fdrel.pair_mu(fd,T);
       mud.dndmu=fd.dndmu;
@@ -740,7 +1185,7 @@ int eos_leptons::pair_density_eq(double nq, double T) {
     e.n=nq;
     retx=electron_density(T);
     
-    if (include_deriv) {
+    if (include_deriv && !fast_e_used) {
       fermion_deriv fd;
       fd=e;
       if (accuracy==acc_ld || accuracy==acc_fp_25) {
@@ -799,6 +1244,79 @@ int eos_leptons::pair_density_eq(double nq, double T) {
   return 0;
 }
 
+/** \brief Copy the mass, degeneracy and flags from \c src to
+    \c dest
+*/
+template<class part_t>
+static void copy_part_settings(part_t &dest, const part_t &src) {
+  dest.m=src.m;
+  dest.ms=src.ms;
+  dest.g=src.g;
+  dest.inc_rest_mass=src.inc_rest_mass;
+  dest.non_interacting=src.non_interacting;
+  return;
+}
+
+void eos_leptons::copy_settings(const eos_leptons &el) {
+  
+  pde_from_density=el.pde_from_density;
+  err_nonconv=el.err_nonconv;
+  include_muons=el.include_muons;
+  include_photons=el.include_photons;
+  include_deriv=el.include_deriv;
+  fast_mode=el.fast_mode;
+  verbose=el.verbose;
+  accuracy=el.accuracy;
+
+  copy_part_settings(e,el.e);
+  copy_part_settings(mu,el.mu);
+  copy_part_settings(tau,el.tau);
+  copy_part_settings(nu_e,el.nu_e);
+  copy_part_settings(nu_mu,el.nu_mu);
+  copy_part_settings(nu_tau,el.nu_tau);
+  copy_part_settings(ph,el.ph);
+
+  frel.copy_settings(el.frel);
+  fdrel.copy_settings(el.fdrel);
+  fast_e=el.fast_e;
+  fast_mu=el.fast_mu;
+
+  mh.tol_rel=el.mh.tol_rel;
+  mh.tol_abs=el.mh.tol_abs;
+  mh.ntrial=el.mh.ntrial;
+  mh.err_nonconv=el.mh.err_nonconv;
+  
+  return;
+}
+
+std::mutex &eos_leptons::ws_mutex() {
+  static std::mutex m;
+  return m;
+}
+
+eos_leptons &eos_leptons::thread_ws() {
+  std::lock_guard<std::mutex> lock(ws_mutex());
+  if (frel.fast_mode && !frel.fast_table.is_built()) {
+    frel.fast_table.build();
+  }
+  if (fast_mode) {
+    if (!fast_e.is_built()) fast_e.build(e.m,e.g);
+    if (include_muons && !fast_mu.is_built()) {
+      fast_mu.build(mu.m,mu.g);
+    }
+  }
+  std::shared_ptr<eos_leptons> &ws=ws_map[std::this_thread::get_id()];
+  if (!ws) ws=std::make_shared<eos_leptons>();
+  ws->copy_settings(*this);
+  return *ws;
+}
+
+void eos_leptons::clear_ws() {
+  std::lock_guard<std::mutex> lock(ws_mutex());
+  ws_map.clear();
+  return;
+}
+
 #ifdef O2SCL_MULTIP
 
 eos_leptons_multip::eos_leptons_multip() {
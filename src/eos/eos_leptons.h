@@ -26,15 +26,193 @@
 #ifndef O2SCL_EOS_LEPTONS_H
 #define O2SCL_EOS_LEPTONS_H
 
+#include <map>
+#include <mutex>
+#include <thread>
+#include <memory>
+
 #include <o2scl/part.h>
 #include <o2scl/fermion.h>
 #include <o2scl/boson.h>
 #include <o2scl/fermion_rel.h>
 #include <o2scl/part_deriv.h>
 #include <o2scl/fermion_deriv_rel.h>
+#include <o2scl/inte_qag_vec.h>
 
 namespace o2scl {
 
+  /** \brief Tabulated Helmholtz free energy of a fermion and its
+      antiparticle for \ref o2scl::eos_leptons
+
+      This class tabulates the Helmholtz free energy density 
+      \f$ F(T,n) = \varepsilon - T s \f$ (including the rest mass)
+      of a fermion and its antiparticle as a function of the
+      temperature and the net density on a uniform grid in \f$ x =
+      \ln T \f$ and \f$ y = \ln n \f$, following the method of
+      [Timmes00]_. The free energy is split into the contribution at
+      \f$ \mu=0 \f$, \f$ B(T) = -P(T,\mu=0) \f$, which is tabulated
+      separately in \f$ x \f$, and the remainder, which vanishes as
+      \f$ n \rightarrow 0 \f$. Without this split, the
+      density-dependent part of the free energy would be lost in the
+      pair background at high temperatures and low densities. At each
+      grid point, the remainder and its derivatives \f$ F_x, F_y,
+      F_{xx}, F_{yy} \f$, and \f$ F_{xy} \f$ are computed from
+      momentum integrals written to avoid the cancellation between
+      particles and antiparticles, and the higher mixed derivatives
+      \f$ F_{xxy}, F_{xyy} \f$, and \f$ F_{xxyy} \f$ are computed
+      from \f$ F_{xy} \f$ by finite differences. The table is
+      interpolated with biquintic Hermite polynomials, and
+      the chemical potential, the entropy, the energy density, and the
+      pressure are obtained from the derivatives of the interpolated
+      free energy,
+      \f[
+      \mu = \frac{F_y}{n} \, , \quad s = -\frac{F_x}{T} \, , \quad
+      \varepsilon = F + T s \, , \quad P = n \mu - F \, ,
+      \f]
+      so the results are thermodynamically consistent everywhere in
+      the table, not just at the grid points. The derivatives
+      \f$ (\partial n/\partial \mu)_T \f$, 
+      \f$ (\partial n/\partial T)_{\mu} \f$, and
+      \f$ (\partial s/\partial T)_{\mu} \f$ are computed from the 
+      second derivatives of the interpolated free energy.
+
+      The function \ref eval() returns false if the point is outside
+      the table or in a cell next to a grid point at which the 
+      chemical potential could not be computed. The table is 
+      shared between copies of this object.
+
+      With the default grid for electrons, the relative errors are
+      less than about \f$ 10^{-4} \f$ in the chemical potential,
+      pressure, entropy, and energy density, and less than about \f$
+      3 \times 10^{-3} \f$ in the derivatives. The accuracy is
+      mostly limited by the grid spacing in temperature.
+  */
+  class eos_leptons_fast_table {
+
+  protected:
+
+    /// The number of stored values at each grid point
+    static const size_t n_vals=9;
+    
+    /// The number of grid points in \f$ \ln T \f$
+    size_t nx;
+    /// The number of grid points in \f$ \ln n \f$
+    size_t ny;
+    /// The value of \f$ \ln T \f$ at the first grid point
+    double x0;
+    /// The value of \f$ \ln n \f$ at the first grid point
+    double y0;
+    /// The grid spacing in \f$ \ln T \f$
+    double hx;
+    /// The grid spacing in \f$ \ln n \f$
+    double hy;
+    /// The mass used to compute the table
+    double m_tab;
+
+    /** \brief The table
+
+        The first <tt>3*nx</tt> entries are the background \f$ B,
+        B_x, B_{xx} \f$ for each temperature, followed by \ref
+        n_vals values at each grid point: \f$ F, F_x, F_y, F_{xx},
+        F_{yy}, F_{xy}, F_{xxy}, F_{xyy}, F_{xxyy} \f$ (with the
+        background subtracted). Grid points at which the calculation
+        failed have all values set to NaN.
+    */
+    std::shared_ptr<const std::vector<double> > table;
+
+    /// Integrator for the momentum integrals
+    inte_qag_vec<> vit;
+
+    /** \brief Compute the biquintic Hermite basis functions
+        and their first and second derivatives at \c z
+        for a cell of width \c h
+    */
+    static void basis(double z, double h, double b[2][3],
+                      double db[2][3], double ddb[2][3]);
+
+    /** \brief The integrands at momentum \c k 
+
+        If <tt>y.size()</tt> is 3, this computes the pressure,
+        entropy, and \f$ ds/dT \f$ integrands at \f$ \mu=0 \f$.
+        Otherwise, it computes the density, \f$ dn/d\mu \f$, \f$
+        dn/dT \f$, pressure, and entropy integrands (the latter two
+        relative to \f$ \mu=0 \f$), stopping after the first
+        <tt>y.size()</tt> values.
+    */
+    int integrands(double k, std::vector<double> &y, double T,
+                   double mu, double m);
+
+    /// Compute the momentum integrals, storing the results in \c res
+    void integ(double T, double mu, double m, std::vector<double> &res);
+
+    /** \brief Solve for the chemical potential \c mu (including
+        the rest mass) given the density \c n, using the initial
+        value of \c mu as a guess
+    */
+    int solve_mu(double T, double n, double m, double g, double &mu);
+
+  public:
+
+    eos_leptons_fast_table();
+
+    /// Copy constructor (the table is shared)
+    eos_leptons_fast_table(const eos_leptons_fast_table &ft);
+
+    /// Copy assignment (the table is shared)
+    eos_leptons_fast_table &operator=(const eos_leptons_fast_table &ft);
+    
+    /// \name Settings (must be set before \ref build())
+    //@{
+    /// The smallest temperature in \f$ \mathrm{fm}^{-1} \f$
+    double T_min;
+    /// The largest temperature in \f$ \mathrm{fm}^{-1} \f$
+    double T_max;
+    /// The smallest density in \f$ \mathrm{fm}^{-3} \f$
+    double n_min;
+    /// The largest density in \f$ \mathrm{fm}^{-3} \f$
+    double n_max;
+    /// The number of grid points per decade in temperature (default 20)
+    size_t T_per_decade;
+    /// The number of grid points per decade in density (default 10)
+    size_t n_per_decade;
+    /** \brief The upper limit of the momentum integrals in units of
+        the temperature above the Fermi energy (default 60)
+    */
+    double upper_limit_fac;
+    /// Verbosity parameter (default 0)
+    int verbose;
+    //@}
+
+    /** \brief Compute the table for a particle with mass \c m and
+        degeneracy \c g (the mass should be in \f$ \mathrm{fm}^{-1}
+        \f$)
+    */
+    void build(double m, double g);
+
+    /// Return true if the table has been computed
+    bool is_built() const {
+      return table!=0;
+    }
+
+    /// Clear the table
+    void clear() {
+      table.reset();
+      return;
+    }
+    
+    /** \brief Compute the thermodynamics of \c f and its antiparticle
+        from the density <tt>f.n</tt> at temperature \c T, storing
+        the derivatives in \c pd
+
+        The chemical potential and energy density in \c f include
+        the rest mass if <tt>f.inc_rest_mass</tt> is true. This
+        function returns false (leaving \c f and \c pd unchanged) if
+        the table does not contain the point.
+    */
+    bool eval(fermion &f, double T, part_deriv_press &pd) const;
+
+  };
+
   /** \brief Lepton and photon EOS
 
       The function \ref pair_density_eq() computes the thermodynamic
@@ -109,6 +287,20 @@ namespace o2scl {
      */
     fermion_deriv_rel fdrel;
     //@}
+
+    /// \name Tabulated thermodynamics [protected]
+    //@{
+    /** \brief Compute \c f from the table \c ft if \ref fast_mode
+        is true, building the table if necessary
+
+        This function returns true if the table was used.
+    */
+    bool fast_eval(eos_leptons_fast_table &ft, fermion &f,
+                   part_deriv_press &pd, double T);
+
+    /// True if the last call to \ref electron_density() used the table
+    bool fast_e_used;
+    //@}
     
     /// \name Accuracy control
     //@{
@@ -209,6 +401,23 @@ namespace o2scl {
      */
     bool include_deriv;
 
+    /** \brief If true, use the tables \ref fast_e and \ref fast_mu
+        for the electrons and muons when the density is specified
+        (default false)
+
+        When this is true, \ref pair_density() and \ref
+        pair_density_eq() compute the electron thermodynamics (and
+        the muon thermodynamics in \ref pair_density()) from the
+        tabulated free energy in \ref fast_e and \ref fast_mu, if the
+        temperature and density are inside the table, and from \ref
+        frel otherwise. The tables are computed on the first call
+        which requires them. The derivatives in \ref ed and \ref mud
+        are also taken from the tables. The settings \ref
+        improved_acc(), \ref ld_acc(), and \ref fp_25_acc() do not
+        affect the tables.
+    */
+    bool fast_mode;
+
     /// Verbosity parameter (default 0)
     int verbose;
     
@@ -341,7 +550,63 @@ namespace o2scl {
      */
     fermion_rel frel;
 
+    /// Table for the electrons (see \ref fast_mode)
+    eos_leptons_fast_table fast_e;
+
+    /// Table for the muons (see \ref fast_mode)
+    eos_leptons_fast_table fast_mu;
+    //@}
+
+    /// \name Thread-safe interface
+    //@{
+    /** \brief Copy the settings from \c el
+
+        This copies the flags, the accuracy setting, the mass,
+        degeneracy, and flags of each particle, and the settings
+        of \ref frel, \ref fdrel, and \ref mh. The tables \ref
+        fast_e and \ref fast_mu are shared rather than copied. The
+        particle densities and chemical potentials and the solver
+        objects are not copied.
+    */
+    void copy_settings(const eos_leptons &el);
+    
+    /** \brief Return the workspace object for the current thread
+
+        This function may be called at the same time from several
+        threads on the same object, as long as the settings of this
+        object are not modified at the same time. Each thread gets
+        a separate \ref eos_leptons object, created on the first
+        call from that thread, which has the settings from this
+        object (see \ref copy_settings()). The inputs and results
+        are stored in the particle objects of the workspace, e.g.
+        \code
+        eos_leptons &w=el.thread_ws();
+        w.e.n=ne;
+        w.mu.n=nmu;
+        w.pair_density(T);
+        \endcode
+        The chemical potentials from the previous call in the same
+        thread are used as initial guesses. The table used by \ref
+        o2scl::fermion_rel_tl::fast_mode and the tables used by
+        \ref fast_mode are shared by all threads.
+    */
+    eos_leptons &thread_ws();
+
+    /** \brief Delete the workspaces for all threads
+
+        This function should not be called while another thread
+        is using this object.
+    */
+    void clear_ws();
     //@}
+
+  protected:
+
+    /// The workspaces for \ref thread_ws()
+    std::map<std::thread::id,std::shared_ptr<eos_leptons> > ws_map;
+
+    /// The mutex which protects \ref ws_map
+    static std::mutex &ws_mutex();
     
   };
   
@@ -30,6 +30,7 @@
 
 using namespace std;
 using namespace o2scl;
+using namespace o2scl_const;
 
 int main(void) {
 
@@ -136,7 +137,87 @@ int main(void) {
 #endif
   
   cout << endl;
-  
+
+  {
+    // Thread-safe interface, compared with the usual interface
+    eos_leptons el2;
+    el2.include_muons=true;
+    el2.default_acc();
+    double ne[4]={1.0e-6,1.0e-4,1.0e-3,1.0e-2};
+    double mue[4];
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for num_threads(2)
+#endif
+    for(size_t i=0;i<4;i++) {
+      eos_leptons &w=el2.thread_ws();
+      w.e.n=ne[i];
+      w.mu.n=ne[i]/10.0;
+      w.pair_density(0.1);
+      mue[i]=w.e.mu;
+    }
+    for(size_t i=0;i<4;i++) {
+      el2.e.n=ne[i];
+      el2.mu.n=ne[i]/10.0;
+      el2.pair_density(0.1);
+      t.test_rel(mue[i],el2.e.mu,1.0e-6,"thread_ws");
+    }
+  }
+
+  {
+    // Tabulated fast mode, compared with the exact results on a
+    // small table
+    eos_leptons el3, el4;
+    el3.include_muons=false;
+    el4.include_muons=false;
+    el3.include_deriv=true;
+    el4.include_deriv=true;
+    el3.fast_mode=true;
+    el3.fast_e.T_min=1.0/hc_mev_fm;
+    el3.fast_e.T_max=10.0/hc_mev_fm;
+    el3.fast_e.n_min=1.0e-10;
+    el3.fast_e.n_max=1.0e-2;
+
+    double Tf[3]={1.3/hc_mev_fm,4.1/hc_mev_fm,8.7/hc_mev_fm};
+    double nf[3]={3.0e-10,2.0e-6,4.0e-3};
+    for(size_t i=0;i<3;i++) {
+      for(size_t j=0;j<3;j++) {
+        el3.e.n=nf[j];
+        el3.pair_density(Tf[i]);
+        el4.e.n=nf[j];
+        el4.pair_density(Tf[i]);
+        t.test_rel(el3.e.mu,el4.e.mu,1.0e-3,"fast mu");
+        t.test_rel(el3.e.pr,el4.e.pr,1.0e-3,"fast pr");
+        t.test_rel(el3.e.en,el4.e.en,1.0e-3,"fast en");
+        t.test_rel(el3.ed.dndmu,el4.ed.dndmu,1.0e-2,"fast dndmu");
+        t.test_rel(el3.ed.dndT,el4.ed.dndT,1.0e-2,"fast dndT");
+        t.test_rel(el3.ed.dsdT,el4.ed.dsdT,1.0e-2,"fast dsdT");
+      }
+    }
+
+    // The interpolated free energy gives the Maxwell relation
+    // (ds/dn)_T = -(dmu/dT)_n
+    double T=3.0/hc_mev_fm, n=1.0e-4, hT=1.0e-4*T, hn=1.0e-4*n;
+    el3.e.n=n+hn;
+    el3.pair_density(T);
+    double s1=el3.e.en;
+    el3.e.n=n-hn;
+    el3.pair_density(T);
+    double s2=el3.e.en;
+    el3.e.n=n;
+    el3.pair_density(T+hT);
+    double mu1=el3.e.mu;
+    el3.pair_density(T-hT);
+    double mu2=el3.e.mu;
+    t.test_rel((s1-s2)/2.0/hn,-(mu1-mu2)/2.0/hT,1.0e-6,"fast Maxwell");
+
+    // Outside the table the exact solver is used
+    el3.e.n=0.1;
+    el3.pair_density(Tf[0]);
+    el4.e.n=0.1;
+    el4.pair_density(Tf[0]);
+    t.test_rel(el3.e.mu,el4.e.mu,1.0e-12,"fast fallback");
+  }
+
   t.report();
   return 0;
 }
@@ -42,24 +42,60 @@ void eos_nse::calc_mu(double mun, double mup, double T,
 		      double &nn, double &np, thermo &th, 
 		      vector<nucleus> &nd) {
 
+  if (T<0.0) {
+    O2SCL_ERR2("Temperature less than zero in ",
+	       "eos_nse::calc_mu().",exc_einval);
+  }
+  
   nn=0.0;
   np=0.0;
 
+  // The zero temperature limit is handled by classical_thermo
+  if (T==0.0) {
+    for(size_t i=0;i<nd.size();i++) {
+      nd[i].mu=mun*nd[i].N+mup*nd[i].Z-nd[i].be;
+      nd[i].non_interacting=true;
+      nd[i].inc_rest_mass=false;
+      cla.calc_mu(nd[i],T);
+    }
+    return;
+  }
+
+  // Update the structure-of-arrays copy if necessary and compute
+  // the logarithms of the densities
+  if (!soa.same(nd)) soa.set(nd);
+  soa.log_dens(mun,mup,T);
+
   for(size_t i=0;i<nd.size();i++) {
-    nd[i].mu=mun*nd[i].N+mup*nd[i].Z-nd[i].be;
-    nd[i].non_interacting=true;
-    nd[i].inc_rest_mass=false;
-    cla.calc_mu(nd[i],T);
-    nn+=nd[i].n*((double)nd[i].N);
-    np+=nd[i].n*((double)nd[i].Z);
-    th.ed+=nd[i].ed;
-    th.pr+=nd[i].pr;
-    th.en+=nd[i].en;
+    nucleus &nuc=nd[i];
+    nuc.mu=mun*soa.N[i]+mup*soa.Z[i]-soa.be[i];
+    nuc.non_interacting=true;
+    nuc.inc_rest_mass=false;
+    nuc.nu=nuc.mu;
+    nuc.ms=nuc.m;
+    nuc.n=exp(soa.ld[i]);
+    nuc.ed=1.5*T*nuc.n;
+    nuc.pr=nuc.n*T;
+    nuc.en=(nuc.ed+nuc.pr-nuc.n*nuc.nu)/T;
+    nn+=nuc.n*soa.N[i];
+    np+=nuc.n*soa.Z[i];
+    th.ed+=nuc.ed;
+    th.pr+=nuc.pr;
+    th.en+=nuc.en;
   }
 
   return;
 }
 
+void eos_nse::calc_mu_soa(double mun, double mup, double T,
+			  double &nn, double &np) {
+  double ln_nn, ln_np;
+  soa.log_sums(mun,mup,T,ln_nn,ln_np);
+  nn=exp(ln_nn);
+  np=exp(ln_np);
+  return;
+}
+
 int eos_nse::calc_density(double nn, double np, double T, 
 			  double &mun, double &mup, thermo &th, 
 			  vector<nucleus> &nd) {
@@ -130,6 +166,8 @@ int eos_nse::direct_solve(double nn, double np, double T,
   x[0]=mun/T;
   x[1]=mup/T;
 
+  if (!soa.same(nd)) soa.set(nd);
+
   mm_funct mfm=std::bind
     (std::mem_fn<int(size_t,const ubvector &,ubvector &,double,
 		     double,double,vector<nucleus> &)>
@@ -155,9 +193,8 @@ int eos_nse::solve_fun(size_t nv, const ubvector &x, ubvector &y,
   double mup=x[1]*T;
 
   double nn2, np2;
-  thermo th;
   
-  calc_mu(mun,mup,T,nn2,np2,th,nd);
+  calc_mu_soa(mun,mup,T,nn2,np2);
 
   y[0]=(nn2-nn)/nn;
   y[1]=(np2-np)/np;
@@ -409,6 +446,8 @@ int eos_nse::density_min(double nn, double np, double T,
   ubvector x(2);
   x[0]=mun;
   x[1]=mup;
+
+  if (!soa.same(nd)) soa.set(nd);
   
   double y=1.0;
 
@@ -423,6 +462,10 @@ int eos_nse::density_min(double nn, double np, double T,
 
   mun=x[0];
   mup=x[1];
+
+  // Update the distribution with the final chemical potentials
+  double nn2, np2;
+  calc_mu(mun,mup,T,nn2,np2,th,nd);
   
   return ret;
 }
@@ -431,7 +474,7 @@ double eos_nse::minimize_fun(size_t nv, const ubvector &x, double T,
 			     double nn, double np, o2scl::thermo &th,
 			     std::vector<o2scl::nucleus> &nd) {
   double mun=x[0], mup=x[1], nn2, np2;
-  calc_mu(mun,mup,T,nn2,np2,th,nd);
+  calc_mu_soa(mun,mup,T,nn2,np2);
   if (std::isinf(nn2) || std::isinf(np2) || nn2>10.0 || np2>10.0) {
     return 1.0e100;
   }
@@ -110,6 +110,17 @@ namespace o2scl {
     /// Compute particle properties assuming classical thermodynamics
     classical_thermo cla;
 
+    /** \brief Structure-of-arrays copy of the distribution used 
+        by the solver and the minimizer
+    */
+    nucdist_soa soa;
+
+    /** \brief Compute the neutron and proton densities using
+        \ref soa without modifying the distribution
+    */
+    void calc_mu_soa(double mun, double mup, double T, double &nn,
+                     double &np);
+
 #endif
 
   public:
@@ -136,6 +147,14 @@ namespace o2scl {
 	the chemical potentials are sufficiently large.
 
 	This function does not use the solver or the minimizer.
+
+        The densities are computed from a structure-of-arrays copy
+        of \c nd (see \ref o2scl::nucdist_soa), which is only
+        rebuilt when the nuclear properties in \c nd change. Inside
+        \ref direct_solve() and \ref density_min(), the solver
+        and minimizer only need the total neutron and proton
+        densities, which are obtained with a log-sum-exp reduction
+        without updating \c nd.
     */
     void calc_mu(double mun, double mup, double T, double &nn, 
 		 double &np, thermo &th, std::vector<nucleus> &nd);
@@ -25,6 +25,10 @@
 #include <o2scl/hdf_eos_io.h>
 #include <o2scl/root_brent_gsl.h>
 
+#ifdef O2SCL_SET_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
@@ -53,6 +57,10 @@ eos_nse_full::eos_nse_full() {
   inc_prot_coul=true;
   include_muons=false;
 
+  soa_cache=false;
+  soa_nneg=0.0;
+  soa_T=0.0;
+
   verbose=1;
 }
 
@@ -264,6 +272,25 @@ int eos_nse_full::calc_density_by_min(dense_matter &dm) {
 
 int eos_nse_full::calc_density_saha(dense_matter &dm) {
 
+  // The binding energies computed in calc_density_fixnp() are fixed
+  // for all of the solver iterations below, so allow them to be
+  // reused. The cache is always cleared on exit.
+  soa_cache=true;
+  soa.resize(0);
+  int ret;
+  try {
+    ret=calc_density_saha_base(dm);
+  } catch (...) {
+    soa_cache=false;
+    throw;
+  }
+  soa_cache=false;
+  
+  return ret;
+}
+
+int eos_nse_full::calc_density_saha_base(dense_matter &dm) {
+
   // Check user-specified conditions
   if (dm.nB<0.0 || dm.Ye<0.0 || dm.T<0.0) {
     O2SCL_ERR2("Cannot use negative densities or temperatures in ",
@@ -479,6 +506,226 @@ int eos_nse_full::calc_density_saha(dense_matter &dm) {
   return 0;
 }
 
+int eos_nse_full::table_point(dense_matter &dm, const dense_matter &proto,
+			      bool seeded, int &method) {
+
+  int ret=exc_efailed;
+  
+  // Saha equation from the neighboring point
+  if (seeded) {
+    try {
+      ret=calc_density_saha(dm);
+    } catch (std::exception &e) {
+      ret=exc_efailed;
+    }
+    if (ret==0 && std::isfinite(dm.th.ed)) {
+      method=0;
+      return 0;
+    }
+  }
+
+  // Saha equation from the initial guess
+  double nB=dm.nB, Ye=dm.Ye, T=dm.T;
+  dm=proto;
+  dm.nB=nB;
+  dm.Ye=Ye;
+  dm.T=T;
+  dm.n.n=nB*(1.0-Ye);
+  dm.p.n=nB*Ye;
+  try {
+    ret=calc_density_saha(dm);
+  } catch (std::exception &e) {
+    ret=exc_efailed;
+  }
+  if (ret==0 && std::isfinite(dm.th.ed)) {
+    method=1;
+    return 0;
+  }
+
+  // Minimization over the densities of the nuclei
+  dm=proto;
+  dm.nB=nB;
+  dm.Ye=Ye;
+  dm.T=T;
+  try {
+    ret=calc_density_by_min(dm);
+  } catch (std::exception &e) {
+    ret=exc_efailed;
+  }
+  if (ret==0 && std::isfinite(dm.th.ed)) {
+    method=2;
+    return 0;
+  }
+
+  method=-1;
+  if (ret==0) ret=exc_efailed;
+  return ret;
+}
+
+size_t eos_nse_full::calc_table(const std::vector<double> &nB_grid,
+				const std::vector<double> &Ye_grid,
+				const std::vector<double> &T_grid,
+				const dense_matter &dm, eos_sn_base &eso,
+				std::vector<eos_nse_full *> &solvers) {
+
+  if (solvers.size()==0) {
+    O2SCL_ERR2("No solvers specified in ",
+	       "eos_nse_full::calc_table().",exc_einval);
+  }
+  
+  size_t n_nB=nB_grid.size(), n_Ye=Ye_grid.size(), n_T=T_grid.size();
+  
+  std::vector<std::string> names={"nse_method","nse_ret"};
+  std::vector<std::string> units={"",""};
+  eso.alloc_grid(nB_grid,Ye_grid,T_grid,true,false,names,units);
+  eso.m_neut=dm.n.m*hc_mev_fm;
+  eso.m_prot=dm.p.m*hc_mev_fm;
+  eso.include_muons=include_muons;
+
+  size_t nt=solvers.size();
+#ifndef O2SCL_SET_OPENMP
+  nt=1;
+#endif
+  if (nt>n_T) nt=n_T;
+  if (nt==0) nt=1;
+
+  // Disable convergence errors in the solvers, restored below
+  std::vector<bool> enc(nt), enc_mroot(nt), enc_mmin(nt);
+  for(size_t it=0;it<nt;it++) {
+    enc[it]=solvers[it]->err_nonconv;
+    enc_mroot[it]=solvers[it]->def_mroot.err_nonconv;
+    enc_mmin[it]=solvers[it]->def_mmin.err_nonconv;
+    solvers[it]->err_nonconv=false;
+    solvers[it]->def_mroot.err_nonconv=false;
+    solvers[it]->def_mmin.err_nonconv=false;
+  }
+  
+  double nan=std::numeric_limits<double>::quiet_NaN();
+  size_t n_fail=0;
+
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(dynamic) reduction(+:n_fail)
+#endif
+  for(size_t iT=0;iT<n_T;iT++) {
+
+    size_t it=0;
+#ifdef O2SCL_SET_OPENMP
+    it=omp_get_thread_num();
+#endif
+    eos_nse_full &nse=*(solvers[it]);
+
+    dense_matter dmt=dm;
+
+    // Converged nucleon densities and chemical potentials for the
+    // previous electron fraction, used to seed the first density
+    std::vector<double> prev_nn(n_nB), prev_np(n_nB);
+    std::vector<double> prev_mun(n_nB), prev_mup(n_nB), prev_mue(n_nB);
+    std::vector<bool> prev_ok(n_nB,false);
+    
+    for(size_t iYe=0;iYe<n_Ye;iYe++) {
+
+      bool last_ok=false;
+      
+      for(size_t inB=0;inB<n_nB;inB++) {
+
+	double nB=nB_grid[inB], Ye=Ye_grid[iYe];
+	
+	bool seeded=false;
+	if (last_ok) {
+	  // Scale the nucleon densities from the previous density
+	  double ratio=nB/dmt.nB;
+	  dmt.n.n*=ratio;
+	  dmt.p.n*=ratio;
+	  seeded=true;
+	} else if (iYe>0 && prev_ok[inB]) {
+	  double Ye_prev=Ye_grid[iYe-1];
+	  dmt.n.n=prev_nn[inB];
+	  dmt.p.n=prev_np[inB];
+	  if (Ye_prev<1.0) dmt.n.n*=(1.0-Ye)/(1.0-Ye_prev);
+	  if (Ye_prev>0.0) dmt.p.n*=Ye/Ye_prev;
+	  dmt.n.mu=prev_mun[inB];
+	  dmt.p.mu=prev_mup[inB];
+	  dmt.e.mu=prev_mue[inB];
+	  seeded=true;
+	}
+	dmt.nB=nB;
+	dmt.Ye=Ye;
+	dmt.T=T_grid[iT]/hc_mev_fm;
+
+	int method;
+	int ret=nse.table_point(dmt,dm,seeded,method);
+
+	eso.other[0].set(inB,iYe,iT,method);
+	eso.other[1].set(inB,iYe,iT,ret);
+	
+	if (ret==0) {
+	  
+	  last_ok=true;
+	  prev_ok[inB]=true;
+	  prev_nn[inB]=dmt.n.n;
+	  prev_np[inB]=dmt.p.n;
+	  prev_mun[inB]=dmt.n.mu;
+	  prev_mup[inB]=dmt.p.mu;
+	  prev_mue[inB]=dmt.e.mu;
+
+	  // Nuclei other than alpha particles
+	  double xalpha=0.0, nnuc=0.0, znuc=0.0, anuc=0.0;
+	  for(size_t i=0;i<dmt.dist.size();i++) {
+	    nucleus &nuc=dmt.dist[i];
+	    if (nuc.Z==2 && nuc.N==2) {
+	      xalpha+=nuc.n*4.0/nB;
+	    } else {
+	      nnuc+=nuc.n;
+	      znuc+=nuc.n*nuc.Z;
+	      anuc+=nuc.n*nuc.A;
+	    }
+	  }
+	  
+	  double fr=dmt.th.ed-dmt.T*dmt.th.en;
+	  eso.F.set(inB,iYe,iT,fr/nB*hc_mev_fm);
+	  eso.E.set(inB,iYe,iT,dmt.th.ed/nB*hc_mev_fm);
+	  eso.P.set(inB,iYe,iT,dmt.th.pr*hc_mev_fm);
+	  eso.S.set(inB,iYe,iT,dmt.th.en/nB);
+	  eso.mun.set(inB,iYe,iT,dmt.n.mu*hc_mev_fm);
+	  eso.mup.set(inB,iYe,iT,dmt.p.mu*hc_mev_fm);
+	  eso.Xn.set(inB,iYe,iT,dmt.n.n/nB);
+	  eso.Xp.set(inB,iYe,iT,dmt.p.n/nB);
+	  eso.Xalpha.set(inB,iYe,iT,xalpha);
+	  eso.Xnuclei.set(inB,iYe,iT,anuc/nB);
+	  if (nnuc>0.0) {
+	    eso.Z.set(inB,iYe,iT,znuc/nnuc);
+	    eso.A.set(inB,iYe,iT,anuc/nnuc);
+	  }
+	  
+	} else {
+
+	  last_ok=false;
+	  prev_ok[inB]=false;
+	  n_fail++;
+	  for(size_t k=0;k<eos_sn_base::n_base;k++) {
+	    eso.arr[k]->set(inB,iYe,iT,nan);
+	  }
+	  
+	}
+
+      }
+    }
+
+    if (verbose>0) {
+      cout << "eos_nse_full::calc_table(): finished T=" << T_grid[iT]
+	   << " MeV." << endl;
+    }
+  }
+
+  for(size_t it=0;it<nt;it++) {
+    solvers[it]->err_nonconv=enc[it];
+    solvers[it]->def_mroot.err_nonconv=enc_mroot[it];
+    solvers[it]->def_mmin.err_nonconv=enc_mmin[it];
+  }
+  
+  return n_fail;
+}
+
 int eos_nse_full::bracket_mu_solve(double &mun_low, double &mun_high,
 				   double &mup_low, double &mup_high,
 				   dense_matter &dm) {
@@ -1110,62 +1357,85 @@ int eos_nse_full::calc_density_fixnp(dense_matter &dm, bool from_densities) {
   // -----------------------------------------------------------
   // Properties of nuclear distribution
 
-  // Vectors for derivatives of nuclear binding energy
-  ubvector vec_dEdnneg(dm.dist.size());
-
-  // Stepsize for verbose output
-  size_t i_out=0, out_step=dm.dist.size()/10;
-  if (out_step==0) out_step=1;
-
-  // Main loop
-  for(size_t i=0;i<dm.dist.size();i++) {
-
-    // Create a reference for this nucleus
-    nucleus &nuc=dm.dist[i];
-
-    double condition;
-    if (inc_prot_coul) {
-      condition=nuc.N*(n_neg-dm.p.n)/nuc.Z/(0.08-dm.n.n);
-    } else {
-      condition=nuc.N*(n_neg)/nuc.Z/(0.08);
+  size_t n_nuc=dm.dist.size();
+  
+  // The binding energies depend only on the negative charge
+  // density and the temperature, so they need only be computed
+  // again if these have changed
+  if (soa_cache==false || soa.size()!=n_nuc || soa_nneg!=n_neg ||
+      soa_T!=dm.T) {
+    
+    soa.resize(n_nuc);
+    soa_dEdnneg.resize(n_nuc);
+    
+    for(size_t i=0;i<n_nuc;i++) {
+      
+      // Create a reference for this nucleus
+      nucleus &nuc=dm.dist[i];
+      
+      double condition=nuc.N*(n_neg)/nuc.Z/(0.08);
+      
+      // If this nucleus is unphysical because R_n > R_{WS}, 
+      // give it a zero degeneracy so that its density vanishes
+      if (condition>=1.0) {
+	
+	soa.set_nucleus(i,nuc.Z,nuc.N,0.0,0.0,0.0);
+	soa_dEdnneg[i]=0.0;
+	
+      } else {
+	
+	// Compute nuclear binding energy and total mass
+	double be=nuc.be, dEdnp=0.0, dEdnn=0.0, dEdnneg=0.0, dEdT=0.0;
+	massp->binding_energy_densmat_derivs
+	  (nuc.Z,nuc.N,0.0,0.0,n_neg,dm.T,be,dEdnp,dEdnn,dEdnneg,dEdT);
+	be/=hc_mev_fm;
+	soa.set_nucleus(i,nuc.Z,nuc.N,be,nuc.g,
+			nuc.Z*dm.p.m+nuc.N*dm.n.m+be);
+	soa_dEdnneg[i]=dEdnneg;
+	
+      }
     }
+    
+    soa_nneg=n_neg;
+    soa_T=dm.T;
+  }
 
-    // If this nucleus is unphysical because R_n > R_{WS}, 
-    // set it's density to zero and continue
-    if (condition>=1.0) {
+  // Compute the logarithms of the nuclear densities, then update the
+  // distribution. Since nuclei are classical and do not include
+  // their rest mass, the energy density is 3nT/2 and the entropy
+  // density is n(5/2-mu/T).
+  soa.log_dens(dm.n.mu,dm.p.mu,dm.T);
+  
+  for(size_t i=0;i<n_nuc;i++) {
+    
+    nucleus &nuc=dm.dist[i];
+    
+    if (soa.g[i]==0.0) {
       
       nuc.n=0.0;
       nuc.ed=0.0;
       nuc.en=0.0;
-      vec_dEdnneg[i]=0.0;
-
+      
     } else {
-    
-      // Compute nuclear binding energy and total mass
-      double dEdnp, dEdnn, dEdnneg, dEdT;
-      // Include protons in the Coulomb energy
-      if (inc_prot_coul) {
-	massp->binding_energy_densmat_derivs
-	  (nuc.Z,nuc.N,dm.p.n,dm.n.n,n_neg,dm.T,nuc.be,dEdnp,dEdnn,
-	   dEdnneg,dEdT);
-      } else {
-	massp->binding_energy_densmat_derivs
-	  (nuc.Z,nuc.N,0.0,0.0,n_neg,dm.T,nuc.be,dEdnp,dEdnn,dEdnneg,dEdT);
-      }
-      nuc.be/=hc_mev_fm;
-      nuc.m=nuc.Z*dm.p.m+nuc.N*dm.n.m+nuc.be;
-      vec_dEdnneg[i]=dEdnneg;
+
+      nuc.be=soa.be[i];
+      nuc.m=soa.m[i];
       
       // Use NSE to compute the chemical potential
       nuc.mu=nuc.Z*dm.p.mu+nuc.N*dm.n.mu-nuc.be;
-    
+      nuc.nu=nuc.mu;
+      nuc.ms=nuc.m;
+      
       // Translational energy
-      cla.calc_mu(nuc,dm.T);
-
+      nuc.n=exp(soa.ld[i]);
+      nuc.ed=1.5*dm.T*nuc.n;
+      nuc.pr=nuc.n*dm.T;
+      nuc.en=(nuc.ed+nuc.pr-nuc.n*nuc.nu)/dm.T;
+      
       // Update thermo object with information from nucleus
       dm.th.ed+=nuc.be*nuc.n+nuc.ed;
       dm.th.en+=nuc.en;
-
+      
     }
   }
 
@@ -1173,38 +1443,35 @@ int eos_nse_full::calc_density_fixnp(dense_matter &dm, bool from_densities) {
   // Compute etas
 
   // Ensure the eta vector has the correct size
-  if (dm.eta_nuc.size()!=dm.dist.size()) {
-    dm.eta_nuc.resize(dm.dist.size());
+  if (dm.eta_nuc.size()!=n_nuc) {
+    dm.eta_nuc.resize(n_nuc);
   }
 
   dm.eta_n=dm.n.mu;
   dm.eta_p=dm.p.mu+dm.e.mu;
 
-  for(size_t i=0;i<dm.dist.size();i++) {
-
-    double dmudm_i=-1.5*dm.T/dm.dist[i].m;
-    double dfdm_i=dm.dist[i].n*dmudm_i;
+  // The sum over the distribution of the derivatives of the free
+  // energy with respect to the negative charge density, which
+  // contributes to eta_p and, multiplied by Z, to each eta_nuc
+  double sum_dfdnneg=0.0;
+  for(size_t j=0;j<n_nuc;j++) {
+    if (dm.dist[j].n>0.0) {
+      double dmudm=-1.5*dm.T/dm.dist[j].m;
+      double dfdm=dm.dist[j].n*dmudm;
+      sum_dfdnneg+=(dm.dist[j].n+dfdm)*soa_dEdnneg[j]/hc_mev_fm;
+    }
+  }
+  
+  // In eta_p, we don't include dEdnp terms which are zero
+  dm.eta_p+=sum_dfdnneg;
+  
+  for(size_t i=0;i<n_nuc;i++) {
     if (dm.dist[i].n>0.0) {
-      dm.eta_nuc[i]=dm.dist[i].be+dm.dist[i].mu+dm.dist[i].Z*dm.e.mu;
+      dm.eta_nuc[i]=dm.dist[i].be+dm.dist[i].mu+dm.dist[i].Z*dm.e.mu+
+	dm.dist[i].Z*sum_dfdnneg;
     } else {
       dm.eta_nuc[i]=0.0;
     }
-    // In eta_p, we don't include dEdnp terms which are zero
-    dm.eta_p+=(dm.dist[i].n+dfdm_i)*(vec_dEdnneg[i])/hc_mev_fm;
-    
-    for(size_t j=0;j<dm.dist.size();j++) {
-      
-      if (dm.dist[i].n>0.0) {
-	
-	double dmudm=-1.5*dm.T/dm.dist[j].m;
-	double dfdm=dm.dist[j].n*dmudm;
-	
-	dm.eta_nuc[i]+=dm.dist[i].Z*(dm.dist[j].n+dfdm)*
-	  vec_dEdnneg[j]/hc_mev_fm;
-
-      }
-
-    }
   }
       
   // -----------------------------------------------------------
@@ -35,6 +35,7 @@
 #include <o2scl/fermion_deriv_rel.h>
 
 #include <o2scl/nucmass_densmat.h>
+#include <o2scl/nucdist.h>
 #include <o2scl/mroot_hybrids.h>
 #include <o2scl/root_cern.h>
 
@@ -42,6 +43,7 @@
 #include <o2scl/nucmass_ldrop.h>
 
 #include <o2scl/mmin_simp2.h>
+#include <o2scl/eos_sn.h>
 
 namespace o2scl {
 
@@ -161,6 +163,46 @@ namespace o2scl {
     /// Nucleonic EOS (0 by default)
     o2scl::eos_had_temp_base *ehtp;
 
+    /// \name Distribution cache for calc_density_fixnp()
+    //@{
+    /** \brief If true, \ref calc_density_fixnp() may reuse the 
+        binding energies in \ref soa (set by \ref calc_density_saha())
+    */
+    bool soa_cache;
+
+    /** \brief Structure-of-arrays copy of the distribution with the
+        in-medium binding energies and masses
+    */
+    nucdist_soa soa;
+
+    /// The derivatives of the binding energies for \ref soa
+    std::vector<double> soa_dEdnneg;
+
+    /// The negative charge density for \ref soa
+    double soa_nneg;
+
+    /// The temperature for \ref soa
+    double soa_T;
+    //@}
+
+    /** \brief Compute one point for \ref calc_table()
+
+        On entry, \c dm should contain the baryon density, electron
+        fraction, and temperature and, if \c seeded is true, the
+        nucleon densities and chemical potentials from a neighboring
+        point. The object \c proto provides the guess used if the
+        seeded solve fails and the initial nuclear densities for
+        \ref calc_density_by_min(). The method which succeeded is
+        stored in \c method and the return value of the last solver
+        is returned.
+    */
+    int table_point(dense_matter &dm, const dense_matter &proto,
+                    bool seeded, int &method);
+
+    /** \brief The implementation of \ref calc_density_saha()
+     */
+    int calc_density_saha_base(dense_matter &dm);
+
   public:
 
     eos_nse_full();
@@ -308,6 +350,13 @@ namespace o2scl {
         - proton radii larger than WS cell radii, i.e.
         \f$ (0.08 - n_p) / (n_e+n_{\mu}-n_p) < 1 \f$ or 
         \f$ n_p > 0.08 \f$ . 
+
+        The nuclear densities are computed from a structure-of-arrays
+        copy of the distribution (see \ref o2scl::nucdist_soa). When
+        called from \ref calc_density_saha(), the in-medium binding
+        energies, which depend only on the negative charge density and
+        the temperature, are computed once and reused for all of the
+        solver iterations.
     */
     virtual int calc_density_fixnp(dense_matter &dm, bool from_densities=true);
   
@@ -361,6 +410,60 @@ namespace o2scl {
     */
     virtual int density_match(dense_matter &dm);
 
+    /// \name Tables over a grid
+    //@{
+    /** \brief Compute the EOS over a grid in baryon density, electron
+        fraction, and temperature and store the results in \c eso
+
+        The temperature grid \c T_grid is in MeV and the baryon
+        density grid is in \f$ \mathrm{fm}^{-3} \f$. The object \c dm
+        provides the distribution of nuclei, the particle masses,
+        and the initial guess for the nucleon densities and chemical
+        potentials. The table \c eso is reallocated with \ref
+        o2scl::eos_sn_base::alloc_grid() and can be written to a file
+        with \ref o2scl::eos_sn_base::output().
+
+        Each point is first computed with \ref calc_density_saha()
+        (which requires \ref inc_prot_coul to be <tt>false</tt>)
+        starting from the converged solution at the previous baryon
+        density or, for the first density, at the previous electron
+        fraction. If that fails, \ref calc_density_saha() is tried
+        again from the initial guess in \c dm, and only if that also
+        fails is \ref calc_density_by_min() used. The method which
+        succeeded (0 for a seeded Saha solve, 1 for an unseeded Saha
+        solve, 2 for minimization, and -1 if all methods failed) is
+        stored in the additional data set <tt>nse_method</tt>, and
+        the return value of the last solver in <tt>nse_ret</tt>. Points
+        which fail have all other quantities set to NaN.
+
+        The temperature slices are independent and are distributed
+        over the objects in \c solvers, one per OpenMP thread (only
+        the first is used if OpenMP is not enabled). Each object must
+        have its own nucleonic EOS and mass formula, and be configured
+        in the same way. Because each slice is computed in the same
+        order from the same guesses, the results do not depend on the
+        number of threads.
+
+        This function returns the number of points which failed.
+    */
+    size_t calc_table(const std::vector<double> &nB_grid,
+                      const std::vector<double> &Ye_grid,
+                      const std::vector<double> &T_grid,
+                      const dense_matter &dm, eos_sn_base &eso,
+                      std::vector<eos_nse_full *> &solvers);
+
+    /** \brief Compute the EOS over a grid using only the current
+        object
+    */
+    size_t calc_table(const std::vector<double> &nB_grid,
+                      const std::vector<double> &Ye_grid,
+                      const std::vector<double> &T_grid,
+                      const dense_matter &dm, eos_sn_base &eso) {
+      std::vector<eos_nse_full *> solvers={this};
+      return calc_table(nB_grid,Ye_grid,T_grid,dm,eso,solvers);
+    }
+    //@}
+
     /** \brief Relativistic fermions
 
         \comment
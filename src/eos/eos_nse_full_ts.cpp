@@ -25,6 +25,7 @@
 #include <o2scl/hdf_eos_io.h>
 #include <o2scl/hdf_nucmass_io.h>
 #include <o2scl/nucmass_ame.h>
+#include <o2scl/nucmass_ldrop_shell.h>
 
 using namespace std;
 using namespace o2scl;
@@ -53,6 +54,38 @@ int main(void) {
   o2scl_hdf::skyrme_load(sk,"../../data/o2scl/skdata/SLy4.o2",1);
   nse.set_eos(sk);
 
+  {
+    // A small table over a grid, compared with a fresh Saha solution
+    nucmass_ldrop_shell nls;
+    nse.set_mass(nls);
+    nse.inc_prot_coul=false;
+
+    dense_matter dm2;
+    nucdist_set(dm2.dist,ame,"Z>=2 && Z<=30 && N>=Z/2 && N<=2*Z");
+
+    vector<double> nBg={1.0e-7,1.0e-6,1.0e-5}, Yeg={0.4,0.5};
+    vector<double> Tg={1.0,2.0};
+    eos_sn_base eso;
+    size_t n_fail=nse.calc_table(nBg,Yeg,Tg,dm2,eso);
+    t.test_gen(n_fail==0,"calc_table fail");
+    for(size_t i=0;i<nBg.size();i++) {
+      t.test_rel(eso.Xn.get(i,1,1)+eso.Xp.get(i,1,1)+eso.Xalpha.get(i,1,1)+
+                 eso.Xnuclei.get(i,1,1),1.0,1.0e-6,"calc_table X");
+    }
+
+    dm2.nB=1.0e-6;
+    dm2.Ye=0.5;
+    dm2.T=2.0/hc_mev_fm;
+    dm2.n.n=dm2.nB/2.0;
+    dm2.p.n=dm2.nB/2.0;
+    ret=nse.calc_density_saha(dm2);
+    t.test_gen(ret==0,"calc_table saha");
+    t.test_rel(eso.F.get(1,1,1),(dm2.th.ed-dm2.T*dm2.th.en)/dm2.nB*
+               hc_mev_fm,1.0e-6,"calc_table F");
+
+    nse.inc_prot_coul=true;
+  }
+
 #ifdef O2SCL_NEVER_DEFINED
   
   // Test nucmass_densmat
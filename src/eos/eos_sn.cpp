@@ -282,6 +282,48 @@ void eos_sn_base::free() {
   return;
 }
 
+void eos_sn_base::alloc_grid(const std::vector<double> &nB,
+                             const std::vector<double> &Ye,
+                             const std::vector<double> &T,
+                             bool leptons, bool baryons,
+                             const std::vector<std::string> &names,
+                             const std::vector<std::string> &units) {
+
+  if (names.size()>30 || units.size()!=names.size()) {
+    O2SCL_ERR2("Too many data sets or names and units mismatched in ",
+               "eos_sn_base::alloc_grid().",exc_einval);
+  }
+  
+  if (loaded) free();
+
+  n_nB=nB.size();
+  n_Ye=Ye.size();
+  n_T=T.size();
+  nB_grid=nB;
+  Ye_grid=Ye;
+  T_grid=T;
+  n_oth=names.size();
+  oth_names=names;
+  oth_units=units;
+
+  std::vector<double> grid;
+  grid.insert(grid.end(),nB.begin(),nB.end());
+  grid.insert(grid.end(),Ye.begin(),Ye.end());
+  grid.insert(grid.end(),T.begin(),T.end());
+  
+  alloc();
+  for(size_t i=0;i<n_base+n_oth;i++) {
+    arr[i]->set_grid_packed(grid);
+    arr[i]->set_all(0.0);
+  }
+
+  with_leptons=leptons;
+  baryons_only=baryons;
+  loaded=true;
+  
+  return;
+}
+
 void eos_sn_base::set_interp_type(size_t interp_type) {
   if (!loaded) {
     O2SCL_ERR("File not loaded in eos_sn_base::set_interp().",
@@ -324,6 +324,25 @@ namespace o2scl {
     /// Free allocated memory
     void free();
 
+    /** \brief Allocate an empty table on the specified grids
+
+        This function is used to fill a table with results computed
+        elsewhere, e.g. by \ref o2scl::eos_nse_full::calc_table().
+        Any previously loaded data is freed, the grids are set, the
+        data for the base quantities and for each of the additional
+        data sets named in \c names (with units in \c units) is
+        allocated and set to zero, and the table is marked as
+        loaded. The parameters \c leptons and \c baryons specify
+        the values returned by \ref data_with_leptons() and \ref
+        data_baryons_only(). The temperature grid is in MeV.
+    */
+    void alloc_grid(const std::vector<double> &nB,
+                    const std::vector<double> &Ye,
+                    const std::vector<double> &T,
+                    bool leptons, bool baryons,
+                    const std::vector<std::string> &names,
+                    const std::vector<std::string> &units);
+
     /// Return true if data with lepton information has been loaded
     bool data_with_leptons() {
       return with_leptons;
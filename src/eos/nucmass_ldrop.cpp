@@ -74,6 +74,30 @@ double nucmass_ldrop::mass_excess_d(double Z, double N) {
       
 }
 
+void nucmass_ldrop::mass_excess_vec(const std::vector<int> &Z,
+                                    const std::vector<int> &N,
+                                    std::vector<double> &mex) {
+  if (Z.size()!=N.size()) {
+    O2SCL_ERR2("Sizes of Z and N do not match in ",
+               "nucmass_ldrop::mass_excess_vec().",exc_einval);
+  }
+  size_t n=Z.size();
+  mex.resize(n);
+
+  double conv=o2scl_settings.get_convert_units().convert("kg","MeV",1.0);
+  
+  for(size_t i=0;i<n;i++) {
+    double dZ=Z[i], dN=N[i];
+    mex[i]=binding_energy_densmat(dZ,dN)-
+      ((dN+dZ)*o2scl_const::unified_atomic_mass_f<double>()-
+       dZ*o2scl_const::mass_electron_f<double>()-
+       dN*o2scl_const::mass_neutron_f<double>()-
+       dZ*o2scl_const::mass_proton_f<double>())*conv;
+  }
+  
+  return;
+}
+
 double nucmass_ldrop::binding_energy_densmat
 (double Z, double N, double npout, double nnout, double ne,
  double T) {
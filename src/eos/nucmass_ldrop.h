@@ -249,6 +249,17 @@ namespace o2scl {
       return mass_excess_d(Z,N);
     }
 
+    /** \brief Compute the mass excesses of several nuclei
+
+        The nuclei are evaluated serially because the bulk energy
+        is computed with the hadronic EOS object given to \ref
+        set_eos_had_temp_base(), which may be shared, but the unit
+        conversion is performed only once.
+    */
+    virtual void mass_excess_vec(const std::vector<int> &Z,
+                                 const std::vector<int> &N,
+                                 std::vector<double> &mex);
+
     /** \brief Given \c Z and \c N, the external densities, and the
         temperature, return the binding energy of the nucleus in MeV
 
@@ -85,6 +85,34 @@ nucmass_frdm_shell::nucmass_frdm_shell() {
   nfit=14;
 }
 
+void nucmass_frdm_shell::mass_excess_vec(const std::vector<int> &Z,
+                                         const std::vector<int> &N,
+                                         std::vector<double> &mex) {
+  if (Z.size()!=N.size()) {
+    O2SCL_ERR2("Sizes of Z and N do not match in ",
+               "nucmass_frdm_shell::mass_excess_vec().",exc_einval);
+  }
+  size_t n=Z.size();
+  mex.resize(n);
+  
+  // The mass formula stores intermediate results in class members,
+  // so each thread works with its own copy
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel
+#endif
+  {
+    nucmass_frdm_shell loc(*this);
+#ifdef O2SCL_SET_OPENMP
+#pragma omp for
+#endif
+    for(size_t i=0;i<n;i++) {
+      mex[i]=loc.nucmass_frdm_shell::mass_excess_d(Z[i],N[i]);
+    }
+  }
+  
+  return;
+}
+
 double nucmass_frdm_shell::mass_excess_d(double Z, double N) {
   
   double ret=nucmass_frdm::mass_excess_d(Z,N);
@@ -94,6 +94,13 @@ namespace o2scl {
     /// Compute the mass excess
     double mass_excess_d(double Z, double N);
 
+    /** \brief Compute the mass excesses of several nuclei in
+        parallel, using a separate copy of this object in each thread
+    */
+    virtual void mass_excess_vec(const std::vector<int> &Z,
+                                 const std::vector<int> &N,
+                                 std::vector<double> &mex);
+
     /// Fix parameters from an array for fitting
     virtual int fit_fun(size_t nv, const ubvector &x);
     
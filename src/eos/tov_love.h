@@ -208,14 +208,6 @@ namespace o2scl {
     /// Schwarzchild radius in km (set in constructor)
     double schwarz_km;
   
-    /** \brief Compute \f$ k_2(\beta,y_R) \f$ using the analytic 
-	expression
-
-	Used in both \ref tov_love::calc_y() and \ref
-	tov_love::calc_H().
-    */
-    double eval_k2(double beta, double yR);
-
     /// List of discontinuities
     std::vector<double> disc;
     
@@ -295,6 +287,14 @@ namespace o2scl {
     void clear_discs() {
       disc.clear();
     }
+
+    /** \brief Compute \f$ k_2(\beta,y_R) \f$ using the analytic 
+	expression
+
+	Used in \ref tov_love::calc_y(), \ref tov_love::calc_H(),
+	and in \ref tov_solve when \ref tov_solve::calc_love is true.
+    */
+    static double eval_k2(double beta, double yR);
     
     /** \brief Compute the love number using H
 
@@ -89,6 +89,7 @@ int main(void) {
   lbar=lambda_km5/pow(1.4*schwarz_km/2.0,5.0);
   cout << "Dimensionless tidal deformability (direct calculation, y): " 
        << lbar << endl;
+  double k2_y=k2, lbar_y=lbar;
   tl.calc_H(yR,beta,k2,lambda_km5,lambda_cgs);
   lbar=lambda_km5/pow(1.4*schwarz_km/2.0,5.0);
   cout << "Dimensionless tidal deformability (direct calculation, H): " 
@@ -106,6 +107,36 @@ int main(void) {
   cout << "Relative deviation: " << acc << endl;
   t.test_abs(acc,0.0,0.015,"lambda and I");
 
+  // Tidal deformability from the TOV integration
+  ts.calc_love=true;
+  ts.fixed(1.4);
+  cout << "Dimensionless tidal deformability (TOV integration): "
+       << ts.Lambda << endl;
+  t.test_rel(ts.k2,k2_y,5.0e-3,"k2 from tov_solve");
+  t.test_rel(ts.Lambda,lbar_y,5.0e-3,"Lambda from tov_solve");
+  t.test_rel(ts.lambda_km5,ts.Lambda*pow(ts.mass*schwarz_km/2.0,5.0),
+             1.0e-12,"lambda from tov_solve");
+  profile=ts.get_results();
+  t.test_rel(profile->get("y",profile->get_nlines()-1),ts.yR,1.0e-12,
+             "y column");
+  t.test_rel(profile->get("y",0),2.0,1.0e-12,"y at center");
+
+  // The moment of inertia from the same integration
+  double I2=ts.domega_rat*pow(ts.rad,4.0)/3.0/schwarz_km;
+  t.test_rel(I2,I,1.0e-3,"I with calc_love");
+
+  // Mass versus radius curve with the tidal deformability
+  ts.mvsr();
+  std::shared_ptr<table_units<> > mvsr_tab=ts.get_results();
+  t.test_gen(mvsr_tab->is_column("k2") && mvsr_tab->is_column("Lambda"),
+             "mvsr Love columns");
+  t.test_rel(mvsr_tab->interp("gm",1.4,"Lambda"),lbar_y,
+             1.0e-2,"Lambda from mvsr");
+  t.test_rel(mvsr_tab->interp("gm",1.4,"lambda"),
+             mvsr_tab->interp("gm",1.4,"Lambda")*
+             pow(1.4*schwarz_km/2.0,5.0),1.0e-2,"lambda from mvsr");
+  ts.calc_love=false;
+
   if (true) {
     // Test tidal def. of 1.4 in NRAPR for comparison with python
     eos_had_skyrme sk;
@@ -25,11 +25,18 @@
 #endif
 
 #include <cstdlib>
+#include <algorithm>
 
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 
 #include <o2scl/tov_solve.h>
+#include <o2scl/tov_love.h>
 #include <o2scl/root_cern.h>
+#include <o2scl/set_openmp.h>
+
+#ifdef O2SCL_SET_OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 using namespace o2scl;
@@ -70,6 +77,12 @@ tov_solve::tov_solve() : out_table(new table_units<>) {
   prend=8.0e-3;
   princ=1.1;
 
+  // Parameters for mvsr_par()
+  par_princ=1.3;
+  par_dm=0.05;
+  par_max_tol=1.0e-3;
+  par_levels=12;
+
   // Guess for pressure for fixed()
   fixed_pr_guess=5.2e-5;
 
@@ -103,12 +116,27 @@ tov_solve::tov_solve() : out_table(new table_units<>) {
   bmass=0.0;
   gpot=0.0;
   domega_rat=0.0;
+  yR=0.0;
+  k2=0.0;
+  lambda_km5=0.0;
+  Lambda=0.0;
 
   // Other options
   gen_rel=true;
   ang_vel=false;
   calc_gpot=false;
+  calc_love=false;
+  love_deriv_step=1.0e-4;
+  min_storage=false;
   err_nonconv=true;
+
+  // Minimal storage mode
+  dense_fill=false;
+  dense_row=0;
+  dense_rlast=0.0;
+  last_pcent=0.0;
+  phi_shift=0.0;
+  f_corr=1.0;
   
   // Initial value for target mass
   tmass=0.0;
@@ -227,6 +255,10 @@ int tov_solve::derivs(double r, size_t nv, const ubvector &y,
       dydx[ix]=0.0;
       ix++;
     }
+    if (calc_love) {
+      dydx[ix]=0.0;
+      ix++;
+    }
     return success;
   }
 
@@ -291,6 +323,25 @@ int tov_solve::derivs(double r, size_t nv, const ubvector &y,
     }
     ix++;
   }
+  if (calc_love) {
+    // The derivative of the energy density with respect to the
+    // pressure, i.e. the inverse of the speed of sound squared
+    double dpr=love_deriv_step*pres, edp, edm, nbt;
+    te->ed_nb_from_pr(pres+dpr,edp,nbt);
+    te->ed_nb_from_pr(pres-dpr,edm,nbt);
+    double dedp=(edp-edm)/2.0/dpr;
+    if (!std::isfinite(dedp)) {
+      return exc_efailed;
+    }
+    double elam=1.0/(1.0-schwarz_km*gm/r);
+    double nup=schwarz_km*elam*(gm+4.0*pi*pres*r3)/r2;
+    double Q=2.0*pi*schwarz_km*elam*(5.0*ed+9.0*pres+(ed+pres)*dedp)-
+      6.0*elam/r2-nup*nup;
+    double yl=y[ix];
+    dydx[ix]=(-r2*Q-yl*elam*(1.0+2.0*pi*schwarz_km*r2*(pres-ed))-
+	      yl*yl)/r;
+    ix++;
+  }
 
   return success;
 }
@@ -339,6 +390,10 @@ void tov_solve::column_setup(bool mvsr_mode) {
     inames.push_back("bm");
     iunits.push_back("Msun");
   }
+  if (calc_love) {
+    inames.push_back("y");
+    iunits.push_back("");
+  }
   inames.push_back("pr");
   iunits.push_back(punits);
   inames.push_back("ed");
@@ -363,6 +418,18 @@ void tov_solve::column_setup(bool mvsr_mode) {
     inames.push_back("dbmdr");
     iunits.push_back("Msun/km");
   }
+  if (calc_love) {
+    inames.push_back("dydr");
+    iunits.push_back("1/km");
+    if (mvsr_mode) {
+      inames.push_back("k2");
+      iunits.push_back("");
+      inames.push_back("lambda");
+      iunits.push_back("km^5");
+      inames.push_back("Lambda");
+      iunits.push_back("");
+    }
+  }
   if (mvsr_mode && pr_list.size()>0) {
     for(size_t i=0;i<pr_list.size();i++) {
       inames.push_back(((string)"r")+szttos(i));
@@ -388,6 +455,186 @@ void tov_solve::column_setup(bool mvsr_mode) {
   return;
 }
 
+void tov_solve::table_row(size_t tix, double r, const ubvector &y,
+			  const ubvector &dydx) {
+
+  size_t iv=0;
+
+  // Output enclosed mass and radius
+  out_table->set("gm",tix,y[0]);
+  out_table->set("r",tix,r);
+
+  iv=2;
+  // Gravitational potential
+  if (calc_gpot) {
+    out_table->set("gp",tix,y[iv]);
+    iv++;
+    if (ang_vel) {
+      out_table->set("rjw",tix,y[iv]);
+      iv++;
+      out_table->set("omega_rat",tix,y[iv]);
+      iv++;
+    }
+  }
+
+  // Enclosed baryon mass
+  if (te->has_baryons()) {
+    out_table->set("bm",tix,y[iv]);
+    iv++;
+  }
+
+  // Love number function
+  if (calc_love) {
+    out_table->set("y",tix,y[iv]);
+    iv++;
+  }
+
+  // Energy density, pressure, and baryon density
+  if (y[1]>min_log_pres) {
+    double ed, nb;
+    if (!std::isfinite(exp(y[1]))) {
+      O2SCL_ERR2("Pressure not finite in ",
+                 "tov_solve::table_row().",exc_efailed);
+    }
+    te->ed_nb_from_pr(exp(y[1]),ed,nb);
+    // Convert pressure, energy density, and baryon density to user 
+    // units by dividing by their factors
+    out_table->set("pr",tix,exp(y[1])/pfactor);
+    out_table->set("ed",tix,ed/efactor);
+    if (te->has_baryons()) {
+      out_table->set("nb",tix,nb/nfactor);
+    }
+  } else {
+    out_table->set("pr",tix,0.0);
+    out_table->set("ed",tix,0.0);
+    if (te->has_baryons()) {
+      out_table->set("nb",tix,0.0);
+    }
+  }
+
+  // surface gravity and redshift
+  if (r!=0.0) {
+    out_table->set("sg",tix,(schwarz_km/2.0*y[0]/r/r/
+                             sqrt(1.0-schwarz_km*y[0]/r)));
+    out_table->set("rs",tix,1.0/sqrt(1.0-y[0]*schwarz_km/r)-1.0);
+  } else {
+    out_table->set("sg",tix,0.0);
+    out_table->set("rs",tix,0.0);
+  }
+
+  // derivatives
+  out_table->set("dmdr",tix,dydx[0]);
+  out_table->set("dlogpdr",tix,dydx[1]);
+  iv=2;
+  if (calc_gpot) {
+    out_table->set("dgpdr",tix,dydx[iv]);
+    iv++;
+    if (ang_vel) iv+=2;
+  }
+  if (te->has_baryons()) {
+    out_table->set("dbmdr",tix,dydx[iv]);
+    iv++;
+  }
+  if (calc_love) {
+    out_table->set("dydr",tix,dydx[iv]);
+    iv++;
+  }
+  
+  // Check for non-finite values
+  for(size_t ik=0;ik<out_table->get_ncolumns();ik++) {
+    if (!std::isfinite(out_table->get(ik,tix))) {
+      O2SCL_ERR((((string)"Non-finite value for column '")+
+                 out_table->get_column_name(ik)+
+                 "' in tov_solve::table_row().").c_str(),exc_efailed);
+    }
+  }
+
+  return;
+}
+
+void tov_solve::dense_eval(double t, double h, size_t k,
+			   const ubvector &y0, const ubvector &d0,
+			   const ubvector &y1, const ubvector &d1,
+			   double &y, double &dydx) {
+  double t2=t*t, t3=t2*t;
+  y=(2.0*t3-3.0*t2+1.0)*y0[k]+(t3-2.0*t2+t)*h*d0[k]+
+    (3.0*t2-2.0*t3)*y1[k]+(t3-t2)*h*d1[k];
+  dydx=6.0*(t2-t)/h*(y0[k]-y1[k])+(3.0*t2-4.0*t+1.0)*d0[k]+
+    (3.0*t2-2.0*t)*d1[k];
+  return;
+}
+
+void tov_solve::dense_step(size_t nvar, double x0, const ubvector &y0,
+			   const ubvector &d0, double x1, const ubvector &y1,
+			   const ubvector &d1) {
+
+  double h=x1-x0, dtmp;
+
+  // Find the radii where the pressure crosses the values in pr_list
+  if (pr_list.size()>0) {
+    
+    size_t ibm=2;
+    if (calc_gpot) {
+      ibm++;
+      if (ang_vel) ibm+=2;
+    }
+    
+    for(size_t i=0;i<pr_list.size();i++) {
+      if (!std::isfinite(pr_list_r[i])) {
+	double lp=log(pr_list[i]*pfactor);
+	if (lp>y0[1]) {
+	  // The pressure is larger than the central pressure
+	  pr_list_r[i]=0.0;
+	  pr_list_gm[i]=0.0;
+	  pr_list_bm[i]=0.0;
+	} else if (lp>=y1[1]) {
+	  // Bisection for log(P) on the interpolating polynomial
+	  double tlo=0.0, thi=1.0, lpt;
+	  for(size_t j=0;j<60;j++) {
+	    double tmid=(tlo+thi)/2.0;
+	    dense_eval(tmid,h,1,y0,d0,y1,d1,lpt,dtmp);
+	    if (lpt>lp) tlo=tmid;
+	    else thi=tmid;
+	  }
+	  double t=(tlo+thi)/2.0;
+	  pr_list_r[i]=x0+t*h;
+	  dense_eval(t,h,0,y0,d0,y1,d1,pr_list_gm[i],dtmp);
+	  if (te->has_baryons()) {
+	    dense_eval(t,h,ibm,y0,d0,y1,d1,pr_list_bm[i],dtmp);
+	  }
+	}
+      }
+    }
+  }
+
+  // Fill the table rows in this step for make_table()
+  if (dense_fill) {
+    size_t nt=out_table->get_nlines();
+    ubvector y(nvar), dydx(nvar);
+    while (dense_row<nt-1) {
+      double r=dense_rlast*((double)dense_row)/((double)(nt-2));
+      if (r>x1) return;
+      double t=(r-x0)/h;
+      for(size_t k=0;k<nvar;k++) {
+	dense_eval(t,h,k,y0,d0,y1,d1,y[k],dydx[k]);
+      }
+      // Apply the same corrections that integ_star() applies
+      // to the buffer
+      if (calc_gpot) {
+	y[2]+=phi_shift;
+	if (ang_vel) {
+	  y[3]*=exp(-phi_shift)/f_corr;
+	  y[4]/=f_corr;
+	}
+      }
+      table_row(dense_row,r,y,dydx);
+      dense_row++;
+    }
+  }
+  
+  return;
+}
+
 void tov_solve::make_table() {
 
   // ---------------------------------------------------------------
@@ -402,6 +649,40 @@ void tov_solve::make_table() {
   out_table->add_constant("mass",mass);
   out_table->add_constant("rad",rad);
 
+  // ---------------------------------------------------------------
+  // In minimal storage mode, integrate the star again and fill the
+  // table from the dense output of each step
+
+  if (min_storage) {
+
+    size_t nt=max_table_size;
+    if (nt<3) nt=3;
+    out_table->set_nlines(nt);
+
+    int verbose_save=verbose;
+    verbose=0;
+    dense_fill=true;
+    dense_row=0;
+    integ_star_final=true;
+    ubvector x(1), y(1);
+    x[0]=last_pcent;
+    int ret=integ_star(1,x,y);
+    dense_fill=false;
+    verbose=verbose_save;
+    if (ret!=0) {
+      O2SCL_ERR2("Integration of star failed in ",
+                 "tov_solve::make_table().",exc_efailed);
+    }
+
+    // The remaining rows are the last step and the surface
+    for(;dense_row<nt-1;dense_row++) {
+      table_row(dense_row,rkx[0],rky[0],rkdydx[0]);
+    }
+    table_row(nt-1,rkx[ix_last],rky[ix_last],rkdydx[ix_last]);
+
+    return;
+  }
+
   // ---------------------------------------------------------------
   // Create output file of profile for star
 
@@ -432,87 +713,7 @@ void tov_solve::make_table() {
     if (bix>=ix_last+1) bix=ix_last;
     if (tix>=out_table->get_nlines()) tix=out_table->get_nlines()-1;
     
-    ubvector line;
-    size_t iv=0;
-
-    // Output enclosed mass and radius
-    out_table->set("gm",tix,rky[bix][0]);
-    out_table->set("r",tix,rkx[bix]);
-
-    iv=2;
-    // Gravitational potential
-    if (calc_gpot) {
-      out_table->set("gp",tix,rky[bix][iv]);
-      iv++;
-      if (ang_vel) {
-	out_table->set("rjw",tix,rky[bix][iv]);
-	iv++;
-	out_table->set("omega_rat",tix,rky[bix][iv]);
-	iv++;
-      }
-    }
-
-    // Enclosed baryon mass
-    if (te->has_baryons()) {
-      out_table->set("bm",tix,rky[bix][iv]);
-      iv++;
-    }
-
-    // Energy density, pressure, and baryon density
-    if (rky[bix][1]>min_log_pres) {
-      double ed, nb;
-      if (!std::isfinite(exp(rky[bix][1]))) {
-	O2SCL_ERR2("Pressure not finite in ",
-		   "tov_solve::make_table().",exc_efailed);
-      }
-      te->ed_nb_from_pr(exp(rky[bix][1]),ed,nb);
-      // Convert pressure, energy density, and baryon density to user 
-      // units by dividing by their factors
-      out_table->set("pr",tix,exp(rky[bix][1])/pfactor);
-      out_table->set("ed",tix,ed/efactor);
-      if (te->has_baryons()) {
-	out_table->set("nb",tix,nb/nfactor);
-      }
-    } else {
-      out_table->set("pr",tix,0.0);
-      out_table->set("ed",tix,0.0);
-      if (te->has_baryons()) {
-	out_table->set("nb",tix,0.0);
-      }
-    }
-
-    // surface gravity and redshift
-    if (rkx[bix]!=0.0) {
-      out_table->set("sg",tix,(schwarz_km/2.0*rky[bix][0]/rkx[bix]/rkx[bix]/
-			       sqrt(1.0-schwarz_km*rky[bix][0]/rkx[bix])));
-      out_table->set("rs",tix,1.0/sqrt(1.0-rky[bix][0]*schwarz_km/
-				       rkx[bix])-1.0);
-    } else {
-      out_table->set("sg",tix,0.0);
-      out_table->set("rs",tix,0.0);
-    }
-
-    // derivatives
-    out_table->set("dmdr",tix,rkdydx[bix][0]);
-    out_table->set("dlogpdr",tix,rkdydx[bix][1]);
-    iv=2;
-    if (calc_gpot) {
-      out_table->set("dgpdr",tix,rkdydx[bix][iv]);
-      iv++;
-    }
-    if (te->has_baryons()) {
-      out_table->set("dbmdr",tix,rkdydx[bix][iv]);
-      iv++;
-    }
-    
-    // Check for non-finite values
-    for(size_t ik=0;ik<out_table->get_ncolumns();ik++) {
-      if (!std::isfinite(out_table->get(ik,tix))) {
-	O2SCL_ERR((((string)"Non-finite value for column '")+
-		   out_table->get_column_name(ik)+
-		   "' in tov_solve::make_table().").c_str(),exc_efailed);
-      }
-    }
+    table_row(tix,rkx[bix],rky[bix],rkdydx[bix]);
       
   }
 
@@ -559,15 +760,18 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
     if (ang_vel) nvar+=2;
   }
   if (te->has_baryons()) nvar++;
+  if (calc_love) nvar++;
 
   // ---------------------------------------------------------------
   // Resize and allocate memory if necessary
 
-  if (rkx.size()!=buffer_size || rky.size()==0 || rky[0].size()!=nvar) {
-    rkx.resize(buffer_size);
-    rky.resize(buffer_size);
-    rkdydx.resize(buffer_size);
-    for(size_t i=0;i<buffer_size;i++) {
+  size_t nbuf=buffer_size;
+  if (min_storage) nbuf=3;
+  if (rkx.size()!=nbuf || rky.size()==0 || rky[0].size()!=nvar) {
+    rkx.resize(nbuf);
+    rky.resize(nbuf);
+    rkdydx.resize(nbuf);
+    for(size_t i=0;i<nbuf;i++) {
       rky[i].resize(nvar);
       rkdydx[i].resize(nvar);
     }
@@ -595,6 +799,35 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
     rky[0][iv]=0.0;
     iv++;
   }
+  if (calc_love) {
+    rky[0][iv]=2.0;
+    iv++;
+  }
+
+  // The derivatives vanish at the center
+  for(size_t k=0;k<nvar;k++) {
+    rkdydx[0][k]=0.0;
+  }
+
+  if (min_storage) {
+    double nan=std::numeric_limits<double>::quiet_NaN();
+    pr_list_r.assign(pr_list.size(),nan);
+    pr_list_gm.assign(pr_list.size(),nan);
+    pr_list_bm.assign(pr_list.size(),0.0);
+    if (dense_fill) {
+      // The first row of the table is the center of the star
+      ubvector y(rky[0]);
+      if (calc_gpot) {
+	y[2]+=phi_shift;
+	if (ang_vel) {
+	  y[3]*=exp(-phi_shift)/f_corr;
+	  y[4]/=f_corr;
+	}
+      }
+      table_row(0,0.0,y,rkdydx[0]);
+      dense_row=1;
+    }
+  }
 
   // ---------------------------------------------------------------
     
@@ -635,8 +868,18 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
 
     if (done==false) {
 
-      ix++;
-      ix_next++;
+      if (min_storage) {
+	// Use the step for the dense output and then swap so that
+	// the new point is always stored in the first row
+	dense_step(nvar,rkx[ix],rky[ix],rkdydx[ix],rkx[ix_next],
+		   rky[ix_next],rkdydx[ix_next]);
+	std::swap(rkx[ix],rkx[ix_next]);
+	rky[ix].swap(rky[ix_next]);
+	rkdydx[ix].swap(rkdydx[ix_next]);
+      } else {
+	ix++;
+	ix_next++;
+      }
 
       // ---------------------------------------------------------------
       // Verbose output
@@ -653,7 +896,7 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
       // leave one empty row at the end for the final calculations
       // of mass and radius done outside of the loop below. 
     
-      if (ix_next>=buffer_size-1) {
+      if (!min_storage && ix_next>=buffer_size-1) {
 
 	//cout << "Rearrangement. ix=" << ix << " ix_next=" << ix_next 
 	//<< " buffer_size=" << buffer_size << endl;
@@ -738,6 +981,40 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
   }
   if (te->has_baryons()) {
     bmass=rky[ix][iv]-rkdydx[ix][iv]*(rkx[ix]-rad);
+    iv++;
+  }
+
+  // Extrapolate the Love number function and compute the 
+  // tidal deformability
+  if (calc_love) {
+    yR=rky[ix][iv]-rkdydx[ix][iv]*(rkx[ix]-rad);
+    double beta=schwarz_km/2.0*mass/rad;
+    k2=tov_love::eval_k2(beta,yR);
+    lambda_km5=2.0/3.0*k2*pow(rad,5.0);
+    Lambda=2.0/3.0*k2/pow(beta,5.0);
+  }
+
+  // In minimal storage mode, the pressures in pr_list which are
+  // between the last step and the surface use the same linear
+  // extrapolation as the mass and radius
+  if (min_storage) {
+    size_t ibm=2;
+    if (calc_gpot) {
+      ibm++;
+      if (ang_vel) ibm+=2;
+    }
+    for(size_t i=0;i<pr_list.size();i++) {
+      if (!std::isfinite(pr_list_r[i])) {
+	double lp=log(pr_list[i]*pfactor);
+	double r=rkx[ix]+(lp-rky[ix][1])/rkdydx[ix][1];
+	if (r>rad) r=rad;
+	pr_list_r[i]=r;
+	pr_list_gm[i]=rky[ix][0]-rkdydx[ix][0]*(rkx[ix]-r);
+	if (te->has_baryons()) {
+	  pr_list_bm[i]=rky[ix][ibm]-rkdydx[ix][ibm]*(rkx[ix]-r);
+	}
+      }
+    }
   }
   
   // --------------------------------------------------------------
@@ -767,6 +1044,8 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
   // Store the last point for radius, mass, and pressure
 
   ix_last=ix_next;
+  last_pcent=ndx[0];
+  dense_rlast=rkx[ix];
   rkx[ix_last]=rad;
   rky[ix_last][0]=mass;
   rky[ix_last][1]=min_log_pres;
@@ -780,7 +1059,7 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
     // conditions
     
     rky[ix_last][iv]=lastgpot;
-    double phi_shift=0.5*log(1-schwarz_km*mass/rad)-lastgpot;
+    phi_shift=0.5*log(1-schwarz_km*mass/rad)-lastgpot;
     for(size_t k=0;k<=ix_last;k++) {
       rky[k][iv]+=phi_shift;
     }
@@ -794,7 +1073,7 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
 
       last_rjw=rky[ix][iv]*exp(-phi_shift);
       last_f=rky[ix][iv+1];
-      double f_corr=last_f+last_rjw/pow(rad,3.0)/3.0;
+      f_corr=last_f+last_rjw/pow(rad,3.0)/3.0;
 
       // Correction for rjw
       for(size_t k=0;k<ix_last;k++) {
@@ -826,6 +1105,14 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
     iv++;
   }
 
+  // --------------------------------------------------------------
+  // Store the last point for the Love number function
+
+  if (calc_love) {
+    rky[ix_last][iv]=yR;
+    iv++;
+  }
+
   // --------------------------------------------------------------
   // Last row of derivatives
   
@@ -836,6 +1123,135 @@ int tov_solve::integ_star(size_t ndvar, const ubvector &ndx,
   return 0;
 }
 
+void tov_solve::mvsr_row(double pc, std::vector<double> &line) {
+
+  line.clear();
+
+  // output mass and radius
+  line.push_back(mass);
+  line.push_back(rad);
+
+  // Gravitational potential and angular velocity columns
+  if (calc_gpot) {
+    line.push_back(gpot);
+    if (ang_vel) {
+      line.push_back(last_rjw);
+      line.push_back(last_f);
+    }
+  }
+
+  // output baryon mass
+  if (te->has_baryons()) line.push_back(bmass);
+
+  // output Love number function at the surface
+  if (calc_love) line.push_back(yR);
+  
+  // output central pressure, energy density, and baryon density
+
+  double ed, nb;
+  if (!std::isfinite(pc)) {
+    O2SCL_ERR2("Central pressure not finite in ",
+               "tov_solve::mvsr_row().",exc_efailed);
+  }
+  te->ed_nb_from_pr(pc,ed,nb);
+  
+  // Convert pressure, energy density, and baryon density to user 
+  // units by dividing by their factors
+  line.push_back(pc/pfactor);
+  line.push_back(ed/efactor);
+  if (te->has_baryons()) {
+    line.push_back(nb/nfactor);
+  }
+
+  // output surface gravity and redshift
+
+  if (rad!=0.0) {
+    line.push_back(schwarz_km/2.0*mass/rad/rad/
+                   sqrt(1.0-schwarz_km*mass/rad));
+    line.push_back(1.0/sqrt(1.0-mass*schwarz_km/rad)-1.0);
+  } else {
+    line.push_back(0.0);
+    line.push_back(0.0);
+  }
+  
+  // output derivatives
+
+  line.push_back(0.0);
+  line.push_back(0.0);
+  if (calc_gpot) line.push_back(0.0);
+  if (te->has_baryons()) line.push_back(0.0);
+  if (calc_love) line.push_back(0.0);
+
+  // output the Love number and the tidal deformability
+  if (calc_love) {
+    line.push_back(k2);
+    line.push_back(lambda_km5);
+    line.push_back(Lambda);
+  }
+
+  // Radius interpolation
+  if (pr_list.size()>0) {
+    iop.set_type(itp_linear);
+    ubvector lpr_col(rky.size()), gm_col(rky.size()), bm_col(rky.size());
+    for(size_t ii=0;ii<rky.size();ii++) {
+      lpr_col[ii]=rky[ii][1];
+      gm_col[ii]=rky[ii][0];
+      if (te->has_baryons()) {
+        size_t index=2;
+        if (calc_gpot) {
+          index++;
+          if (ang_vel) index+=2;
+        }
+        bm_col[ii]=rky[ii][index];
+      }
+    }
+    for(size_t ii=0;ii<pr_list.size();ii++) {
+      double thisr, thisgm, thisbm=0.0;
+      if (min_storage) {
+        // These were computed by dense_step() during the integration
+        thisr=pr_list_r[ii];
+        thisgm=pr_list_gm[ii];
+        thisbm=pr_list_bm[ii];
+      } else {
+        iop.set(ix_last-1,lpr_col,rkx);
+        thisr=iop.eval(log(pr_list[ii]*pfactor));
+        iop.set(ix_last-1,lpr_col,gm_col);
+        thisgm=iop.eval(log(pr_list[ii]*pfactor));
+        if (te->has_baryons()) {
+          iop.set(ix_last-1,lpr_col,bm_col);
+          thisbm=iop.eval(log(pr_list[ii]*pfactor));
+        }
+      }
+      
+      if (!std::isfinite(thisr)) {
+        string str=((string)"Obtained non-finite value when ")+
+          "interpolating radius for pressure "+dtos(pr_list[ii])+
+          " in tov_solve::mvsr_row().";
+        O2SCL_ERR(str.c_str(),exc_efailed);
+      }
+      line.push_back(thisr);
+      if (!std::isfinite(thisgm)) {
+        string str=((string)"Obtained non-finite value when ")+
+          "interpolating gravitational mass for pressure "+dtos(pr_list[ii])+
+          " in tov_solve::mvsr_row().";
+        O2SCL_ERR(str.c_str(),exc_efailed);
+      }
+      line.push_back(thisgm);
+      if (te->has_baryons()) {
+        if (!std::isfinite(thisbm)) {
+          string str=((string)"Obtained non-finite value when ")+
+            "interpolating baryon mass for pressure "+dtos(pr_list[ii])+
+            " in tov_solve::mvsr_row().";
+          O2SCL_ERR(str.c_str(),exc_efailed);
+        }
+        line.push_back(thisbm);
+      }
+    }
+  }
+
+  return;
+}
+
 int tov_solve::mvsr() {
 
   int info=0;
@@ -874,129 +1290,270 @@ int tov_solve::mvsr() {
     // Fill line of data for table
 
     std::vector<double> line;
+    mvsr_row(x[0],line);
+
+    // --------------------------------------------------------------
+    // Copy line of data to table
+    
+    out_table->line_of_data(line.size(),&(line[0]));
+    if (line.size()!=out_table->get_ncolumns()) {
+      O2SCL_ERR("Table size problem in tov_solve::mvsr().",
+		exc_esanity);
+    }
+    
+    // --------------------------------------------------------------
+    // Get next central pressure
+
+    x[0]*=princ;
 
-    // output mass and radius
-    line.push_back(mass);
-    line.push_back(rad);
+  }
 
-    // Gravitational potential and angular velocity columns
-    if (calc_gpot) {
-      line.push_back(gpot);
-      if (ang_vel) {
-	line.push_back(last_rjw);
-	line.push_back(last_f);
-      }
+  // Find the row that refers to the maximum mass star
+  size_t ix=out_table->lookup("gm",out_table->max("gm"));
+  pcent_max=out_table->get("pr",ix);
+
+  return info;
+}
+
+void tov_solve::copy_settings(const tov_solve &ts) {
+  te=ts.te;
+  eos_set=ts.eos_set;
+  efactor=ts.efactor;
+  pfactor=ts.pfactor;
+  nfactor=ts.nfactor;
+  eunits=ts.eunits;
+  punits=ts.punits;
+  nunits=ts.nunits;
+  min_log_pres=ts.min_log_pres;
+  buffer_size=ts.buffer_size;
+  max_table_size=ts.max_table_size;
+  baryon_mass=ts.baryon_mass;
+  ang_vel=ts.ang_vel;
+  gen_rel=ts.gen_rel;
+  calc_gpot=ts.calc_gpot;
+  calc_love=ts.calc_love;
+  love_deriv_step=ts.love_deriv_step;
+  min_storage=ts.min_storage;
+  step_min=ts.step_min;
+  step_max=ts.step_max;
+  step_start=ts.step_start;
+  verbose=ts.verbose;
+  max_integ_steps=ts.max_integ_steps;
+  err_nonconv=ts.err_nonconv;
+  pmax_default=ts.pmax_default;
+  pcent_max=ts.pcent_max;
+  pr_list=ts.pr_list;
+  def_stepper.con.eps_abs=ts.def_stepper.con.eps_abs;
+  def_stepper.con.eps_rel=ts.def_stepper.con.eps_rel;
+  def_stepper.con.a_y=ts.def_stepper.con.a_y;
+  def_stepper.con.a_dydt=ts.def_stepper.con.a_dydt;
+  return;
+}
+
+void tov_solve::mvsr_par_points
+(const std::vector<double> &pcs, std::vector<std::vector<double> > &lines,
+ std::vector<int> &rets, std::vector<std::shared_ptr<tov_solve> > &thr) {
+
+  size_t np=pcs.size();
+  lines.resize(np);
+  rets.resize(np);
+  
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for num_threads(thr.size()+1) schedule(dynamic)
+#endif
+  for(size_t i=0;i<np;i++) {
+
+    size_t it=0;
+#ifdef O2SCL_SET_OPENMP
+    it=omp_get_thread_num();
+#endif
+    tov_solve *tp=this;
+    if (it>0) tp=thr[it-1].get();
+
+    ubvector x(1), y(1);
+    x[0]=pcs[i];
+    try {
+      tp->integ_star_final=true;
+      rets[i]=tp->integ_star(1,x,y);
+      tp->mvsr_row(x[0],lines[i]);
+    } catch (std::exception &e) {
+      rets[i]=exc_efailed;
+      lines[i].clear();
     }
+  }
+  
+  return;
+}
 
-    // output baryon mass
-    if (te->has_baryons()) line.push_back(bmass);
-    
-    // output central pressure, energy density, and baryon density
+int tov_solve::mvsr_par(size_t n_threads) {
 
-    double ed, nb;
-    if (!std::isfinite(x[0])) {
-      O2SCL_ERR2("Central pressure not finite in ",
-		 "tov_solve::mvsr().",exc_efailed);
+  int info=0;
+  pcent_max=pmax_default;
+
+  if (eos_set==false) {
+    O2SCL_ERR
+      ("EOS not specified tov_solve::mvsr_par().",exc_efailed);
+  }
+  if (par_princ<=1.0) {
+    O2SCL_ERR2("Increment factor par_princ not larger than one in ",
+               "tov_solve::mvsr_par().",exc_einval);
+  }
+
+  if (verbose>0) cout << "Parallel mass versus radius mode." << endl;
+
+  // ---------------------------------------------------------------
+  // Clear previously stored data and setup table
+  
+  out_table->clear();
+  column_setup(true);
+
+  // ---------------------------------------------------------------
+  // Create the objects for the additional threads. Failures are
+  // reported after the table is constructed, so the error handler
+  // is not called during the integrations.
+
+#ifndef O2SCL_SET_OPENMP
+  n_threads=1;
+#endif
+  if (n_threads==0) n_threads=1;
+
+  bool err_nonconv_save=err_nonconv;
+  err_nonconv=false;
+  
+  std::vector<std::shared_ptr<tov_solve> > thr(n_threads-1);
+  for(size_t i=0;i<n_threads-1;i++) {
+    thr[i]=std::make_shared<tov_solve>();
+    thr[i]->copy_settings(*this);
+  }
+
+  // ---------------------------------------------------------------
+  // The initial grid, stored in order of increasing central pressure
+
+  std::vector<double> new_pcs;
+  double plow=prbegin, phigh=prend;
+  if (prend<prbegin) {
+    plow=prend;
+    phigh=prbegin;
+  }
+  for(double pc=plow;pc<=phigh;pc*=par_princ) {
+    new_pcs.push_back(pc);
+  }
+  
+  std::vector<double> pcs;
+  std::vector<std::vector<double> > lines, new_lines;
+  std::vector<int> rets, new_rets;
+
+  // ---------------------------------------------------------------
+  // Main loop over refinement passes
+
+  for(size_t il=0;il<=par_levels && new_pcs.size()>0;il++) {
+
+    mvsr_par_points(new_pcs,new_lines,new_rets,thr);
+
+    // Merge the new rows. Each new central pressure lies between
+    // two old ones, so a sort by pressure keeps the order.
+    std::vector<std::pair<double,size_t> > order;
+    for(size_t i=0;i<pcs.size();i++) {
+      order.push_back(std::make_pair(pcs[i],i));
+    }
+    for(size_t i=0;i<new_pcs.size();i++) {
+      order.push_back(std::make_pair(new_pcs[i],pcs.size()+i));
     }
-    te->ed_nb_from_pr(x[0],ed,nb);
+    std::sort(order.begin(),order.end());
     
-    // Convert pressure, energy density, and baryon density to user 
-    // units by dividing by their factors
-    line.push_back(x[0]/pfactor);
-    line.push_back(ed/efactor);
-    if (te->has_baryons()) {
-      line.push_back(nb/nfactor);
+    std::vector<double> pcs2(order.size());
+    std::vector<std::vector<double> > lines2(order.size());
+    std::vector<int> rets2(order.size());
+    for(size_t i=0;i<order.size();i++) {
+      size_t j=order[i].second;
+      pcs2[i]=order[i].first;
+      if (j<pcs.size()) {
+        std::swap(lines2[i],lines[j]);
+        rets2[i]=rets[j];
+      } else {
+        std::swap(lines2[i],new_lines[j-pcs.size()]);
+        rets2[i]=new_rets[j-pcs.size()];
+      }
     }
+    std::swap(pcs,pcs2);
+    std::swap(lines,lines2);
+    std::swap(rets,rets2);
 
-    // output surface gravity and redshift
-
-    if (rad!=0.0) {
-      line.push_back(schwarz_km/2.0*mass/rad/rad/
-		     sqrt(1.0-schwarz_km*mass/rad));
-      line.push_back(1.0/sqrt(1.0-mass*schwarz_km/rad)-1.0);
-    } else {
-      line.push_back(0.0);
-      line.push_back(0.0);
+    if (verbose>0) {
+      cout << "mvsr_par(): pass " << il << " computed "
+           << new_pcs.size() << " stars, total " << pcs.size()
+           << "." << endl;
     }
     
-    // output derivatives
-
-    line.push_back(0.0);
-    line.push_back(0.0);
-    if (calc_gpot) line.push_back(0.0);
-    if (te->has_baryons()) line.push_back(0.0);
-
-    // Radius interpolation
-    if (pr_list.size()>0) {
-      iop.set_type(itp_linear);
-      ubvector lpr_col(rky.size()), gm_col(rky.size()), bm_col(rky.size());
-      for(size_t ii=0;ii<rky.size();ii++) {
-	lpr_col[ii]=rky[ii][1];
-	gm_col[ii]=rky[ii][0];
-	if (te->has_baryons()) {
-	  size_t index=2;
-	  if (calc_gpot) {
-	    index++;
-	    if (ang_vel) index+=2;
-	  }
-	  bm_col[ii]=rky[ii][index];
-	}
-      }
-      for(size_t ii=0;ii<pr_list.size();ii++) {
-        iop.set(ix_last-1,lpr_col,rkx);
-	double thisr=iop.eval(log(pr_list[ii]*pfactor));
-        iop.set(ix_last-1,lpr_col,gm_col);
-	double thisgm=iop.eval(log(pr_list[ii]*pfactor));
-                               
-	if (!std::isfinite(thisr)) {
-	  string str=((string)"Obtained non-finite value when ")+
-	    "interpolating radius for pressure "+dtos(pr_list[ii])+
-	    " in tov_solve::mvsr().";
-	  O2SCL_ERR(str.c_str(),exc_efailed);
-	}
-	line.push_back(thisr);
-	if (!std::isfinite(thisgm)) {
-	  string str=((string)"Obtained non-finite value when ")+
-	    "interpolating gravitational mass for pressure "+dtos(pr_list[ii])+
-	    " in tov_solve::mvsr().";
-	  O2SCL_ERR(str.c_str(),exc_efailed);
-	}
-	line.push_back(thisgm);
-	if (te->has_baryons()) {
-          iop.set(ix_last-1,lpr_col,bm_col);
-	  double thisbm=iop.eval(log(pr_list[ii]*pfactor));
-				 
-	  if (!std::isfinite(thisbm)) {
-	    string str=((string)"Obtained non-finite value when ")+
-	      "interpolating baryon mass for pressure "+dtos(pr_list[ii])+
-	      " in tov_solve::mvsr().";
-	    O2SCL_ERR(str.c_str(),exc_efailed);
-	  }
-	  line.push_back(thisbm);
-	}
+    // Find the maximum mass among the successful integrations
+    // (the gravitational mass is the first entry in each row)
+    size_t imax=0;
+    bool found=false;
+    for(size_t i=0;i<pcs.size();i++) {
+      if (rets[i]==0 && lines[i].size()>0 &&
+          (found==false || lines[i][0]>lines[imax][0])) {
+        imax=i;
+        found=true;
       }
     }
 
-    // --------------------------------------------------------------
-    // Copy line of data to table
-    
-    out_table->line_of_data(line.size(),&(line[0]));
-    if (line.size()!=out_table->get_ncolumns()) {
-      O2SCL_ERR("Table size problem in tov_solve::mvsr().",
-		exc_esanity);
+    // Choose the central pressures for the next pass
+    new_pcs.clear();
+    for(size_t i=0;i+1<pcs.size();i++) {
+      if (rets[i]==0 && rets[i+1]==0 && lines[i].size()>0 &&
+          lines[i+1].size()>0) {
+        bool refine=(fabs(lines[i+1][0]-lines[i][0])>par_dm);
+        if (found && imax>0 && imax+1<pcs.size() &&
+            (i+1==imax || i==imax) &&
+            pcs[i+1]/pcs[i]>1.0+par_max_tol) {
+          refine=true;
+        }
+        if (refine) new_pcs.push_back(sqrt(pcs[i]*pcs[i+1]));
+      }
     }
-    
-    // --------------------------------------------------------------
-    // Get next central pressure
+  }
 
-    x[0]*=princ;
+  err_nonconv=err_nonconv_save;
+
+  // ---------------------------------------------------------------
+  // Copy the rows to the table in the direction from prbegin to
+  // prend
 
+  size_t n_fail=0;
+  for(size_t k=0;k<pcs.size();k++) {
+
+    size_t i=k;
+    if (prend<prbegin) i=pcs.size()-1-k;
+
+    if (rets[i]!=0 && info==0) {
+      info+=mvsr_integ_star_failed+rets[i];
+    }
+    if (rets[i]!=0) n_fail++;
+
+    if (lines[i].size()>0) {
+      out_table->line_of_data(lines[i].size(),&(lines[i][0]));
+      if (lines[i].size()!=out_table->get_ncolumns()) {
+        O2SCL_ERR("Table size problem in tov_solve::mvsr_par().",
+                  exc_esanity);
+      }
+    }
   }
 
+  if (out_table->get_nlines()==0) {
+    O2SCL_CONV_RET("No stars succeeded in tov_solve::mvsr_par().",
+                   exc_efailed,err_nonconv);
+  }
+  
   // Find the row that refers to the maximum mass star
   size_t ix=out_table->lookup("gm",out_table->max("gm"));
   pcent_max=out_table->get("pr",ix);
 
+  if (n_fail>0) {
+    O2SCL_CONV((((string)"Integration of ")+szttos(n_fail)+
+                " stars failed in mvsr_par().").c_str(),exc_efailed,
+               err_nonconv);
+  }
+  
   return info;
 }
 
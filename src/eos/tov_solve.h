@@ -345,6 +345,41 @@ namespace o2scl {
       table may be smaller than this, as it cannot be larger than the
       number of steps stored in the buffer.
 
+      If \ref min_storage is true, then only the two most recent
+      ODE steps are kept during the integration. The radii and
+      masses for the pressures in \ref pr_list are obtained from
+      the cubic Hermite polynomial constructed from the values and
+      derivatives at the ends of each step, and the profile table
+      is constructed on demand by re-integrating the star and
+      evaluating the same polynomials on a uniform grid in radius
+      with \ref max_table_size rows. In this mode, the buffers
+      returned by \ref get_rkx(), \ref get_rky(), and \ref
+      get_rkdydx() contain only the last few steps and \ref
+      buffer_size is ignored. This is useful for \ref mvsr() and
+      \ref mvsr_par() when many stars are computed at once.
+
+      <b>Tidal deformability</b>
+
+      If \ref calc_love is true, then the function \f$ y(r) \f$
+      described in \ref o2scl::tov_love is integrated along with 
+      the TOV equations, starting from \f$ y(0)=2 \f$, so that 
+      the Love number does not require a separate integration 
+      over the stellar profile. The speed of sound is computed from
+      a finite difference of \ref eos_tov::ed_nb_from_pr() with
+      relative step \ref love_deriv_step, so discontinuities in 
+      the energy density are not treated (see \ref
+      o2scl::tov_love::add_disc() for that case). The value of
+      \f$ y \f$ is stored in the column <tt>"y"</tt> of the
+      profile and \f$ y(R) \f$, \f$ k_2 \f$, \f$ \lambda \f$
+      (in \f$ \mathrm{km}^5 \f$) and \f$ \Lambda = \lambda /
+      (G M)^5 \f$ are stored in \ref yR, \ref k2, \ref lambda_km5,
+      and \ref Lambda. In \ref mvsr() and \ref mvsr_par(), the
+      table has the additional columns <tt>"y"</tt>, 
+      <tt>"k2"</tt>, <tt>"lambda"</tt> and <tt>"Lambda"</tt>
+      for each star. If \ref ang_vel is also true, the moment of
+      inertia is obtained from the same integration as described
+      above.
+
       \note The function \ref o2scl::tov_solve::integ_star() returns
       <tt>gsl_efailed</tt> without calling the error handler in the
       case that the solver can recover gracefully from, for example, a
@@ -404,6 +439,74 @@ namespace o2scl {
     void make_unique_name(std::string &col, 
 			  std::vector<std::string> &cnames);
 
+    /** \brief Construct the row of the \ref mvsr() table for the
+	star with central pressure \c pc from the last call to 
+	\ref integ_star()
+    */
+    void mvsr_row(double pc, std::vector<double> &line);
+
+    /** \brief Integrate the stars with central pressures \c pcs
+	in parallel for \ref mvsr_par()
+
+	Thread 0 uses this object and the remaining threads use
+	the objects in \c thr. The table rows are stored in \c lines
+	and the return values of \ref integ_star() in \c rets. If
+	an exception is thrown for a star, the corresponding row is
+	left empty and its return value is \ref o2scl::exc_efailed .
+    */
+    void mvsr_par_points(const std::vector<double> &pcs,
+			 std::vector<std::vector<double> > &lines,
+			 std::vector<int> &rets,
+			 std::vector<std::shared_ptr<tov_solve> > &thr);
+
+    /// \name Minimal storage mode
+    //@{
+    /** \brief Store the row with index \c tix of the profile table
+	at radius \c r
+    */
+    void table_row(size_t tix, double r, const ubvector &y,
+		   const ubvector &dydx);
+
+    /** \brief Evaluate the cubic Hermite polynomial for the
+	variable with index \c k at the relative position \c t in 
+	a step of size \c h
+    */
+    void dense_eval(double t, double h, size_t k,
+		    const ubvector &y0, const ubvector &d0,
+		    const ubvector &y1, const ubvector &d1,
+		    double &y, double &dydx);
+
+    /** \brief Process one ODE step from \c x0 to \c x1 when
+	\ref min_storage is true
+	
+	This locates the pressures in \ref pr_list within the
+	step and, when \ref dense_fill is true, stores the 
+	profile table rows which lie within the step.
+    */
+    void dense_step(size_t nvar, double x0, const ubvector &y0,
+		    const ubvector &d0, double x1, const ubvector &y1,
+		    const ubvector &d1);
+
+    /// If true, \ref dense_step() fills the profile table
+    bool dense_fill;
+    /// The next row of the profile table for \ref dense_step()
+    size_t dense_row;
+    /// The last radius in the buffer from \ref integ_star()
+    double dense_rlast;
+    /// The central pressure from the last call to \ref integ_star()
+    double last_pcent;
+    /// The shift in the gravitational potential
+    double phi_shift;
+    /// The correction factor for the angular velocity
+    double f_corr;
+    /// Radii for the pressures in \ref pr_list
+    std::vector<double> pr_list_r;
+    /// Gravitational masses for the pressures in \ref pr_list
+    std::vector<double> pr_list_gm;
+    /// Baryon masses for the pressures in \ref pr_list
+    std::vector<double> pr_list_bm;
+    //@}
+
     /// \name User EOS
     //@{
     /// The EOS
@@ -451,7 +554,8 @@ namespace o2scl {
 	next column is the gravitational potential (which is
 	unitless), and when \ref eos_tov::baryon_column is true, the
 	next column is the baryonic mass in \f$ \mathrm{M}_{\odot}
-	\f$.
+	\f$. When \ref calc_love is true, the last column is the 
+	function \f$ y(r) \f$ for the Love number.
     */
     std::vector<ubvector> rky;
     /// The derivatives of the ODE functions
@@ -517,6 +621,20 @@ namespace o2scl {
 	at the surface (when \ref ang_vel is true)
     */
     double domega_rat;
+    /** \brief The value of \f$ y(r=R) \f$ for the Love number
+	(when \ref calc_love is true)
+    */
+    double yR;
+    /// The Love number \f$ k_2 \f$ (when \ref calc_love is true)
+    double k2;
+    /** \brief The tidal deformability \f$ \lambda \f$ in 
+	\f$ \mathrm{km}^5 \f$ (when \ref calc_love is true)
+    */
+    double lambda_km5;
+    /** \brief The dimensionless tidal deformability 
+	\f$ \Lambda \f$ (when \ref calc_love is true)
+    */
+    double Lambda;
 
     /** \brief Maximum value for central pressure in 
 	\f$ \mathrm{M}_{\odot}/\mathrm{km}^3 \f$ (default \f$ 10^{20} \f$ )
@@ -553,6 +671,25 @@ namespace o2scl {
     /** \brief calculate the gravitational potential (default false)
     */
     bool calc_gpot;
+    /** \brief Integrate the equation for the tidal Love number
+	along with the TOV equations (default false)
+
+	See the discussion of the Love number in the class 
+	documentation.
+    */
+    bool calc_love;
+    /** \brief Relative step in pressure for the finite-difference
+	computation of \f$ d \varepsilon / dP \f$ when \ref calc_love
+	is true (default \f$ 10^{-4} \f$)
+    */
+    double love_deriv_step;
+    /** \brief If true, keep only the last ODE steps during the
+	integration (default false)
+
+	See the discussion of minimal storage mode in the class
+	documentation.
+    */
+    bool min_storage;
     /// smallest allowed radial stepsize in km (default 1.0e-4)
     double step_min;
     /// largest allowed radial stepsize in km (default 0.05)
@@ -600,6 +737,26 @@ namespace o2scl {
     std::vector<double> pr_list;
     //@}
 
+    /// \name Parallel mass versus radius parameters
+    //@{
+    /** \brief Increment factor for the initial pressure grid
+	in \ref mvsr_par() (default 1.3)
+    */
+    double par_princ;
+    /** \brief Largest change in gravitational mass between adjacent
+	rows in \ref mvsr_par() in \f$ \mathrm{M}_{\odot} \f$ 
+	(default 0.05)
+    */
+    double par_dm;
+    /** \brief Relative width of the central pressure interval 
+	around the maximum mass star in \ref mvsr_par() 
+	(default \f$ 10^{-3} \f$)
+    */
+    double par_max_tol;
+    /// Maximum number of refinement passes in \ref mvsr_par() (default 12)
+    size_t par_levels;
+    //@}
+
     /// \name Fixed mass parameter
     //@{
     /** \brief Guess for central pressure in 
@@ -655,6 +812,44 @@ namespace o2scl {
      */
     virtual int mvsr();
 
+    /** \brief Calculate the mass vs. radius curve in parallel with 
+	adaptive refinement
+
+	This function creates the same table as \ref mvsr(), but the
+	central pressures are chosen adaptively and the stars are
+	integrated using \c n_threads threads if OpenMP is enabled.
+	The initial grid runs from \ref prbegin to \ref prend with
+	an increment factor of \ref par_princ. Each pass then adds
+	the geometric mean of the central pressures of adjacent rows
+	if the gravitational masses differ by more than \ref par_dm
+	or if the rows bracket the maximum mass star and their
+	central pressures differ by more than a relative amount 
+	\ref par_max_tol. At most \ref par_levels passes are 
+	performed. The rows are stored in the table in order of 
+	central pressure in the direction from \ref prbegin to 
+	\ref prend.
+
+	Thread 0 uses this object and the additional threads use
+	separate objects with the default stepper, with the settings
+	taken from this object (see \ref copy_settings()). The EOS
+	object is shared between the threads, so 
+	\ref eos_tov::ed_nb_from_pr() must be safe to call 
+	simultaneously from several threads (this is true for the
+	EOS classes in \o2 ). If the stepper has been changed with 
+	\ref set_stepper(), it is only used by thread 0.
+
+	Stars which fail to converge are handled as in \ref mvsr(), 
+	except that the error handler is called (if \ref err_nonconv
+	is true) only after the table has been constructed.
+    */
+    virtual int mvsr_par(size_t n_threads=1);
+
+    /** \brief Copy the EOS, the output units, the solution 
+	parameters, and the tolerances of \ref def_stepper from 
+	\c ts
+    */
+    void copy_settings(const tov_solve &ts);
+
     /** \brief Calculate the profile of a star with fixed mass
 
 	This function computes the profile for a star with a fixed
@@ -332,6 +332,100 @@ int main(void) {
 
   cout << endl;
 
+  // --------------------------------------------------------------
+  // Parallel mass vs. radius curve
+
+  cout << "----------------------------------------------------" << endl;
+  cout << "Parallel mass vs. radius curve: " << endl;
+
+  double r14=tab->interp("gm",1.4,"r");
+  double mmax_serial=tab->max("gm");
+  double pcent_max_serial=at.pcent_max;
+
+  int info_par=at.mvsr_par(4);
+  tab->summary(&cout);
+  t.test_gen(info_par==0,"mvsr_par info");
+
+  // Rows are in order of increasing central pressure, and the
+  // change in mass between rows is limited
+  bool in_order=true, small_dm=true;
+  for(size_t i=1;i<tab->get_nlines();i++) {
+    if (tab->get("pr",i)<=tab->get("pr",i-1)) in_order=false;
+    if (fabs(tab->get("gm",i)-tab->get("gm",i-1))>at.par_dm) {
+      small_dm=false;
+    }
+  }
+  t.test_gen(in_order,"mvsr_par order");
+  t.test_gen(small_dm,"mvsr_par dm");
+  t.test_gen(tab->get_nlines()<100,"mvsr_par size");
+
+  // The refined maximum is at least as large as that from the fixed
+  // grid and agrees with the result from max()
+  t.test_gen(tab->max("gm")>=mmax_serial,"mvsr_par max vs. mvsr");
+  t.test_rel(tab->max("gm"),massmax,1.0e-5,"mvsr_par max mass");
+  t.test_rel(tab->get("r",tab->lookup("gm",tab->max("gm"))),radmax,
+             1.0e-3,"mvsr_par max radius");
+  t.test_rel(at.pcent_max,pcent_max_serial,0.1,"mvsr_par pcent_max");
+  t.test_rel(tab->interp("gm",1.4,"r"),r14,1.0e-3,"mvsr_par r14");
+  t.test_rel(tab->interp("gm",1.4,"r0"),r1test,1.0e-2,"mvsr_par r0");
+  t.test_rel(tab->interp("gm",1.4,"gm1"),gm2test,1.0e-2,"mvsr_par gm1");
+  cout << endl;
+
+  // --------------------------------------------------------------
+  // Minimal storage mode
+
+  cout << "----------------------------------------------------" << endl;
+  cout << "Minimal storage mode: " << endl;
+
+  at.mvsr();
+  table_units<> tab_full=*tab;
+  at.min_storage=true;
+  at.mvsr();
+  tab->summary(&cout);
+  t.test_gen(tab->get_nlines()==tab_full.get_nlines(),"min_storage nlines");
+  for(size_t i=0;i<tab->get_nlines();i+=10) {
+    t.test_rel(tab->get("gm",i),tab_full.get("gm",i),1.0e-12,
+               "min_storage gm");
+    t.test_rel(tab->get("r",i),tab_full.get("r",i),1.0e-12,
+               "min_storage r");
+    t.test_rel(tab->get("bm",i),tab_full.get("bm",i),1.0e-12,
+               "min_storage bm");
+    // Pressures larger than the central pressure give zero
+    // in minimal storage mode rather than an extrapolation
+    if (tab->get("r0",i)>0.0) {
+      t.test_rel(tab->get("r0",i),tab_full.get("r0",i),1.0e-3,
+                 "min_storage r0");
+    }
+    if (tab->get("gm1",i)>0.0) {
+      t.test_rel(tab->get("gm1",i),tab_full.get("gm1",i),1.0e-3,
+                 "min_storage gm1");
+    }
+  }
+
+  // The profile of a 1.4 solar mass star is reconstructed on a
+  // uniform grid in radius
+  at.min_storage=false;
+  at.fixed(1.4);
+  tab_full=*tab;
+  double rad_full=at.rad;
+  at.min_storage=true;
+  at.fixed(1.4);
+  t.test_rel(at.rad,rad_full,1.0e-12,"min_storage fixed rad");
+  t.test_gen(at.get_rkx().size()==3,"min_storage buffer");
+  t.test_gen(tab->get_nlines()==at.max_table_size,"min_storage table");
+  t.test_rel(tab->get("pr",0),tab_full.get("pr",0),1.0e-12,
+             "min_storage central pr");
+  t.test_rel(tab->get("r",tab->get_nlines()-1),rad_full,1.0e-12,
+             "min_storage surface");
+  for(double rx=1.0;rx<rad_full*0.9;rx+=2.0) {
+    t.test_rel(tab->interp("r",rx,"gm"),tab_full.interp("r",rx,"gm"),
+               1.0e-3,"min_storage gm profile");
+    t.test_rel(tab->interp("r",rx,"ed"),tab_full.interp("r",rx,"ed"),
+               1.0e-4,"min_storage ed profile");
+  }
+  at.min_storage=false;
+  cout << endl;
+
   // --------------------------------------------------------------
   // Test the Buchdahl EOS 
 
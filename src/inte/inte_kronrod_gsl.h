@@ -649,6 +649,37 @@ namespace o2scl {
       set_rule(1);
     }
       
+    /** \brief Copy constructor
+
+        This copies the settings and the integration rule, but 
+        allocates a new workspace.
+    */
+    inte_kronrod_gsl(const inte_kronrod_gsl &ik) :
+      inte_gsl(ik), inte<func_t>(ik) {
+      w=new inte_workspace_gsl;
+      w->allocate(ik.w->limit);
+      n_gk=0;
+      set_rule(ik.get_rule());
+    }
+
+    /** \brief Copy assignment
+
+        This copies the settings and the integration rule, but 
+        keeps the workspace.
+    */
+    inte_kronrod_gsl &operator=(const inte_kronrod_gsl &ik) {
+      if (this!=&ik) {
+        inte_gsl::operator=(ik);
+        inte<func_t>::operator=(ik);
+        if (w->limit!=ik.w->limit) {
+          w->free();
+          w->allocate(ik.w->limit);
+        }
+        set_rule(ik.get_rule());
+      }
+      return *this;
+    }
+      
     ~inte_kronrod_gsl() {
       w->free();
       delete w;
@@ -669,7 +700,7 @@ namespace o2scl {
         This returns the index of the GSL integration rule
         a number between 1 and 6 (inclusive)
     */
-    int get_rule() {
+    int get_rule() const {
       switch (n_gk) {
       case 8:
         return 1;
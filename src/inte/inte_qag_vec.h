@@ -0,0 +1,390 @@
+/*
+  ───────────────────────────────────────────────────────────────────
+
+  Copyright (C) 2025, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  ───────────────────────────────────────────────────────────────────
+*/
+#ifndef O2SCL_INTE_QAG_VEC_H
+#define O2SCL_INTE_QAG_VEC_H
+
+/** \file inte_qag_vec.h
+    \brief File defining \ref o2scl::inte_qag_vec
+*/
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <iostream>
+
+#include <o2scl/err_hnd.h>
+#include <o2scl/inte_kronrod_gsl.h>
+
+namespace o2scl {
+
+  /** \brief Adaptive integration of a vector-valued function
+      with shared abscissas
+
+      This class integrates \c nf functions which share the same
+      integration variable simultaneously. The functions are
+      evaluated together at the same abscissas, so any work which is
+      common to all of them (e.g. a distribution function) is done
+      only once per point. Each subinterval is integrated with the
+      21-point Gauss-Kronrod rule from \ref inte_qag_gsl and the error
+      for each component is rescaled using the QUADPACK heuristics.
+      The subinterval with the largest value of
+      \f[
+      \max_i \frac{\delta_i}{\max(\mathrm{tol\_abs},
+      \mathrm{tol\_rel}\,|I_i|)}
+      \f]
+      (where \f$ \delta_i \f$ is the error estimate for the \f$ i
+      \f$-th component on that subinterval and \f$ I_i \f$ is the
+      current total integral for the \f$ i \f$-th component) is
+      bisected until every component satisfies its tolerance.
+
+      The function must be callable as <tt>f(x,y)</tt> where \c y
+      is a <tt>std::vector<fp_t></tt> of size \c nf which is to be
+      filled with the function values at \c x.
+
+      Semi-infinite integrals are handled with the same
+      transformation as \ref inte_qagiu_gsl, \f$ x = a + (1-t)/t \f$.
+
+      \note The Gauss-Kronrod coefficients are stored in double
+      precision, so this class is not intended to give results more
+      accurate than about \f$ 10^{-15} \f$ even if \c fp_t is a
+      higher-precision type.
+  */
+  template<class fp_t=double> class inte_qag_vec {
+
+  protected:
+
+    /// A subinterval and its integral and error estimates
+    class interval {
+    public:
+      /// Left endpoint
+      fp_t a;
+      /// Right endpoint
+      fp_t b;
+      /// Integral estimates
+      std::vector<fp_t> r;
+      /// Error estimates
+      std::vector<fp_t> e;
+    };
+
+    /** \brief Rescale the raw error estimate using the QUADPACK
+        heuristic
+    */
+    fp_t rescale_error(fp_t err, fp_t result_abs, fp_t result_asc) {
+
+      using std::abs;
+      using std::pow;
+
+      err=abs(err);
+      fp_t eps=std::numeric_limits<fp_t>::epsilon();
+      fp_t tiny=std::numeric_limits<fp_t>::min();
+
+      if (result_asc!=0 && err!=0) {
+        fp_t scale=pow(200*err/result_asc,((fp_t)3)/((fp_t)2));
+        if (scale<1) {
+          err=result_asc*scale;
+        } else {
+          err=result_asc;
+        }
+      }
+      if (result_abs>tiny/(50*eps)) {
+        fp_t min_err=50*eps*result_abs;
+        if (min_err>err) err=min_err;
+      }
+
+      return err;
+    }
+
+    /** \brief Apply the 21-point Gauss-Kronrod rule to all
+        components on the interval \c iv
+    */
+    template<class func_t>
+    void gk21(func_t &&func, size_t nf, interval &iv, bool transform,
+              fp_t a0) {
+
+      using namespace o2scl_inte_gk_coeffs;
+      using std::abs;
+
+      const size_t n=11;
+      fp_t center=(iv.a+iv.b)/2;
+      fp_t half_length=(iv.b-iv.a)/2;
+      fp_t abs_half_length=abs(half_length);
+
+      // Store the function values at all 21 points
+      for(size_t k=0;k<21;k++) {
+        fp_t x;
+        if (k==20) {
+          x=center;
+        } else if (k%2==0) {
+          x=center-half_length*((fp_t)qk21_xgk[k/2]);
+        } else {
+          x=center+half_length*((fp_t)qk21_xgk[k/2]);
+        }
+        eval_point(func,nf,x,fv[k],transform,a0);
+      }
+
+      iv.r.resize(nf);
+      iv.e.resize(nf);
+
+      for(size_t i=0;i<nf;i++) {
+
+        fp_t f_center=fv[20][i];
+        fp_t result_gauss=0;
+        fp_t result_kronrod=f_center*((fp_t)qk21_wgk[n-1]);
+        fp_t result_abs=abs(result_kronrod);
+
+        for(size_t j=0;j<(n-1)/2;j++) {
+          size_t jtw=j*2+1;
+          fp_t fval1=fv[2*jtw][i];
+          fp_t fval2=fv[2*jtw+1][i];
+          fp_t fsum=fval1+fval2;
+          result_gauss+=((fp_t)qk21_wg[j])*fsum;
+          result_kronrod+=((fp_t)qk21_wgk[jtw])*fsum;
+          result_abs+=((fp_t)qk21_wgk[jtw])*(abs(fval1)+abs(fval2));
+        }
+
+        for(size_t j=0;j<n/2;j++) {
+          size_t jtwm1=j*2;
+          fp_t fval1=fv[2*jtwm1][i];
+          fp_t fval2=fv[2*jtwm1+1][i];
+          fp_t fsum=fval1+fval2;
+          result_kronrod+=((fp_t)qk21_wgk[jtwm1])*fsum;
+          result_abs+=((fp_t)qk21_wgk[jtwm1])*(abs(fval1)+abs(fval2));
+        }
+
+        fp_t mean=result_kronrod/2;
+        fp_t result_asc=((fp_t)qk21_wgk[n-1])*abs(f_center-mean);
+        for(size_t j=0;j<n-1;j++) {
+          result_asc+=((fp_t)qk21_wgk[j])*
+            (abs(fv[2*j][i]-mean)+abs(fv[2*j+1][i]-mean));
+        }
+
+        fp_t err=(result_kronrod-result_gauss)*half_length;
+
+        iv.r[i]=result_kronrod*half_length;
+        iv.e[i]=rescale_error(err,result_abs*abs_half_length,
+                              result_asc*abs_half_length);
+      }
+
+      n_eval+=21;
+
+      return;
+    }
+
+    /** \brief Evaluate the functions at \c x, applying the
+        semi-infinite transformation if necessary
+    */
+    template<class func_t>
+    void eval_point(func_t &&func, size_t nf, fp_t x,
+                    std::vector<fp_t> &y, bool transform, fp_t a0) {
+      y.resize(nf);
+      if (transform) {
+        fp_t xt=a0+(1-x)/x;
+        func(xt,y);
+        for(size_t i=0;i<nf;i++) y[i]/=x*x;
+      } else {
+        func(x,y);
+      }
+      return;
+    }
+
+    /** \brief The ratio of the error to the tolerance for the
+        worst component of interval \c iv
+    */
+    fp_t worst_ratio(const interval &iv, const std::vector<fp_t> &tol) {
+      fp_t ret=0;
+      for(size_t i=0;i<iv.e.size();i++) {
+        fp_t ratio;
+        if (tol[i]>0) {
+          ratio=iv.e[i]/tol[i];
+        } else if (iv.e[i]>0) {
+          ratio=std::numeric_limits<fp_t>::max();
+        } else {
+          ratio=0;
+        }
+        if (ratio>ret) ret=ratio;
+      }
+      return ret;
+    }
+
+    /// Function values at the 21 abscissas
+    std::vector<fp_t> fv[21];
+
+    /// The list of subintervals
+    std::vector<interval> ilist;
+
+    /// The main adaptive loop
+    template<class func_t>
+    int integ_base(func_t &&func, size_t nf, fp_t a, fp_t b,
+                   std::vector<fp_t> &res, std::vector<fp_t> &err,
+                   bool transform, fp_t a0) {
+
+      using std::abs;
+
+      n_eval=0;
+      n_intervals=0;
+      res.resize(nf);
+      err.resize(nf);
+
+      ilist.clear();
+      ilist.resize(1);
+      ilist[0].a=a;
+      ilist[0].b=b;
+      gk21(func,nf,ilist[0],transform,a0);
+
+      std::vector<fp_t> tol(nf);
+      fp_t eps=std::numeric_limits<fp_t>::epsilon();
+      fp_t tiny=std::numeric_limits<fp_t>::min();
+
+      while (true) {
+
+        // Sum the integrals and errors over all intervals
+        for(size_t i=0;i<nf;i++) {
+          res[i]=0;
+          err[i]=0;
+        }
+        for(size_t j=0;j<ilist.size();j++) {
+          for(size_t i=0;i<nf;i++) {
+            res[i]+=ilist[j].r[i];
+            err[i]+=ilist[j].e[i];
+          }
+        }
+
+        bool done=true;
+        for(size_t i=0;i<nf;i++) {
+          tol[i]=tol_rel*abs(res[i]);
+          if (tol_abs>tol[i]) tol[i]=tol_abs;
+          if (err[i]>tol[i]) done=false;
+        }
+        n_intervals=ilist.size();
+
+        if (verbose>1) {
+          std::cout << "inte_qag_vec: " << ilist.size()
+                    << " intervals." << std::endl;
+          for(size_t i=0;i<nf;i++) {
+            std::cout << "  " << i << " " << res[i] << " "
+                      << err[i] << " " << tol[i] << std::endl;
+          }
+        }
+
+        if (done) return success;
+
+        if (ilist.size()>=limit) {
+          O2SCL_CONV2_RET("Iteration limit exceeded in ",
+                          "inte_qag_vec::integ_base().",
+                          exc_emaxiter,err_nonconv);
+        }
+
+        // Find the interval with the worst component and bisect it
+        size_t jmax=0;
+        fp_t rmax=worst_ratio(ilist[0],tol);
+        for(size_t j=1;j<ilist.size();j++) {
+          fp_t rj=worst_ratio(ilist[j],tol);
+          if (rj>rmax) {
+            rmax=rj;
+            jmax=j;
+          }
+        }
+
+        fp_t a1=ilist[jmax].a;
+        fp_t b2=ilist[jmax].b;
+        fp_t mid=(a1+b2)/2;
+
+        fp_t tmp=(1+100*eps)*(abs(mid)+1000*tiny);
+        if (abs(a1)<=tmp && abs(b2)<=tmp) {
+          O2SCL_CONV2_RET("Subinterval too small in ",
+                          "inte_qag_vec::integ_base().",
+                          exc_esing,err_nonconv);
+        }
+
+        interval right;
+        right.a=mid;
+        right.b=b2;
+        ilist[jmax].b=mid;
+        gk21(func,nf,ilist[jmax],transform,a0);
+        gk21(func,nf,right,transform,a0);
+        ilist.push_back(right);
+      }
+
+      return success;
+    }
+
+  public:
+
+    inte_qag_vec() {
+      tol_rel=1.0e-8;
+      tol_abs=1.0e-8;
+      limit=1000;
+      verbose=0;
+      err_nonconv=true;
+      n_eval=0;
+      n_intervals=0;
+    }
+
+    /// The maximum relative uncertainty (default \f$ 10^{-8} \f$)
+    fp_t tol_rel;
+
+    /// The maximum absolute uncertainty (default \f$ 10^{-8} \f$)
+    fp_t tol_abs;
+
+    /// Maximum number of subintervals (default 1000)
+    size_t limit;
+
+    /// Verbosity parameter (default 0)
+    int verbose;
+
+    /// If true, call the error handler if the integration fails
+    bool err_nonconv;
+
+    /// Number of function evaluations in the last integration
+    size_t n_eval;
+
+    /// Number of subintervals used in the last integration
+    size_t n_intervals;
+
+    /** \brief Integrate the \c nf functions in \c func from \c a to
+        \c b, storing the results in \c res and the uncertainties in
+        \c err
+    */
+    template<class func_t>
+    int integ_err(func_t &&func, size_t nf, fp_t a, fp_t b,
+                  std::vector<fp_t> &res, std::vector<fp_t> &err) {
+      return integ_base(func,nf,a,b,res,err,false,a);
+    }
+
+    /** \brief Integrate the \c nf functions in \c func from \c a to
+        \f$ \infty \f$, storing the results in \c res and the
+        uncertainties in \c err
+    */
+    template<class func_t>
+    int integ_iu_err(func_t &&func, size_t nf, fp_t a,
+                     std::vector<fp_t> &res, std::vector<fp_t> &err) {
+      return integ_base(func,nf,((fp_t)0),((fp_t)1),res,err,true,a);
+    }
+
+    /// Return string denoting type ("inte_qag_vec")
+    const char *type() { return "inte_qag_vec"; }
+
+  };
+
+}
+
+#endif
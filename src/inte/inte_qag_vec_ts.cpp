@@ -0,0 +1,109 @@
+/*
+  ───────────────────────────────────────────────────────────────────
+
+  Copyright (C) 2025, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  ───────────────────────────────────────────────────────────────────
+*/
+#include <o2scl/test_mgr.h>
+#include <o2scl/funct.h>
+#include <o2scl/inte_qag_gsl.h>
+#include <o2scl/inte_qagiu_gsl.h>
+#include <o2scl/inte_qag_vec.h>
+
+using namespace std;
+using namespace o2scl;
+
+int vec_fun(double x, std::vector<double> &y) {
+  y[0]=sin(x);
+  y[1]=x*x;
+  y[2]=sin(1.0/(x+0.01))*pow(x+0.01,-2.0);
+  return 0;
+}
+
+int vec_fun_iu(double x, std::vector<double> &y) {
+  double ex=exp(-x);
+  y[0]=ex;
+  y[1]=x*ex;
+  y[2]=exp(-x*x);
+  return 0;
+}
+
+double sin_recip(double x) {
+  return sin(1.0/(x+0.01))*pow(x+0.01,-2.0);
+}
+
+double gaussian(double x) {
+  return exp(-x*x);
+}
+
+int main(void) {
+  test_mgr t;
+  t.set_output_level(2);
+
+  cout.setf(ios::scientific);
+
+  inte_qag_vec<> iv;
+  vector<double> res, err;
+
+  // Finite interval, compared with exact results and with
+  // inte_qag_gsl for the oscillatory component
+  iv.integ_err(vec_fun,3,0.0,1.0,res,err);
+  t.test_rel(res[0],1.0-cos(1.0),1.0e-8,"finite 0");
+  t.test_rel(res[1],1.0/3.0,1.0e-8,"finite 1");
+  t.test_rel(res[2],cos(1.0/1.01)-cos(100.0),1.0e-8,"finite 2");
+  cout << iv.n_intervals << " " << iv.n_eval << endl;
+
+  funct tf=sin_recip;
+  inte_qag_gsl<> iq;
+  double r2, e2;
+  iq.integ_err(tf,0.0,1.0,r2,e2);
+  t.test_rel(res[2],r2,1.0e-8,"finite vs. qag");
+
+  // The integration must continue until the hardest component
+  // converges, so the easy components are also accurate
+  for(size_t i=0;i<3;i++) {
+    t.test_gen(err[i]<=max(iv.tol_abs,iv.tol_rel*fabs(res[i])),
+               "finite error");
+  }
+
+  // Semi-infinite interval
+  iv.integ_iu_err(vec_fun_iu,3,0.0,res,err);
+  t.test_rel(res[0],1.0,1.0e-8,"iu 0");
+  t.test_rel(res[1],1.0,1.0e-8,"iu 1");
+  t.test_rel(res[2],0.5*sqrt(acos(-1.0)),1.0e-8,"iu 2");
+
+  funct tf2=gaussian;
+  inte_qagiu_gsl<> iqu;
+  iqu.integ_err(tf2,1.0,0.0,r2,e2);
+  iv.integ_iu_err(vec_fun_iu,3,1.0,res,err);
+  t.test_rel(res[0],exp(-1.0),1.0e-8,"iu shifted 0");
+  t.test_rel(res[1],2.0*exp(-1.0),1.0e-8,"iu shifted 1");
+  t.test_rel(res[2],r2,1.0e-8,"iu shifted vs. qagiu");
+
+  // A tighter tolerance
+  iv.tol_rel=1.0e-10;
+  iv.tol_abs=0.0;
+  iv.integ_err(vec_fun,3,0.0,1.0,res,err);
+  t.test_rel(res[0],1.0-cos(1.0),1.0e-10,"tight 0");
+  t.test_rel(res[1],1.0/3.0,1.0e-10,"tight 1");
+  t.test_rel(res[2],cos(1.0/1.01)-cos(100.0),1.0e-10,"tight 2");
+
+  t.report();
+  return 0;
+}
@@ -377,6 +377,84 @@ namespace o2scl_linalg {
     return stat_chol;
   }
 
+  /** \brief Update a Cholesky decomposition after a rank-one
+      modification
+
+      Given the Cholesky decomposition of a matrix A in \c LLT, as
+      produced by \ref cholesky_decomp(), this function replaces \c
+      LLT with the Cholesky decomposition of <tt>A+v*v^T</tt> using
+      a sequence of Givens rotations. This requires \f$ {\cal
+      O}(N^2) \f$ operations rather than the \f$ {\cal O}(N^3) \f$
+      operations for a new decomposition. A rank-k update can be
+      performed with k successive calls. The vector \c v is
+      destroyed on output.
+  */
+  template<class mat_t, class vec_t>
+    void cholesky_update_rank1(const size_t N, mat_t &LLT, vec_t &v) {
+  
+    for (size_t k=0;k<N;k++) {
+      double L_kk=O2SCL_IX2(LLT,k,k);
+      double v_k=O2SCL_IX(v,k);
+      double r=sqrt(L_kk*L_kk+v_k*v_k);
+      double c=r/L_kk;
+      double s=v_k/L_kk;
+      O2SCL_IX2(LLT,k,k)=r;
+      for (size_t i=k+1;i<N;i++) {
+	double L_ik=(O2SCL_IX2(LLT,i,k)+s*O2SCL_IX(v,i))/c;
+	O2SCL_IX(v,i)=c*O2SCL_IX(v,i)-s*L_ik;
+	O2SCL_IX2(LLT,i,k)=L_ik;
+	O2SCL_IX2(LLT,k,i)=L_ik;
+      }
+    }
+  
+    return;
+  }
+
+  /** \brief Downdate a Cholesky decomposition after a rank-one
+      modification
+
+      Given the Cholesky decomposition of a matrix A in \c LLT, as
+      produced by \ref cholesky_decomp(), this function replaces \c
+      LLT with the Cholesky decomposition of <tt>A-v*v^T</tt> using
+      a sequence of hyperbolic rotations in \f$ {\cal O}(N^2) \f$
+      operations. The vector \c v is destroyed on output.
+
+      If the downdated matrix is not positive-definite, the error
+      handler will be called, unless \c err_on_fail is false, in
+      which case a non-zero value will be returned and the contents
+      of \c LLT are undefined.
+  */
+  template<class mat_t, class vec_t>
+    int cholesky_downdate_rank1(const size_t N, mat_t &LLT, vec_t &v,
+				bool err_on_fail=true) {
+  
+    for (size_t k=0;k<N;k++) {
+      double L_kk=O2SCL_IX2(LLT,k,k);
+      double v_k=O2SCL_IX(v,k);
+      double diag=(L_kk-v_k)*(L_kk+v_k);
+      if (diag<=0.0) {
+	if (err_on_fail) {
+	  O2SCL_ERR2("Downdated matrix not positive definite in ",
+		     "cholesky_downdate_rank1().",o2scl::exc_einval);
+	} else {
+	  return 1;
+	}
+      }
+      double r=sqrt(diag);
+      double c=r/L_kk;
+      double s=v_k/L_kk;
+      O2SCL_IX2(LLT,k,k)=r;
+      for (size_t i=k+1;i<N;i++) {
+	double L_ik=(O2SCL_IX2(LLT,i,k)-s*O2SCL_IX(v,i))/c;
+	O2SCL_IX(v,i)=c*O2SCL_IX(v,i)-s*L_ik;
+	O2SCL_IX2(LLT,i,k)=L_ik;
+	O2SCL_IX2(LLT,k,i)=L_ik;
+      }
+    }
+  
+    return 0;
+  }
+
 #ifdef DOXYGEN
 }
 #endif
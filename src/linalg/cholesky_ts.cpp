@@ -152,6 +152,34 @@ int main(void) {
     
     t.test_rel_mat(5,5,om1,gsl_matrix_wrap(gm1),5.0e-12,"cholesky invert 1");
 
+    // Test rank-one update and downdate
+
+    for(size_t i=0;i<5;i++) {
+      ov1[i]=cos(((double)(i)));
+      for(size_t j=0;j<5;j++) {
+	om1(i,j)=((double)(1))/(1.0+i+j);
+	if (i==j) om1(i,j)+=1.0;
+	om2(i,j)=om1(i,j)+ov1[i]*cos(((double)(j)));
+      }
+    }
+
+    cholesky_decomp(5,om1);
+    cholesky_decomp(5,om2);
+    ov2=ov1;
+    cholesky_update_rank1(5,om1,ov2);
+    t.test_rel_mat(5,5,om1,om2,1.0e-12,"cholesky update");
+
+    ov2=ov1;
+    cholesky_downdate_rank1(5,om1,ov2);
+    for(size_t i=0;i<5;i++) {
+      for(size_t j=0;j<5;j++) {
+	om2(i,j)=((double)(1))/(1.0+i+j);
+	if (i==j) om2(i,j)+=1.0;
+      }
+    }
+    cholesky_decomp(5,om2);
+    t.test_rel_mat(5,5,om1,om2,1.0e-12,"cholesky downdate");
+
   }
 
 #endif
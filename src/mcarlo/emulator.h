@@ -190,6 +190,12 @@ namespace o2scl {
     /// Index of the "log weight" in the MCMC data vector
     size_t ix;
 
+    /// The column names for the parameters
+    std::vector<std::string> col_x;
+    
+    /// The column names for the output quantities
+    std::vector<std::string> col_y;
+
   public:
     
     /// The internal interpolation object
@@ -226,6 +232,8 @@ namespace o2scl {
       iko.full_min=true;
       
       ix=ix_log_wgt;
+      col_x=list_x;
+      col_y=list_y;
 
       std::vector<std::vector<std::vector<double>>> param_lists;
 
@@ -299,6 +307,27 @@ namespace o2scl {
 
       return;
     }
+
+    /** \brief Update the emulator after new rows have been added
+        to the end of the table \c t which was given to \ref set()
+
+        The covariance parameters are only re-optimized when
+        required by \ref interpm_krige_optim::refit_interval, 
+        otherwise the new points are added using
+        \ref interpm_krige_optim::update_data() .
+    */
+    void update(table<> &t) {
+      
+      const_matrix_view_table<> mvt_x;
+      matrix_view_table<> mvt_y;
+      
+      mvt_x.set(t,col_x);
+      mvt_y.set(t,col_y);
+
+      iko.update_data(t.get_nlines(),mvt_x,mvt_y);
+      
+      return;
+    }
     
     /** \brief Evaluate the emulator at the point \c p returning
         \c log_wgt and \c dat and their uncertainties
@@ -21,14 +21,274 @@
   ───────────────────────────────────────────────────────────────────
 */
 
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+// The binary cache uses POSIX file and memory-mapping functions
+#if defined(__unix__) || defined(__APPLE__)
+#define O2SCL_NUCMASS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include <o2scl/hdf_nucmass_io.h>
 
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
+using namespace o2scl_hdf;
 
-void o2scl_hdf::ame_load_ext(o2scl::nucmass_ame &ame, std::string file_name, 
-			     std::string table_name, bool exp_only) {
+/** \brief The header of a nuclear mass table cache file
+
+    The header is followed by the table name, the canonical path of
+    the source file, the reference, padding to a multiple of eight
+    bytes, and the entries.
+*/
+struct nucmass_cache_header {
+  /// The file identifier, \c "o2nucm2"
+  char magic[8];
+  /// The size of each entry in bytes
+  uint64_t entry_size;
+  /// The number of entries
+  uint64_t n;
+  /// The length of the table name
+  uint64_t key_len;
+  /// The length of the canonical path of the source file
+  uint64_t src_len;
+  /// The length of the reference
+  uint64_t ref_len;
+  /// The size of the source file in bytes
+  uint64_t src_size;
+  /// The modification time of the source file
+  int64_t src_mtime;
+};
+
+static const char nucmass_cache_magic[8]="o2nucm2";
+
+nucmass_shared_table::nucmass_shared_table() {
+  n=0;
+  entry_size=0;
+  data=0;
+  mapped=false;
+  map_base=0;
+  map_len=0;
+}
+
+nucmass_shared_table::~nucmass_shared_table() {
+#ifdef O2SCL_NUCMASS_MMAP
+  if (mapped) munmap(map_base,map_len);
+#endif
+}
+
+nucmass_registry::nucmass_registry() {
+  verbose=0;
+  char *cd=getenv("O2SCL_NUCMASS_CACHE");
+  if (cd) cache_dir=cd;
+}
+
+nucmass_registry &nucmass_registry::instance() {
+  static nucmass_registry reg;
+  return reg;
+}
+
+void nucmass_registry::set_cache_dir(std::string dir) {
+  std::lock_guard<std::mutex> lock(mtx);
+  cache_dir=dir;
+  return;
+}
+
+std::string nucmass_registry::get_cache_dir() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return cache_dir;
+}
+
+size_t nucmass_registry::n_tables() {
+  std::lock_guard<std::mutex> lock(mtx);
+  return tables.size();
+}
+
+void nucmass_registry::clear() {
+  std::lock_guard<std::mutex> lock(mtx);
+  tables.clear();
+  return;
+}
+
+std::string nucmass_registry::canonical_path(std::string fname) {
+#ifdef O2SCL_NUCMASS_MMAP
+  char *rp=realpath(fname.c_str(),0);
+  if (rp) {
+    fname=rp;
+    free(rp);
+  }
+#endif
+  return fname;
+}
+
+std::string nucmass_registry::cache_file(std::string key) {
+  std::ostringstream oss;
+  oss << cache_dir << "/nucmass_" << std::hex
+      << std::hash<std::string>()(key) << ".bin";
+  return oss.str();
+}
+
+nucmass_registry::table_ptr nucmass_registry::get
+(std::string key, std::string source, size_t entry_size, load_funct &load) {
+
+  std::lock_guard<std::mutex> lock(mtx);
+
+  std::map<std::string,table_ptr>::iterator it=tables.find(key);
+  if (it!=tables.end()) return it->second;
+
+  table_ptr tp;
+  if (cache_dir.length()>0) {
+    tp=cache_read(key,source,entry_size);
+    if (tp && verbose>0) {
+      std::cout << "nucmass_registry::get(): Read table '" << key
+                << "' from " << cache_file(key) << "." << std::endl;
+    }
+  }
+
+  if (!tp) {
+    std::shared_ptr<nucmass_shared_table> t(new nucmass_shared_table);
+    load(t->buf,t->n,t->reference);
+    t->entry_size=entry_size;
+    if (t->buf.size()>0) t->data=&(t->buf[0]);
+    if (cache_dir.length()>0 && t->n>0) cache_write(key,source,*t);
+    tp=t;
+  }
+
+  tables.insert(std::make_pair(key,tp));
+  
+  return tp;
+}
+
+nucmass_registry::table_ptr nucmass_registry::cache_read
+(std::string key, std::string source, size_t entry_size) {
+
+  table_ptr tp;
+  
+#ifdef O2SCL_NUCMASS_MMAP
+
+  // The path, size, and modification time of the source are
+  // compared with those stored in the cache file below
+  std::string fname=cache_file(key);
+  std::string src=canonical_path(source);
+  struct stat st_src, st_cache;
+  if (stat(src.c_str(),&st_src)!=0) return tp;
+  if (stat(fname.c_str(),&st_cache)!=0) return tp;
+  
+  size_t len=st_cache.st_size;
+  if (len<sizeof(nucmass_cache_header)) return tp;
+  
+  int fd=open(fname.c_str(),O_RDONLY);
+  if (fd<0) return tp;
+  void *base=mmap(0,len,PROT_READ,MAP_PRIVATE,fd,0);
+  close(fd);
+  if (base==MAP_FAILED) return tp;
+
+  // Check the header and the size of the file
+  const char *c=(const char *)base;
+  nucmass_cache_header h;
+  memcpy(&h,c,sizeof(h));
+  size_t off=sizeof(h)+h.key_len+h.src_len+h.ref_len;
+  off=(off+7)/8*8;
+  if (memcmp(h.magic,nucmass_cache_magic,8)!=0 ||
+      h.entry_size!=entry_size || h.key_len!=key.length() ||
+      h.src_len!=src.length() || off+h.n*h.entry_size!=len ||
+      h.src_size!=(uint64_t)st_src.st_size ||
+      h.src_mtime!=(int64_t)st_src.st_mtime ||
+      key.compare(0,key.length(),c+sizeof(h),h.key_len)!=0 ||
+      src.compare(0,src.length(),c+sizeof(h)+h.key_len,h.src_len)!=0) {
+    if (verbose>0) {
+      std::cout << "nucmass_registry::cache_read(): Ignoring "
+                << "invalid cache file " << fname << "." << std::endl;
+    }
+    munmap(base,len);
+    return tp;
+  }
+
+  std::shared_ptr<nucmass_shared_table> t(new nucmass_shared_table);
+  t->n=h.n;
+  t->entry_size=h.entry_size;
+  t->reference=std::string(c+sizeof(h)+h.key_len+h.src_len,h.ref_len);
+  t->data=c+off;
+  t->mapped=true;
+  t->map_base=base;
+  t->map_len=len;
+  tp=t;
+  
+#endif
+  
+  return tp;
+}
+
+void nucmass_registry::cache_write(std::string key, std::string source,
+                                   const nucmass_shared_table &t) {
+  
+#ifdef O2SCL_NUCMASS_MMAP
+
+  std::string src=canonical_path(source);
+  struct stat st_src;
+  if (stat(src.c_str(),&st_src)!=0) return;
+
+  // Write to a temporary file and then rename it, so that other
+  // processes never see a partially written file
+  std::string fname=cache_file(key);
+  std::string tmp=fname+"."+itos(getpid())+".tmp";
+  
+  nucmass_cache_header h;
+  memset(&h,0,sizeof(h));
+  memcpy(h.magic,nucmass_cache_magic,8);
+  h.entry_size=t.entry_size;
+  h.n=t.n;
+  h.key_len=key.length();
+  h.src_len=src.length();
+  h.ref_len=t.reference.length();
+  h.src_size=st_src.st_size;
+  h.src_mtime=st_src.st_mtime;
+  size_t off=sizeof(h)+h.key_len+h.src_len+h.ref_len;
+  size_t pad=(off+7)/8*8-off;
+  char zeros[8]={0,0,0,0,0,0,0,0};
+  
+  std::ofstream fout(tmp.c_str(),std::ios::binary);
+  fout.write((const char *)&h,sizeof(h));
+  fout.write(key.c_str(),h.key_len);
+  fout.write(src.c_str(),h.src_len);
+  fout.write(t.reference.c_str(),h.ref_len);
+  fout.write(zeros,pad);
+  fout.write((const char *)t.data,t.n*t.entry_size);
+  fout.close();
+
+  if (!fout || std::rename(tmp.c_str(),fname.c_str())!=0) {
+    if (verbose>0) {
+      std::cout << "nucmass_registry::cache_write(): Could not write "
+                << fname << "." << std::endl;
+    }
+    std::remove(tmp.c_str());
+    return;
+  }
+  
+  if (verbose>0) {
+    std::cout << "nucmass_registry::cache_write(): Wrote table '" << key
+              << "' to " << fname << "." << std::endl;
+  }
+  
+#endif
+  
+  return;
+}
+
+/** \brief Read an AME table from an HDF5 file into \c buf
+ */
+static void ame_read(std::string file_name, std::string table_name,
+                     bool exp_only, std::vector<char> &buf,
+                     size_t &n_entries, std::string &reference) {
 
   size_t offset[23]={HOFFSET(o2scl::nucmass_ame::entry,NMZ),
 		     HOFFSET(o2scl::nucmass_ame::entry,N),
@@ -83,43 +343,31 @@ void o2scl_hdf::ame_load_ext(o2scl::nucmass_ame &ame, std::string file_name,
   hid_t file=hf.get_current_id();
 
   int nrecords;
-  std::string reference;
   hf.geti("nrecords",nrecords);
   if (nrecords<=0) {
     O2SCL_ERR("Number of records <= 0 in ame_load().",exc_efailed);
   }
   hf.gets_fixed("reference",reference);
-    
-  o2scl::nucmass_ame::entry *m=new o2scl::nucmass_ame::entry[nrecords];
+
+  buf.resize(((size_t)nrecords)*sizeof(o2scl::nucmass_ame::entry));
+  o2scl::nucmass_ame::entry *m=(o2scl::nucmass_ame::entry *)(&buf[0]);
   herr_t status=H5TBread_table(file,table_name.c_str(),
 			       sizeof(o2scl::nucmass_ame::entry),
 			       offset,sizes,m);
-
-  ame.n=nrecords;
-  ame.mass=m;
-  ame.reference=reference;
-  ame.last=nrecords/2;
+  n_entries=nrecords;
     
   if (exp_only) {
 
-    size_t n_exp=0;
-    for(int i=0;i<nrecords;i++) {
-      if (m[i].mass_acc==0) n_exp++;
-    }
-    o2scl::nucmass_ame::entry *m2=new o2scl::nucmass_ame::entry[n_exp];
+    // Move the experimental masses to the front of the buffer
     size_t i_exp=0;
     for(int i=0;i<nrecords;i++) {
       if (m[i].mass_acc==0) {
-	m2[i_exp]=m[i];
+	m[i_exp]=m[i];
 	i_exp++;
       }
     }
-    delete[] m;
-
-    ame.n=n_exp;
-    ame.mass=m2;
-    ame.reference=reference;
-    ame.last=n_exp/2;
+    n_entries=i_exp;
+    buf.resize(n_entries*sizeof(o2scl::nucmass_ame::entry));
   }
       
   hf.close();
@@ -127,6 +375,35 @@ void o2scl_hdf::ame_load_ext(o2scl::nucmass_ame &ame, std::string file_name,
   return;
 }
 
+void o2scl_hdf::ame_load_ext(o2scl::nucmass_ame &ame, std::string file_name, 
+			     std::string table_name, bool exp_only) {
+
+  file_name=nucmass_registry::canonical_path(file_name);
+  std::string key=((std::string)"ame ")+file_name+" "+table_name;
+  if (exp_only) key+=" exp";
+  
+  nucmass_registry::load_funct lf=
+    std::bind(ame_read,file_name,table_name,exp_only,
+              std::placeholders::_1,std::placeholders::_2,
+              std::placeholders::_3);
+  nucmass_registry::table_ptr tp=nucmass_registry::instance().get
+    (key,file_name,sizeof(o2scl::nucmass_ame::entry),lf);
+
+  if (ame.n>0 && !ame.shared_data) {
+    delete[] ame.mass;
+  }
+  
+  // The shared tables are read-only, but nucmass_ame never
+  // modifies its entries
+  ame.n=tp->n;
+  ame.mass=(o2scl::nucmass_ame::entry *)tp->data;
+  ame.reference=tp->reference;
+  ame.shared_data=tp;
+  ame.index_build(ame.n,ame.mass);
+
+  return;
+}
+
 void o2scl_hdf::ame_load(o2scl::nucmass_ame &ame, std::string name,
 			 bool exp_only) {
   
@@ -169,19 +446,11 @@ void o2scl_hdf::ame_load(o2scl::nucmass_ame &ame, std::string name,
   return;
 }
 
-void o2scl_hdf::mnmsk_load(o2scl::nucmass_mnmsk &mnmsk, std::string model,
-			   string filename) {
-
-  if (model=="mnmsk97") {
-    if (filename.size()==0) {
-      filename=o2scl::o2scl_settings.get_data_dir()+"/nucmass/mnmsk.o2";
-    }
-  } else {
-    model="msis16";
-    if (filename.size()==0) {
-      filename=o2scl::o2scl_settings.get_data_dir()+"/nucmass/msis16.o2";
-    }
-  }
+/** \brief Read an FRDM table from an HDF5 file into \c buf
+ */
+static void mnmsk_read(std::string model, std::string filename,
+                       std::vector<char> &buf, size_t &n_entries,
+                       std::string &reference) {
 
   if (model=="mnmsk97") {
     size_t offset[34]={HOFFSET(o2scl::nucmass_mnmsk::entry,N),
@@ -260,18 +529,18 @@ void o2scl_hdf::mnmsk_load(o2scl::nucmass_mnmsk &mnmsk, std::string model,
     hid_t file=hf.get_current_id();
 
     int nrecords;
-    std::string reference;
     hf.geti("nrecords",nrecords);
     if (nrecords<=0) {
       O2SCL_ERR("Number of records <= 0 in mnmsk_load().",exc_efailed);
     }
     hf.gets("reference",reference);
 
-    o2scl::nucmass_mnmsk::entry *m=new o2scl::nucmass_mnmsk::entry[nrecords];
+    buf.resize(((size_t)nrecords)*sizeof(o2scl::nucmass_mnmsk::entry));
+    o2scl::nucmass_mnmsk::entry *m=
+      (o2scl::nucmass_mnmsk::entry *)(&buf[0]);
     herr_t status=H5TBread_table
       (file,"mnmsk.o2",sizeof(o2scl::nucmass_mnmsk::entry),offset,sizes,m);
-    
-    mnmsk.set_data(nrecords,m,reference);
+    n_entries=nrecords;
     
     hf.close();
 
@@ -284,7 +553,9 @@ void o2scl_hdf::mnmsk_load(o2scl::nucmass_mnmsk &mnmsk, std::string model,
     hdf_input_n(hf,tab,name);
     hf.close();
     size_t nr=tab.get_nlines();
-    o2scl::nucmass_mnmsk::entry *m=new o2scl::nucmass_mnmsk::entry[nr];
+    buf.resize(nr*sizeof(o2scl::nucmass_mnmsk::entry));
+    o2scl::nucmass_mnmsk::entry *m=
+      (o2scl::nucmass_mnmsk::entry *)(&buf[0]);
     for(size_t j=0;j<nr;j++) {
       m[j].N=tab.get("N",j);
       m[j].Z=tab.get("Z",j);
@@ -325,33 +596,50 @@ void o2scl_hdf::mnmsk_load(o2scl::nucmass_mnmsk &mnmsk, std::string model,
       m[j].Qalpha=1.0e99;
       m[j].Talpha=1.0e99;
     }
-    string reference=((std::string)"Möller, Sierk, Ichikawa, and ")+
+    reference=((std::string)"Möller, Sierk, Ichikawa, and ")+
       "Sagawa, At. Data and Nucl. Data Tables 109 (2016), 1.";
-    mnmsk.set_data(nr,m,reference);
+    n_entries=nr;
   }
 
   return;
 }
 
-void o2scl_hdf::hfb_load(o2scl::nucmass_hfb &hfb, size_t model, 
-			 string filename) {
-    
-  if (filename.size()==0) {
-    filename=o2scl::o2scl_settings.get_data_dir()+"/nucmass";
-  }
-    
-  std::string tname;
-  if (model==2) {
-    tname="/hfb2.o2";
-  } else if (model==8) {
-    tname="/hfb8.o2";
-  } else if (model==14) {
-    tname="/hfb14.o2";
+void o2scl_hdf::mnmsk_load(o2scl::nucmass_mnmsk &mnmsk, std::string model,
+			   string filename) {
+
+  if (model=="mnmsk97") {
+    if (filename.size()==0) {
+      filename=o2scl::o2scl_settings.get_data_dir()+"/nucmass/mnmsk.o2";
+    }
   } else {
-    tname="/hfb14_v0.o2";
+    model="msis16";
+    if (filename.size()==0) {
+      filename=o2scl::o2scl_settings.get_data_dir()+"/nucmass/msis16.o2";
+    }
   }
-  filename=filename+tname;
-  
+
+  filename=nucmass_registry::canonical_path(filename);
+  std::string key=((std::string)"mnmsk ")+model+" "+filename;
+  nucmass_registry::load_funct lf=
+    std::bind(mnmsk_read,model,filename,std::placeholders::_1,
+              std::placeholders::_2,std::placeholders::_3);
+  nucmass_registry::table_ptr tp=nucmass_registry::instance().get
+    (key,filename,sizeof(o2scl::nucmass_mnmsk::entry),lf);
+
+  // The shared tables are read-only, but nucmass_mnmsk never
+  // modifies its entries
+  mnmsk.set_data(tp->n,(o2scl::nucmass_mnmsk::entry *)tp->data,
+                 tp->reference,tp);
+
+  return;
+}
+
+/** \brief Read an HFB table from an HDF5 file into \c buf
+ */
+static void hfb_read(std::string filename, std::string tname,
+                     std::vector<char> &buf, size_t &n_entries,
+                     std::string &reference) {
+
   size_t offset[12]={HOFFSET(o2scl::nucmass_hfb::entry,N),
 		     HOFFSET(o2scl::nucmass_hfb::entry,Z),
 		     HOFFSET(o2scl::nucmass_hfb::entry,A),
@@ -385,51 +673,63 @@ void o2scl_hdf::hfb_load(o2scl::nucmass_hfb &hfb, size_t model,
   hid_t file=hf.get_current_id();
 
   int nrecords;
-  std::string reference;
   hf.geti("nrecords",nrecords);
   if (nrecords<=0) {
     O2SCL_ERR("Number of records <= 0 in hfb_load().",exc_efailed);
   }
   hf.gets("reference",reference);
 
-  o2scl::nucmass_hfb::entry *m=new o2scl::nucmass_hfb::entry[nrecords];
+  buf.resize(((size_t)nrecords)*sizeof(o2scl::nucmass_hfb::entry));
+  o2scl::nucmass_hfb::entry *m=(o2scl::nucmass_hfb::entry *)(&buf[0]);
   herr_t status=H5TBread_table
     (file,tname.c_str(),sizeof(o2scl::nucmass_hfb::entry),offset,sizes,m);
-    
-  hfb.set_data(nrecords,m,reference);
+  n_entries=nrecords;
     
   hf.close();
 
   return;
 }
 
-void o2scl_hdf::hfb_sp_load(nucmass_hfb_sp &hfb, size_t model,
-			    string filename) {
-  
+void o2scl_hdf::hfb_load(o2scl::nucmass_hfb &hfb, size_t model, 
+			 string filename) {
+    
   if (filename.size()==0) {
     filename=o2scl::o2scl_settings.get_data_dir()+"/nucmass";
   }
     
   std::string tname;
-  if (model==17) {
-    tname="/hfb17.o2";
-  } else if (model==21) {
-    tname="/hfb21.o2";
-  } else if (model==22) {
-    tname="/hfb22.o2";
-  } else if (model==23) {
-    tname="/hfb23.o2";
-  } else if (model==24) {
-    tname="/hfb24.o2";
-  } else if (model==25) {
-    tname="/hfb25.o2";
-  } else if (model==26) {
-    tname="/hfb26.o2";
+  if (model==2) {
+    tname="/hfb2.o2";
+  } else if (model==8) {
+    tname="/hfb8.o2";
+  } else if (model==14) {
+    tname="/hfb14.o2";
   } else {
-    tname="/hfb27.o2";
+    tname="/hfb14_v0.o2";
   }
-  filename=filename+tname;
-  
+  filename=nucmass_registry::canonical_path(filename+tname);
+
+  std::string key=((std::string)"hfb ")+filename;
+  nucmass_registry::load_funct lf=
+    std::bind(hfb_read,filename,tname,std::placeholders::_1,
+              std::placeholders::_2,std::placeholders::_3);
+  nucmass_registry::table_ptr tp=nucmass_registry::instance().get
+    (key,filename,sizeof(o2scl::nucmass_hfb::entry),lf);
+
+  // The shared tables are read-only, but nucmass_hfb never
+  // modifies its entries
+  hfb.set_data(tp->n,(o2scl::nucmass_hfb::entry *)tp->data,
+               tp->reference,tp);
+
+  return;
+}
+
+/** \brief Read an HFB table from an HDF5 file into \c buf
+ */
+static void hfb_sp_read(std::string filename, std::string tname,
+                        std::vector<char> &buf, size_t &n_entries,
+                        std::string &reference) {
+
   size_t offset[16]={HOFFSET(o2scl::nucmass_hfb_sp::entry,N),
 		     HOFFSET(o2scl::nucmass_hfb_sp::entry,Z),
 		     HOFFSET(o2scl::nucmass_hfb_sp::entry,A),
@@ -471,21 +771,62 @@ void o2scl_hdf::hfb_sp_load(nucmass_hfb_sp &hfb, size_t model,
   hid_t file=hf.get_current_id();
 
   int nrecords;
-  std::string reference;
   hf.geti("nrecords",nrecords);
   if (nrecords<=0) {
     O2SCL_ERR("Number of records <= 0 in ame_load().",exc_efailed);
   }
   hf.gets("reference",reference);
 
-  o2scl::nucmass_hfb_sp::entry *m=new o2scl::nucmass_hfb_sp::entry[nrecords];
+  buf.resize(((size_t)nrecords)*sizeof(o2scl::nucmass_hfb_sp::entry));
+  o2scl::nucmass_hfb_sp::entry *m=
+    (o2scl::nucmass_hfb_sp::entry *)(&buf[0]);
   herr_t status=H5TBread_table
     (file,tname.c_str(),sizeof(o2scl::nucmass_hfb_sp::entry),offset,sizes,m);
-    
-  hfb.set_data(nrecords,m,reference);
+  n_entries=nrecords;
     
   hf.close();
 
   return;
 }
 
+void o2scl_hdf::hfb_sp_load(nucmass_hfb_sp &hfb, size_t model,
+			    string filename) {
+  
+  if (filename.size()==0) {
+    filename=o2scl::o2scl_settings.get_data_dir()+"/nucmass";
+  }
+    
+  std::string tname;
+  if (model==17) {
+    tname="/hfb17.o2";
+  } else if (model==21) {
+    tname="/hfb21.o2";
+  } else if (model==22) {
+    tname="/hfb22.o2";
+  } else if (model==23) {
+    tname="/hfb23.o2";
+  } else if (model==24) {
+    tname="/hfb24.o2";
+  } else if (model==25) {
+    tname="/hfb25.o2";
+  } else if (model==26) {
+    tname="/hfb26.o2";
+  } else {
+    tname="/hfb27.o2";
+  }
+  filename=nucmass_registry::canonical_path(filename+tname);
+
+  std::string key=((std::string)"hfb_sp ")+filename;
+  nucmass_registry::load_funct lf=
+    std::bind(hfb_sp_read,filename,tname,std::placeholders::_1,
+              std::placeholders::_2,std::placeholders::_3);
+  nucmass_registry::table_ptr tp=nucmass_registry::instance().get
+    (key,filename,sizeof(o2scl::nucmass_hfb_sp::entry),lf);
+
+  // The shared tables are read-only, but nucmass_hfb_sp never
+  // modifies its entries
+  hfb.set_data(tp->n,(o2scl::nucmass_hfb_sp::entry *)tp->data,
+               tp->reference,tp);
+
+  return;
+}
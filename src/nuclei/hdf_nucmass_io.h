@@ -41,6 +41,13 @@
 #endif
 #endif
 
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <functional>
+
 #include <o2scl/constants.h>
 #include <o2scl/hdf_file.h>
 #include <o2scl/lib_settings.h>
@@ -51,6 +58,177 @@
 
 namespace o2scl_hdf {
 
+  /** \brief A read-only nuclear mass table shared between objects
+
+      Objects of this type are created by \ref nucmass_registry
+      and hold the entries for one table, either in memory or
+      in a memory-mapped binary cache file.
+
+      \note This class is in the o2scl_hdf namespace,
+      see \ref hdf_nucmass_io.h .
+  */
+  class nucmass_shared_table {
+
+  public:
+
+    nucmass_shared_table();
+
+    ~nucmass_shared_table();
+    
+    /// The number of entries
+    size_t n;
+
+    /// The size of each entry in bytes
+    size_t entry_size;
+    
+    /// The reference for the original data
+    std::string reference;
+
+    /// Pointer to the first entry
+    const void *data;
+
+    /// If true, the entries are memory-mapped from the binary cache
+    bool mapped;
+    
+  protected:
+
+    friend class nucmass_registry;
+    
+    /// Storage for the entries if they are not memory-mapped
+    std::vector<char> buf;
+
+    /// The start of the memory-mapped region
+    void *map_base;
+
+    /// The length of the memory-mapped region
+    size_t map_len;
+    
+  private:
+
+    nucmass_shared_table(const nucmass_shared_table &);
+    nucmass_shared_table& operator=(const nucmass_shared_table &);
+    
+  };
+  
+  /** \brief Process-wide registry of nuclear mass tables
+
+      The functions \ref ame_load_ext(), \ref ame_load(), \ref
+      mnmsk_load(), \ref hfb_load() and \ref hfb_sp_load() obtain
+      their data from this registry. Each table is read from its HDF5
+      file the first time it is requested, and all of the objects
+      which load the same table then share one read-only copy of the
+      entries. The registry is protected by a mutex, so tables can be
+      loaded from several threads.
+
+      If the cache directory is not empty, a table which is read from
+      an HDF5 file is also written in a compact binary form to the
+      cache directory. In later runs, the table is mapped into memory
+      from the cache file with <tt>mmap()</tt> instead of being read
+      from the HDF5 file. The cache file records the canonical path,
+      the size, and the modification time of the HDF5 file, and it is
+      ignored if any of these differ from those of the current HDF5
+      file or if it was written with a different entry size. The
+      loading functions use the canonical path of the HDF5 file in
+      the table name, so a relative path refers to the same table
+      from any working directory.
+      The cache directory is taken from the environment variable
+      <tt>O2SCL_NUCMASS_CACHE</tt>, if it is present, and is otherwise
+      empty.
+
+      \note The cache files are written in the native binary format 
+      and should not be shared between different architectures.
+
+      \note This class is in the o2scl_hdf namespace,
+      see \ref hdf_nucmass_io.h .
+  */
+  class nucmass_registry {
+    
+  public:
+
+    /// A pointer to a shared table
+    typedef std::shared_ptr<const nucmass_shared_table> table_ptr;
+
+    /** \brief The type of the function which reads a table
+
+        The function resizes the first argument and fills it with the
+        entries, and sets the number of entries and the reference.
+    */
+    typedef std::function<void(std::vector<char> &,size_t &,
+                               std::string &)> load_funct;
+    
+    /// Return the registry for this process
+    static nucmass_registry &instance();
+
+    /** \brief Return the table with name \c key, loading it if
+        necessary
+
+        If the table is not in the registry and not in the cache, it
+        is read with \c load. The string \c source is the HDF5 file
+        used to determine whether or not the cache file is up to
+        date, and \c entry_size is the size of each entry in bytes.
+    */
+    table_ptr get(std::string key, std::string source, size_t entry_size,
+                  load_funct &load);
+
+    /** \brief Set the binary cache directory (an empty string
+        disables the cache)
+    */
+    void set_cache_dir(std::string dir);
+
+    /// Get the binary cache directory
+    std::string get_cache_dir();
+
+    /// The name of the cache file for the table with name \c key
+    std::string cache_file(std::string key);
+
+    /** \brief Return the canonical absolute path of \c fname, or
+        \c fname itself if the file does not exist
+    */
+    static std::string canonical_path(std::string fname);
+
+    /// The number of tables in the registry
+    size_t n_tables();
+    
+    /** \brief Remove all tables from the registry
+
+        Objects which already use a table keep their copy, which is
+        freed when the last of them is destroyed.
+    */
+    void clear();
+
+    /// Verbosity parameter (default 0)
+    int verbose;
+    
+  protected:
+
+    nucmass_registry();
+
+    /// Mutex protecting the registry
+    std::mutex mtx;
+
+    /// The tables, indexed by name
+    std::map<std::string,table_ptr> tables;
+
+    /// The binary cache directory
+    std::string cache_dir;
+
+    /** \brief Read table \c key from the cache, returning an
+        empty pointer if the cache file is missing or out of date
+    */
+    table_ptr cache_read(std::string key, std::string source,
+                         size_t entry_size);
+
+    /// Write table \c key read from file \c source to the cache
+    void cache_write(std::string key, std::string source,
+                     const nucmass_shared_table &t);
+    
+  private:
+
+    nucmass_registry(const nucmass_registry &);
+    nucmass_registry& operator=(const nucmass_registry &);
+    
+  };
+
   /** \brief Read data for \ref o2scl::nucmass_ame from an HDF table
       specified in a file
       
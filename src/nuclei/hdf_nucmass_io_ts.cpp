@@ -21,13 +21,44 @@
   ───────────────────────────────────────────────────────────────────
 */
 #include <iostream>
+#include <fstream>
+#include <cstdio>
 #include <o2scl/test_mgr.h>
 #include <o2scl/nucmass.h>
 #include <o2scl/hdf_nucmass_io.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <utime.h>
+#endif
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_const;
+using namespace o2scl_hdf;
+
+/// The number of calls to test_load()
+static size_t n_test_load=0;
+
+/** \brief A load function for the registry which records
+    the number of times it is called
+*/
+void test_load(vector<char> &buf, size_t &n, string &ref) {
+  n_test_load++;
+  n=4;
+  buf.resize(n*sizeof(double));
+  double *d=(double *)(&buf[0]);
+  for(size_t i=0;i<n;i++) d[i]=i;
+  ref="test";
+  return;
+}
+
+/// Write \c len bytes to the file \c fname
+void write_source(string fname, size_t len) {
+  ofstream fout(fname.c_str());
+  for(size_t i=0;i<len;i++) fout << 'x';
+  fout.close();
+  return;
+}
 
 int main(void) {
 
@@ -36,6 +67,119 @@ int main(void) {
 
   cout.setf(ios::scientific);
 
+  nucmass_registry &reg=nucmass_registry::instance();
+  reg.set_cache_dir("");
+  reg.clear();
+
+  string fn="../../data/o2scl/nucmass/ame12.o2";
+  
+  // Two objects loading the same table share one copy
+  nucmass_ame ame, ame2, ame3;
+  ame_load_ext(ame,fn,"ame12.o2");
+  ame_load_ext(ame2,fn,"ame12.o2");
+  t.test_gen(reg.n_tables()==1,"shared table");
+  t.test_gen(ame.get_nentries()==ame2.get_nentries(),"shared n");
+  t.test_rel(ame.mass_excess(82,126),ame2.mass_excess(82,126),1.0e-15,
+             "shared mass excess");
+
+  // The experimental-only table is a different table
+  ame_load_ext(ame3,fn,"ame12.o2",true);
+  t.test_gen(reg.n_tables()==2,"exp table");
+  t.test_gen(ame3.get_nentries()<ame.get_nentries(),"exp n");
+
+  // Write the tables to a binary cache and read them back
+  reg.set_cache_dir(".");
+  reg.clear();
+  {
+    nucmass_ame ame4;
+    ame_load_ext(ame4,fn,"ame12.o2");
+  }
+  string cf=reg.cache_file(((string)"ame ")+
+                           nucmass_registry::canonical_path(fn)+
+                           " ame12.o2");
+  ifstream fin(cf.c_str());
+  t.test_gen(fin.good(),"cache file written");
+  fin.close();
+  
+  reg.clear();
+  nucmass_ame ame5;
+  ame_load_ext(ame5,fn,"ame12.o2");
+  t.test_gen(ame5.get_nentries()==ame.get_nentries(),"cache n");
+
+  // A different path to the same file gives the same table
+  nucmass_ame ame6;
+  ame_load_ext(ame6,"../../data/o2scl/nucmass/../nucmass/ame12.o2",
+               "ame12.o2");
+  t.test_gen(reg.n_tables()==1,"canonical path");
+  t.test_gen(ame5.reference==ame.reference,"cache reference");
+  for(int Z=8;Z<=100;Z+=23) {
+    for(int N=Z;N<=Z+40;N+=7) {
+      if (ame.is_included(Z,N)) {
+        t.test_gen(ame5.is_included(Z,N),"cache included");
+        t.test_rel(ame5.mass_excess(Z,N),ame.mass_excess(Z,N),1.0e-15,
+                   "cache mass excess");
+        t.test_gen(string(ame5.get_ZN(Z,N).el)==
+                   string(ame.get_ZN(Z,N).el),"cache element");
+      }
+    }
+  }
+
+  // The FRDM table through the cache
+  nucmass_mnmsk mm, mm2;
+  mnmsk_load(mm,"mnmsk97","../../data/o2scl/nucmass/mnmsk.o2");
+  reg.clear();
+  mnmsk_load(mm2,"mnmsk97","../../data/o2scl/nucmass/mnmsk.o2");
+  t.test_gen(mm2.get_nentries()==mm.get_nentries(),"mnmsk cache n");
+  t.test_rel(mm2.mass_excess(82,126),mm.mass_excess(82,126),1.0e-15,
+             "mnmsk cache mass excess");
+  std::remove(reg.cache_file("mnmsk mnmsk97 "+
+                             nucmass_registry::canonical_path
+                             ("../../data/o2scl/nucmass/mnmsk.o2")).c_str());
+  std::remove(cf.c_str());
+
+#if defined(__unix__) || defined(__APPLE__)
+  
+  // The cache file is not used if the source file is replaced by
+  // a file with a different size or an older modification time
+  {
+    string src="hdf_nucmass_io_ts.tmp";
+    string key="test "+nucmass_registry::canonical_path(src);
+    nucmass_registry::load_funct lf=test_load;
+    write_source(src,10);
+    reg.clear();
+    reg.get(key,src,sizeof(double),lf);
+    t.test_gen(n_test_load==1,"registry load");
+    reg.clear();
+    nucmass_registry::table_ptr tp=reg.get(key,src,sizeof(double),lf);
+    t.test_gen(n_test_load==1 && tp->mapped,"registry cache");
+    t.test_rel(((const double *)tp->data)[3],3.0,1.0e-15,
+               "registry cache data");
+
+    write_source(src,11);
+    reg.clear();
+    reg.get(key,src,sizeof(double),lf);
+    t.test_gen(n_test_load==2,"registry size changed");
+
+    struct utimbuf ut;
+    ut.actime=1000000000;
+    ut.modtime=1000000000;
+    utime(src.c_str(),&ut);
+    reg.clear();
+    reg.get(key,src,sizeof(double),lf);
+    t.test_gen(n_test_load==3,"registry older source");
+    reg.clear();
+    reg.get(key,src,sizeof(double),lf);
+    t.test_gen(n_test_load==3,"registry cache after older source");
+    
+    reg.clear();
+    std::remove(reg.cache_file(key).c_str());
+    std::remove(src.c_str());
+  }
+
+#endif
+  
+  reg.set_cache_dir("");
+
   t.report();
   return 0;
 }
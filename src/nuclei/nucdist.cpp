@@ -22,6 +22,11 @@
 */
 #include <o2scl/nucdist.h>
 
+#include <cmath>
+#include <limits>
+
+#include <o2scl/constants.h>
+
 using namespace std;
 using namespace o2scl;
 
@@ -109,3 +114,96 @@ void o2scl::nucdist_pair_set(vector<nucleus> &dist, nucmass &nm,
   return;
 }
 
+
+void nucdist_soa::resize(size_t n) {
+  Z.resize(n);
+  N.resize(n);
+  be.resize(n);
+  g.resize(n);
+  m.resize(n);
+  lpre.resize(n);
+  ld.resize(n);
+  return;
+}
+
+void nucdist_soa::set(const std::vector<nucleus> &dist) {
+  resize(dist.size());
+  for(size_t i=0;i<dist.size();i++) {
+    set_nucleus(i,dist[i].Z,dist[i].N,dist[i].be,dist[i].g,dist[i].m);
+  }
+  return;
+}
+
+bool nucdist_soa::same(const std::vector<nucleus> &dist) const {
+  if (dist.size()!=size()) return false;
+  for(size_t i=0;i<dist.size();i++) {
+    if (Z[i]!=dist[i].Z || N[i]!=dist[i].N || be[i]!=dist[i].be ||
+        g[i]!=dist[i].g || m[i]!=dist[i].m) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void nucdist_soa::set_nucleus(size_t i, double Zi, double Ni, double bei,
+                              double gi, double mi) {
+  Z[i]=Zi;
+  N[i]=Ni;
+  be[i]=bei;
+  g[i]=gi;
+  m[i]=mi;
+  if (gi>0.0 && mi>0.0) {
+    lpre[i]=log(gi)+1.5*log(mi/2.0/o2scl_const::pi);
+  } else {
+    lpre[i]=-std::numeric_limits<double>::infinity();
+  }
+  return;
+}
+
+void nucdist_soa::log_dens(double mun, double mup, double T) {
+
+  size_t n=size();
+  double lT=1.5*log(T);
+  double min_arg=std::numeric_limits<double>::min_exponent10;
+  double neg_inf=-std::numeric_limits<double>::infinity();
+  const double *pZ=Z.data(), *pN=N.data(), *pbe=be.data();
+  const double *plpre=lpre.data();
+  double *pld=ld.data();
+  
+  for(size_t i=0;i<n;i++) {
+    double arg=(pN[i]*mun+pZ[i]*mup-pbe[i])/T;
+    pld[i]=(arg<min_arg) ? neg_inf : plpre[i]+lT+arg;
+  }
+  
+  return;
+}
+
+void nucdist_soa::log_sums(double mun, double mup, double T,
+                           double &ln_nn, double &ln_np) {
+  log_dens(mun,mup,T);
+  ln_nn=log_sum_exp(size(),ld.data(),N.data());
+  ln_np=log_sum_exp(size(),ld.data(),Z.data());
+  return;
+}
+
+double nucdist_soa::log_sum_exp(size_t n, const double *x,
+                                const double *w) {
+
+  double neg_inf=-std::numeric_limits<double>::infinity();
+  
+  // Find the largest term with a nonzero weight
+  double x_max=neg_inf;
+  for(size_t i=0;i<n;i++) {
+    double xi=(w[i]>0.0) ? x[i] : neg_inf;
+    x_max=(xi>x_max) ? xi : x_max;
+  }
+  if (!std::isfinite(x_max)) return x_max;
+
+  double sum=0.0;
+  for(size_t i=0;i<n;i++) {
+    // Terms with a zero weight may be larger than x_max
+    if (w[i]>0.0) sum+=w[i]*exp(x[i]-x_max);
+  }
+  
+  return x_max+log(sum);
+}
@@ -24,10 +24,12 @@
 #define O2SCL_NUCDIST_H
 
 /** \file nucdist.h
-    \brief File defining \ref o2scl::nucdist_set().
+    \brief File defining \ref o2scl::nucdist_set() and
+    \ref o2scl::nucdist_soa
 */
 
 #include <iostream>
+#include <vector>
 #include <o2scl/nucleus.h>
 #include <o2scl/nucmass.h>
 
@@ -58,6 +60,103 @@ namespace o2scl {
                         nucmass &nm2, std::string expr="1", int maxA=400,
                         bool include_neutron=false);
 
+  /** \brief A structure-of-arrays copy of a distribution of nuclei
+      for fast Boltzmann sums
+
+      This class stores the proton and neutron numbers, the binding
+      energies, the spin degeneracies, and the masses of a
+      distribution of nuclei in contiguous arrays so that the
+      classical number densities
+      \f[
+      n_i = g_i \left(\frac{m_i T}{2 \pi}\right)^{3/2}
+      \exp \left[ \frac{N_i \mu_n + Z_i \mu_p - B_i}{T} \right]
+      \f]
+      (with \f$ B_i \f$ the binding energy, the same convention as
+      \ref o2scl::eos_nse) can be computed in simple loops which
+      the compiler can vectorize. The logarithm of the
+      density-independent prefactor \f$ g_i (m_i/2\pi)^{3/2} \f$ is
+      computed once in \ref set() or \ref set_nucleus(), so an
+      evaluation costs one exponential per nucleus.
+
+      The sums \f$ \sum_i N_i n_i \f$ and \f$ \sum_i Z_i n_i \f$
+      are computed with a log-sum-exp reduction in \ref log_sums(),
+      so they are accurate even when the individual densities
+      would overflow or underflow.
+
+      As in \ref o2scl::classical_thermo::calc_mu(), nuclei with
+      \f$ \mu_i/T \f$ smaller than the minimum base 10 exponent are
+      given zero density. Nuclei can be removed from the sums by
+      giving them a zero degeneracy.
+  */
+  class nucdist_soa {
+
+  public:
+
+    /// \name Distribution data
+    //@{
+    /// Proton numbers
+    std::vector<double> Z;
+    /// Neutron numbers
+    std::vector<double> N;
+    /// Binding energies
+    std::vector<double> be;
+    /// Spin degeneracies
+    std::vector<double> g;
+    /// Masses
+    std::vector<double> m;
+    /// The logarithm of \f$ g_i (m_i/2\pi)^{3/2} \f$
+    std::vector<double> lpre;
+    /// The logarithm of the number densities from \ref log_dens()
+    std::vector<double> ld;
+    //@}
+
+    /// Return the number of nuclei
+    size_t size() const {
+      return Z.size();
+    }
+
+    /// Resize all of the arrays
+    void resize(size_t n);
+
+    /** \brief Copy the distribution in \c dist (resizing 
+        if necessary)
+    */
+    void set(const std::vector<nucleus> &dist);
+
+    /** \brief Return true if the proton and neutron numbers, binding
+        energies, degeneracies, and masses all match those in \c dist
+    */
+    bool same(const std::vector<nucleus> &dist) const;
+
+    /** \brief Set the properties of the nucleus with index \c i
+     */
+    void set_nucleus(size_t i, double Zi, double Ni, double bei,
+                     double gi, double mi);
+
+    /** \brief Compute the logarithms of the number densities
+        for the chemical potentials \c mun and \c mup and the 
+        temperature \c T, storing them in \ref ld
+    */
+    void log_dens(double mun, double mup, double T);
+
+    /** \brief Compute the logarithms of the neutron and proton number
+        densities bound in nuclei, \f$ \ln \sum_i N_i n_i \f$ and 
+        \f$ \ln \sum_i Z_i n_i \f$
+
+        This function calls \ref log_dens() and then reduces the
+        result with \ref log_sum_exp(). If the sums are zero, the
+        results are \f$ -\infty \f$.
+    */
+    void log_sums(double mun, double mup, double T,
+                  double &ln_nn, double &ln_np);
+
+    /** \brief Compute \f$ \ln \sum_i w_i e^{x_i} \f$ for 
+        nonnegative weights \c w
+    */
+    static double log_sum_exp(size_t n, const double *x, const double *w);
+    
+  };
+  
 }
 
 #endif
@@ -23,6 +23,7 @@
 #include <o2scl/constants.h>
 #include <o2scl/nucdist.h>
 #include <o2scl/hdf_nucmass_io.h>
+#include <o2scl/classical.h>
 #include <o2scl/test_mgr.h>
 
 using namespace std;
@@ -63,6 +64,49 @@ int main(void) {
   vector<nucleus> fdx;
   nucdist_set(fdx,mth,"1",400,true);
 
+  {
+    // Compare the structure-of-arrays densities with
+    // classical_thermo
+    vector<nucleus> dist;
+    nucdist_set(dist,ame12,"Z>=20 && Z<=40");
+    
+    nucdist_soa soa;
+    soa.set(dist);
+    t.test_gen(soa.same(dist),"soa same");
+
+    double T=1.0/hc_mev_fm, mun=-9.0/hc_mev_fm, mup=-10.0/hc_mev_fm;
+    classical_thermo cla;
+    double nn=0.0, np=0.0;
+    soa.log_dens(mun,mup,T);
+    for(size_t i=0;i<dist.size();i++) {
+      dist[i].mu=mun*dist[i].N+mup*dist[i].Z-dist[i].be;
+      dist[i].inc_rest_mass=false;
+      dist[i].non_interacting=true;
+      cla.calc_mu(dist[i],T);
+      if (i%50==0) {
+        t.test_rel(exp(soa.ld[i]),dist[i].n,1.0e-12,"soa density");
+      }
+      nn+=dist[i].N*dist[i].n;
+      np+=dist[i].Z*dist[i].n;
+    }
+    double ln_nn, ln_np;
+    soa.log_sums(mun,mup,T,ln_nn,ln_np);
+    t.test_rel(ln_nn,log(nn),1.0e-12,"soa log_sums n");
+    t.test_rel(ln_np,log(np),1.0e-12,"soa log_sums p");
+
+    // The log-sum-exp reduction remains finite when the
+    // individual terms overflow
+    double x[2]={800.0,801.0}, w[2]={1.0,2.0};
+    t.test_rel(nucdist_soa::log_sum_exp(2,x,w),
+               801.0+log(2.0+exp(-1.0)),1.0e-14,"log_sum_exp");
+
+    // Terms with zero weight are ignored, even when they are much
+    // larger than the others (e.g. free neutrons in the proton sum)
+    double x3[3]={800.0,2000.0,801.0}, w3[3]={1.0,0.0,2.0};
+    t.test_rel(nucdist_soa::log_sum_exp(3,x3,w3),
+               801.0+log(2.0+exp(-1.0)),1.0e-14,"log_sum_exp zero w");
+  }
+
   t.report();
   return 0;
 }
@@ -343,6 +343,26 @@ int nucmass::get_nucleus(int Z, int N, nucleus &n) {
   return 0;
 }
 
+void nucmass_table::index_alloc(int Zmax, int Nmax) {
+  index_ZN.clear();
+  if (Zmax<0 || Nmax<0) {
+    index_nN=0;
+    return;
+  }
+  index_nN=Nmax+1;
+  index_ZN.resize(((size_t)(Zmax+1))*index_nN,-1);
+  return;
+}
+
+void nucmass_table::index_add(int Z, int N, size_t i) {
+  if (Z<0 || N<0 || N>=index_nN) return;
+  size_t k=((size_t)Z)*index_nN+N;
+  if (k<index_ZN.size() && index_ZN[k]<0) {
+    index_ZN[k]=((int)i);
+  }
+  return;
+}
+
 double nucmass_table::mass_excess_d(double Z, double N) {
   int Z1=(int)Z;
   int N1=(int)N;
@@ -355,6 +375,20 @@ double nucmass_table::mass_excess_d(double Z, double N) {
   return mz1+(Z-Z1)*(mz2-mz1);
 }
 
+void nucmass_fit_base::mass_excess_vec(const std::vector<int> &Z,
+                                       const std::vector<int> &N,
+                                       std::vector<double> &mex) {
+  if (Z.size()!=N.size()) {
+    O2SCL_ERR2("Sizes of Z and N do not match in ",
+               "nucmass_fit_base::mass_excess_vec().",exc_einval);
+  }
+  mex.resize(Z.size());
+  for(size_t i=0;i<Z.size();i++) {
+    mex[i]=mass_excess(Z[i],N[i]);
+  }
+  return;
+}
+
 nucmass_semi_empirical::nucmass_semi_empirical() {
   B=-16.0;
   Ss=18.0;
@@ -375,6 +409,24 @@ double nucmass_semi_empirical::mass_excess_d(double Z, double N) {
   return ret;
 }
 
+void nucmass_semi_empirical::mass_excess_vec(const std::vector<int> &Z,
+                                             const std::vector<int> &N,
+                                             std::vector<double> &mex) {
+  if (Z.size()!=N.size()) {
+    O2SCL_ERR2("Sizes of Z and N do not match in ",
+               "nucmass_semi_empirical::mass_excess_vec().",exc_einval);
+  }
+  size_t n=Z.size();
+  mex.resize(n);
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for
+#endif
+  for(size_t i=0;i<n;i++) {
+    mex[i]=nucmass_semi_empirical::mass_excess_d(Z[i],N[i]);
+  }
+  return;
+}
+
 int nucmass_semi_empirical::fit_fun(size_t nv, const ubvector &x) {
   B=-x[0]; Sv=x[1]; Ss=x[2]; Ec=x[3]; Epair=x[4];
   return 0;
@@ -29,6 +29,8 @@
 #include <cmath>
 #include <string>
 #include <map>
+#include <vector>
+#include <memory>
 
 #include <boost/numeric/ublas/vector.hpp>
 
@@ -355,16 +357,98 @@ namespace o2scl {
       Generally, descendants of this class only need to provide an
       implementation of \ref mass_excess() and possibly a version
       of \ref nucmass::is_included()
+
+      Descendants which store their entries in an array should call
+      \ref index_build() (or \ref index_alloc() and \ref
+      index_add()) after the data is loaded. The function \ref
+      index_find() then gives the position of a nucleus in the
+      table in constant time using a dense array over \f$ Z \f$
+      and \f$ N \f$. Lookups with \ref index_find() do not modify
+      the object, so they can be used simultaneously from several
+      threads.
       
   */
   class nucmass_table : public nucmass {
 
   protected:
+
+    /// \name Dense (Z,N) index [protected]
+    //@{
+    /// The number of neutron numbers in each row of \ref index_ZN
+    int index_nN;
+
+    /** \brief The position in the table of the nucleus with 
+        proton number \c Z and neutron number \c N stored in 
+        <tt>index_ZN[Z*index_nN+N]</tt>, or -1 if the nucleus
+        is not in the table
+    */
+    std::vector<int> index_ZN;
+
+    /** \brief Clear the index
+     */
+    void index_clear() {
+      index_ZN.clear();
+      index_nN=0;
+      return;
+    }
+    
+    /** \brief Clear the index and allocate space for all nuclei
+        with \f$ Z \leq \f$ \c Zmax and \f$ N \leq \f$ \c Nmax
+    */
+    void index_alloc(int Zmax, int Nmax);
+
+    /** \brief Record that the nucleus with proton number \c Z and
+        neutron number \c N is at position \c i in the table
+
+        If the nucleus has already been added, the first position
+        is kept. Nuclei with negative \c Z or \c N or outside the
+        range given to \ref index_alloc() are ignored.
+    */
+    void index_add(int Z, int N, size_t i);
+
+    /** \brief Build the index from the first \c n_entries entries 
+        of \c m, each of which has integer members \c Z and \c N
+    */
+    template<class vec_t> void index_build(size_t n_entries,
+                                           const vec_t &m) {
+      int Zmax=0, Nmax=0;
+      for(size_t i=0;i<n_entries;i++) {
+        if (m[i].Z>Zmax) Zmax=m[i].Z;
+        if (m[i].N>Nmax) Nmax=m[i].N;
+      }
+      index_alloc(Zmax,Nmax);
+      for(size_t i=0;i<n_entries;i++) {
+        index_add(m[i].Z,m[i].N,i);
+      }
+      return;
+    }
+    //@}
+
+    /** \brief The owner of the table data if it is shared with 
+        other objects (empty if this object owns the data)
+
+        This is set when the data is obtained from \ref
+        o2scl_hdf::nucmass_registry, and the data is then not 
+        deleted by the destructor.
+    */
+    std::shared_ptr<const void> shared_data;
     
   public:
 
     nucmass_table() {
       n=0;
+      index_nN=0;
+    }
+
+    /** \brief Return the position of the nucleus with proton number
+        \c Z and neutron number \c N in the table, or -1 if it
+        is not present
+    */
+    int index_find(int Z, int N) const {
+      if (Z<0 || N<0 || N>=index_nN) return -1;
+      size_t k=((size_t)Z)*index_nN+N;
+      if (k>=index_ZN.size()) return -1;
+      return index_ZN[k];
     }
     
     /// The number of entries
@@ -415,6 +499,21 @@ namespace o2scl {
     /// Fill array with guess from present values for fitting [abstract]
     virtual int guess_fun(size_t nv, ubvector &x)=0;
 
+    /** \brief Compute the mass excesses (in MeV) of the nuclei with
+        proton numbers \c Z and neutron numbers \c N, storing the
+        results in \c mex
+
+        The vector \c mex is resized to the size of \c Z. The default
+        implementation calls \ref mass_excess() for each nucleus.
+        Descendants override this function to evaluate the nuclei in
+        parallel when OpenMP is enabled. A class which modifies the
+        mass formula of a parent class which overrides this function
+        should also override it.
+    */
+    virtual void mass_excess_vec(const std::vector<int> &Z,
+                                 const std::vector<int> &N,
+                                 std::vector<double> &mex);
+    
   };
   
   /** \brief Semi-empirical mass formula
@@ -485,6 +584,11 @@ namespace o2scl {
       return mass_excess_d(Z,N);
     }
 
+    /// Compute the mass excesses of several nuclei in parallel
+    virtual void mass_excess_vec(const std::vector<int> &Z,
+                                 const std::vector<int> &N,
+                                 std::vector<double> &mex);
+    
     /// Fix parameters from an array for fitting
     virtual int fit_fun(size_t nv, const ubvector &x);
 
@@ -277,9 +277,6 @@ namespace o2scl {
      */
     entry *mass;
     
-    /// The last table index for caching
-    int last;
-    
   };
 
   /** \brief 
@@ -608,9 +605,6 @@ namespace o2scl {
      */
     std::vector<entry> mass;
     
-    /// The last table index for caching
-    int last;
-    
   };
   
 }
@@ -141,6 +141,7 @@ namespace o2scl {
 	drip_th=dm.drip_th;
 	th=dm.th;
 	
+	dist.clear();
 	for (size_t i=0;i<dm.dist.size();i++) {
 	  dist.push_back(dm.dist[i]);
 	}
@@ -30,130 +30,20 @@ using namespace o2scl;
 using namespace o2scl_const;
 
 bool nucmass_dz_table::is_included(int l_Z, int l_N) {
-  int lo=0, hi=0, mid=last;
-  int l_A=l_Z+l_N;
-  
-  // binary search for the correct A first
-  if (data.get("A",mid)!=l_A) {
-    if (data.get("A",mid)>l_A) {
-      lo=0;
-      hi=mid;
-    } else {
-      lo=mid;
-      hi=n-1;
-    }
-    while (hi>lo+1) {
-      int mp=(lo+hi)/2;
-      if (data.get("A",mp)<l_A) {
-	lo=mp;
-      } else {
-	hi=mp;
-      }
-    }
-    mid=lo;
-    if (data.get("A",mid)!=l_A) mid=hi;
-    if (data.get("A",mid)!=l_A) {
-      return false;
-    }
-  }
-
-  // The cached point was the right one, so we're done
-  if (data.get("Z",mid)==l_Z) {
-    return true;
-  }
-
-  // Now look for the right N among all the Z's. There are a
-  // few gaps in the table which don't have all the Z's for
-  // a fixed A, i.e. Z=25, A=104 is not in the 1995 table,
-  // so we need to implement this counter mechanism to ensure
-  // the loop doesn't go on forever.
-  
-  int counter=0;
-  while (data.get("A",mid)==l_A) {
-
-    //cout << "3." << " " << mid << " " << l_A << " " << l_Z << " "
-    //<< data.get("Z",mid) << " " << data.get("A",mid) << endl;
-    
-    if (data.get("Z",mid)==l_Z) {
-      return true;
-    } else if (data.get("Z",mid)>l_Z) {
-      if (mid==0) return false;
-      mid--;
-    } else {
-      if (mid==((int)(n-1))) return false;
-      mid++;
-    }
-    counter++;
-    if (counter>200) {
-      return false;
-    }
-  }
-  
-  return false;
+  return (index_find(l_Z,l_N)>=0);
 }
 
 double nucmass_dz_table::mass_excess(int l_Z, int l_N) {
-  int lo=0, hi=0, mid=last;
-  int l_A=l_Z+l_N;
-  
-  // binary search for the correct A first
-  if (data.get("A",mid)!=l_A) {
-    if (data.get("A",mid)>l_A) {
-      lo=0;
-      hi=mid;
-    } else {
-      lo=mid;
-      hi=n-1;
-    }
-    while (hi>lo+1) {
-      int mp=(lo+hi)/2;
-      if (data.get("A",mp)<l_A) {
-	lo=mp;
-      } else {
-	hi=mp;
-      }
-    }
-    mid=lo;
-    if (data.get("A",mid)!=l_A) mid=hi;
-    if (data.get("A",mid)!=l_A) {
-      O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-		 " not found in nucmass_dz_table::mass_excess().").c_str(),
-		exc_enotfound);
-    }
-  }
-  
-  // The cached point was the right one, so we're done
-  if (data.get("Z",mid)==l_Z) {
-    return data.get("ME",mid);
-  }
-  
-  // Now look for the right N among all the Z's
-  while (data.get("A",mid)==l_A) {
-    
-    if (data.get("Z",mid)==l_Z) {
-      return data.get("ME",mid);
-    } else if (data.get("Z",mid)>l_Z) {
-      if (mid==0) {
-	O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-		   " not found in nucmass_dz_table::mass_excess().").c_str(),
-		  exc_enotfound);
-      }
-      mid--;
-    } else {
-      if (mid==((int)(n-1))) {
-	O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-		   " not found in nucmass_dz_table::mass_excess().").c_str(),
-		  exc_enotfound);
-      }
-      mid++;
-    }
+
+  int ix=index_find(l_Z,l_N);
+  if (ix<0) {
+    O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
+	       " not found in nucmass_dz_table::mass_excess().").c_str(),
+	      exc_enotfound);
+    return 0.0;
   }
   
-  O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-	     " not found in nucmass_dz_table::mass_excess().").c_str(),
-	    exc_enotfound);
-  
-  return 0.0;
+  return data.get("ME",ix);
 }
 
 nucmass_dz_table::nucmass_dz_table(std::string model, bool external) {
@@ -182,7 +72,21 @@ nucmass_dz_table::nucmass_dz_table(std::string model, bool external) {
   hf.close();
   
   n=data.get_nlines();
-  last=n/2;
+
+  // Construct the (Z,N) index from the Z and A columns
+  int Zmax=0, Nmax=0;
+  for(size_t i=0;i<n;i++) {
+    int Z=((int)(data.get("Z",i)+1.0e-6));
+    int N=((int)(data.get("A",i)+1.0e-6))-Z;
+    if (Z>Zmax) Zmax=Z;
+    if (N>Nmax) Nmax=N;
+  }
+  index_alloc(Zmax,Nmax);
+  for(size_t i=0;i<n;i++) {
+    int Z=((int)(data.get("Z",i)+1.0e-6));
+    int N=((int)(data.get("A",i)+1.0e-6))-Z;
+    index_add(Z,N,i);
+  }
 }
 
 nucmass_dz_table::~nucmass_dz_table() {
@@ -467,6 +371,34 @@ double nucmass_dz_fit::mass_excess_d(double Z, double N) {
   return (binding_energy_d(Z,N)-((Z+N)*m_amu-Z*m_elec-N*m_neut-Z*m_prot));
 }
 
+void nucmass_dz_fit::mass_excess_vec(const std::vector<int> &Z,
+                                     const std::vector<int> &N,
+                                     std::vector<double> &mex) {
+  if (Z.size()!=N.size()) {
+    O2SCL_ERR2("Sizes of Z and N do not match in ",
+               "nucmass_dz_fit::mass_excess_vec().",exc_einval);
+  }
+  size_t n=Z.size();
+  mex.resize(n);
+  
+  // The mass formula stores intermediate results in class members,
+  // so each thread works with its own copy
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel
+#endif
+  {
+    nucmass_dz_fit loc(*this);
+#ifdef O2SCL_SET_OPENMP
+#pragma omp for
+#endif
+    for(size_t i=0;i<n;i++) {
+      mex[i]=loc.nucmass_dz_fit::mass_excess(Z[i],N[i]);
+    }
+  }
+  
+  return;
+}
+
 nucmass_dz_fit_33::nucmass_dz_fit_33() {
 
   // The values 8.07132 and 7.28897 are those given in
@@ -887,3 +819,31 @@ double nucmass_dz_fit_33::mass_excess(int Z, int N) {
 double nucmass_dz_fit_33::mass_excess_d(double Z, double N) {
   return (binding_energy_d(Z,N)-((Z+N)*m_amu-Z*m_elec-N*m_neut-Z*m_prot));
 }
+
+void nucmass_dz_fit_33::mass_excess_vec(const std::vector<int> &Z,
+                                        const std::vector<int> &N,
+                                        std::vector<double> &mex) {
+  if (Z.size()!=N.size()) {
+    O2SCL_ERR2("Sizes of Z and N do not match in ",
+               "nucmass_dz_fit_33::mass_excess_vec().",exc_einval);
+  }
+  size_t n=Z.size();
+  mex.resize(n);
+  
+  // The mass formula stores intermediate results in class members,
+  // so each thread works with its own copy
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel
+#endif
+  {
+    nucmass_dz_fit_33 loc(*this);
+#ifdef O2SCL_SET_OPENMP
+#pragma omp for
+#endif
+    for(size_t i=0;i<n;i++) {
+      mex[i]=loc.nucmass_dz_fit_33::mass_excess(Z[i],N[i]);
+    }
+  }
+  
+  return;
+}
@@ -76,9 +76,6 @@ namespace o2scl {
     /// Table containing the data
     table<> data;
 
-    /// The last table index for caching
-    int last;
-
   };
 
   /** \brief The 10-parameter Duflo-Zuker mass formula
@@ -217,6 +214,13 @@ namespace o2scl {
      */
     virtual double mass_excess_d(double Z, double N);
 
+    /** \brief Compute the mass excesses of several nuclei in
+        parallel, using a separate copy of this object in each thread
+    */
+    virtual void mass_excess_vec(const std::vector<int> &Z,
+                                 const std::vector<int> &N,
+                                 std::vector<double> &mex);
+
   };
 
   /** \brief The 33-parameter Duflo-Zuker mass formula
@@ -348,6 +352,13 @@ namespace o2scl {
      */
     virtual double mass_excess_d(double Z, double N);
 
+    /** \brief Compute the mass excesses of several nuclei in
+        parallel, using a separate copy of this object in each thread
+    */
+    virtual void mass_excess_vec(const std::vector<int> &Z,
+                                 const std::vector<int> &N,
+                                 std::vector<double> &mex);
+
   };
 
 }
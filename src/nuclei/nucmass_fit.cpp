@@ -24,6 +24,8 @@
 #include <config.h>
 #endif
 
+#include <map>
+
 #include <o2scl/nucmass_fit.h>
 
 using namespace std;
@@ -39,6 +41,9 @@ nucmass_fit::nucmass_fit() {
   fit_method=rms_mass_excess;
   uncs.resize(1);
   uncs[0]=1.0;
+  mm_grad=0;
+  grad_step=1.0e-6;
+  batch_ready=false;
 }
 
 double nucmass_fit::min_fun(size_t nv, const ubvector &x) {
@@ -46,12 +51,169 @@ double nucmass_fit::min_fun(size_t nv, const ubvector &x) {
   double y=0.0;
   
   nmf->fit_fun(nv,x);
+
+  if (batch_ready) return batch_eval();
   
   eval(*nmf,y);
   
   return y;
 }
 
+int nucmass_fit::grad_fun(size_t nv, ubvector &x, ubvector &g) {
+
+  ubvector xt(nv);
+  for(size_t j=0;j<nv;j++) xt[j]=x[j];
+  
+  for(size_t j=0;j<nv;j++) {
+    double h=grad_step*fabs(x[j]);
+    if (h==0.0) h=grad_step;
+    xt[j]=x[j]+h;
+    double fp=min_fun(nv,xt);
+    xt[j]=x[j]-h;
+    double fm=min_fun(nv,xt);
+    xt[j]=x[j];
+    g[j]=(fp-fm)/(2.0*h);
+  }
+
+  // Restore the parameters
+  nmf->fit_fun(nv,x);
+  
+  return 0;
+}
+
+void nucmass_fit::batch_setup() {
+
+  batch_Z.clear();
+  batch_N.clear();
+  term_type.clear();
+  term_ix.clear();
+  term_ix2.clear();
+  term_exp.clear();
+  term_unc.clear();
+
+  // The index of the first occurence of each nucleus in dist, used
+  // for the experimental separation energies
+  std::map<std::pair<int,int>,size_t> dist_ix;
+  for(size_t i=0;i<dist.size();i++) {
+    dist_ix.insert(std::make_pair(std::make_pair(dist[i].Z,dist[i].N),i));
+  }
+
+  // The index of each nucleus in batch_Z and batch_N
+  std::map<std::pair<int,int>,size_t> batch_ix;
+
+  bool sep=(fit_method==rms_me_Sn || fit_method==rms_me_Sn_S2n);
+  bool use_be=(fit_method==rms_binding_energy ||
+               fit_method==chi_squared_be);
+  bool chi2=(fit_method==chi_squared_me || fit_method==chi_squared_be);
+  size_t unc_ix=0;
+  
+  for(size_t i=0;i<dist.size();i++) {
+    int Z=dist[i].Z;
+    int N=dist[i].N;
+
+    // Mass excess and binding energy terms, in the same order as
+    // in eval()
+    if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
+      std::pair<std::map<std::pair<int,int>,size_t>::iterator,bool> it=
+        batch_ix.insert(std::make_pair(std::make_pair(Z,N),
+                                       batch_Z.size()));
+      if (it.second) {
+        batch_Z.push_back(Z);
+        batch_N.push_back(N);
+      }
+      term_ix.push_back(it.first->second);
+      term_ix2.push_back(0);
+      if (use_be) {
+        term_type.push_back(1);
+        term_exp.push_back(dist[i].be*hc_mev_fm);
+      } else {
+        term_type.push_back(0);
+        term_exp.push_back(dist[i].mex*hc_mev_fm);
+      }
+      if (chi2) {
+        if (unc_ix>=uncs.size()) unc_ix=0;
+        term_unc.push_back(uncs[unc_ix]);
+        unc_ix++;
+      } else {
+        term_unc.push_back(1.0);
+      }
+    }
+
+    // Separation energy terms
+    for(int dN=1;sep && dN<=2;dN++) {
+      if (dN==2 && fit_method!=rms_me_Sn_S2n) continue;
+      if (even_even==true || N<=dN) continue;
+      std::map<std::pair<int,int>,size_t>::iterator dit=
+        dist_ix.find(std::make_pair(Z,N-dN));
+      if (dit==dist_ix.end()) continue;
+      
+      std::pair<std::map<std::pair<int,int>,size_t>::iterator,bool> it=
+        batch_ix.insert(std::make_pair(std::make_pair(Z,N),
+                                       batch_Z.size()));
+      if (it.second) {
+        batch_Z.push_back(Z);
+        batch_N.push_back(N);
+      }
+      std::pair<std::map<std::pair<int,int>,size_t>::iterator,bool> it2=
+        batch_ix.insert(std::make_pair(std::make_pair(Z,N-dN),
+                                       batch_Z.size()));
+      if (it2.second) {
+        batch_Z.push_back(Z);
+        batch_N.push_back(N-dN);
+      }
+      term_type.push_back(dN+1);
+      term_ix.push_back(it.first->second);
+      term_ix2.push_back(it2.first->second);
+      term_exp.push_back((dist[dit->second].be-dist[i].be)*hc_mev_fm);
+      term_unc.push_back(1.0);
+    }
+  }
+
+  batch_mex.resize(batch_Z.size());
+  batch_ready=true;
+  
+  return;
+}
+
+double nucmass_fit::batch_eval() {
+
+  nmf->mass_excess_vec(batch_Z,batch_N,batch_mex);
+
+  double fmin=0.0;
+  for(size_t k=0;k<term_type.size();k++) {
+    size_t i=term_ix[k];
+    double mod;
+    if (term_type[k]==0) {
+      mod=batch_mex[i];
+    } else {
+      // Convert the mass excesses to binding energies
+      int Z=batch_Z[i];
+      int N=batch_N[i];
+      mod=batch_mex[i]+((Z+N)*nmf->m_amu-Z*nmf->m_elec-N*nmf->m_neut-
+                        Z*nmf->m_prot);
+      if (term_type[k]>=2) {
+        size_t i2=term_ix2[k];
+        int N2=batch_N[i2];
+        mod=batch_mex[i2]+((Z+N2)*nmf->m_amu-Z*nmf->m_elec-
+                           N2*nmf->m_neut-Z*nmf->m_prot)-mod;
+      }
+    }
+    fmin+=pow((term_exp[k]-mod)/term_unc[k],2.0);
+    if (!std::isfinite(fmin)) {
+      std::string s=((std::string)"Non-finite value for nucleus with Z=")+
+        itos(batch_Z[i])+" and N="+itos(batch_N[i])+
+        " in nucmass_fit::batch_eval().";
+      O2SCL_ERR(s.c_str(),exc_efailed);
+    }
+  }
+
+  if (fit_method!=chi_squared_me && fit_method!=chi_squared_be) {
+    fmin=sqrt(fmin/term_type.size());
+  }
+  
+  return fmin;
+}
+
 double nucmass_fit::fit_covar_fun(size_t np, const ubvector &p,
 				  double x, const std::vector<size_t> &Zlist,
 				  const std::vector<size_t> &Nlist) {
@@ -142,9 +304,23 @@ void nucmass_fit::fit(nucmass_fit_base &n, double &fmin) {
 	      (&nucmass_fit::min_fun),
 	      this,std::placeholders::_1,std::placeholders::_2);
   
-  mm->mmin(nv,mx,fmin,mfm);
+  // Construct the list of nuclei so that min_fun() can compute
+  // all of the masses in one call to mass_excess_vec()
+  batch_setup();
+
+  if (mm_grad!=0) {
+    grad_funct gfm=
+      std::bind(std::mem_fn<int(size_t,ubvector &,ubvector &)>
+                (&nucmass_fit::grad_fun),this,std::placeholders::_1,
+                std::placeholders::_2,std::placeholders::_3);
+    mm_grad->mmin_de(nv,mx,fmin,mfm,gfm);
+  } else {
+    mm->mmin(nv,mx,fmin,mfm);
+  }
   fmin=mfm(nv,mx);
 
+  batch_ready=false;
+
   return;
 }
 
@@ -124,6 +124,7 @@ namespace o2scl {
     /// Change the minimizer for use in the fit
     void set_mmin(mmin_base<> &umm) {
       mm=&umm;
+      mm_grad=0;
       return;
     }
     
@@ -172,17 +173,104 @@ namespace o2scl {
                       ubvector &qual, int min_iso=-8, int max_iso=60);
 
     /** \brief The function to minimize
+
+        During a call to \ref fit() the fit quality is computed from
+        a single call to \ref nucmass_fit_base::mass_excess_vec() over
+        all of the nuclei needed by the fit, rather than by calling
+        \ref eval().
      */
     virtual double min_fun(size_t nv, const ubvector &x);
 
+    /// \name Gradient of the fit quality
+    //@{
+    /** \brief Use a minimizer which requires the gradient
+        of \ref min_fun() in the fit
+
+        After this is called, \ref fit() calls mmin_base::mmin_de()
+        on \c umm with the gradient computed by \ref grad_fun(),
+        e.g. with \ref o2scl::mmin_bfgs2 or \ref o2scl::mmin_conf .
+        A subsequent call to \ref set_mmin() returns to a minimizer
+        which does not use the gradient.
+    */
+    void set_mmin_grad(mmin_base<multi_funct,grad_funct> &umm) {
+      mm_grad=&umm;
+      return;
+    }
+    
+    /** \brief Relative step size for the gradient (default
+        \f$ 10^{-6} \f$)
+    */
+    double grad_step;
+
+    /** \brief Compute the gradient of \ref min_fun() with respect
+        to the fit parameters in \c g
+
+        The gradient is computed with central differences. Each of
+        the \f$ 2 n_v \f$ function evaluations uses one call to
+        \ref nucmass_fit_base::mass_excess_vec(). The fit parameters
+        are restored to \c x before this function returns.
+    */
+    virtual int grad_fun(size_t nv, ubvector &x, ubvector &g);
+    //@}
+
   protected:
 
+    /// \name Batch evaluation of the fit quality [protected]
+    //@{
+    /// If true, \ref min_fun() uses \ref batch_eval()
+    bool batch_ready;
+    
+    /// Proton numbers of the nuclei to evaluate
+    std::vector<int> batch_Z;
+    
+    /// Neutron numbers of the nuclei to evaluate
+    std::vector<int> batch_N;
+    
+    /// Mass excesses from the model (in MeV)
+    std::vector<double> batch_mex;
+    
+    /** \brief The type of each term: 0 for the mass excess, 1 for
+        the binding energy, 2 for \f$ S_n \f$ and 3 for \f$ S_{2n}
+        \f$
+    */
+    std::vector<int> term_type;
+    
+    /// Index in \ref batch_Z of the nucleus for each term
+    std::vector<size_t> term_ix;
+    
+    /** \brief Index in \ref batch_Z of the nucleus with fewer
+        neutrons for separation energy terms
+    */
+    std::vector<size_t> term_ix2;
+    
+    /// Experimental value for each term (in MeV)
+    std::vector<double> term_exp;
+    
+    /// Uncertainty for each term (in MeV)
+    std::vector<double> term_unc;
+    
+    /** \brief Construct the list of nuclei and terms from \ref dist
+        and the current fit settings
+    */
+    void batch_setup();
+
+    /** \brief Compute the fit quality for the current parameters
+        from the terms set in \ref batch_setup()
+    */
+    double batch_eval();
+    //@}
+
     /// Uncertainties
     ubvector uncs;
     
     /// The pointer to the minimizer
     mmin_base<> *mm;
     
+    /** \brief The pointer to the minimizer which uses the gradient
+        (default 0)
+    */
+    mmin_base<multi_funct,grad_funct> *mm_grad;
+    
     /** \brief The nuclear mass formula to fit to
 
         This pointer is set by fit() and eval().
@@ -23,6 +23,9 @@
 #include <iostream>
 #include <o2scl/test_mgr.h>
 #include <o2scl/nucmass_fit.h>
+#include <o2scl/nucmass_frdm.h>
+#include <o2scl/nucmass_dz.h>
+#include <o2scl/mmin_bfgs2.h>
 #include <o2scl/hdf_nucmass_io.h>
 
 using namespace std;
@@ -118,6 +121,63 @@ int main(void) {
 
   cout << "covariance matrix2: " << endl;
   matrix_out(cout,covar);
+
+  {
+    // Compare the batched mass excesses with the scalar versions
+    vector<int> Zl, Nl;
+    vector<double> mex;
+    vector<nucleus> ndist;
+    nucdist_set(ndist,ame,"Z>=8 && N>=8");
+    for(size_t i=0;i<ndist.size();i++) {
+      Zl.push_back(ndist[i].Z);
+      Nl.push_back(ndist[i].N);
+    }
+    nucmass_frdm frdm;
+    nucmass_dz_fit dzf;
+    sem.mass_excess_vec(Zl,Nl,mex);
+    t.test_gen(mex.size()==Zl.size(),"mass_excess_vec size");
+    for(size_t i=0;i<Zl.size();i+=97) {
+      t.test_rel(mex[i],sem.mass_excess(Zl[i],Nl[i]),1.0e-14,
+                 "mass_excess_vec sem");
+    }
+    frdm.mass_excess_vec(Zl,Nl,mex);
+    for(size_t i=0;i<Zl.size();i+=97) {
+      t.test_rel(mex[i],frdm.mass_excess(Zl[i],Nl[i]),1.0e-14,
+                 "mass_excess_vec frdm");
+    }
+    dzf.mass_excess_vec(Zl,Nl,mex);
+    for(size_t i=0;i<Zl.size();i+=97) {
+      t.test_rel(mex[i],dzf.mass_excess(Zl[i],Nl[i]),1.0e-14,
+                 "mass_excess_vec dz_fit");
+    }
+  }
+
+  {
+    // The fit quality from the batched evaluation in fit() should
+    // match eval() for each fit method
+    nucdist_set(mf.dist,ame);
+    for(int fm=0;fm<=5;fm++) {
+      nucmass_semi_empirical sem2;
+      mf.fit_method=fm;
+      double res2;
+      mf.fit(sem2,res);
+      mf.eval(sem2,res2);
+      t.test_rel(res,res2,1.0e-10,"batch eval");
+    }
+
+    // Fit with a gradient minimizer
+    nucmass_semi_empirical sem2, sem3;
+    mf.fit_method=nucmass_fit::rms_mass_excess;
+    mf.fit(sem2,res);
+    mmin_bfgs2<> bfgs;
+    bfgs.err_nonconv=false;
+    mf.set_mmin_grad(bfgs);
+    double res2;
+    mf.fit(sem3,res2);
+    cout << "simplex: " << res << " bfgs: " << res2 << endl;
+    t.test_rel(res2,res,1.0e-2,"gradient fit");
+    mf.set_mmin(mf.def_mmin);
+  }
   
   
   t.report();
@@ -61,6 +61,34 @@ nucmass_frdm::nucmass_frdm() {
 
 }
 
+void nucmass_frdm::mass_excess_vec(const std::vector<int> &Z,
+                                   const std::vector<int> &N,
+                                   std::vector<double> &mex) {
+  if (Z.size()!=N.size()) {
+    O2SCL_ERR2("Sizes of Z and N do not match in ",
+               "nucmass_frdm::mass_excess_vec().",exc_einval);
+  }
+  size_t n=Z.size();
+  mex.resize(n);
+  
+  // The mass formula stores intermediate results in class members,
+  // so each thread works with its own copy
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel
+#endif
+  {
+    nucmass_frdm loc(*this);
+#ifdef O2SCL_SET_OPENMP
+#pragma omp for
+#endif
+    for(size_t i=0;i<n;i++) {
+      mex[i]=loc.nucmass_frdm::mass_excess_d(Z[i],N[i]);
+    }
+  }
+  
+  return;
+}
+
 double nucmass_frdm::mass_excess_d(double Z, double N) {
   double ret;
       
@@ -307,17 +335,19 @@ nucmass_mnmsk::nucmass_mnmsk() {
 }
 
 nucmass_mnmsk::~nucmass_mnmsk() {
-  if (n>0) {
+  if (n>0 && !shared_data) {
     delete[] mass;
   }
 }
 
-int nucmass_mnmsk::set_data(int n_mass, nucmass_mnmsk::entry *m, 
-			    std::string ref) {
+int nucmass_mnmsk::set_data(int n_mass, nucmass_mnmsk::entry *m,
+                            std::string ref,
+                            std::shared_ptr<const void> owner) {
   n=n_mass;
   mass=m;
   reference=ref;
-  last=n/2;
+  shared_data=owner;
+  index_build(n,mass);
   return 0;
 }
 
@@ -329,109 +359,15 @@ double nucmass_mnmsk::mass_excess(int Z, int N) {
 }
 
 bool nucmass_mnmsk::is_included(int l_Z, int l_N) {
-  int lo=0, hi=0, mid=last;
-
-  // binary search for the correct Z first
-  if (mass[mid].Z!=l_Z) {
-    if (mass[mid].Z>l_Z) {
-      lo=0;
-      hi=mid;
-    } else {
-      lo=mid;
-      hi=n-1;
-    }
-    while (hi>lo+1) {
-      int mp=(lo+hi)/2;
-      if (mass[mp].Z<l_Z) {
-	lo=mp;
-      } else {
-	hi=mp;
-      }
-    }
-    mid=lo;
-    if (mass[mid].Z!=l_Z) mid=hi;
-    if (mass[mid].Z!=l_Z) {
-      return false;
-    }
-  }
-
-  // The cached point was the right one, so we're done
-  if (mass[mid].N==l_N) {
-    return true;
-  }
-
-
-  // Now look for the right N among all the Z's
-  while (mass[mid].Z==l_Z) {
-    if (mass[mid].N==l_N) {
-      return true;
-    } else if (mass[mid].N>l_N) {
-      if (mid==0) return false;
-      mid--;
-    } else {
-      if (mid==((int)n-1)) return false;
-      mid++;
-    }
-  }
-  
-  return false;
+  return (index_find(l_Z,l_N)>=0);
 }
 
 bool nucmass_mnmsk_exp::is_included(int l_Z, int l_N) {
-  int lo=0, hi=0, mid=last;
-
-  // binary search for the correct Z first
-  if (mass[mid].Z!=l_Z) {
-    if (mass[mid].Z>l_Z) {
-      lo=0;
-      hi=mid;
-    } else {
-      lo=mid;
-      hi=n-1;
-    }
-    while (hi>lo+1) {
-      int mp=(lo+hi)/2;
-      if (mass[mp].Z<l_Z) {
-	lo=mp;
-      } else {
-	hi=mp;
-      }
-    }
-    mid=lo;
-    if (mass[mid].Z!=l_Z) mid=hi;
-    if (mass[mid].Z!=l_Z) {
-      return false;
-    }
-  }
-
-  // The cached point was the right one, so we're done
-  if (mass[mid].N==l_N) {
-    if (fabs(mass[mid].Mexp)>1.0e-20 &&
-	fabs(mass[mid].Mexp)<1.0e90) {
-      return true;
-    } else {
-      return false;
-    }
-  }
-
-  // Now look for the right N among all the Z's
-  while (mass[mid].Z==l_Z) {
-    if (mass[mid].N==l_N) {
-      if (fabs(mass[mid].Mexp)>1.0e-20 &&
-	  fabs(mass[mid].Mexp)<1.0e90) {
-	return true;
-      } else {
-	return false;
-      }
-    } else if (mass[mid].N>l_N) {
-      if (mid==0) return false;
-      mid--;
-    } else {
-      if (mid==((int)n-1)) return false;
-      mid++;
-    }
+  int ix=index_find(l_Z,l_N);
+  if (ix<0) return false;
+  if (fabs(mass[ix].Mexp)>1.0e-20 && fabs(mass[ix].Mexp)<1.0e90) {
+    return true;
   }
-  
   return false;
 }
 
@@ -449,79 +385,19 @@ nucmass_mnmsk::entry nucmass_mnmsk::get_ZN(int l_Z, int l_N) {
               o2scl::exc_efailed);
   }
   
-  int lo=0, hi=0, mid=last;
-  
   nucmass_mnmsk::entry ret;
   ret.Z=0;
   ret.A=0;
   ret.N=0;
 
-  if (mid>((int)n)-1) {
-    O2SCL_ERR("Indexing problem in nucmass_mnmsk::get_ZN().",
-	      o2scl::exc_esanity);
-  }
-  
-  // binary search for the correct Z first
-  if (mass[mid].Z!=l_Z) {
-    if (mass[mid].Z>l_Z) {
-      lo=0;
-      hi=mid;
-    } else {
-      lo=mid;
-      hi=n-1;
-    }
-    while (hi>lo+1) {
-      int mp=(lo+hi)/2;
-      if (mass[mp].Z<l_Z) {
-	lo=mp;
-      } else {
-	hi=mp;
-      }
-    }
-    mid=lo;
-    if (mass[mid].Z!=l_Z) mid=hi;
-    if (mass[mid].Z!=l_Z) {
-      O2SCL_ERR((((string)"Nuclei with Z=")+itos(l_Z) 
-		 +" not found in nucmass_mnmsk::get_ZN().").c_str(),
-		exc_enotfound);
-    }
-  }
-
-  // The cached point was the right one, so we're done
-  if (mass[mid].N==l_N) {
-    ret=mass[mid];
-    last=mid;
+  int ix=index_find(l_Z,l_N);
+  if (ix<0) {
+    O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)
+               +" not found in nucmass_mnmsk::get_ZN().").c_str(),exc_enotfound);
     return ret;
   }
-
-  // Now look for the right N among all the Z's
-  while (mass[mid].Z==l_Z) {
-    if (mass[mid].N==l_N) {
-      ret=mass[mid];
-      last=mid;
-      return ret;
-    } else if (mass[mid].N>l_N) {
-      if (mid==0) {
-	O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)
-		   +" not found in nucmass_mnmsk::get_ZN().").c_str(),
-		  exc_enotfound);
-	return ret;
-      }
-      mid--;
-    } else {
-      if (mid==((int)n)-1) {
-	O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)
-		   +" not found in nucmass_mnmsk::get_ZN().").c_str(),
-		  exc_enotfound);
-	return ret;
-      }
-      mid++;
-    }
-  }
   
-  O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)
-	     +" not found in nucmass_mnmsk::get_ZN().").c_str(),exc_enotfound);
-  return ret;
+  return mass[ix];
 }
 
 void nucmass_patch::load(bool include_fit) {
@@ -187,6 +187,13 @@ namespace o2scl {
       return mass_excess_d(Z,N);
     }
 
+    /** \brief Compute the mass excesses of several nuclei in
+        parallel, using a separate copy of this object in each thread
+    */
+    virtual void mass_excess_vec(const std::vector<int> &Z,
+                                 const std::vector<int> &N,
+                                 std::vector<double> &mex);
+
     /// Fix parameters from an array for fitting
     virtual int fit_fun(size_t nv, const ubvector &x);
 
@@ -463,18 +470,19 @@ namespace o2scl {
     
     /** \brief Set data
 
-        This function is used by the HDF I/O routines.
+        This function is used by the HDF I/O routines. If \c owner
+        is not empty, then the array \c m is owned by \c owner and
+        is not deleted by this object.
     */
-    int set_data(int n_mass, nucmass_mnmsk::entry *m, std::string ref);
+    int set_data(int n_mass, nucmass_mnmsk::entry *m, std::string ref,
+                 std::shared_ptr<const void> owner=
+                 std::shared_ptr<const void>());
 
   protected:
     
     /// The array containing the mass data of length ame::n
     nucmass_mnmsk::entry *mass;
     
-    /// The last table index for caching
-    int last;
-    
   };
 
   /** \brief The experimental values from the Moller et al.
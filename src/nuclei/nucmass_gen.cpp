@@ -41,6 +41,7 @@ int nucmass_gen::load_be(std::string fname, std::string be_col,
   if (n>0) {
     data.clear();
     n=0;
+    index_clear();
   }
   
   std::string dir=o2scl::o2scl_settings.get_data_dir();
@@ -91,51 +92,51 @@ int nucmass_gen::load_be(std::string fname, std::string be_col,
     data.set("mex",i,mex);
   }
   mex_col_ix=data.lookup_column("mex");
-  
-  last=n/2;
+
+  // Construct the (Z,N) index
+  int Zmax=0, Nmax=0;
+  for(size_t i=0;i<n;i++) {
+    int Z=((int)(data.get("Z",i)+1.0e-6));
+    int N=((int)(data.get("N",i)+1.0e-6));
+    if (Z>Zmax) Zmax=Z;
+    if (N>Nmax) Nmax=N;
+  }
+  index_alloc(Zmax,Nmax);
+  for(size_t i=0;i<n;i++) {
+    index_add(((int)(data.get("Z",i)+1.0e-6)),
+              ((int)(data.get("N",i)+1.0e-6)),i);
+  }
 
   return 0;
 }
 
 bool nucmass_gen::is_included(int l_Z, int l_N) {
-
-  for(size_t i=0;i<n;i++) {
-    if (fabs(data.get("Z",i)-l_Z)<1.0e-12 &&
-	fabs(data.get("N",i)-l_N)<1.0e-12) {
-      return true;
-    }
-  }
-
-  return false;
+  return (index_find(l_Z,l_N)>=0);
 }
 
 double nucmass_gen::mass_excess(int l_Z, int l_N) {
-  for(size_t i=0;i<n;i++) {
-    if (fabs(data.get("Z",i)-l_Z)<1.0e-12 &&
-	fabs(data.get("N",i)-l_N)<1.0e-12) {
-      return data.get(mex_col_ix,i);
-    }
+
+  int ix=index_find(l_Z,l_N);
+  if (ix<0) {
+    O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
+	       " not found in nucmass_gen::mass_excess().").c_str(),
+	      exc_enotfound);
+    return 0.0;
   }
   
-  O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-	     " not found in nucmass_gen::mass_excess().").c_str(),
-	    exc_enotfound);
-  
-  return 0.0;
+  return data.get(mex_col_ix,ix);
 }
 
 double nucmass_gen::get_string(int l_Z, int l_N, std::string column) {
-  for(size_t i=0;i<n;i++) {
-    if (fabs(data.get("Z",i)-l_Z)<1.0e-12 &&
-	fabs(data.get("N",i)-l_N)<1.0e-12) {
-      return data.get(column,i);
-    }
+
+  int ix=index_find(l_Z,l_N);
+  if (ix<0) {
+    O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
+	       " not found in nucmass_gen::get_string().").c_str(),
+	      exc_enotfound);
+    return 0.0;
   }
   
-  O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-	     " not found in nucmass_gen::mass_excess().").c_str(),
-	    exc_enotfound);
-  
-  return 0.0;
+  return data.get(column,ix);
 }
 
@@ -77,9 +77,6 @@ namespace o2scl {
     /// Column which refers to the mass excess
     size_t mex_col_ix;
     
-    /// The last table index for caching
-    int last;
-    
   };
   
 }
@@ -126,18 +126,19 @@ namespace o2scl {
 
     /** \brief Set data
         
-        This function is used by the HDF I/O routines.
+        This function is used by the HDF I/O routines. If \c owner
+        is not empty, then the array \c m is owned by \c owner and
+        is not deleted by this object.
     */
-    int set_data(int n_mass, nucmass_hfb::entry *m, std::string ref);
+    int set_data(int n_mass, nucmass_hfb::entry *m, std::string ref,
+                 std::shared_ptr<const void> owner=
+                 std::shared_ptr<const void>());
 
   protected:
     
     /// The array containing the mass data of length ame::n
     nucmass_hfb::entry *mass;
     
-    /// The last table index for caching
-    int last;
-    
   };
 
   /** \brief HFB Mass formula with spin and parity information
@@ -230,17 +231,18 @@ namespace o2scl {
 
     /** \brief Set data
         
-        This function is used by the HDF I/O routines.
+        This function is used by the HDF I/O routines. If \c owner
+        is not empty, then the array \c m is owned by \c owner and
+        is not deleted by this object.
     */
-    int set_data(int n_mass, nucmass_hfb_sp::entry *m, std::string ref);
+    int set_data(int n_mass, nucmass_hfb_sp::entry *m, std::string ref,
+                 std::shared_ptr<const void> owner=
+                 std::shared_ptr<const void>());
 
   protected:
     
     /// The array containing the mass data of length ame::n
     nucmass_hfb_sp::entry *mass;
-
-    /// The last table index for caching
-    int last;
     
   };
   
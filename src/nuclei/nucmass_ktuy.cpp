@@ -74,7 +74,7 @@ int nucmass_ktuy::load(std::string model, bool external) {
     mass[i]=kme;
   }
 
-  last=n/2;
+  index_build(n,mass);
 
   return 0;
 }
@@ -86,121 +86,25 @@ nucmass_ktuy::~nucmass_ktuy() {
 }
 
 bool nucmass_ktuy::is_included(int l_Z, int l_N) {
-  int lo=0, hi=0, mid=last;
-
-  // binary search for the correct Z first
-  if (mass[mid].Z!=l_Z) {
-    if (mass[mid].Z>l_Z) {
-      lo=0;
-      hi=mid;
-    } else {
-      lo=mid;
-      hi=n-1;
-    }
-    while (hi>lo+1) {
-      int mp=(lo+hi)/2;
-      if (mass[mp].Z<l_Z) {
-	lo=mp;
-      } else {
-	hi=mp;
-      }
-    }
-    mid=lo;
-    if (mass[mid].Z!=l_Z) mid=hi;
-    if (mass[mid].Z!=l_Z) {
-      return false;
-    }
-  }
-
-  // The cached point was the right one, so we're done
-  if (mass[mid].N==l_N) {
-    return true;
-  }
-
-  int it=0;
-
-  // Now look for the right N among all the Z's
-  while (mass[mid].Z==l_Z) {
-
-    // This hack is necessary because some nuclei are missing from
-    // some of the KTUY tables
-    if (it>14 && mid!=0 && mass[mid].Z==mass[mid-1].Z && 
-	mass[mid].N!=mass[mid-1].N+1) {
-      return false;
-    }
-    if (mass[mid].N==l_N) {
-      return true;
-    } else if (mass[mid].N>l_N) {
-      if (mid==0) return false;
-      mid--;
-    } else {
-      if (mid==((int)n-1)) return false;
-      mid++;
-    }
-
-    it++;
-  }
-  
-  return false;
+  return (index_find(l_Z,l_N)>=0);
 }
 
 nucmass_ktuy::entry nucmass_ktuy::get_ZN(int l_Z, int l_N) {
-  int lo=0, hi=0, mid=last;
 
   nucmass_ktuy::entry ret;
   ret.Z=0;
   ret.A=0;
   ret.N=0;
-  
-  // binary search for the correct Z first
-  if (mass[mid].Z!=l_Z) {
-    if (mass[mid].Z>l_Z) {
-      lo=0;
-      hi=mid;
-    } else {
-      lo=mid;
-      hi=n-1;
-    }
-    while (hi>lo+1) {
-      int mp=(lo+hi)/2;
-      if (mass[mp].Z<l_Z) {
-	lo=mp;
-      } else {
-	hi=mp;
-      }
-    }
-    mid=lo;
-    if (mass[mid].Z!=l_Z) mid=hi;
-    if (mass[mid].Z!=l_Z) {
-      O2SCL_ERR((((string)"Nuclei with Z=")+itos(l_Z) 
-		 +" not found in nucmass_ktuy::get_ZN().").c_str(),
-		exc_enotfound);
-    }
-  }
 
-  // The cached point was the right one, so we're done
-  if (mass[mid].N==l_N) {
-    ret=mass[mid];
-    last=mid;
+  int ix=index_find(l_Z,l_N);
+  if (ix<0) {
+    O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)
+               +" not found in nucmass_ktuy::get_ZN().").c_str(),
+              exc_enotfound);
     return ret;
   }
-
-  // Now look for the right N among all the Z's
-  while (mass[mid].Z==l_Z) {
-    if (mass[mid].N==l_N) {
-      ret=mass[mid];
-      last=mid;
-      return ret;
-    } else if (mass[mid].N>l_N) {
-      mid--;
-    } else {
-      mid++;
-    }
-  }
   
-  O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)
-	     +" not found in nucmass_ktuy::get_ZN().").c_str(),exc_enotfound);
-  return ret;
+  return mass[ix];
 }
 
 double nucmass_ktuy::mass_excess(int Z, int N) {
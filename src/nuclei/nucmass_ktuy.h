@@ -114,9 +114,6 @@ namespace o2scl {
     /// The array containing the mass data of length ame::n
     entry *mass;
     
-    /// The last table index for caching
-    int last;
-    
   };
   
 }
@@ -245,6 +245,20 @@ int main(void) {
 	       "ptr mex");
   }
 
+  // Test the (Z,N) index: every entry of each table is found by
+  // is_included() and nuclei outside the tables are not
+  for(size_t i=0;i<27;i++) {
+    size_t count=0;
+    for(int Z=0;Z<=150;Z++) {
+      for(int N=0;N<=350;N++) {
+        if (nmd[i]->is_included(Z,N)) count++;
+      }
+    }
+    t.test_gen(count==nmd[i]->get_nentries(),"index count");
+    t.test_gen(nmd[i]->is_included(-1,10)==false,"index negative");
+    t.test_gen(nmd[i]->is_included(400,600)==false,"index range");
+  }
+  
   // Test size of ame95rmd
   
   t.test_gen(ame95rmd.get_nentries()==2931,"ame.n");
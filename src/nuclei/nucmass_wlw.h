@@ -106,9 +106,6 @@ namespace o2scl {
 
     /// The array containing the mass data of length n
     entry *mass;
-
-    /// The last table index for caching
-    int last;
     
   };
   
@@ -23,6 +23,9 @@
 #include <o2scl/part_funcs.h>
 #include <o2scl/nucdist.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace std;
 using namespace o2scl;
 using namespace o2scl_hdf;
@@ -33,6 +36,202 @@ part_funcs::part_funcs() : cu(o2scl_settings.get_convert_units()) {
   rtk_beta=-0.06571;
   rtk_gamma=0.04884;
   spin_deg_mode=0;
+  cache_method=cache_few78;
+  cache_Zmin=0;
+  cache_Nmin=0;
+  cache_nN=0;
+}
+
+void part_funcs::cache_clear() {
+  cache_index.clear();
+  cache_Z.clear();
+  cache_N.clear();
+  cache_T.clear();
+  cache_lpf.clear();
+  cache_dlpf.clear();
+  cache_Zmin=0;
+  cache_Nmin=0;
+  cache_nN=0;
+  return;
+}
+
+void part_funcs::cache_set_dist(const std::vector<nucleus> &dist,
+                                int method) {
+
+  if (method<cache_few78 || method>cache_ghk08) {
+    O2SCL_ERR2("Invalid method in ",
+               "part_funcs::cache_set_dist().",o2scl::exc_einval);
+  }
+  
+  cache_clear();
+  cache_method=method;
+  if (dist.size()==0) return;
+
+  int Zmax=dist[0].Z, Nmax=dist[0].N;
+  cache_Zmin=dist[0].Z;
+  cache_Nmin=dist[0].N;
+  for(size_t i=1;i<dist.size();i++) {
+    if (dist[i].Z<cache_Zmin) cache_Zmin=dist[i].Z;
+    if (dist[i].N<cache_Nmin) cache_Nmin=dist[i].N;
+    if (dist[i].Z>Zmax) Zmax=dist[i].Z;
+    if (dist[i].N>Nmax) Nmax=dist[i].N;
+  }
+  cache_nN=Nmax-cache_Nmin+1;
+  cache_index.resize(((size_t)(Zmax-cache_Zmin+1))*cache_nN,-1);
+
+  // Store each nucleus only once, even if it appears more
+  // than once in the distribution
+  for(size_t i=0;i<dist.size();i++) {
+    size_t k=((size_t)(dist[i].Z-cache_Zmin))*cache_nN+
+      (dist[i].N-cache_Nmin);
+    if (cache_index[k]<0) {
+      cache_index[k]=((int)cache_Z.size());
+      cache_Z.push_back(dist[i].Z);
+      cache_N.push_back(dist[i].N);
+    }
+  }
+  
+  return;
+}
+
+size_t part_funcs::cache_add_temp(double T_K) {
+
+  if (!(T_K>0.0)) {
+    O2SCL_ERR2("Temperature not positive in ",
+               "part_funcs::cache_add_temp().",o2scl::exc_einval);
+  }
+  
+  std::vector<double>::iterator it=std::lower_bound(cache_T.begin(),
+                                                    cache_T.end(),T_K);
+  if (it!=cache_T.end() && *it==T_K) return 0;
+  size_t jT=it-cache_T.begin();
+
+  size_t n=cache_Z.size(), n_missing=0;
+  std::vector<double> lpf(n), dlpf(n);
+  
+  // The partition functions are computed serially since the
+  // integrator used in shen10() is shared
+  for(size_t i=0;i<n;i++) {
+    double pf=0.0, TdpfdT=0.0;
+    int ret=1;
+    switch (cache_method) {
+    case cache_few78:
+      ret=few78(cache_Z[i],cache_N[i],T_K,pf,TdpfdT);
+      break;
+    case cache_rtk97:
+      ret=rtk97(cache_Z[i],cache_N[i],T_K,pf,TdpfdT);
+      break;
+    case cache_rt00:
+      ret=rt00(cache_Z[i],cache_N[i],T_K,pf,TdpfdT);
+      break;
+    case cache_r03:
+      ret=r03(cache_Z[i],cache_N[i],T_K,pf,TdpfdT);
+      break;
+    default:
+      ret=ghk08(cache_Z[i],cache_N[i],T_K,pf,TdpfdT);
+      break;
+    }
+    if (ret==0 && pf>0.0 && std::isfinite(pf) && std::isfinite(TdpfdT)) {
+      lpf[i]=log(pf);
+      dlpf[i]=TdpfdT/pf;
+    } else {
+      lpf[i]=std::numeric_limits<double>::quiet_NaN();
+      dlpf[i]=std::numeric_limits<double>::quiet_NaN();
+      n_missing++;
+    }
+  }
+
+  cache_T.insert(cache_T.begin()+jT,T_K);
+  cache_lpf.insert(cache_lpf.begin()+jT,lpf);
+  cache_dlpf.insert(cache_dlpf.begin()+jT,dlpf);
+  
+  return n_missing;
+}
+
+int part_funcs::cache_find(int Z, int N) const {
+  if (Z<cache_Zmin || N<cache_Nmin || N-cache_Nmin>=cache_nN) return -1;
+  size_t k=((size_t)(Z-cache_Zmin))*cache_nN+(N-cache_Nmin);
+  if (k>=cache_index.size()) return -1;
+  return cache_index[k];
+}
+
+int part_funcs::cache_interp(size_t ix, size_t jT, double T_K,
+                             double &pf, double &TdpfdT) const {
+
+  // Exact match with a cached temperature
+  if (cache_T[jT]==T_K) {
+    double lpf=cache_lpf[jT][ix];
+    if (!std::isfinite(lpf)) return 1;
+    pf=exp(lpf);
+    TdpfdT=pf*cache_dlpf[jT][ix];
+    return 0;
+  }
+
+  double y0=cache_lpf[jT][ix], y1=cache_lpf[jT+1][ix];
+  if (!std::isfinite(y0) || !std::isfinite(y1)) return 1;
+  
+  // Cubic Hermite interpolation of ln G in ln T, using the
+  // stored values of d ln G / d ln T as the slopes
+  double x0=log(cache_T[jT]), h=log(cache_T[jT+1])-x0;
+  double t=(log(T_K)-x0)/h;
+  double m0=cache_dlpf[jT][ix]*h, m1=cache_dlpf[jT+1][ix]*h;
+  double t2=t*t, t3=t2*t;
+  
+  double lpf=(2.0*t3-3.0*t2+1.0)*y0+(t3-2.0*t2+t)*m0+
+    (-2.0*t3+3.0*t2)*y1+(t3-t2)*m1;
+  double dlpf=((6.0*t2-6.0*t)*y0+(3.0*t2-4.0*t+1.0)*m0+
+               (-6.0*t2+6.0*t)*y1+(3.0*t2-2.0*t)*m1)/h;
+
+  pf=exp(lpf);
+  TdpfdT=pf*dlpf;
+  
+  return 0;
+}
+
+int part_funcs::cache_get(int Z, int N, double T_K, double &pf,
+                          double &TdpfdT) const {
+
+  int ix=cache_find(Z,N);
+  if (ix<0 || cache_T.size()==0) return 1;
+  if (T_K<cache_T[0] || T_K>cache_T[cache_T.size()-1]) return 1;
+
+  // Find jT such that cache_T[jT] <= T_K < cache_T[jT+1], or
+  // jT is the last cached temperature if T_K is equal to it
+  size_t jT=std::upper_bound(cache_T.begin(),cache_T.end(),T_K)-
+    cache_T.begin()-1;
+  
+  return cache_interp(ix,jT,T_K,pf,TdpfdT);
+}
+
+size_t part_funcs::cache_get_dist(double T_K, std::vector<double> &pf,
+                                  std::vector<double> &TdpfdT) const {
+
+  size_t n=cache_Z.size();
+  pf.resize(n);
+  TdpfdT.resize(n);
+
+  if (cache_T.size()==0 || T_K<cache_T[0] ||
+      T_K>cache_T[cache_T.size()-1]) {
+    for(size_t i=0;i<n;i++) {
+      pf[i]=0.0;
+      TdpfdT[i]=0.0;
+    }
+    return n;
+  }
+  
+  size_t jT=std::upper_bound(cache_T.begin(),cache_T.end(),T_K)-
+    cache_T.begin()-1;
+  
+  size_t n_missing=0;
+  for(size_t i=0;i<n;i++) {
+    if (cache_interp(i,jT,T_K,pf[i],TdpfdT[i])!=0) {
+      pf[i]=0.0;
+      TdpfdT[i]=0.0;
+      n_missing++;
+    }
+  }
+  
+  return n_missing;
 }
 
 int part_funcs::load_rt00(std::string fname, bool external) {
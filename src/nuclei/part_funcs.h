@@ -33,6 +33,7 @@
 #include <o2scl/nucmass_hfb.h>
 #include <o2scl/hdf_nucmass_io.h>
 #include <o2scl/inte_qag_gsl.h>
+#include <o2scl/nucleus.h>
 
 namespace o2scl {
 
@@ -40,6 +41,23 @@ namespace o2scl {
 
       \note The partition functions returned by this class have
       not been divided by the spin degeneracy factor.
+
+      \verbatim embed:rst
+      
+      For repeated evaluations at a fixed set of temperatures (e.g.
+      an NSE table where the density varies at fixed temperature),
+      the partition functions for a distribution of nuclei can be
+      cached with :cpp:func:`o2scl::part_funcs::cache_set_dist()` and
+      :cpp:func:`o2scl::part_funcs::cache_add_temp()`. The cache
+      stores :math:`\ln G` and :math:`d \ln G / d \ln T` in a dense
+      :math:`(Z,N)` array for each temperature, and
+      :cpp:func:`o2scl::part_funcs::cache_get()` uses cubic Hermite
+      interpolation in :math:`\ln T` between cached temperatures.
+      The function :cpp:func:`o2scl::part_funcs::cache_get()` does not
+      modify the object and may be called simultaneously from
+      several threads once the cache has been built.
+
+      \endverbatim
    */
   class part_funcs {
     
@@ -131,6 +149,78 @@ namespace o2scl {
     int spin_deg_mode;
     //@}
 
+    /// \name Methods for the partition function cache
+    //@{
+    static const int cache_few78=0;
+    static const int cache_rtk97=1;
+    static const int cache_rt00=2;
+    static const int cache_r03=3;
+    static const int cache_ghk08=4;
+    //@}
+
+    /// \name Cached partition functions
+    //@{
+    /** \brief Set the distribution of nuclei for the cache and
+        the method used to compute the partition functions
+
+        This clears any previously cached temperatures. The value
+        of \c method should be one of \ref cache_few78, \ref
+        cache_rtk97, \ref cache_rt00, \ref cache_r03, or \ref
+        cache_ghk08.
+    */
+    void cache_set_dist(const std::vector<nucleus> &dist,
+                        int method=cache_few78);
+
+    /** \brief Compute the partition functions for all nuclei
+        in the cached distribution at temperature \c T_K (in K)
+
+        If the temperature is already cached then this function
+        does nothing. Nuclei for which the selected method fails
+        are marked as missing for this temperature. This function
+        returns the number of nuclei which were missing.
+    */
+    size_t cache_add_temp(double T_K);
+
+    /** \brief Get the partition function and its derivative
+        for nucleus \c Z, \c N at temperature \c T_K (in K)
+        from the cache
+
+        If \c T_K is one of the cached temperatures, the stored
+        values are returned directly, otherwise the result is
+        interpolated between the two neighbouring cached
+        temperatures. This function returns 1 if the nucleus is
+        not in the cached distribution, if \c T_K lies outside
+        the range of cached temperatures, or if the partition
+        function is missing at one of the neighbouring
+        temperatures, and 0 otherwise.
+    */
+    int cache_get(int Z, int N, double T_K, double &pf,
+                  double &TdpfdT) const;
+
+    /** \brief Get the partition functions for the full cached
+        distribution at temperature \c T_K (in K)
+
+        The vectors \c pf and \c TdpfdT are resized to the number
+        of distinct nuclei in the distribution given to \ref
+        cache_set_dist() and filled in order of their first
+        appearance in that distribution. Entries for which \ref cache_get() would
+        fail are set to zero. This function returns the number of
+        such entries.
+    */
+    size_t cache_get_dist(double T_K, std::vector<double> &pf,
+                          std::vector<double> &TdpfdT) const;
+
+    /** \brief Return the number of cached temperatures
+     */
+    size_t cache_n_temps() const {
+      return cache_T.size();
+    }
+
+    /** \brief Clear the cache
+     */
+    void cache_clear();
+    //@}
+
   protected:
 
     /// \name Partition function tables [protected]
@@ -170,6 +260,57 @@ namespace o2scl {
     double rtk_gamma;
     //@}
 
+    /// \name Partition function cache [protected]
+    //@{
+    /// Method for the cache
+    int cache_method;
+
+    /// Minimum proton number in the cache
+    int cache_Zmin;
+
+    /// Minimum neutron number in the cache
+    int cache_Nmin;
+
+    /// Number of neutron numbers in each row of \ref cache_index
+    int cache_nN;
+
+    /** \brief Dense \f$ (Z,N) \f$ array giving the index in the
+        distribution, or -1 if the nucleus is not in the distribution
+    */
+    std::vector<int> cache_index;
+
+    /// Proton numbers in distribution order
+    std::vector<int> cache_Z;
+
+    /// Neutron numbers in distribution order
+    std::vector<int> cache_N;
+
+    /// Sorted list of cached temperatures in K
+    std::vector<double> cache_T;
+
+    /** \brief For each cached temperature, \f$ \ln G \f$ in
+        distribution order (NaN if missing)
+    */
+    std::vector<std::vector<double>> cache_lpf;
+
+    /** \brief For each cached temperature, \f$ d \ln G / d \ln T \f$
+        in distribution order
+    */
+    std::vector<std::vector<double>> cache_dlpf;
+
+    /** \brief Get the position of nucleus \c Z, \c N in the cached
+        distribution, or -1 if it is not present
+    */
+    int cache_find(int Z, int N) const;
+
+    /** \brief Interpolate the cached values for entry \c ix at
+        temperature \c T_K using the temperature bracket starting
+        at \c jT
+    */
+    int cache_interp(size_t ix, size_t jT, double T_K, double &pf,
+                     double &TdpfdT) const;
+    //@}
+
     /** \brief Partition function formalism from Shen et al. (2010)
      */
     int shen10(int Z, int N, double T, double &pf, double &TdpfdT,
@@ -85,6 +85,64 @@ int main(void) {
   pf.r03(28,28,28.8e9,xpf,TdpfdT);
   cout << xpf << " " << TdpfdT << endl;
 
+  // Cached partition functions
+  vector<nucleus> dist(4);
+  dist[0].Z=26;
+  dist[0].N=30;
+  dist[1].Z=28;
+  dist[1].N=28;
+  dist[2].Z=41;
+  dist[2].N=74;
+  dist[3].Z=78;
+  dist[3].N=109;
+
+  vector<double> Tc;
+  for(double TK=5.0e9;TK<1.21e10;TK*=1.05) Tc.push_back(TK);
+  
+  pf.cache_set_dist(dist,part_funcs::cache_few78);
+  for(size_t j=0;j<Tc.size();j++) {
+    t.test_gen(pf.cache_add_temp(Tc[j])==0,"cache_add_temp");
+  }
+  t.test_gen(pf.cache_n_temps()==Tc.size(),"cache_n_temps");
+  
+  for(size_t i=0;i<dist.size();i++) {
+    double pfc, dpfc;
+    
+    // Exact match with a cached temperature
+    pf.few78(dist[i].Z,dist[i].N,Tc[3],v,vop);
+    t.test_gen(pf.cache_get(dist[i].Z,dist[i].N,Tc[3],pfc,dpfc)==0,
+               "cache_get 1");
+    t.test_rel(pfc,v,1.0e-12,"cache few78 1");
+    t.test_rel(dpfc,vop,1.0e-12,"cache few78 2");
+    
+    // Interpolation between cached temperatures
+    pf.few78(dist[i].Z,dist[i].N,T_K,v,vop);
+    t.test_gen(pf.cache_get(dist[i].Z,dist[i].N,T_K,pfc,dpfc)==0,
+               "cache_get 2");
+    t.test_rel(pfc,v,1.0e-4,"cache few78 3");
+    t.test_rel(dpfc,vop,1.0e-3,"cache few78 4");
+  }
+
+  vector<double> pfv, dpfv;
+  t.test_gen(pf.cache_get_dist(T_K,pfv,dpfv)==0,"cache_get_dist");
+  pf.few78(41,74,T_K,v,vop);
+  t.test_rel(pfv[2],v,1.0e-4,"cache_get_dist pf");
+
+  // Failures outside of the cache
+  t.test_gen(pf.cache_get(2,2,T_K,v,vop)==1,"cache_get missing nucleus");
+  t.test_gen(pf.cache_get(28,28,1.0e11,v,vop)==1,"cache_get out of range");
+
+  // The linearly interpolated tables are reproduced exactly
+  // when the table points are cached
+  pf.cache_set_dist(dist,part_funcs::cache_rt00);
+  t.test_gen(pf.cache_n_temps()==0,"cache reset");
+  pf.cache_add_temp(5.0e9);
+  pf.cache_add_temp(6.0e9);
+  pf.rt00(28,28,6.0e9,v,vop);
+  double pfc, dpfc;
+  t.test_gen(pf.cache_get(28,28,6.0e9,pfc,dpfc)==0,"cache_get rt00");
+  t.test_rel(pfc,v,1.0e-12,"cache rt00");
+
   t.report();
   return 0;
 }
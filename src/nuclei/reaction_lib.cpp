@@ -20,6 +20,10 @@
 
   ───────────────────────────────────────────────────────────────────
 */
+#include <map>
+#include <set>
+#include <algorithm>
+
 #include <o2scl/reaction_lib.h>
 
 using namespace std;
@@ -1157,3 +1161,192 @@ int reaction_lib::read_file_reaclib2(std::string fname) {
   return 0;
 }
 
+reaction_network::reaction_network() {
+  reac_start.push_back(0);
+  jac_start.push_back(0);
+}
+
+void reaction_network::clear() {
+  spec_Z.clear();
+  spec_A.clear();
+  spec_isomer.clear();
+  reac_chap.clear();
+  reac_Q.clear();
+  reac_start.clear();
+  reac_start.push_back(0);
+  reac_spec.clear();
+  set_reac.clear();
+  for(size_t k=0;k<7;k++) set_a[k].clear();
+  jac_start.clear();
+  jac_start.push_back(0);
+  jac_col.clear();
+  return;
+}
+
+size_t reaction_network::n_reactants(size_t chap) {
+  if (chap==1 || chap==2 || chap==3 || chap==11) return 1;
+  if (chap>=4 && chap<=7) return 2;
+  if (chap==8 || chap==9) return 3;
+  if (chap==10) return 4;
+  std::string str=((std::string)"Invalid chapter ")+szttos(chap)+
+    " in reaction_network::n_reactants().";
+  O2SCL_ERR(str.c_str(),exc_einval);
+  return 0;
+}
+
+int reaction_network::species_index(size_t Z, size_t A,
+                                    size_t isomer) const {
+  // The nuclei are sorted, so use a binary search
+  size_t lo=0, hi=spec_Z.size();
+  while (lo<hi) {
+    size_t mid=(lo+hi)/2;
+    if (spec_Z[mid]<Z || (spec_Z[mid]==Z && (spec_A[mid]<A ||
+        (spec_A[mid]==A && spec_isomer[mid]<isomer)))) {
+      lo=mid+1;
+    } else {
+      hi=mid;
+    }
+  }
+  if (lo<spec_Z.size() && spec_Z[lo]==Z && spec_A[lo]==A &&
+      spec_isomer[lo]==isomer) {
+    return ((int)lo);
+  }
+  return -1;
+}
+
+void reaction_network::compile(const std::vector<nuclear_reaction> &nrl) {
+
+  clear();
+
+  // Collect the nuclei, which are sorted by the map
+  std::map<std::vector<size_t>,size_t> spec_map;
+  std::vector<size_t> key(3);
+  for(size_t j=0;j<nrl.size();j++) {
+    for(size_t i=0;i<6 && nrl[j].name[i].length()>0 && nrl[j].A[i]>0;
+        i++) {
+      key[0]=nrl[j].Z[i];
+      key[1]=nrl[j].A[i];
+      key[2]=nrl[j].isomer[i];
+      spec_map.insert(std::make_pair(key,0));
+    }
+  }
+  for(std::map<std::vector<size_t>,size_t>::iterator it=spec_map.begin();
+      it!=spec_map.end();it++) {
+    it->second=spec_Z.size();
+    spec_Z.push_back(it->first[0]);
+    spec_A.push_back(it->first[1]);
+    spec_isomer.push_back(it->first[2]);
+  }
+
+  // Combine the sets into reactions. The key for each reaction
+  // is the chapter followed by the indices of the participants.
+  std::map<std::vector<size_t>,size_t> reac_map;
+  for(size_t j=0;j<nrl.size();j++) {
+    
+    std::vector<size_t> rkey;
+    rkey.push_back(nrl[j].chap);
+    for(size_t i=0;i<6 && nrl[j].name[i].length()>0 && nrl[j].A[i]>0;
+        i++) {
+      key[0]=nrl[j].Z[i];
+      key[1]=nrl[j].A[i];
+      key[2]=nrl[j].isomer[i];
+      rkey.push_back(spec_map[key]);
+    }
+    if (rkey.size()-1<n_reactants(nrl[j].chap)) {
+      std::string str=((std::string)"Reaction ")+szttos(j)+
+        " has too few participants in reaction_network::compile().";
+      O2SCL_ERR(str.c_str(),exc_einval);
+    }
+
+    std::pair<std::map<std::vector<size_t>,size_t>::iterator,bool> it=
+      reac_map.insert(std::make_pair(rkey,reac_chap.size()));
+    if (it.second) {
+      reac_chap.push_back(nrl[j].chap);
+      reac_Q.push_back(nrl[j].Q);
+      for(size_t i=1;i<rkey.size();i++) {
+        reac_spec.push_back(rkey[i]);
+      }
+      reac_start.push_back(reac_spec.size());
+    }
+    
+    set_reac.push_back(it.first->second);
+    for(size_t k=0;k<7;k++) {
+      set_a[k].push_back(nrl[j].a[k]);
+    }
+  }
+
+  // Construct the Jacobian sparsity pattern
+  std::vector<std::set<size_t> > rows(spec_Z.size());
+  for(size_t j=0;j<reac_chap.size();j++) {
+    size_t nin=n_reactants(reac_chap[j]);
+    for(size_t i=reac_start[j];i<reac_start[j+1];i++) {
+      for(size_t k=reac_start[j];k<reac_start[j]+nin;k++) {
+        rows[reac_spec[i]].insert(reac_spec[k]);
+      }
+    }
+  }
+  for(size_t i=0;i<rows.size();i++) {
+    jac_col.insert(jac_col.end(),rows[i].begin(),rows[i].end());
+    jac_start.push_back(jac_col.size());
+  }
+  
+  return;
+}
+
+void reaction_network::rates(size_t n_T, const double *T9,
+                             double *r) const {
+  
+  size_t ns=set_reac.size();
+  size_t nr=reac_chap.size();
+  if (ns==0) return;
+
+  std::vector<double> sr(ns);
+  double *srp=&(sr[0]);
+  const double *a0=&(set_a[0][0]), *a1=&(set_a[1][0]);
+  const double *a2=&(set_a[2][0]), *a3=&(set_a[3][0]);
+  const double *a4=&(set_a[4][0]), *a5=&(set_a[5][0]);
+  const double *a6=&(set_a[6][0]);
+  
+  for(size_t i=0;i<n_T;i++) {
+
+    // The temperature-dependent factors are the same for all sets
+    double T=T9[i];
+    double T13=cbrt(T);
+    double Tm1=1.0/T;
+    double Tm13=1.0/T13;
+    double T53=T*T13*T13;
+    double lnT=log(T);
+
+    // Evaluate all of the sets. The exponent and the exponential
+    // are computed in separate loops, since the first always
+    // vectorizes and the second only vectorizes when the compiler
+    // has a vector version of exp() (e.g. glibc with -ffast-math).
+#ifdef O2SCL_SET_OPENMP
+#pragma omp simd
+#endif
+    for(size_t k=0;k<ns;k++) {
+      srp[k]=a0[k]+a1[k]*Tm1+a2[k]*Tm13+a3[k]*T13+a4[k]*T+
+        a5[k]*T53+a6[k]*lnT;
+    }
+#ifdef O2SCL_SET_OPENMP
+#pragma omp simd
+#endif
+    for(size_t k=0;k<ns;k++) {
+      srp[k]=exp(srp[k]);
+    }
+
+    // Sum the sets into the reactions
+    double *ri=r+i*nr;
+    for(size_t j=0;j<nr;j++) ri[j]=0.0;
+    for(size_t k=0;k<ns;k++) ri[set_reac[k]]+=srp[k];
+  }
+  
+  return;
+}
+
+void reaction_network::rates(const std::vector<double> &T9,
+                             std::vector<double> &r) const {
+  r.resize(T9.size()*reac_chap.size());
+  if (r.size()>0) rates(T9.size(),&(T9[0]),&(r[0]));
+  return;
+}
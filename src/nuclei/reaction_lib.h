@@ -31,6 +31,7 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include <o2scl/err_hnd.h>
 #include <o2scl/string_conv.h>
@@ -244,6 +245,137 @@ namespace o2scl {
 
   };
 
+  /** \brief A compiled reaction network for fast rate evaluation
+
+      This class converts a list of \ref nuclear_reaction objects,
+      for example \ref reaction_lib::lib, into arrays which are
+      convenient for a network calculation. The participating nuclei
+      are numbered, sorted by proton number, mass number, and isomer.
+      REACLIB rate fit sets which have the same chapter and the
+      same participants are combined into one reaction, whose rate is
+      the sum of the rates from each set.
+
+      The seven fit coefficients of the sets are stored in separate
+      arrays, so that \ref rates() can evaluate all of the sets for
+      one temperature in a loop which the compiler can vectorize.
+      The rate of each set is
+      \f[
+      \lambda = \exp \left( a_0 + a_1 T_9^{-1} + a_2 T_9^{-1/3}
+      + a_3 T_9^{1/3} + a_4 T_9 + a_5 T_9^{5/3} + a_6 \ln T_9
+      \right)
+      \f]
+      which is the same as \ref nuclear_reaction::rate() .
+
+      The sparsity pattern of the Jacobian \f$ \partial \dot{Y}_i
+      / \partial Y_k \f$ is stored in compressed row format in
+      \ref jac_start and \ref jac_col. The element \f$ (i,k) \f$ is
+      nonzero if nucleus \f$ i \f$ participates in a reaction in
+      which nucleus \f$ k \f$ is a reactant.
+
+      This class is experimental.
+  */
+  class reaction_network {
+
+  public:
+
+    reaction_network();
+    
+    /** \brief Compile the network from the reactions in \c nrl
+     */
+    void compile(const std::vector<nuclear_reaction> &nrl);
+
+    /// Clear the network
+    void clear();
+    
+    /// The number of nuclei
+    size_t n_species() const {
+      return spec_Z.size();
+    }
+    
+    /// The number of reactions
+    size_t n_reactions() const {
+      return reac_chap.size();
+    }
+    
+    /// The number of rate fit sets
+    size_t n_sets() const {
+      return set_reac.size();
+    }
+
+    /** \brief Return the index of the nucleus with proton number 
+        \c Z, mass number \c A and isomer \c isomer, or -1 if it 
+        is not in the network
+    */
+    int species_index(size_t Z, size_t A, size_t isomer=0) const;
+
+    /** \brief Return the number of reactants in a reaction in
+        REACLIB chapter \c chap
+    */
+    static size_t n_reactants(size_t chap);
+    
+    /** \brief Compute the rates of all reactions at the \c n_T
+        temperatures in \c T9 (in units of \f$ 10^9 \f$ K)
+
+        The rate of reaction \c j at temperature \c i is stored in
+        <tt>r[i*n_reactions()+j]</tt>, so \c r must have space for
+        <tt>n_T*n_reactions()</tt> values.
+    */
+    void rates(size_t n_T, const double *T9, double *r) const;
+
+    /** \brief Compute the rates of all reactions at the 
+        temperatures in \c T9, resizing \c r if necessary
+    */
+    void rates(const std::vector<double> &T9,
+               std::vector<double> &r) const;
+
+    /// \name Nuclei
+    //@{
+    /// Proton numbers
+    std::vector<size_t> spec_Z;
+    /// Mass numbers
+    std::vector<size_t> spec_A;
+    /// Isomer designations
+    std::vector<size_t> spec_isomer;
+    //@}
+
+    /// \name Reactions
+    //@{
+    /// REACLIB chapter
+    std::vector<size_t> reac_chap;
+    /// Q value (in MeV)
+    std::vector<double> reac_Q;
+    /** \brief The participants of reaction \c j are 
+        <tt>reac_spec[reac_start[j]]</tt> to
+        <tt>reac_spec[reac_start[j+1]-1]</tt>
+    */
+    std::vector<size_t> reac_start;
+    /** \brief Indices of the participating nuclei, with the
+        reactants first
+    */
+    std::vector<size_t> reac_spec;
+    //@}
+
+    /// \name Rate fit sets
+    //@{
+    /// The reaction for each set
+    std::vector<size_t> set_reac;
+    /// Fit coefficient \f$ a_i \f$ for each set
+    std::vector<double> set_a[7];
+    //@}
+
+    /// \name Jacobian sparsity pattern
+    //@{
+    /** \brief The nonzero columns in row \c i are
+        <tt>jac_col[jac_start[i]]</tt> to 
+        <tt>jac_col[jac_start[i+1]-1]</tt>
+    */
+    std::vector<size_t> jac_start;
+    /// The column indices, sorted within each row
+    std::vector<size_t> jac_col;
+    //@}
+    
+  };
+
 }
 
 #endif
@@ -20,12 +20,33 @@
 
   ───────────────────────────────────────────────────────────────────
 */
+#include <iomanip>
 #include <o2scl/reaction_lib.h>
 #include <o2scl/test_mgr.h>
 
 using namespace std;
 using namespace o2scl;
 
+/** \brief Write one REACLIB2 entry to \c fout
+ */
+void write_entry(ofstream &fout, size_t chap, vector<string> names,
+                 string ref, double a[7]) {
+  fout << chap << endl;
+  fout << "     ";
+  for(size_t i=0;i<6;i++) {
+    fout << setw(5) << (i<names.size() ? names[i] : "");
+  }
+  fout << "        " << ref << "   " << " 0.00000e+00" << endl;
+  fout.setf(ios::scientific);
+  fout.precision(6);
+  for(size_t i=0;i<4;i++) fout << setw(13) << a[i];
+  fout << endl;
+  for(size_t i=4;i<7;i++) fout << setw(13) << a[i];
+  fout << endl;
+  fout.unsetf(ios::scientific);
+  return;
+}
+
 int main(void) {
   test_mgr t;
   t.set_output_level(2);
@@ -51,6 +72,64 @@ int main(void) {
   
   t.test_gen(r.lib.size()==2,"size");
 
+  {
+    // A small network with two sets for p(p,e+nu)d and one for
+    // he4(he4 he4,g)c12
+    ofstream fout2("reaction_temp2.dat");
+    double a1[7]={-6.786180,0,0,0,0,0,0};
+    double a2[7]={-2.014510e1,0,0,0,0,0,0};
+    double a3[7]={-3.478630e1,0,-3.511930,3.100860,-1.983140e-1,
+                  1.262510e-2,-1.025170};
+    double a4[7]={-4.337300e1,-4.000000e-3,-5.000000,1.000000,
+                  -1.000000e-1,1.000000e-2,-6.666670e-1};
+    double a5[7]={-2.435050e1,-4.126560,-1.349000e1,2.142590e1,
+                  -1.347690,8.798160e-2,-1.316530e1};
+    write_entry(fout2,1,{"n","p"},"wc07w ",a1);
+    write_entry(fout2,1,{"t","he3"},"wc07w ",a2);
+    write_entry(fout2,4,{"p","p","d"},"bet+w ",a3);
+    write_entry(fout2,4,{"p","p","d"},"xxxxw ",a4);
+    write_entry(fout2,8,{"he4","he4","he4","c12"},"fy05r ",a5);
+    fout2.close();
+
+    reaction_lib r2;
+    r2.read_file_reaclib2("reaction_temp2.dat");
+    t.test_gen(r2.lib.size()==5,"size 2");
+
+    reaction_network net;
+    net.compile(r2.lib);
+    t.test_gen(net.n_species()==7,"n_species");
+    t.test_gen(net.n_reactions()==4,"n_reactions");
+    t.test_gen(net.n_sets()==5,"n_sets");
+    t.test_gen(net.species_index(0,1)==0,"index n");
+    t.test_gen(net.species_index(1,1)==1,"index p");
+    t.test_gen(net.species_index(6,12)==6,"index c12");
+    t.test_gen(net.species_index(8,16)==-1,"index o16");
+
+    // Compare the batched rates with nuclear_reaction::rate()
+    vector<double> T9={0.05,0.3,1.0,2.5,7.0}, rv;
+    net.rates(T9,rv);
+    t.test_gen(rv.size()==T9.size()*4,"rates size");
+    for(size_t i=0;i<T9.size();i++) {
+      t.test_rel(rv[i*4],r2.lib[0].rate(T9[i]),1.0e-12,"rate 0");
+      t.test_rel(rv[i*4+1],r2.lib[1].rate(T9[i]),1.0e-12,"rate 1");
+      t.test_rel(rv[i*4+2],r2.lib[2].rate(T9[i])+r2.lib[3].rate(T9[i]),
+                 1.0e-12,"rate 2");
+      t.test_rel(rv[i*4+3],r2.lib[4].rate(T9[i]),1.0e-12,"rate 3");
+    }
+
+    // The Jacobian pattern: n -> p, t -> he3, p + p -> d and
+    // 3 he4 -> c12
+    size_t ip=net.species_index(1,1), id=net.species_index(1,2);
+    size_t in=net.species_index(0,1);
+    t.test_gen(net.jac_start.size()==8,"jac_start size");
+    t.test_gen(net.jac_col.size()==8,"jac nonzeros");
+    t.test_gen(net.jac_start[ip+1]-net.jac_start[ip]==2,"jac row p");
+    t.test_gen(net.jac_col[net.jac_start[ip]]==in,"jac p,n");
+    t.test_gen(net.jac_col[net.jac_start[ip]+1]==ip,"jac p,p");
+    t.test_gen(net.jac_start[id+1]-net.jac_start[id]==1,"jac row d");
+    t.test_gen(net.jac_col[net.jac_start[id]]==ip,"jac d,p");
+  }
+
   t.report();
   return 0;
 }
@@ -0,0 +1,1165 @@
+/*
+  ───────────────────────────────────────────────────────────────────
+  
+  Copyright (C) 2025, Andrew W. Steiner
+  
+  This file is part of O2scl.
+  
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+  
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  ───────────────────────────────────────────────────────────────────
+*/
+/** \file fermi_dirac_vec.h
+    \brief File defining \ref o2scl::fermi_dirac_integ_vec
+*/
+#ifndef O2SCL_FERMI_DIRAC_VEC_H
+#define O2SCL_FERMI_DIRAC_VEC_H
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <o2scl/constants.h>
+
+/** \brief Coefficients for \ref o2scl::fermi_dirac_integ_vec
+
+    All coefficients are for the Fermi-Dirac integral normalized
+    as in GSL, i.e. including the factor \f$ 1/\Gamma(a+1) \f$.
+    They were computed with 34 digit arithmetic by Chebyshev
+    interpolation at 48 nodes and then truncated to 25 terms, which
+    gives a near-minimax polynomial on each interval.
+
+    For \f$ \mu \leq 0 \f$, the expansion variable is \f$ x=2 e^{\mu}-1
+    \f$ and the expansion gives \f$ F_a(\mu) e^{-\mu} \f$. For the
+    half-integer orders, rows 1 through 20 hold the expansion of \f$
+    F_a(\mu) \f$ in \f$ x=\mu-2 i+1 \f$ for \f$ 2(i-1) < \mu \leq 2 i
+    \f$. The Sommerfeld coefficients \f$ s_k \f$ give
+    \f$ F_a(\mu) = \mu^{a+1} \sum_k s_k \mu^{-2k} \f$ for
+    \f$ \mu \geq 40 \f$.
+*/
+namespace o2scl_fd_vec_coeffs {
+
+  /** \brief Chebyshev coefficients for order 2 at \f$ \mu \leq 0 \f$ */
+  static const double cheb_2[25]={
+    9.47963376091704668e-01, -4.90091807429257273e-02, 2.78759284445355675e-03,
+    -2.17372755153201301e-04, 2.01345509425917063e-05, -2.08007550321235748e-06,
+    2.31783207060389308e-07, -2.73068551569993611e-08, 3.35765409097668741e-09,
+    -4.27099365567717337e-10, 5.58465565767252596e-11, -7.47130118063449922e-12,
+    1.01899298802878328e-12, -1.41288200956470162e-13, 1.98716153777463073e-14,
+    -2.82989608635246850e-15, 4.07451163753808898e-16, -5.92399408459984957e-17,
+    8.68838682514327433e-18, -1.28430634128301712e-18, 1.91195369804510643e-19,
+    -2.86473503489573555e-20, 4.31763441197031456e-21, -6.54256810686379517e-22,
+    9.96331847280333062e-23};
+
+  /** \brief Chebyshev coefficients for order 3 at \f$ \mu \leq 0 \f$ */
+  static const double cheb_3[25]={
+    9.72467966463167577e-01, -2.64202012373833811e-02, 1.04362888738747839e-03,
+    -6.29605312778387866e-05, 4.77827300518737117e-06, -4.19184645033197273e-07,
+    4.06498319852873316e-08, -4.24312694660377701e-09, 4.68643760693452335e-10,
+    -5.41300487120833029e-11, 6.48384055293226993e-12, -8.00438832489521567e-13,
+    1.01361074655543304e-13, -1.31177317947341294e-14, 1.72987913785087111e-15,
+    -2.31905400261735021e-16, 3.15426102720988786e-17, -4.34582937661709911e-18,
+    6.05682418115647888e-19, -8.52929320983900100e-20, 1.21240489936983952e-20,
+    -1.73811543570990025e-21, 2.51121658318641801e-22, -3.65412235759801897e-23,
+    5.35214653951748528e-24};
+
+  /** \brief Chebyshev coefficients for order -1/2, 21 rows of 25 */
+  static const double cheb_m1o2[525]={
+    7.74341960245551131e-01, -1.93335556801508684e-01, 2.74565198103372231e-02,
+    -4.11273457766586376e-03, 6.34524060874164676e-04, -9.97613095377023910e-05,
+    1.58919966752140236e-05, -2.55620916525787270e-06, 4.14229690644858952e-07,
+    -6.75217122572869343e-08, 1.10591815638110996e-08, -1.81854371696616770e-09,
+    3.00036567860354349e-10, -4.96435109947091720e-11, 8.23417666544118491e-12,
+    -1.36870880727437802e-12, 2.27941518809043858e-13, -3.80245922140126420e-14,
+    6.35267430116458269e-15, -1.06275587982112607e-15, 1.78007751630450869e-16,
+    -2.98486129257803744e-17, 5.01010731082574867e-18, -8.41725858867086419e-19,
+    1.41534620793199431e-19, 1.03056383285565900e+00, 4.33611365992241593e-01,
+    3.77826969881658783e-03, -3.95979078748513388e-03, 2.62858261729639246e-04,
+    4.65969708637206203e-05, -8.52164385633111674e-06, -1.88748627870388996e-07,
+    1.79729847998515482e-07, -1.10259569352457706e-08, -2.66534221915734303e-09,
+    4.42266179250189939e-10, 1.72789122828051701e-11, -1.04734188905552305e-11,
+    5.20836902459994709e-13, 1.72711945898798353e-13, -2.53217007734328682e-14,
+    -1.46768164431474090e-15, 6.53352882814291385e-16, -2.43819118083111618e-17,
+    -1.16855916832550483e-17, 1.50375037058947059e-18, 1.19627866123373206e-19,
+    -4.20142127373468579e-20, 1.02835441666252094e-21, 1.83919482029545045e+00,
+    3.60501730181453872e-01, -1.42028947002443701e-02, 3.02242818931533572e-04,
+    8.88071783740954340e-05, -1.64027525461395092e-05, 1.42049968005327149e-06,
+    -2.16941713170887265e-08, -1.32474118533636729e-08, 2.21555534045869861e-09,
+    -1.72355926551527353e-10, -8.10144686534393054e-13, 2.20680528348624953e-12,
+    -3.22472305546962069e-13, 2.16440948534466462e-14, 6.98275963787328815e-16,
+    -3.74023348366682576e-16, 4.81786796383731677e-17, -2.66900284761871594e-18,
+    -1.96135651371866219e-19, 6.34651178266318756e-20, -7.23526438899890920e-21,
+    3.06781673026870671e-22, 4.44753871828907445e-23, -1.07078402766295787e-23,
+    2.46476831038053001e+00, 2.70194495265013324e-01, -8.23937639416452532e-03,
+    4.44925292912685141e-04, -1.99401668484305038e-05, 2.73046666859210948e-08,
+    1.25665777430726544e-07, -1.73568077220866466e-08, 1.54412134326098091e-09,
+    -9.72362185594324389e-11, 3.19799585308086926e-12, 1.98943659735870720e-13,
+    -4.83378934224102316e-14, 5.33169561602123274e-15, -4.13127405798666687e-16,
+    2.13593949929701907e-17, -1.73388872534154294e-19, -1.20770657259440879e-19,
+    1.79994639800014557e-20, -1.68569089604320567e-21, 1.12155374919691987e-22,
+    -4.10875795754936508e-24, -1.96678835688849346e-25, 5.58952640416867838e-26,
+    -6.48055128188397238e-27, 2.95269380911071577e+00, 2.20790488339074359e-01,
+    -4.54706283429474976e-03, 1.97135600228670046e-04, -1.00761003503672707e-05,
+    4.78650216582540878e-07, -1.62801533337076746e-08, -5.41682548810920111e-11,
+    7.20792714878307589e-11, -8.00520866985897638e-12, 6.25531559021342981e-13,
+    -3.97260418538258012e-14, 2.07731518622067555e-15, -8.15278640487853011e-17,
+    1.15710418941873079e-18, 1.90337600261087396e-19, -2.65697091511977203e-20,
+    2.30742597878478043e-21, -1.60118203126111060e-22, 9.23712707201618813e-24,
+    -4.23160195192740314e-25, 1.16341256115370367e-26, 3.70457780677840088e-28,
+    -9.06530871418926753e-29, 9.05333123549450263e-30, 3.36385259516222224e+00,
+    1.91733833739194198e-01, -2.89670287401682953e-03, 9.32306560025956559e-05,
+    -3.88645715891494529e-06, 1.76825264664185720e-07, -7.80666519007864437e-09,
+    2.99907347634234843e-10, -8.13117522973943731e-12, -2.33765612168675323e-14,
+    2.38238541165221490e-14, -2.20352901011434530e-15, 1.47521026532385251e-16,
+    -8.36025034436072359e-18, 4.18986727613915940e-19, -1.86414033167831788e-20,
+    7.10982338832896235e-22, -2.02186054413392246e-23, 1.01033465278992435e-25,
+    4.31493158218238948e-26, -4.44632987975600987e-27, 3.17466257610793857e-28,
+    -1.90639579869088333e-29, 1.01142618441926175e-30, -4.79456247301151541e-32,
+    3.72708614240676317e+00, 1.72192918239432669e-01, -2.06071918283643298e-03,
+    5.15142949028443202e-05, -1.68494070684689003e-06, 6.35586675560455282e-08,
+    -2.54844538768872147e-09, 1.01289091796646073e-10, -3.74343989383240725e-12,
+    1.18949369787810490e-13, -2.68731580660301981e-15, -4.07314071620813091e-18,
+    5.29346389992585845e-18, -4.18990815563692995e-19, 2.41867384579748526e-20,
+    -1.20056413762501662e-21, 5.39901348645356256e-23, -2.24345811012735563e-24,
+    8.63133568405756816e-26, -3.02648961108019717e-27, 9.20729348574976136e-29,
+    -2.05605861096299997e-30, 4.57408361791968515e-34, 3.94013167789221979e-33,
+    -5.19599849579472978e-34, 4.05667276778970809e+00, 1.57800518535795908e-01,
+    -1.57097297519654734e-03, 3.21658734483848351e-05, -8.51415137023129795e-07,
+    2.61492826569066203e-08, -8.82950798804429521e-10, 3.13045532786978368e-11,
+    -1.11366973849022858e-12, 3.80629094600069743e-14, -1.19467981573389283e-15,
+    3.22289868085332665e-17, -6.25305644272037068e-19, -2.20368519268116416e-22,
+    8.59202867535926394e-22, -5.94377088733422281e-23, 2.99666326312455143e-24,
+    -1.30738772999371267e-25, 5.22059678600806004e-27, -1.95629006328931319e-28,
+    6.95439861532160711e-30, -2.34498020145349177e-31, 7.37069439133198434e-33,
+    -8.02470810161348228e-36, -2.20679472794370761e-34, 4.36078709760614824e+00,
+    1.46578611382487373e-01, -1.25251974900515250e-03, 2.18147760619648317e-05,
+    -4.85785445322735016e-07, 1.24454646672827213e-08, -3.51513409228727026e-10,
+    1.06449584676691169e-11, -3.36084133686761831e-13, 1.07260399936653572e-14,
+    -3.35273124914105671e-16, 9.94600013727496093e-18, -2.70025090968036408e-19,
+    6.31801424018361225e-21, -1.07499427055798157e-22, 4.88454203617093683e-26,
+    1.07254771859621698e-25, -6.59105578961260868e-27, 2.94061349825733444e-28,
+    -1.13793229714025507e-29, 4.04429238905116273e-31, -1.32046571812049858e-32,
+    3.20988324064539323e-34, 2.06636233616547194e-34, -2.52778305200824706e-34,
+    4.64467070953601624e+00, 1.37489795902513645e-01, -1.03041594941696282e-03,
+    1.56583898288253191e-05, -3.02142647422791093e-07, 6.65241757417780328e-09,
+    -1.60408090109593354e-10, 4.14918596613699653e-12, -1.13330885787754739e-13,
+    3.21125211111800551e-15, -9.23900633808944445e-17, 2.63607506242026623e-18,
+    -7.28231819760508915e-20, 1.89976781554871148e-21, -4.53443241238850497e-23,
+    9.35869651706180253e-25, -1.41803177712460919e-26, 1.37179696719868437e-29,
+    1.06616392208658260e-29, -5.89799996052387724e-31, 2.31813755285359473e-32,
+    -4.01235405080674165e-34, -1.16358267473395492e-34, 2.30710357921387642e-34,
+    -2.58796836277034818e-34, 4.91194989509058022e+00, 1.29924811171559074e-01,
+    -8.67715200931946018e-04, 1.17126051727179773e-05, -1.99924123880579191e-07,
+    3.87292374580605766e-09, -8.16452764943432551e-11, 1.83626275318641894e-12,
+    -4.35688955163072420e-14, 1.08044499169522180e-15, -2.76853894061774510e-17,
+    7.22128419121884262e-19, -1.88362205872696501e-20, 4.82176994690372135e-22,
+    -1.18823122874447513e-23, 2.75989042787229671e-25, -5.87052773746222263e-27,
+    1.08327520778935560e-28, -1.47924259261902301e-30, 1.56281190278922587e-33,
+    4.85494840147615733e-34, 4.15278644258497731e-34, -1.50463276905252801e-34,
+    2.42747420073807867e-34, -2.72840075454858427e-34, 5.16526798128123321e+00,
+    1.23496187072124980e-01, -7.44103579977368730e-04, 9.04206410632554804e-06,
+    -1.38581181277840607e-07, 2.40246489395457356e-09, -4.51303026961676856e-11,
+    8.99905111448130350e-13, -1.88428360261118315e-14, 4.11621222542656665e-16,
+    -9.32819074740190093e-18, 2.17692827471204818e-19, -5.17742216813939369e-21,
+    1.23835024925555062e-22, -2.93459325449174818e-24, 6.78395995855862346e-26,
+    -1.50535430265677654e-27, 3.14699320201764296e-29, -6.03450024533232258e-31,
+    9.72594621915554106e-33, -5.53704859011330308e-34, 4.67439246918985397e-34,
+    -1.36420037727429213e-34, 2.64815367353244930e-34, -2.90895668683488763e-34,
+    5.40662670737372064e+00, 1.17942990926063335e-01, -6.47486812495636161e-04,
+    7.15780421205671471e-06, -9.96242892923487717e-08, 1.56508234782650608e-09,
+    -2.65698593321425564e-11, 4.77153758797566834e-13, -8.96127711102388709e-15,
+    1.74884253828365903e-16, -3.53266816449362793e-18, 7.36095405409860565e-20,
+    -1.57470448575680311e-21, 3.43390804544117164e-23, -7.55860076308464149e-25,
+    1.65976230257666175e-26, -3.58981043768615025e-28, 7.54779568678054310e-30,
+    -1.52268836228115835e-31, 2.55185717631308751e-33, -4.89507194198422417e-34,
+    4.81482486096808963e-34, -1.78549755260899998e-34, 2.80864783556471881e-34,
+    -2.98920376785102217e-34, 5.63758710233426541e+00, 1.13081747463952942e-01,
+    -5.70225216779725189e-04, 5.78360720815298927e-06, -7.37631146561828056e-08,
+    1.06030327280344769e-09, -1.64410625267657677e-11, 2.69077103093339485e-13,
+    -4.59241296693259510e-15, 8.11731639325248667e-17, -1.47999218531276920e-18,
+    2.77672099375289400e-20, -5.34973243737373293e-22, 1.05530780588447669e-23,
+    -2.12117867492580633e-25, 4.31348577232928091e-27, -8.79344665003429401e-29,
+    1.77870864955503502e-30, -3.54451356848267514e-32, 3.08951261912119099e-34,
+    -4.73457777995195509e-34, 4.85494840147615733e-34, -1.68518870133883137e-34,
+    2.72840075454858427e-34, -3.04938907861312329e-34, 5.85939539187326996e+00,
+    1.08778979294097883e-01, -5.07266487980636833e-04, 4.75390059042848702e-06,
+    -5.59683208986241406e-08, 7.41865008149590502e-10, -1.05945374992942530e-11,
+    1.59455892164464414e-13, -2.49810603326540354e-15, 4.04368880730776590e-17,
+    -6.73296300308548929e-19, 1.15018489597475489e-20, -2.01280688687098854e-22,
+    3.60397268576074313e-24, -6.59073246770342771e-26, 1.22710997950617843e-27,
+    -2.31435029186503834e-29, 4.39308632668779334e-31, -8.47810410935464495e-33,
+    -2.08642410641950536e-34, -4.89507194198422417e-34, 5.41667796858910084e-34,
+    -1.60494162032269662e-34, 2.92901845708892105e-34, -3.33025386216959547e-34,
+    6.07306581191263373e+00, 1.04934856044425415e-01, -4.55143969333661545e-04,
+    3.96466166078839854e-06, -4.33536465031715036e-08, 5.33321114362066606e-10,
+    -7.06213765604746404e-12, 9.84536691560170239e-14, -1.42690331421898330e-15,
+    2.13343440065681444e-17, -3.27479803082742771e-19, 5.14525957083778174e-21,
+    -8.26011619836879141e-23, 1.35363448081368769e-24, -2.26285749096829249e-26,
+    3.85491770379659137e-28, -6.67900066415935846e-30, 1.17549936626485094e-31,
+    -2.24691826845177505e-33, -3.37037740267766274e-34, -5.01544256350842642e-34,
+    5.61729567112943762e-34, -1.64506516083076389e-34, 3.08951261912119099e-34,
+    -3.45062448369379771e-34, 6.27943720482354095e+00, 1.01472970980666141e-01,
+    -4.11405462296038035e-04, 3.34797839796568220e-06, -3.41827960845017441e-08,
+    3.92379648233864532e-10, -4.84498992530636489e-12, 6.29351718480035488e-14,
+    -8.49128978832830731e-16, 1.18062779701136534e-17, -1.68307742181380492e-19,
+    2.45192687040317578e-21, -3.64260889496823459e-23, 5.51175716786424443e-25,
+    -8.48928178946704625e-27, 1.33046125440832775e-28, -2.12066152353503931e-30,
+    3.45905042720049154e-32, -7.46297853450053893e-34, -3.93210696979060625e-34,
+    -5.05556610401649411e-34, 5.77778983316170756e-34, -1.64506516083076389e-34,
+    3.20988324064539323e-34, -3.49074802420186498e-34, 6.47921293216972316e+00,
+    9.83336906615702999e-02, -3.74271250396858977e-04, 2.85806505071089089e-06,
+    -2.73696195855974032e-08, 2.94526638348294789e-10, -3.40749603538088475e-12,
+    4.14480447049410252e-14, -5.23316002633679601e-16, 6.80377459392920045e-18,
+    -9.06132159082073565e-20, 1.23186399551267136e-21, -1.70545586880593334e-23,
+    2.40086682987908962e-25, -3.43374421730020790e-27, 4.98731997396632244e-29,
+    -7.35544744593891797e-31, 1.06688494210951257e-32, -2.52778305200824706e-34,
+    1.84568286337110110e-34, -7.62347269653280887e-34, 6.82100188637146067e-35,
+    1.92592994438723585e-34, 7.94446102059734789e-34, -7.90433748008928105e-34,
+    6.67298977304545193e+00, 9.54696838865875391e-02, -3.42420956893049245e-04,
+    2.46319523722465978e-06, -2.22117843754635282e-08, 2.24984659542922673e-10,
+    -2.44901143384283045e-12, 2.80145951517166368e-14, -3.32465225030310381e-16,
+    4.06053666225653325e-18, -5.07677533246499887e-20, 6.47412816932734537e-22,
+    -8.39979930170033036e-24, 1.10688175233463805e-25, -1.47976230481451591e-27,
+    2.00564659219785403e-29, -2.75576500917508610e-31, 4.10865054802610293e-33,
+    -2.36728888997597755e-34, -4.21297175334707843e-34, -5.53704859011330308e-34,
+    6.01853107621011204e-34, -2.04630056591143809e-34, 3.12963615962925826e-34,
+    -3.77161280775833674e-34, 6.86127932304483767e+00, 9.28428304679920907e-02,
+    -3.14856119929772299e-04, 2.14085739426731930e-06, -1.82420037068530210e-08,
+    1.74541411888717027e-10, -1.79407473436013585e-12, 1.93720203469485798e-14,
+    -2.16920405403918214e-16, 2.49865316114563519e-18, -2.94482708804273662e-20,
+    3.53794736538646410e-22, -4.32157825799021381e-24, 5.35702984863920912e-26,
+    -6.73027634213394144e-28, 8.56197835843270908e-30, -1.10287575794524907e-31,
+    1.71327517969447867e-33, -2.36728888997597755e-34, -4.21297175334707843e-34,
+    -5.57717213062137078e-34, 6.45989002179885331e-34, -2.00617702540337082e-34,
+    3.45062448369379771e-34, -3.73148926725026947e-34, 7.04452415098108187e+00,
+    9.04220318037691206e-02, -2.90808972288219213e-04, 1.87474378725129810e-06,
+    -1.51415461261923235e-08, 1.37283912050234265e-10, -1.33677663495522667e-12,
+    1.36696128882893886e-14, -1.44910792569837143e-16, 1.57967975465806170e-18,
+    -1.76122007208950456e-20, 2.00079896410258390e-22, -2.30979267718703672e-24,
+    2.70443658479415218e-26, -3.20702142911865533e-28, 3.84729784221870444e-30,
+    -4.66757146730348204e-32, 8.54631412821835910e-34, -2.12654764692757306e-34,
+    -4.77470132046002193e-34, -5.69754275214557302e-34, 6.54013710281498870e-34,
+    -1.84568286337110110e-34, 3.57099510521799995e-34, -4.09260113182287619e-34};
+
+  /** \brief Sommerfeld coefficients for order -1/2 */
+  static const double s_m1o2[9]={
+    1.12837916709551256e+00, -4.64027333069308989e-01, -2.00364771630039185e+00,
+    -3.28409742798193207e+01, -1.18678995010028325e+03, -7.58709964228488388e+04,
+    -7.57357238111421466e+06, -1.08889866080053997e+09, -2.13161631863285767e+11};
+
+  /** \brief Chebyshev coefficients for order 1/2, 21 rows of 25 */
+  static const double cheb_1o2[525]={
+    8.71009738646305487e-01, -1.16094254955589268e-01, 1.13964332993326291e-02,
+    -1.31002275499740063e-03, 1.64277460483191155e-04, -2.17754830010221743e-05,
+    2.99991835864332805e-06, -4.25203778338566708e-07, 6.15987672579716759e-08,
+    -9.07968780244990448e-09, 1.35733157815566839e-09, -2.05292207893508540e-10,
+    3.13569281723254831e-11, -4.82999894876397933e-12, 7.49407509426565917e-13,
+    -1.17016226334494720e-13, 1.83739530178995756e-14, -2.89944314257726642e-15,
+    4.59571179483151426e-16, -7.31345682885648809e-17, 1.16804070694589835e-17,
+    -1.87160919512037070e-18, 3.00794383621049283e-19, -4.84744387996044603e-20,
+    7.83156745783570590e-21, 1.68553827314098914e+00, 1.02867469800625067e+00,
+    1.09392789194931686e-01, 5.85901906181158106e-04, -5.00798469793606793e-04,
+    2.71379905585970387e-05, 3.89880995763258396e-06, -6.21526693166402219e-07,
+    -1.11076669334464515e-08, 1.01330661232040458e-08, -5.73411155724798053e-10,
+    -1.21937324156370379e-10, 1.88641499225310473e-11, 6.44541360782506756e-13,
+    -3.80218958444786756e-13, 1.82052867744475886e-14, 5.44311336072228459e-15,
+    -7.63972166360210546e-16, -4.00916592362897170e-17, 1.75010124867775391e-17,
+    -6.47141554472515835e-19, -2.81076655937581398e-19, 3.51310132574276500e-20,
+    2.57825025449376121e-21, -8.92091335251545090e-22, 4.57755609901289162e+00,
+    1.84629626764557275e+00, 9.00498718406305826e-02, -2.38195031310307762e-03,
+    3.98306964347091335e-05, 8.73866786940421692e-06, -1.36508819790186830e-06,
+    1.02410506564759652e-07, -1.49435791609671402e-09, -7.26391995934008100e-10,
+    1.10818274257261659e-10, -7.93466962886425536e-12, -2.03196825411429609e-14,
+    8.40446611012616452e-14, -1.15418064825267628e-14, 7.33937273393777678e-16,
+    2.03155401296548626e-17, -1.09221866329136424e-17, 1.34374486915958420e-18,
+    -7.19070517222462485e-20, -4.72250967457192037e-21, 1.50376990841940485e-21,
+    -1.65448631276934614e-22, 6.90194594156328544e-24, 9.04086259140994915e-25,
+    8.91159068028308177e+00, 2.46888799857761221e+00, 6.74373924930251611e-02,
+    -1.36990603788601567e-03, 5.56122485307499034e-05, -2.00658326258612312e-06,
+    3.72178953400064539e-09, 8.86583257767611185e-09, -1.07872321897045094e-09,
+    8.56068526337722217e-11, -4.87175811095841560e-12, 1.47560624841058146e-13,
+    8.06716517166039579e-15, -1.84326023140813708e-15, 1.89654865036723666e-16,
+    -1.37651338975377517e-17, 6.71255176569675956e-19, -5.62906872100427708e-21,
+    -3.30791573231696112e-21, 4.70718647501578416e-22, -4.20395534527010554e-23,
+    2.67504889954637027e-24, -9.46512097420177816e-26, -4.13474487253375454e-27,
+    1.15359277981592124e-27, 1.43456369913048469e+01, 2.95496734052786314e+00,
+    5.51483381847114179e-02, -7.56164455657397155e-04, 2.45821187515109400e-05,
+    -1.00598201970335634e-06, 3.98920320697851662e-08, -1.16801661465682177e-09,
+    -2.88519038820206467e-12, 3.96965221826718989e-12, -3.98274131400257570e-13,
+    2.83388292652328315e-14, -1.65185474957404227e-15, 7.98522339242791058e-17,
+    -2.91850720175165642e-18, 3.94557966189967214e-20, 5.87594294632177989e-21,
+    -7.76752674942763202e-22, 6.38385792137649147e-23, -4.20250113064267064e-24,
+    2.30637322717764771e-25, -1.00840621231560757e-26, 2.66471923896077189e-28,
+    7.85728861648952063e-30, -1.87509341856351432e-30, 2.06719167453016084e+01,
+    3.36530094659923051e+00, 4.79101507707979032e-02, -4.82136069476319100e-04,
+    1.16317288422414351e-05, -3.87865049372486688e-07, 1.47104464430459570e-08,
+    -5.57038143917778904e-10, 1.87456702622157320e-11, -4.53055504658664415e-13,
+    -1.05865161033765935e-15, 1.07619695863589834e-15, -9.14653649904160244e-17,
+    5.65777076172197393e-18, -2.97914605037282720e-19, 1.39425248425014273e-20,
+    -5.81912022229603013e-22, 2.09082736881514176e-23, -5.62826521679522071e-25,
+    2.77578271575693385e-27, 1.07079472434136439e-27, -1.05409476110175580e-28,
+    7.19167117829308823e-30, -4.12309502260900771e-31, 1.99173255082046650e-32,
+    2.77693883382183415e+01, 3.72811650199818123e+00, 4.30353509861324535e-02,
+    -3.43172373688264347e-04, 6.43134202941103422e-06, -1.68239226145920114e-07,
+    5.28811487202074003e-09, -1.81764424842492057e-10, 6.32313390167864125e-12,
+    -2.07819587668100232e-13, 5.94767214642633494e-15, -1.22391330477406624e-16,
+    -1.52256245860182871e-19, 2.02664506210302912e-19, -1.49210804080726295e-20,
+    8.04424944101688208e-22, -3.74475212351303074e-23, 1.58540651605891171e-24,
+    -6.22342125852919451e-26, 2.26897933053166106e-27, -7.56128281368692442e-29,
+    2.19446877629962956e-30, -4.74260248805356829e-32, 1.42839804208719998e-33,
+    -1.46049687449365380e-33, 3.55579536614690426e+01, 4.05745825427730633e+00,
+    3.94420881655868846e-02, -2.61686926676587368e-04, 4.01746552071599138e-06,
+    -8.50532186224325369e-08, 2.17649817530232657e-09, -6.29883663618528027e-11,
+    1.95415564807736421e-12, -6.18041699263608121e-14, 1.90153402365992216e-15,
+    -5.42752050040736698e-17, 1.34288363237719135e-18, -2.40832633515222980e-20,
+    -5.74752894115555647e-24, 2.85402068066622406e-23, -1.85334281581288491e-24,
+    8.79836092831264788e-26, -3.62619955990851022e-27, 1.37198771451025982e-28,
+    -4.88740032103908174e-30, 1.68326277139444414e-31, -6.21112407064883563e-33,
+    1.95802877679368967e-33, -1.99012760920014383e-33, 4.39791589626180297e+01,
+    4.36141335748065107e+00, 3.66391991516063498e-02, -2.08672327259971642e-04,
+    2.72529132466219369e-06, -4.85433931913506285e-08, 1.03623497573458765e-09,
+    -2.50840946496457363e-11, 6.64639526729715755e-13, -1.86527144756582091e-14,
+    5.35804699676404120e-16, -1.52274136283244394e-17, 4.14153421793119009e-19,
+    -1.03814458284994143e-20, 2.25641621243532649e-22, -3.58688939739385611e-24,
+    1.73238958500886819e-27, 3.14590487505548612e-27, -1.82770302338694985e-28,
+    7.72490500693720301e-30, -2.87477143032201420e-31, 1.32407683676622465e-32,
+    -1.54074395550978868e-33, 2.18272060363886741e-33, -2.29506651706145594e-33,
+    5.29876492349497070e+01, 4.64518591751072485e+00, 3.43685343781712019e-02,
+    -1.71685634461590016e-04, 1.95646717640639261e-06, -3.01982239332681524e-08,
+    5.54022365684305536e-10, -1.14496256588432573e-11, 2.59123419626617392e-13,
+    -6.29102754024299168e-15, 1.60430801802779271e-16, -4.19623819085992789e-18,
+    1.09757303941867163e-19, -2.79914760199793348e-21, 6.78154266415591609e-23,
+    -1.51100479747618850e-24, 2.92454975714767495e-26, -4.17379223950008512e-28,
+    3.95746504739170543e-31, 2.76724034176039324e-31, -1.89062122874013662e-32,
+    4.97531902300035906e-33, -1.34815096107106510e-33, 2.66420308973567638e-33,
+    -2.88889491658085378e-33, 6.25467933362815884e+01, 4.91238375269104655e+00,
+    3.24782746415965898e-02, -1.44585879468010921e-04, 1.46359153112152142e-06,
+    -1.99842478604084857e-08, 3.22590623587739250e-10, -5.82869339991621022e-12,
+    1.14698894262170226e-13, -2.41895611816117004e-15, 5.39861431638049997e-17,
+    -1.25757059934500966e-18, 3.00685934219712215e-20, -7.24013010576749624e-22,
+    1.72107502042715230e-23, -3.95881397097167223e-25, 8.62127205992705614e-27,
+    -1.72616157695237363e-28, 3.00724331166344942e-30, -4.28840400950224498e-32,
+    -4.84692369337454379e-33, 5.48890034150362218e-33, -1.57284278791624250e-33,
+    3.01729024620666939e-33, -3.46667389989702454e-33, 7.26261553302969531e+01,
+    5.16564003307122199e+00, 3.08717862520046619e-02, -1.23994166466015145e-04,
+    1.12995770517894903e-06, -1.38536050975144440e-08, 2.00130415736927141e-10,
+    -3.22224713286725532e-12, 5.62183431390992322e-14, -1.04630599085357942e-15,
+    2.05701764857592750e-17, -4.23773332965172802e-19, 9.06537468526722499e-21,
+    -1.99018752880993168e-22, 4.42025662203305492e-24, -9.77696022905328709e-26,
+    2.11900374723657571e-27, -4.42542750527891589e-29, 8.71643793997256435e-31,
+    -2.04790550753176070e-32, -5.61729567112943813e-33, 6.22717348685206305e-33,
+    -1.79753461476142024e-33, 3.53087156470993217e-33, -3.88395872118092587e-33,
+    8.31999019617676083e+01, 5.40695045077996816e+00, 2.94839582804628172e-02,
+    -1.07897864701057299e-04, 8.94529891213611100e-07, -9.95977194330166224e-09,
+    1.30383766172309046e-10, -1.89720700393082370e-12, 2.98111796589836508e-14,
+    -4.97652469047744071e-16, 8.74053221439124617e-18, -1.60504248182177851e-19,
+    3.06563339419509757e-21, -6.05364856042462628e-23, 1.22580296204327821e-24,
+    -2.51833762390525790e-26, 5.18439797776303791e-28, -1.05504368283477167e-29,
+    2.07101666686440747e-31, -9.30866139787164041e-33, -6.38766764888433179e-33,
+    7.44692911829731151e-33, -1.89383111198078204e-33, 3.94815638599383350e-33,
+    -4.46173770449709662e-33, 9.42457368261156034e+01, 5.63787221494265545e+00,
+    2.82689909641861969e-02, -9.50252422775114947e-05, 7.22818363110023228e-07,
+    -7.37466735936560412e-09, 8.83361829750295392e-11, -1.17403357955705981e-12,
+    1.68122456205879343e-14, -2.55051831930404550e-16, 4.05726983612936793e-18,
+    -6.72480550940490703e-20, 1.15652736915229303e-21, -2.05677356114808023e-23,
+    3.76741596053246101e-25, -7.06767191216066598e-27, 1.34740305827599465e-28,
+    -2.58113131146777349e-30, 4.63507139949194744e-32, -6.86915013498114075e-33,
+    -7.31853378867149624e-33, 8.28149876086511417e-33, -2.37531359807759100e-33,
+    4.68642953134227368e-33, -5.16791201743908264e-33, 1.05744154056190126e+02,
+    5.85964902511726038e+00, 2.71935563483768662e-02, -8.45350866099563788e-05,
+    5.94144840677542164e-07, -5.59577263611248415e-09, 6.18087960214521608e-11,
+    -7.56574242375784818e-13, 9.96346595477445925e-15, -1.38746263164727497e-16,
+    2.02126931120589664e-18, -3.05952281645414787e-20, 4.79093541136106790e-22,
+    -7.73903005319929818e-24, 1.28669489605259128e-25, -2.19614735264149254e-27,
+    3.83329392411057875e-29, -6.75552026826229400e-31, 9.18026606824582378e-33,
+    -6.99754546460695739e-33, -8.15310343123929890e-33, 9.24446373305873209e-33,
+    -2.56790659251631458e-33, 5.64939450353589161e-33, -5.97038282760043114e-33,
+    1.17677897002232626e+02, 6.07329338389730111e+00, 2.62327228456911594e-02,
+    -7.58501026145264008e-05, 4.95516042459254509e-07, -4.33465843655154532e-09,
+    4.44352217244092096e-11, -5.04336482338088986e-13, 6.15202092575065396e-15,
+    -7.92542130231055848e-17, 1.06645993734986632e-18, -1.48816909964011407e-20,
+    2.14329414024174802e-22, -3.17609743940055273e-24, 4.83303264760069212e-26,
+    -7.54072768437880321e-28, 1.20424547562645083e-29, -1.90988052818400881e-31,
+    -3.20988324064539323e-34, -7.57532444792312814e-33, -9.24446373305873209e-33,
+    1.03358240348781653e-32, -3.53087156470993217e-33, 5.71359216834879993e-33,
+    -6.22717348685206305e-33, 1.30031554268123443e+02, 6.27964290755468912e+00,
+    2.53674057505670451e-02, -6.85618799166589141e-05, 4.18448252289681036e-07,
+    -3.41779510945764400e-09, 3.26930594218347063e-11, -3.46010056880538050e-13,
+    3.93271034812708949e-15, -4.71644817272583015e-17, 5.90191302162163450e-19,
+    -7.64869618602199765e-21, 1.02140653955146483e-22, -1.40067691206422395e-24,
+    1.96801015910136950e-26, -2.82915385365925813e-28, 4.15622101765246765e-30,
+    -5.64939450353589147e-32, -2.69630192214213019e-33, -7.96051043680057532e-33,
+    -1.02716263700652583e-32, 1.14271843366975999e-32, -4.04445288321319529e-33,
+    6.41976648129078663e-33, -7.31853378867149624e-33, 1.42791251060294542e+02,
+    6.47940006779492172e+00, 2.45827081491298977e-02, -6.23739801295455524e-05,
+    3.57221315509067831e-07, -2.73662120895620210e-09, 2.45404325252991552e-11,
+    -2.43355194241303670e-13, 2.59007755814669330e-15, -2.90680771898761889e-17,
+    3.40127136496685762e-19, -4.11800733407159671e-21, 5.13176628796456305e-23,
+    -6.55812498805049418e-25, 8.57275008461166690e-27, -1.14443700515680141e-28,
+    1.55743534836114478e-30, -1.57926255439753340e-32, -3.59506922952284049e-33,
+    -9.18026606824582378e-33, -1.17481726607621387e-32, 1.25185446385170330e-32,
+    -3.46667389989702454e-33, 6.41976648129078663e-33, -8.28149876086511417e-33,
+    1.55944408618549858e+02, 6.67316098352389808e+00, 2.38668051728375789e-02,
+    -5.70664575181123023e-05, 3.07871281570639590e-07, -2.22093353640296845e-09,
+    1.87463870789809125e-11, -1.74905640615557162e-13, 1.75065841344089888e-15,
+    -1.84674698487214359e-17, 2.02994462471981475e-19, -2.30724334206419838e-21,
+    2.69709220440932943e-23, -3.23012291932001637e-25, 3.95243978258548058e-27,
+    -4.93270461309755086e-29, 6.26312417914729099e-31, -2.24691826845177505e-33,
+    -3.91605755358737934e-33, -9.50125439231036400e-33, -1.18765679903879540e-32,
+    1.38666955995880981e-32, -4.62223186652936605e-33, 7.44692911829731151e-33,
+    -8.28149876086511417e-33, 1.69479553482756444e+02, 6.86143675110480267e+00,
+    2.32101724026494566e-02, -5.24729796543442408e-05, 2.67585356606928824e-07,
+    -1.82402096321186623e-09, 1.45435033223641739e-11, -1.28132700996766571e-13,
+    1.21059510586171466e-15, -1.20494976185021053e-17, 1.24914968320454878e-19,
+    -1.33836133192037811e-21, 1.47392152740400445e-23, -1.66188664126219021e-25,
+    1.91292722096069987e-27, -2.24433752232629636e-29, 2.66420308973567612e-31,
+    3.46667389989702454e-33, -5.77778983316170756e-33, -1.11703936774459679e-32,
+    -1.38666955995880981e-32, 1.54716372199107938e-32, -4.75062719615518200e-33,
+    7.76791744236185173e-33, -9.56545205712327095e-33, 1.83386164013772401e+02,
+    7.04466955546722584e+00, 2.26050392649954669e-02, -4.84656384570155048e-05,
+    2.34325812917405989e-07, -1.51402093495573678e-09, 1.14391868697788308e-11,
+    -9.54736945830469183e-14, 8.54252075533420593e-16, -8.04962113161757598e-18,
+    7.89739837380835924e-20, -8.00449587650399312e-22, 8.33553551678341372e-24,
+    -8.88258475774974259e-26, 9.65741521196776251e-28, -1.07021359103006175e-29,
+    1.19279261222382814e-31, 6.54816181091660190e-33, -5.52099917391007634e-33,
+    -1.16839749959492304e-32, -1.43802769180913619e-32, 1.59210208736011506e-32,
+    -4.62223186652936605e-33, 8.85927774418128492e-33, -1.05284170293168889e-32};
+
+  /** \brief Sommerfeld coefficients for order 1/2 */
+  static const double s_1o2[9]={
+    7.52252778063675076e-01, 9.28054666138617979e-01, 8.01459086520156738e-01,
+    7.29799428440429310e+00, 1.82583069246197397e+02, 8.92599957915868799e+03,
+    7.21292607725163340e+05, 8.71118928640431911e+07, 1.47008021974679852e+10};
+
+  /** \brief Chebyshev coefficients for order 3/2, 21 rows of 25 */
+  static const double cheb_3o2[525]={
+    9.29056866124100100e-01, -6.59961650056665045e-02, 4.50164175641110890e-03,
+    -3.99234607451648166e-04, 4.08794047753336797e-05, -4.58602009811376718e-06,
+    5.48143845803420182e-07, -6.86474639403411351e-08, 8.91102370374153028e-09,
+    -1.19009478415652340e-09, 1.62658717884406789e-10, -2.26622110679297642e-11,
+    3.20885424993846919e-12, -4.60681510675886487e-13, 6.69334377901434335e-14,
+    -9.82698793507790903e-15, 1.45610850725681763e-15, -2.17528028930566062e-16,
+    3.27347175699865427e-17, -4.95854922544600297e-18, 7.55579428994536457e-19,
+    -1.15757587215295543e-19, 1.78220638092896646e-20, -2.75630205422763818e-21,
+    4.28054045392305769e-22, 2.25921285560374763e+00, 1.63084187854352325e+00,
+    2.57022199025017384e-01, 1.83155979441208816e-02, 6.98454894528201313e-05,
+    -5.04697279751239422e-05, 2.31329310431362022e-06, 2.79279830326145022e-07,
+    -3.94787349556003963e-08, -5.85236432095647458e-10, 5.12750172368020754e-10,
+    -2.69216048021513238e-11, -5.10757772988137034e-12, 7.40168033883685959e-13,
+    2.23691455002878264e-14, -1.28554023935169669e-14, 5.92789341900243682e-16,
+    1.61270735881134529e-16, -2.17075883013052252e-17, -1.03801362320571592e-18,
+    4.44552228567877886e-19, -1.62445849459509762e-20, -6.44670241345627764e-21,
+    7.83110969406123417e-22, 5.32473636531320778e-23, 8.25107987411473154e+00,
+    4.53253116309257642e+00, 4.62169554489668954e-01, 1.50016735240326455e-02,
+    -2.98836122621560227e-04, 4.11957846326110027e-06, 7.19688113569954751e-07,
+    -9.73995599989836968e-08, 6.44605616004335401e-09, -8.91764550196653125e-11,
+    -3.59228663152571920e-11, 5.03811790635467242e-12, -3.34113095415229881e-13,
+    -3.37610617639084475e-16, 2.97538299385242363e-15, -3.85404067421880602e-16,
+    2.32768581258341014e-17, 5.57993978249861442e-19, -3.01396655033094651e-19,
+    3.54859836535299816e-20, -1.83527054076699650e-21, -1.08501453411442890e-22,
+    3.40197264198758023e-23, -3.61636342441824057e-24, 1.48239773196303763e-25,
+    2.15322026978497441e+01, 8.87787198403656852e+00, 6.17564476153874553e-01,
+    1.12302967074157344e-02, -1.70987431827928689e-04, 5.56085267412159036e-06,
+    -1.67954091263649946e-07, 3.42893768069364001e-10, 5.48764107815146220e-10,
+    -5.96584144921940289e-11, 4.27296460044655781e-12, -2.21810239824094341e-13,
+    6.22516187801942904e-15, 3.02981165639371992e-16, -6.53391106253785473e-17,
+    6.29945366200513225e-18, -4.29984525900523761e-19, 1.98400909500592528e-20,
+    -1.69438538014916204e-22, -8.59441099714744061e-23, 1.17010899638214156e-23,
+    -9.98688147475242251e-25, 6.08905370922009352e-26, -2.08271206101998533e-27,
+    -8.34532167180967668e-29, 4.46271200353835908e+01, 1.43180628222124913e+01,
+    7.38930876245880164e-01, 9.18729267765998510e-03, -9.43948092047117198e-05,
+    2.45422267194411554e-06, -8.37345002573916218e-08, 2.84963694715524063e-09,
+    -7.32491416796930629e-11, -1.38162014266767078e-13, 1.97065669450097858e-13,
+    -1.80282853023037983e-14, 1.17745737630452300e-15, -6.34206247066265628e-17,
+    2.85045636170214850e-18, -9.74794381566018294e-20, 1.25726716543486115e-21,
+    1.70944246092944460e-22, -2.14597270520261045e-23, 1.67389320499788913e-24,
+    -1.04810429291125959e-25, 5.48502302724074915e-27, -2.29362624245137832e-28,
+    5.83571217623915368e-30, 1.57589217699485574e-31, 7.95077694043193617e+01,
+    2.06479616699162101e+01, 8.41445770667176740e-01, 7.98308650699260970e-03,
+    -6.02185255533683265e-05, 1.16170183957983877e-06, -3.22756676023807422e-08,
+    1.04940719805598156e-09, -3.47865680258200160e-11, 1.04148493965700385e-12,
+    -2.27065850808650157e-14, -4.39630111521474289e-17, 4.46057994947573535e-17,
+    -3.50644039943764533e-18, 2.01565294174270070e-19, -9.91108976717356929e-21,
+    4.35050517774117406e-22, -1.70985057529791520e-23, 5.80708272238021503e-25,
+    -1.48394082810092432e-26, 7.20244836127355560e-29, 2.53295096402568633e-29,
+    -2.38773584621888867e-30, 1.60076877210985746e-31, -1.29037306273944802e-32,
+    1.27828071606581631e+02, 2.77478706627252762e+01, 9.32114918592967356e-01,
+    7.17148660735050705e-03, -4.28755168077648015e-05, 6.42605391453901416e-07,
+    -1.40047884767564687e-08, 3.77270838437075785e-10, -1.13472878284264977e-11,
+    3.50954790529567493e-13, -1.03848598168811419e-14, 2.70355654666917990e-16,
+    -5.10808312431736391e-18, -5.28212174815974426e-21, 7.20928861665532476e-21,
+    -4.96121096236827341e-22, 2.50887355479695455e-23, -1.09956726028649845e-24,
+    4.39760382006418016e-26, -1.63576112166475897e-27, 5.66604737778836013e-29,
+    -1.78995929031349700e-30, 4.73136789671130923e-32, 5.20001084984553680e-33,
+    -6.67655714054241717e-33, 1.91045595180830844e+02, 3.55382326173862495e+01,
+    1.01442998530099571e+00, 6.57301178334436086e-03, -3.27002341822456121e-05,
+    4.01528902254068866e-07, -7.08251918800589044e-09, 1.55324572832446382e-10,
+    -3.93291013699540259e-12, 1.08458561891872457e-13, -3.08749473606783717e-15,
+    8.63723245467065825e-17, -2.26046340586340985e-18, 5.16495915348492249e-20,
+    -8.61135841360396611e-22, -1.29806217498034551e-25, 8.89131973340740691e-25,
+    -5.44034220364364345e-26, 2.44017160007076444e-27, -9.53102926925058983e-29,
+    3.41184909414680099e-30, -1.01689101063646053e-31, -2.56790659251631433e-34,
+    9.50125439231036400e-33, -1.00148357108136264e-32, 2.70481364778749366e+02,
+    4.39608393630422256e+01, 1.09040550745197784e+00, 6.10607897671361453e-03,
+    -2.60779729833475350e-05, 2.72425508968645937e-07, -4.04319242472508148e-09,
+    7.39693097291327097e-11, -1.56659012094812985e-12, 3.68946512238910721e-14,
+    -9.31874353101494114e-16, 2.43359339206641313e-17, -6.34043007603977558e-19,
+    1.59202992373770614e-20, -3.70637819241530865e-22, 7.52132960974167191e-24,
+    -1.12188605904242472e-25, 5.63397422444783174e-29, 8.71630954464293949e-29,
+    -4.82034586014199994e-30, 1.73590485654102866e-31, 1.52790442254720702e-32,
+    -5.90618516278752351e-33, 1.28395329625815733e-32, -1.47654629069688091e-32,
+    3.67353564903738231e+02, 5.29704649677606270e+01, 1.16133940078629649e+00,
+    5.72776298516579959e-03, -2.14569295297070940e-05, 1.95591315404070846e-07,
+    -2.51556452563410895e-09, 3.95545173046199219e-11, -7.15208414456438387e-13,
+    1.43868327124897016e-14, -3.14341565102606556e-16, 7.28732020449259833e-18,
+    -1.74726626802385727e-19, 4.21882648135003591e-21, -9.99155927413069520e-23,
+    2.25953934472150897e-24, -4.72058595026411339e-26, 8.60167305853982581e-28,
+    -1.16133575646550322e-29, -1.05284170293168889e-32, -1.92592994438723585e-32,
+    2.88889491658085378e-32, -8.47409175530383775e-33, 1.72049741698593060e-32,
+    -1.87457181253690947e-32, 4.82798928906367280e+02, 6.25305541989607931e+01,
+    1.22813208464262869e+00, 5.41280184167757840e-03, -1.80707369025188143e-05,
+    1.46326894049793358e-07, -1.66486826391738073e-09, 2.30339946209626493e-11,
+    -3.64142152737378068e-13, 6.36916156216702384e-15, -1.20884927378091240e-16,
+    2.45254884410830832e-18, -5.23686077638998933e-20, 1.15582241044800587e-21,
+    -2.58434688791140899e-23, 5.73404261694467637e-25, -1.23659062163325893e-26,
+    2.53500914115958797e-28, -4.80763472250904419e-30, 5.13581318503262931e-32,
+    -3.54371109767251397e-32, 3.95457615247512447e-32, -1.23259516440783095e-32,
+    2.15704153771370416e-32, -2.49086939474082522e-32, 6.17887449217187623e+02,
+    7.26107194371709426e+01, 1.29144100680942198e+00, 5.14510938238324673e-03,
+    -1.54975391076147045e-05, 1.12975757476321220e-07, -1.15419857086513150e-09,
+    1.42910140995562875e-11, -2.01325051679775099e-13, 3.12209849792297091e-15,
+    -5.22941108760307080e-17, 9.34595959594256939e-19, -1.76489297587994081e-20,
+    3.48498247246455926e-22, -7.10432080670281989e-24, 1.47271210314127597e-25,
+    -3.05392246091155174e-27, 6.23272016509189746e-29, -1.24851618528143215e-30,
+    -1.38666955995880981e-32, -4.46815747097838718e-32, 5.05877598725713987e-32,
+    -1.59210208736011506e-32, 2.87605538361827239e-32, -3.23556230657055623e-32,
+    7.73633062200538916e+02, 8.31851599826273684e+01, 1.35176458716116743e+00,
+    4.91384395842860058e-03, -1.34859881161392486e-05, 8.94399507447438749e-08,
+    -8.29822894691477665e-10, 9.31099678518928911e-12, -1.18544334466360994e-13,
+    1.65569106259829236e-15, -2.48745982399780875e-17, 3.97157571863484526e-19,
+    -6.68515465396873243e-21, 1.17861830422260280e-22, -2.16111790197214267e-24,
+    4.08427603000807015e-26, -7.86656100620677298e-28, 1.52764763188795548e-29,
+    -3.17906836153519746e-31, -4.00593428432545057e-32, -5.90618516278752365e-32,
+    6.77927340424307020e-32, -1.95160901031239891e-32, 3.46667389989702454e-32,
+    -4.28840400950224498e-32, 9.51001721065655943e+02, 9.42316023306335069e+01,
+    1.40949181004623325e+00, 4.71137802430384757e-03, -1.18772334512690158e-05,
+    7.22730026927048234e-08, -6.14457777148837263e-10, 6.30852648067206749e-12,
+    -7.33611579828205870e-14, 9.33788241708433750e-16, -1.27492291937655203e-17,
+    1.84368786761808035e-19, -2.80114530653244674e-21, 4.44673318155552550e-23,
+    -7.34309524515365156e-25, 1.25534923064972241e-26, -2.20790663149826746e-28,
+    4.00542070300694708e-30, -1.02202682382149309e-31, -5.85482703093719699e-32,
+    -6.93334779979404907e-32, 8.16594296420188002e-32, -2.61926472436664076e-32,
+    4.57087373467903994e-32, -5.34124571243393373e-32, 1.15091768145318883e+03,
+    1.05730557278015937e+02, 1.46493339005096757e+00, 4.53216036725603150e-03,
+    -1.05661863546650335e-05, 5.94083031881520761e-08, -4.66251338489175695e-10,
+    4.41420232539267092e-12, -4.72772185070387540e-14, 5.53413593636847367e-16,
+    -6.93578339682813710e-18, 9.18541008029176472e-20, -1.27447871385188827e-21,
+    1.84217258220589636e-23, -2.76315445827221637e-25, 4.28761925724757218e-27,
+    -6.86118962454434026e-29, 1.18175061387600792e-30, -5.34124571243393373e-32,
+    -7.24149659089600681e-32, -8.73088241455546884e-32, 9.03903120565742657e-32,
+    -2.87605538361827239e-32, 5.44396197613458704e-32, -6.67655714054241799e-32,
+    1.37426851367521385e+03, 1.17664780640809781e+02, 1.51834230849997875e+00,
+    4.37203788827478321e-03, -9.48072099451123124e-06, 4.95471607237530109e-08,
+    -3.61179508339100612e-10, 3.17350497882024743e-12, -3.15160767578166166e-14,
+    3.41719692545183503e-16, -3.96196656660544789e-18, 4.84657094515965859e-20,
+    -6.19938120687816317e-22, 8.24158012492285264e-24, -1.13405057795461127e-25,
+    1.61051192330318293e-27, -2.35672195434777277e-29, 4.18055193261655967e-31,
+    -4.51951560282871329e-32, -8.52544988715416441e-32, -1.07852076885685208e-31,
+    1.17096540618743940e-31, -3.33827857027120899e-32, 6.72791527239274355e-32,
+    -7.44692911829731233e-32, 1.62190917837192296e+03, 1.30018870565248164e+02,
+    1.56992786735865142e+00, 4.22783121705245894e-03, -8.56980776519368233e-06,
+    4.18415559230259165e-08, -2.84787424950063636e-10, 2.33493762224904163e-12,
+    -2.16226807749256716e-14, 2.18451119823607029e-16, -2.35784165155360367e-18,
+    2.68222346139775986e-20, -3.18637312755430279e-22, 3.92772974702788258e-24,
+    -5.00140042853043808e-26, 6.55744736115514119e-28, -8.84078881671516746e-30,
+    1.93106575757226841e-31, -5.03309692133197600e-32, -1.01689101063646053e-31,
+    -1.29422492262822249e-31, 1.41748443906900559e-31, -3.69778549322349284e-32,
+    8.42273362345351110e-32, -8.93631494195677436e-32, 1.89466539509411723e+03,
+    1.42778959706219979e+02, 1.61986561044376276e+00, 4.09705848796906424e-03,
+    -7.79640543854207487e-06, 3.57196775076542526e-08, -2.28031487813496743e-10,
+    1.75270303198150062e-12, -1.52078828852571126e-14, 1.43874301722788646e-16,
+    -1.45319795912708244e-18, 1.54579917651150290e-20, -1.71556313255561084e-22,
+    1.97342652815079530e-24, -2.34177036957097828e-26, 2.85576892153739332e-28,
+    -3.58377044051576848e-30, 1.07852076885685208e-31, -6.36840834944046025e-32,
+    -1.22232353803776562e-31, -1.45857094454926669e-31, 1.62291696647031067e-31,
+    -4.62223186652936605e-32, 7.90915230495024893e-32, -1.00661938426639520e-31,
+    2.19333646532537659e+03, 1.55932475215963422e+02, 1.66830451249535416e+00,
+    3.97774955025933467e-03, -7.13302957307198738e-06, 3.07852535183560647e-08,
+    -1.85063219230196075e-10, 1.33890260146910525e-12, -1.09304483216067774e-14,
+    9.72475232765792086e-17, -9.23258130268946969e-19, 9.22579507039511684e-21,
+    -9.61216802470794842e-23, 1.03719110624702046e-24, -1.15342958293220029e-26,
+    1.31573370824713914e-28, -1.54793409396883430e-30, 9.34717999675938431e-32,
+    -6.16297582203915473e-32, -1.43802769180913603e-31, -1.69481835106076755e-31,
+    1.88997925209200752e-31, -5.75211076723654478e-32, 9.55261252416068983e-32,
+    -1.23259516440783095e-31, 2.51869766669476576e+03, 1.69467948396555101e+02,
+    1.71537230602111412e+00, 3.86831746954880784e-03, -6.55889445417262828e-06,
+    2.67570813103606460e-08, -1.51991069209239110e-10, 1.03873519480416508e-12,
+    -8.00754071869675427e-15, 6.72483439385218170e-17, -6.02407962858501026e-19,
+    5.67728314109442703e-21, -5.57581307776693569e-23, 5.66819303836405550e-25,
+    -5.93439721177554452e-27, 6.35875302065259817e-29, -7.10796544808515816e-31,
+    1.02716263700652586e-31, -7.19013845904568015e-32, -1.58183046099004979e-31,
+    -1.93106575757226841e-31, 2.10568340586337772e-31, -6.67655714054241799e-32,
+    1.02716263700652586e-31, -1.42775606543907092e-31, 2.87150230472045041e+03,
+    1.83374861494139907e+02, 1.76117950527642075e+00, 3.76746748986375810e-03,
+    -6.05801555451006857e-06, 2.34314373730536224e-08, -1.26160455105096158e-10,
+    8.17023758407378352e-13, -5.96660281011970634e-15, 4.74540611972044995e-17,
+    -4.02441034101474214e-19, 3.58934764549710530e-21, -3.33483648582311142e-23,
+    3.20560354697505281e-25, -3.17183713657067137e-27, 3.19837901911092019e-29,
+    -3.49235296582218753e-31, 1.12987890070717829e-31, -7.60100351384829120e-32,
+    -1.76671973565122443e-31, -2.17758479045383482e-31, 2.54736333977618410e-31,
+    -6.98470593164437573e-32, 1.23259516440783095e-31, -1.59210208736011490e-31};
+
+  /** \brief Sommerfeld coefficients for order 3/2 */
+  static const double s_3o2[9]={
+    3.00901111225470030e-01, 1.85610933227723596e+00, -5.34306057680104418e-01,
+    -2.08514122411551250e+00, -3.31969216811268026e+01, -1.19013327722115832e+03,
+    -7.59255376552803500e+04, -7.57494720556897298e+06, -1.08894831092355442e+09};
+
+  /** \brief Chebyshev coefficients for order 5/2, 21 rows of 25 */
+  static const double cheb_5o2[525]={
+    9.62054948626933415e-01, -3.61048529137884960e-02, 1.71189906549937894e-03,
+    -1.17410416317689946e-04, 9.84255101459265029e-06, -9.36832549878951359e-07,
+    9.73662710713040973e-08, -1.07954312925612278e-08, 1.25785181377245123e-09,
+    -1.52443479506750945e-10, 1.90756992251754737e-11, -2.45117625245936499e-12,
+    3.22095428331286139e-13, -4.31420673076969946e-14, 5.87492260320985051e-15,
+    -8.11672380209030389e-16, 1.13577442733983965e-16, -1.60737493931464892e-17,
+    2.29792603388730700e-18, -3.31518213801460271e-19, 4.82229274520349015e-20,
+    -7.06722301414502971e-21, 1.04282168031460996e-21, -1.54842399259920106e-22,
+    2.31244122877334386e-23, 2.69566452821007019e+00, 2.13070175609123913e+00,
+    4.03131570149850571e-01, 4.28253922559274289e-02, 2.29575845901200089e-03,
+    6.75321963485065132e-06, -4.22908398378750676e-06, 1.68055131376372900e-07,
+    1.74915666723900425e-08, -2.22174917377602317e-09, -2.79157413646748056e-11,
+    2.35389886408137357e-11, -1.15257386816812531e-12, -1.97305649053140689e-13,
+    2.68936941527572474e-14, 7.25878538612919483e-16, -4.06771035293690708e-16,
+    1.80734391235749675e-17, 4.50857637512056226e-18, -5.82951066575608082e-19,
+    -2.55442259564941947e-20, 1.07380697852699247e-20, -3.86993088985399882e-22,
+    -1.41303256024036334e-22, 1.66930523918038291e-23, 1.22404075583524463e+01,
+    8.01999509686989676e+00, 1.12938237239213590e+00, 7.70780651020484125e-02,
+    1.87469424319617315e-03, -2.99555810735130201e-05, 3.51414835271673652e-07,
+    5.09458612435650953e-08, -6.08189897149775197e-09, 3.60109945908811731e-10,
+    -4.71072864630099905e-12, -1.61767060090190743e-12, 2.09935646540512978e-13,
+    -1.29649414772723960e-14, 1.70690892081414752e-18, 9.84035378575529907e-17,
+    -1.20613144187540773e-17, 6.93478081790212092e-19, 1.45141109610086958e-20,
+    -7.88319432874603400e-21, 8.89862127673094254e-22, -4.45069111230882697e-23,
+    -2.38375204530929375e-24, 7.36336666650407320e-25, -7.57088864607521462e-26,
+    4.05770035272164762e+01, 2.12234204597728038e+01, 2.21666042183228829e+00,
+    1.02955910597617079e-01, 1.40309198184270173e-03, -1.70819477736665059e-05,
+    4.63375815029460041e-07, -1.20359182408189344e-08, 2.51595114100973769e-11,
+    3.02495079563721996e-11, -2.97183021261849685e-12, 1.93942701753115400e-13,
+    -9.25471754123890554e-15, 2.41942345717107956e-16, 1.05957754277631032e-17,
+    -2.16363753664926931e-18, 1.96237924095470007e-19, -1.26416202165432076e-20,
+    5.53500973888167545e-22, -4.76683231767958487e-24, -2.12363554744405700e-24,
+    2.77147606965998669e-25, -2.26501240435341764e-26, 1.32552323422858377e-27,
+    -4.38680779506909085e-29, 1.04923875627878488e+02, 4.42576545972606539e+01,
+    3.57721888238370767e+00, 1.23170878509180820e-01, 1.14810480687350513e-03,
+    -9.43110747044543218e-06, 2.04281086249746681e-07, -5.97580365112228010e-09,
+    1.78110944323094209e-10, -4.08034485273017578e-12, -6.00668644822316382e-15,
+    8.90400963971787905e-15, -7.48536028233215403e-16, 4.51771892285700324e-17,
+    -2.26154090244535156e-18, 9.49733031512184325e-20, -3.05157445008625385e-21,
+    3.76096144883052606e-23, 4.70195424295440638e-24, -5.61971496783163242e-25,
+    4.17101988260443903e-26, -2.49002028432717711e-27, 1.24525526489726044e-28,
+    -4.98501287038710861e-30, 1.17706418434466557e-31, 2.26949357871225914e+02,
+    7.90870465189857725e+01, 5.15999464585230427e+00, 1.40250998198788335e-01,
+    9.97740600644128834e-04, -6.01862498857659468e-06, 9.67210360318152403e-08,
+    -2.30292007388249447e-09, 6.55228570697702791e-11, -1.93132563559661936e-12,
+    5.20764451334077956e-14, -1.03414504001635324e-15, -1.68569044802956202e-18,
+    1.70785516156088448e-18, -1.24876046773936103e-19, 6.70434145520351005e-21,
+    -3.09187226923117909e-22, 1.27785238179523896e-23, -4.74546295303428705e-25,
+    1.52798861136484285e-26, -3.71632128498492358e-28, 1.78552965144140636e-30,
+    5.69433286890492705e-31, -4.03803311673190432e-32, -8.66668474974256134e-33,
+    4.31918940140133316e+02, 1.27362014147285137e+02, 6.93517479402948123e+00,
+    1.55359632351629195e-01, 8.96355500244881698e-04, -4.28615120192880471e-06,
+    5.35190100512886929e-08, -9.99531513494860284e-10, 2.35574927279091393e-11,
+    -6.29827942700534265e-13, 1.75342217437450281e-14, -4.71806896988946555e-16,
+    1.12650390328611142e-17, -1.96742015882085171e-19, -1.70928594694880341e-22,
+    2.39473329343282138e-22, -1.54694227895125972e-23, 7.36610591202970624e-25,
+    -3.04981121677786719e-26, 1.15574555220892483e-27, -4.08770926976413261e-29,
+    1.37639793358874461e-30, -4.78914579504292631e-32, 2.18272060363886721e-32,
+    -2.09284387290079638e-32, 7.48196098357166193e+02, 1.90538380188180355e+02,
+    8.88291490140072604e+00, 1.69077114255862998e-01, 8.21576281805263338e-04,
+    -3.26931516630576104e-06, 3.34477981401030326e-08, -5.05613305562063967e-10,
+    9.70100714190965748e-12, -2.18323480125518602e-13, 5.41860947836628800e-15,
+    -1.40237921484635180e-16, 3.59669478979887098e-18, -8.69077796162415254e-20,
+    1.84463290506879285e-21, -2.87341658277413102e-23, -2.35635012147317653e-27,
+    2.60792002118969498e-26, -1.50858606125170694e-27, 6.40767164124003396e-29,
+    -2.42898284586118186e-30, 1.36099049403364660e-31, -1.61778115328527812e-32,
+    3.51803203174735064e-32, -3.95457615247512447e-32, 1.20691574034629798e+03,
+    2.69936162025023350e+02, 1.09886833210163779e+01, 1.81738597570826860e-01,
+    7.63225818900580780e-04, -2.60739297909228113e-06, 2.26959616382430656e-08,
+    -2.88687559614580984e-10, 4.62077594236930137e-12, -8.69810136997238003e-14,
+    1.84351576449852033e-15, -4.23291050042677589e-17, 1.01333390089286321e-18,
+    -2.43720142225041951e-20, 5.68313496753472842e-22, -1.23508544359492055e-23,
+    2.35039776534985529e-25, -3.30218048013756973e-27, 1.65784049612853262e-30,
+    2.21353548274906319e-30, -1.98242388942259463e-31, 9.39853812860971096e-32,
+    -2.05432527401305167e-32, 6.16297582203915473e-32, -6.06025955833850252e-32,
+    1.84174763786800645e+03, 3.66772895203345058e+02, 1.32411843011938650e+01,
+    1.93560142952637709e-01, 7.15945924231299407e-04, -2.14544139651814578e-06,
+    1.62959800738971853e-08, -1.79632094087118027e-10, 2.47125815449421429e-12,
+    -3.97163373828519910e-14, 7.18977269614260426e-16, -1.42803108398093427e-17,
+    3.03462557417260558e-19, -6.71641196962957031e-21, 1.50591676577722246e-22,
+    -3.32894636014272116e-24, 7.05837054361751757e-26, -1.38797611083308212e-27,
+    2.38394176422844561e-29, -4.06756404254584212e-31, -1.18123703255750473e-31,
+    1.44829931817920136e-31, -3.38963670212153510e-32, 7.80643604124959563e-32,
+    -9.75804505156199535e-32, 2.68871358213827034e+03, 4.82184862864046011e+02,
+    1.56312853492797785e+01, 2.04691692563255173e-01, 6.76581939347941112e-04,
+    -1.80690720342548963e-06, 1.21919883379310325e-08, -1.18893151554617368e-10,
+    1.43922659121253014e-12, -2.02234037672222209e-14, 3.18335450666145794e-16,
+    -5.49238903501493878e-18, 1.02141375904259588e-19, -2.01318324216674207e-21,
+    4.12588932036623558e-23, -8.61036957209254704e-25, 1.79109327786475221e-26,
+    -3.63431711388285946e-28, 6.95491821517118611e-30, -2.78361074628768474e-31,
+    -1.92079413120220330e-31, 2.05432527401305172e-31, -6.26569208573980694e-32,
+    1.27368166988809205e-31, -1.39694118632887515e-31, 3.78604003003014031e+03,
+    6.17241728713783004e+02, 1.81513935819471399e+01, 2.15242750724754933e-01,
+    6.43124550828221377e-04, -1.54963849090438409e-06, 9.41345553851847182e-09,
+    -8.24283747009608369e-11, 8.92993250066147764e-13, -1.11818198649388372e-14,
+    1.56058195098168854e-16, -2.37620281573972308e-18, 3.89269775563888070e-20,
+    -6.78531747668378205e-22, 1.24411064590456343e-23, -2.36709179800918874e-25,
+    4.60025058609742663e-27, -8.96055598019012874e-29, 1.61675399064827147e-30,
+    -2.42410382333540101e-31, -2.58844984525644499e-31, 2.93768514183866361e-31,
+    -8.21730109605220667e-32, 1.78726298839135487e-31, -1.93106575757226841e-31,
+    5.17403583580331269e+03, 7.72957179906958345e+02, 2.07950615346672372e+01,
+    2.25296345524880565e-01, 6.14219314809732043e-04, -1.34851582932445578e-06,
+    7.45255331232989020e-09, -5.92645964540722292e-11, 5.81833818382918246e-13,
+    -6.58441443711783518e-15, 8.27646952513215003e-17, -1.13035968569667043e-18,
+    1.65433212517419155e-20, -2.57038212996795417e-22, 4.20789262515933189e-24,
+    -7.20114183607834884e-26, 1.27582022249833950e-27, -2.28584773239432249e-29,
+    2.56790659251631432e-31, -3.08148791101957736e-31, -3.63615573500310129e-31,
+    4.14973705350636389e-31, -1.27368166988809205e-31, 2.42410382333540101e-31,
+    -2.58844984525644499e-31, 6.89498856606540176e+03, 9.50296975160632883e+02,
+    2.35567227381523026e+01, 2.34917281213280732e-01, 5.88913218912644459e-04,
+    -1.18766189934918683e-06, 6.02222451385201255e-09, -4.38846011422038838e-11,
+    3.94224543276897480e-13, -4.07491159742371231e-15, 4.66801936460836274e-17,
+    -5.79383093111947109e-19, 7.68017997675209724e-21, -1.07708115382899030e-22,
+    1.58767092828732150e-24, -2.44701489138635872e-26, 3.92129608303611270e-28,
+    -6.17119312313520717e-30, -1.19150865892756984e-31, -4.02647753706558080e-31,
+    -4.93038065763132378e-31, 5.42341872339445616e-31, -1.56128720824991913e-31,
+    3.20474742746036046e-31, -3.57452597678270974e-31, 8.99307506720755191e+03,
+    1.15018521475816351e+03, 2.64315062794121722e+01, 2.44157326039553702e-01,
+    5.66512619869105399e-04, -1.05657201033265448e-06, 4.95032408215222376e-09,
+    -3.33002900907620470e-11, 2.75853056987439622e-13, -2.62612681798010717e-15,
+    2.76660869768023029e-17, -3.15204950823589146e-19, 3.82648662886321613e-21,
+    -4.90077846563017024e-23, 6.57766052491024299e-25, -9.20889103661392209e-27,
+    1.33896812709622676e-28, -1.60237371373018023e-30, -2.71170936169722808e-31,
+    -5.25907270147341174e-31, -6.65601388780228711e-31, 7.43665749192724700e-31,
+    -2.21867129593409570e-31, 4.02647753706558080e-31, -4.88929415215106246e-31,
+    1.15142832625831688e+04, 1.37350934252096386e+03, 2.94151021507303767e+01,
+    2.53058631536828893e-01, 5.46498542639257392e-04, -9.48035981500289148e-07,
+    4.12866560156451557e-09, -2.57962851615959156e-11, 1.98322703695481389e-13,
+    -1.75067304395833417e-15, 1.70835613417866855e-17, -1.80061210385943286e-19,
+    2.01906116213925538e-21, -2.38394122928214425e-23, 2.94285119469172970e-25,
+    -3.78019680591580041e-27, 5.02241442990710831e-29, -1.47911419728939714e-31,
+    -3.53343947130244886e-31, -6.57384087684176534e-31, -8.25838760153246734e-31,
+    9.49098276594029828e-31, -2.50627683429592278e-31, 5.42341872339445616e-31,
+    -6.32732184396019915e-31, 1.45063429919344744e+04, 1.62112421443824360e+03,
+    3.25036606835077748e+01, 2.61656072861069400e-01, 5.28473671937067084e-04,
+    -8.56952297776873289e-07, 3.48660174878363926e-09, -2.03404144478063359e-11,
+    1.45919948195576120e-13, -1.20112905184856264e-15, 1.09212148794497513e-17,
+    -1.07160137011335169e-19, 1.11742945458936910e-21, -1.22533578286109938e-23,
+    1.40253273103269483e-25, -1.66790668997119646e-27, 2.03953413204015770e-29,
+    4.02647753706558080e-31, -4.51951560282871318e-31, -8.62816615085481662e-31,
+    -1.10111834687099559e-30, 1.16685675563941335e-30, -3.69778549322349284e-31,
+    6.82035990972333153e-31, -7.72426303028907364e-31, 1.80186642633669217e+04,
+    1.89385546228889530e+03, 3.56937156619329983e+01, 2.69978901141533556e-01,
+    5.12127846036444594e-04, -7.79617740705426187e-07, 2.97649373371852240e-09,
+    -1.62868771379008208e-11, 1.09534947354986108e-13, -8.44801649294332898e-16,
+    7.19294218655129132e-18, -6.60466546739258921e-20, 6.44000765445623158e-22,
+    -6.59741932943584132e-24, 7.04700704336431399e-26, -7.81654332159774050e-28,
+    8.81716407606401783e-30, 4.93038065763132378e-31, -5.01255366859184555e-31,
+    -1.16685675563941335e-30, -1.29833357317624854e-30, 1.47911419728939714e-30,
+    -4.76603463571027937e-31, 6.82035990972333153e-31, -1.01894533591047364e-30,
+    2.21022816742828181e+04, 2.19250231306912883e+03, 3.89821243666032942e+01,
+    2.78051940920821195e-01, 4.97214845625727048e-04, -7.13284450985275647e-07,
+    2.56532621797954930e-09, -1.32180206272767478e-11, 8.36753346216142875e-14,
+    -6.07195836859806584e-16, 4.86191487407555803e-18, -4.19619094819369458e-20,
+    3.84364913292308868e-22, -3.69654435206594536e-24, 3.70387615679588692e-26,
+    -3.85868024868419489e-28, 4.01004293487347644e-30, 6.73818689876280888e-31,
+    -6.90253292068385330e-31, -1.42159308961703163e-30, -1.70098132688280671e-30,
+    1.90641385428411175e-30, -5.25907270147341174e-31, 1.02716263700652573e-30,
+    -1.25724706769598756e-30, 2.68098040329685973e+04, 2.51783998054175527e+03,
+    4.23660200197713905e+01, 2.85896477485928058e-01, 4.83536339058437210e-04,
+    -6.55874246310341973e-07, 2.22967021459715357e-09, -1.08559329763228870e-11,
+    6.49167466537641664e-14, -4.44829906151883935e-16, 3.36213333276921206e-18,
+    -2.73796456701583700e-20, 2.36529848807326667e-22, -2.14431556785226990e-24,
+    2.02424502162084297e-26, -1.99581809020915987e-28, 1.75850243455517203e-30,
+    8.54599313989429397e-31, -8.05295507413116160e-31, -1.64346021921044138e-30,
+    -2.08719447839726052e-30, 2.31727890908672218e-30, -6.90253292068385330e-31,
+    1.01894533591047364e-30, -1.46267959509729278e-30, 3.21953684137404016e+04,
+    2.87062171496781230e+03, 4.58427735066625104e+01, 2.93530927215329196e-01,
+    4.70930507303298103e-04, -6.05788939405496367e-07, 1.95255169577460093e-09,
+    -9.01103489302043036e-12, 5.10610190216363201e-14, -3.31455576060312256e-16,
+    2.37252359247803524e-18, -1.82912584434349631e-20, 1.49542797721656578e-22,
+    -1.28250785656075952e-24, 1.14488697942900807e-26, -1.07893163391165476e-28,
+    8.87468518373638281e-31, 1.00251073371836911e-30, -9.69641529334160403e-31,
+    -1.98858686524463404e-30, -2.38301731785513995e-30, 2.66240555512091484e-30,
+    -8.05295507413116160e-31, 1.28189897098414418e-30, -1.80780624113148527e-30};
+
+  /** \brief Sommerfeld coefficients for order 5/2 */
+  static const double s_5o2[9]={
+    8.59717460644199988e-02, 1.23740622151815738e+00, 1.06861211536020884e+00,
+    8.34056489646204935e-01, 7.37709370691706745e+00, 1.83097427264793595e+02,
+    8.93241619473886385e+03, 7.21423543387521291e+05, 8.71158648738843501e+07};
+
+}
+
+namespace o2scl {
+
+  /** \brief Compute several Fermi-Dirac integrals with
+      piecewise polynomial approximations
+
+      This class computes the Fermi-Dirac integral
+      \f[
+      F_{a}(\mu) = \int_0^{\infty} \frac{x^a}{1+e^{x-\mu}} \, .
+      \f]
+      for \f$ a \in [-1/2,1/2,3/2,5/2,2,3] \f$ using the same
+      normalization as \ref o2scl::fermi_dirac_integ_gsl, so it can
+      be used as the \c fd_inte_t template parameter in 
+      \ref o2scl::fermion_thermo_tl and related classes. 
+
+      For \f$ \mu \leq 0 \f$, the integral is obtained from a
+      Chebyshev expansion in \f$ e^{\mu} \f$. For the integer orders
+      and \f$ \mu>0 \f$, the exact reflection formulas
+      \f[
+      F_2(\mu)-F_2(-\mu) = \frac{\mu^3}{3}+\frac{\pi^2 \mu}{3}
+      \quad \mathrm{and} \quad
+      F_3(\mu)+F_3(-\mu) = \frac{\mu^4}{4}+\frac{\pi^2 \mu^2}{2}
+      +\frac{7 \pi^4}{60}
+      \f]
+      are used. For the half-integer orders, Chebyshev expansions
+      on intervals of width 2 are used for \f$ 0<\mu<40 \f$ and 
+      the Sommerfeld expansion is used for \f$ \mu \geq 40 \f$. 
+      The relative accuracy is about \f$ 10^{-15} \f$ everywhere.
+
+      The functions ending in <tt>_vec</tt> evaluate an entire
+      array of arguments. They process the arguments in blocks,
+      first computing the interval and expansion variable for each
+      argument and then running the Clenshaw recurrence across the
+      block, so that the inner loops have a fixed trip count and no
+      branches and can be vectorized by the compiler. The output
+      vector must already have at least \c n elements. 
+
+      Unlike \ref o2scl::fermi_dirac_integ_gsl, the functions in
+      this class never throw exceptions. The result is <tt>inf</tt>
+      only if the argument is <tt>inf</tt>.
+  */
+  class fermi_dirac_integ_vec {
+
+  protected:
+
+    /// The number of Chebyshev coefficients in each row
+    static const size_t n_cheb=25;
+
+    /// The number of Sommerfeld coefficients
+    static const size_t n_somm=9;
+
+    /// The number of arguments processed at once by the array functions
+    static const size_t block=64;
+
+    /// The value of \f$ \mu \f$ above which the Sommerfeld expansion is used
+    static constexpr double mu_somm=40.0;
+
+    /** \brief Evaluate a Chebyshev series with coefficients \c c
+        at \c x using the Clenshaw recurrence
+    */
+    double cheb_sum(const double *c, double x) const {
+      double b1=0.0, b2=0.0;
+      for(size_t j=n_cheb-1;j>=1;j--) {
+        double tmp=2.0*x*b1-b2+c[j];
+        b2=b1;
+        b1=tmp;
+      }
+      return x*b1-b2+c[0];
+    }
+
+    /** \brief Evaluate the Sommerfeld expansion for a
+        half-integer order \f$ a=p-1/2 \f$
+    */
+    double somm_sum(const double *s, size_t p, double mu) const {
+      if (std::isinf(mu)) return mu;
+      double x2=1.0/mu/mu;
+      double sum=s[n_somm-1];
+      for(size_t k=n_somm-1;k>=1;k--) {
+        sum=sum*x2+s[k-1];
+      }
+      double pw=sqrt(mu);
+      for(size_t k=0;k<p;k++) pw*=mu;
+      return pw*sum;
+    }
+
+    /** \brief Compute a half-integer order \f$ a=p-1/2 \f$ for
+        one argument
+    */
+    double calc_half(const double *c, const double *s, size_t p,
+                     double norm, double mu) const {
+      if (mu<=0.0) {
+        double t=exp(mu);
+        return norm*t*cheb_sum(c,2.0*t-1.0);
+      }
+      if (mu<mu_somm) {
+        size_t row=1+((size_t)(mu/2.0));
+        return norm*cheb_sum(c+row*n_cheb,mu-2.0*row+1.0);
+      }
+      return norm*somm_sum(s,p,mu);
+    }
+
+    /** \brief The polynomial part of the reflection formula for 
+        integer order \c a
+    */
+    double refl_poly(int a, double mu) const {
+      double pi2=o2scl_const::pi2;
+      if (a==2) {
+        return mu*(mu*mu+pi2)/6.0;
+      }
+      double mu2=mu*mu;
+      return mu2*mu2/24.0+pi2*mu2/12.0+7.0*pi2*pi2/360.0;
+    }
+    
+    /** \brief Compute integer order \c a for one argument
+     */
+    double calc_int(const double *c, int a, double norm,
+                    double mu) const {
+      if (std::isinf(mu) && mu>0.0) return mu;
+      double t=exp(-fabs(mu));
+      double f=t*cheb_sum(c,2.0*t-1.0);
+      if (mu<=0.0) return norm*f;
+      if (a==2) return norm*(refl_poly(a,mu)+f);
+      return norm*(refl_poly(a,mu)-f);
+    }
+
+    /** \brief Compute a half-integer order \f$ a=p-1/2 \f$ for
+        an array of arguments
+    */
+    template<class vec_t, class vec2_t>
+    void calc_half_vec(const double *c, const double *s, size_t p,
+                       double norm, size_t n, const vec_t &mu,
+                       vec2_t &res) const {
+      
+      double x[block], pre[block], b1[block], b2[block];
+      size_t off[block];
+      
+      for(size_t i0=0;i0<n;i0+=block) {
+        size_t nb=n-i0;
+        if (nb>block) nb=block;
+        
+        // Determine the expansion variable and the coefficient row
+        bool any_somm=false;
+        for(size_t k=0;k<nb;k++) {
+          double m=mu[i0+k];
+          if (m<=0.0) {
+            double t=exp(m);
+            x[k]=2.0*t-1.0;
+            pre[k]=norm*t;
+            off[k]=0;
+          } else if (m<mu_somm) {
+            size_t row=1+((size_t)(m/2.0));
+            x[k]=m-2.0*row+1.0;
+            pre[k]=norm;
+            off[k]=row*n_cheb;
+          } else {
+            x[k]=0.0;
+            pre[k]=0.0;
+            off[k]=0;
+            any_somm=true;
+          }
+          b1[k]=0.0;
+          b2[k]=0.0;
+        }
+
+        // Clenshaw recurrence across the block
+        for(size_t j=n_cheb-1;j>=1;j--) {
+          for(size_t k=0;k<nb;k++) {
+            double tmp=2.0*x[k]*b1[k]-b2[k]+c[off[k]+j];
+            b2[k]=b1[k];
+            b1[k]=tmp;
+          }
+        }
+        for(size_t k=0;k<nb;k++) {
+          res[i0+k]=pre[k]*(x[k]*b1[k]-b2[k]+c[off[k]]);
+        }
+
+        // Large arguments
+        if (any_somm) {
+          for(size_t k=0;k<nb;k++) {
+            if (mu[i0+k]>=mu_somm) {
+              res[i0+k]=norm*somm_sum(s,p,mu[i0+k]);
+            }
+          }
+        }
+      }
+      
+      return;
+    }
+
+    /** \brief Compute integer order \c a for an array of arguments
+     */
+    template<class vec_t, class vec2_t>
+    void calc_int_vec(const double *c, int a, double norm,
+                      size_t n, const vec_t &mu, vec2_t &res) const {
+      
+      double x[block], t[block], b1[block], b2[block];
+      double sign=(a==2) ? 1.0 : -1.0;
+      
+      for(size_t i0=0;i0<n;i0+=block) {
+        size_t nb=n-i0;
+        if (nb>block) nb=block;
+        
+        for(size_t k=0;k<nb;k++) {
+          t[k]=exp(-fabs(mu[i0+k]));
+          x[k]=2.0*t[k]-1.0;
+          b1[k]=0.0;
+          b2[k]=0.0;
+        }
+        
+        // Clenshaw recurrence across the block
+        for(size_t j=n_cheb-1;j>=1;j--) {
+          for(size_t k=0;k<nb;k++) {
+            double tmp=2.0*x[k]*b1[k]-b2[k]+c[j];
+            b2[k]=b1[k];
+            b1[k]=tmp;
+          }
+        }
+
+        // Apply the reflection formula for positive arguments
+        for(size_t k=0;k<nb;k++) {
+          double m=mu[i0+k];
+          double f=t[k]*(x[k]*b1[k]-b2[k]+c[0]);
+          if (m>0.0) {
+            if (std::isinf(m)) f=m;
+            else f=refl_poly(a,m)+sign*f;
+          }
+          res[i0+k]=norm*f;
+        }
+      }
+      
+      return;
+    }
+
+  public:
+
+    /// \name Functions for one argument
+    //@{
+    /** \brief Fermi-Dirac integral of order \f$ -1/2 \f$
+     */
+    double calc_m1o2(double y) const {
+      return calc_half(o2scl_fd_vec_coeffs::cheb_m1o2,
+                       o2scl_fd_vec_coeffs::s_m1o2,0,
+                       o2scl_const::root_pi,y);
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 1/2 \f$
+     */
+    double calc_1o2(double y) const {
+      return calc_half(o2scl_fd_vec_coeffs::cheb_1o2,
+                       o2scl_fd_vec_coeffs::s_1o2,1,
+                       o2scl_const::root_pi/2.0,y);
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 3/2 \f$
+     */
+    double calc_3o2(double y) const {
+      return calc_half(o2scl_fd_vec_coeffs::cheb_3o2,
+                       o2scl_fd_vec_coeffs::s_3o2,2,
+                       o2scl_const::root_pi*0.75,y);
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 5/2 \f$
+     */
+    double calc_5o2(double y) const {
+      return calc_half(o2scl_fd_vec_coeffs::cheb_5o2,
+                       o2scl_fd_vec_coeffs::s_5o2,3,
+                       o2scl_const::root_pi*15.0/8.0,y);
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 2 \f$
+     */
+    double calc_2(double y) const {
+      return calc_int(o2scl_fd_vec_coeffs::cheb_2,2,2.0,y);
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 3 \f$
+     */
+    double calc_3(double y) const {
+      return calc_int(o2scl_fd_vec_coeffs::cheb_3,3,6.0,y);
+    }
+    //@}
+
+    /// \name Functions for arrays of arguments
+    //@{
+    /** \brief Fermi-Dirac integral of order \f$ -1/2 \f$ for
+        the first \c n elements of \c y
+    */
+    template<class vec_t, class vec2_t>
+    void calc_m1o2_vec(size_t n, const vec_t &y, vec2_t &res) const {
+      calc_half_vec(o2scl_fd_vec_coeffs::cheb_m1o2,
+                    o2scl_fd_vec_coeffs::s_m1o2,0,
+                    o2scl_const::root_pi,n,y,res);
+      return;
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 1/2 \f$ for
+        the first \c n elements of \c y
+    */
+    template<class vec_t, class vec2_t>
+    void calc_1o2_vec(size_t n, const vec_t &y, vec2_t &res) const {
+      calc_half_vec(o2scl_fd_vec_coeffs::cheb_1o2,
+                    o2scl_fd_vec_coeffs::s_1o2,1,
+                    o2scl_const::root_pi/2.0,n,y,res);
+      return;
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 3/2 \f$ for
+        the first \c n elements of \c y
+    */
+    template<class vec_t, class vec2_t>
+    void calc_3o2_vec(size_t n, const vec_t &y, vec2_t &res) const {
+      calc_half_vec(o2scl_fd_vec_coeffs::cheb_3o2,
+                    o2scl_fd_vec_coeffs::s_3o2,2,
+                    o2scl_const::root_pi*0.75,n,y,res);
+      return;
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 5/2 \f$ for
+        the first \c n elements of \c y
+    */
+    template<class vec_t, class vec2_t>
+    void calc_5o2_vec(size_t n, const vec_t &y, vec2_t &res) const {
+      calc_half_vec(o2scl_fd_vec_coeffs::cheb_5o2,
+                    o2scl_fd_vec_coeffs::s_5o2,3,
+                    o2scl_const::root_pi*15.0/8.0,n,y,res);
+      return;
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 2 \f$ for
+        the first \c n elements of \c y
+    */
+    template<class vec_t, class vec2_t>
+    void calc_2_vec(size_t n, const vec_t &y, vec2_t &res) const {
+      calc_int_vec(o2scl_fd_vec_coeffs::cheb_2,2,2.0,n,y,res);
+      return;
+    }
+    
+    /** \brief Fermi-Dirac integral of order \f$ 3 \f$ for
+        the first \c n elements of \c y
+    */
+    template<class vec_t, class vec2_t>
+    void calc_3_vec(size_t n, const vec_t &y, vec2_t &res) const {
+      calc_int_vec(o2scl_fd_vec_coeffs::cheb_3,3,6.0,n,y,res);
+      return;
+    }
+    //@}
+    
+  };
+
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+  ───────────────────────────────────────────────────────────────────
+  
+  Copyright (C) 2025, Andrew W. Steiner
+  
+  This file is part of O2scl.
+  
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+  
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  ───────────────────────────────────────────────────────────────────
+*/
+#include <vector>
+
+#include <o2scl/test_mgr.h>
+#include <o2scl/fermi_dirac_vec.h>
+
+using namespace std;
+using namespace o2scl;
+
+typedef double (fermi_dirac_integ_vec::*scalar_fn_t)(double) const;
+
+/** \brief Return the maximum relative deviation between the scalar 
+    and array versions over the arguments in \c mu
+*/
+template<class vec_fn_t>
+double compare_vec(fermi_dirac_integ_vec &fdv, scalar_fn_t f,
+                   vec_fn_t fv, const vector<double> &mu) {
+  vector<double> res(mu.size());
+  fv(mu.size(),mu,res);
+  double dev=0.0;
+  for(size_t i=0;i<mu.size();i++) {
+    double s=(fdv.*f)(mu[i]);
+    dev=max(dev,fabs(res[i]-s)/fabs(s));
+  }
+  return dev;
+}
+
+int main(void) {
+
+  cout.setf(ios::scientific);
+  
+  test_mgr t;
+  t.set_output_level(1);
+
+  fermi_dirac_integ_vec fdv;
+
+  // Compare with values computed with 34-digit arithmetic. These
+  // were generated once from the polylogarithm, -Li_{j+1}(-e^{mu}),
+  // and are recorded here so that the test has no external
+  // dependencies.
+
+  t.test_rel(fdv.calc_m1o2(-20.0),3.6532996700745534e-9,
+             1.0e-14,"ref m1o2");
+  t.test_rel(fdv.calc_m1o2(-0.7),0.65902734480536352,
+             1.0e-14,"ref m1o2");
+  t.test_rel(fdv.calc_m1o2(1.9),2.5208172014917184,
+             1.0e-14,"ref m1o2");
+  t.test_rel(fdv.calc_m1o2(13.7),7.3860668260215001,
+             1.0e-14,"ref m1o2");
+  t.test_rel(fdv.calc_m1o2(39.9),12.630017097432444,
+             1.0e-14,"ref m1o2");
+  t.test_rel(fdv.calc_m1o2(55.0),14.830377690490632,
+             1.0e-14,"ref m1o2");
+  t.test_rel(fdv.calc_1o2(-20.0),1.8266498363684073e-9,
+             1.0e-14,"ref 1o2");
+  t.test_rel(fdv.calc_1o2(-0.7),0.37871374676799604,
+             1.0e-14,"ref 1o2");
+  t.test_rel(fdv.calc_1o2(1.9),2.3745487181555729,
+             1.0e-14,"ref 1o2");
+  t.test_rel(fdv.calc_1o2(13.7),34.028962310171848,
+             1.0e-14,"ref 1o2");
+  t.test_rel(fdv.calc_1o2(39.9),168.15302581722448,
+             1.0e-14,"ref 1o2");
+  t.test_rel(fdv.calc_1o2(55.0),272.03821104907536,
+             1.0e-14,"ref 1o2");
+  t.test_rel(fdv.calc_3o2(-20.0),2.7399747555509589e-9,
+             1.0e-14,"ref 3o2");
+  t.test_rel(fdv.calc_3o2(-0.7),0.61064660196653879,
+             1.0e-14,"ref 3o2");
+  t.test_rel(fdv.calc_3o2(1.9),5.1715247956210668,
+             1.0e-14,"ref 3o2");
+  t.test_rel(fdv.calc_3o2(13.7),287.00102274242057,
+             1.0e-14,"ref 3o2");
+  t.test_rel(fdv.calc_3o2(39.9),4038.0474690120941,
+             1.0e-14,"ref 3o2");
+  t.test_rel(fdv.calc_3o2(55.0),8991.8971620994686,
+             1.0e-14,"ref 3o2");
+  t.test_rel(fdv.calc_5o2(-20.0),6.8499368901253323e-9,
+             1.0e-14,"ref 5o2");
+  t.test_rel(fdv.calc_5o2(-0.7),1.5852996580787923,
+             1.0e-14,"ref 5o2");
+  t.test_rel(fdv.calc_5o2(1.9),16.191221596901102,
+             1.0e-14,"ref 5o2");
+  t.test_rel(fdv.calc_5o2(13.7),2928.7741601833643,
+             1.0e-14,"ref 5o2");
+  t.test_rel(fdv.calc_5o2(39.9),115677.25233452577,
+             1.0e-14,"ref 5o2");
+  t.test_rel(fdv.calc_5o2(55.0),354212.15552116476,
+             1.0e-14,"ref 5o2");
+  t.test_rel(fdv.calc_2(-20.0),4.1223072438150271e-9,
+             1.0e-14,"ref 2");
+  t.test_rel(fdv.calc_2(-0.7),0.939068891513843,
+             1.0e-14,"ref 2");
+  t.test_rel(fdv.calc_2(1.9),8.8308606458692304,
+             1.0e-14,"ref 2");
+  t.test_rel(fdv.calc_2(13.7),902.18886234320035,
+             1.0e-14,"ref 2");
+  t.test_rel(fdv.calc_2(39.9),21304.998738534486,
+             1.0e-14,"ref 2");
+  t.test_rel(fdv.calc_2(55.0),55639.276080686638,
+             1.0e-14,"ref 2");
+  t.test_rel(fdv.calc_3(-20.0),1.2366921733038214e-8,
+             1.0e-14,"ref 3");
+  t.test_rel(fdv.calc_3(-0.7),2.8949185046181321,
+             1.0e-14,"ref 3");
+  t.test_rel(fdv.calc_3(1.9),31.547795431485377,
+             1.0e-14,"ref 3");
+  t.test_rel(fdv.calc_3(13.7),9744.4614372395182,
+             1.0e-14,"ref 3");
+  t.test_rel(fdv.calc_3(39.9),641491.57887024301,
+             1.0e-14,"ref 3");
+  t.test_rel(fdv.calc_3(55.0),2302595.3910506016,
+             1.0e-14,"ref 3");
+
+  // Check continuity at the boundaries between the expansions
+  for(double mu : {0.0,2.0,10.0,38.0,40.0}) {
+    double lo=mu*(1.0-1.0e-15)-1.0e-300, hi=mu*(1.0+1.0e-15)+1.0e-300;
+    t.test_rel(fdv.calc_m1o2(lo),fdv.calc_m1o2(hi),1.0e-14,"cont m1o2");
+    t.test_rel(fdv.calc_1o2(lo),fdv.calc_1o2(hi),1.0e-14,"cont 1o2");
+    t.test_rel(fdv.calc_3o2(lo),fdv.calc_3o2(hi),1.0e-14,"cont 3o2");
+    t.test_rel(fdv.calc_5o2(lo),fdv.calc_5o2(hi),1.0e-14,"cont 5o2");
+    t.test_rel(fdv.calc_2(lo),fdv.calc_2(hi),1.0e-14,"cont 2");
+    t.test_rel(fdv.calc_3(lo),fdv.calc_3(hi),1.0e-14,"cont 3");
+  }
+
+  // Compare the array functions with the scalar functions, using a
+  // length which is not a multiple of the block size
+  vector<double> mu;
+  for(double x=-60.0;x<80.0;x+=0.137) mu.push_back(x);
+  double dev;
+  
+  dev=compare_vec(fdv,&fermi_dirac_integ_vec::calc_m1o2,
+                  [&fdv](size_t n, const vector<double> &y,
+                         vector<double> &r) { fdv.calc_m1o2_vec(n,y,r); },mu);
+  t.test_abs(dev,0.0,1.0e-15,"vec m1o2");
+  dev=compare_vec(fdv,&fermi_dirac_integ_vec::calc_1o2,
+                  [&fdv](size_t n, const vector<double> &y,
+                         vector<double> &r) { fdv.calc_1o2_vec(n,y,r); },mu);
+  t.test_abs(dev,0.0,1.0e-15,"vec 1o2");
+  dev=compare_vec(fdv,&fermi_dirac_integ_vec::calc_3o2,
+                  [&fdv](size_t n, const vector<double> &y,
+                         vector<double> &r) { fdv.calc_3o2_vec(n,y,r); },mu);
+  t.test_abs(dev,0.0,1.0e-15,"vec 3o2");
+  dev=compare_vec(fdv,&fermi_dirac_integ_vec::calc_5o2,
+                  [&fdv](size_t n, const vector<double> &y,
+                         vector<double> &r) { fdv.calc_5o2_vec(n,y,r); },mu);
+  t.test_abs(dev,0.0,1.0e-15,"vec 5o2");
+  dev=compare_vec(fdv,&fermi_dirac_integ_vec::calc_2,
+                  [&fdv](size_t n, const vector<double> &y,
+                         vector<double> &r) { fdv.calc_2_vec(n,y,r); },mu);
+  t.test_abs(dev,0.0,1.0e-15,"vec 2");
+  dev=compare_vec(fdv,&fermi_dirac_integ_vec::calc_3,
+                  [&fdv](size_t n, const vector<double> &y,
+                         vector<double> &r) { fdv.calc_3_vec(n,y,r); },mu);
+  t.test_abs(dev,0.0,1.0e-15,"vec 3");
+
+  // Infinite arguments
+  t.test_gen(std::isinf(fdv.calc_1o2(std::numeric_limits<double>::infinity())),
+             "inf 1o2");
+  t.test_gen(std::isinf(fdv.calc_3(std::numeric_limits<double>::infinity())),
+             "inf 3");
+  t.test_abs(fdv.calc_1o2(-std::numeric_limits<double>::infinity()),0.0,
+             1.0e-300,"-inf 1o2");
+  
+  t.report();
+  return 0;
+}
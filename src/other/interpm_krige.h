@@ -31,6 +31,8 @@
 #include <string>
 #include <cmath>
 #include <ctime>
+#include <algorithm>
+#include <limits>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -38,6 +40,12 @@
 
 #include <gsl/gsl_combination.h>
 
+#include <o2scl/set_openmp.h>
+
+#ifdef O2SCL_SET_OPENMP
+#include <omp.h>
+#endif
+
 #include <o2scl/interpm_base.h>
 #include <o2scl/vector.h>
 #include <o2scl/vec_stats.h>
@@ -92,6 +100,31 @@ namespace o2scl {
     */
     virtual double deriv2(const vec_t &x1, const vec2_t &x2,
                           size_t ix, size_t iy)=0;
+
+    /** \brief The derivative of the covariance function with
+        respect to parameter \c ip
+
+        This is used to compute the gradient of the log marginal
+        likelihood in \ref interpm_krige_optim::qual_grad(). The
+        default implementation calls the error handler.
+    */
+    virtual double deriv_param(const vec2_t &x1, const vec2_t &x2,
+                               size_t ip) {
+      O2SCL_ERR2("Function deriv_param() not implemented in ",
+                 "mcovar_base.",o2scl::exc_eunimpl);
+      return 0.0;
+    }
+
+    /** \brief Create a copy of this covariance function
+
+        This is used to give each thread its own copy of the
+        covariance function in \ref interpm_krige_optim . The
+        default implementation returns an empty pointer, which
+        indicates that copies are not supported.
+    */
+    virtual std::shared_ptr<mcovar_base<vec_t,vec2_t>> clone() const {
+      return std::shared_ptr<mcovar_base<vec_t,vec2_t>>();
+    }
     
   };
   
@@ -178,6 +211,51 @@ namespace o2scl {
       return exp(sum)/len[ix]/len[ix]*(x1[ix]-x2[ix])/
         len[iy]/len[iy]*(x1[iy]-x2[iy]);
     }
+
+    /** \brief The derivative of the covariance function with
+        respect to parameter \c ip
+
+        For \f$ \mathrm{ip} < d \f$ this is
+        \f[
+        \frac{\partial K_{ij}}{\partial \ell_k} =
+        \frac{\left(x_{ik}-x_{jk}\right)^2}{\ell_k^3}
+        \exp \left[ - \sum_m \frac{\left(x_{im}-x_{jm}\right)^2}
+        {2 \ell_m^2} \right]
+        \f]
+        and for the last parameter, the derivative of the noise
+        term, \f$ \ln 10 \times 10^{\mathrm{log10\_noise}} \f$,
+        which is nonzero only when the two points are equal.
+    */
+    template<class vec3_t, class vec4_t>
+    double deriv_param_tl(const vec3_t &x1, const vec4_t &x2, size_t ip) {
+      bool equal=true;
+      double sum=0.0;
+      for(size_t j=0;j<len.size();j++) {
+        if (x1[j]!=x2[j]) equal=false;
+        sum+=-(x1[j]-x2[j])*(x1[j]-x2[j])/len[j]/len[j]/2.0;
+      }
+      if (ip==len.size()) {
+        if (equal) return log(10.0)*pow(10.0,log10_noise);
+        return 0.0;
+      }
+      return exp(sum)*(x1[ip]-x2[ip])*(x1[ip]-x2[ip])/
+        len[ip]/len[ip]/len[ip];
+    }
+    
+    /** \brief The derivative of the covariance function with
+        respect to parameter \c ip
+
+        See \ref deriv_param_tl().
+    */
+    virtual double deriv_param(const vec2_t &x1, const vec2_t &x2,
+                               size_t ip) {
+      return deriv_param_tl(x1,x2,ip);
+    }
+
+    /// Create a copy of this covariance function
+    virtual std::shared_ptr<mcovar_base<vec_t,vec2_t>> clone() const {
+      return std::make_shared<mcovar_funct_rbf_noise<vec_t,vec2_t>>(*this);
+    }
     
   };
 
@@ -375,6 +453,12 @@ namespace o2scl {
                           size_t iy) {
       return deriv2_tl(x1,x2,ix,iy);
     }
+
+    /// Create a copy of this covariance function
+    virtual std::shared_ptr<mcovar_base<vec_t,vec2_t>> clone() const {
+      return std::make_shared<mcovar_funct_quad_correl<vec_t,vec2_t>>
+        (*this);
+    }
     
   };
 
@@ -448,6 +532,675 @@ namespace o2scl {
     ubvector mean_y;
     /// The output standard deviations for rescaling
     ubvector std_y;
+
+    /// \name Block-diagonal local experts
+    //@{
+    /// The indices of the points in each block
+    std::vector<std::vector<size_t>> blk_index;
+    
+    /** \brief The inverse covariance matrix for each output 
+        quantity and each block
+    */
+    std::vector<std::vector<mat_inv_kxx_t>> blk_inv_KXX;
+
+    /** \brief The inverse covariance matrix times the function
+        vector for each output quantity and each block
+    */
+    std::vector<std::vector<ubvector>> blk_Kinvf;
+
+    /** \brief Recursively divide the points listed in \c ix into
+        blocks with at most \ref block_size points
+
+        The points are sorted along the input coordinate with the
+        largest range and then divided in half, as in the
+        construction of a k-d tree.
+    */
+    void split_block(std::vector<size_t> &ix) {
+      
+      if (ix.size()<=block_size) {
+        blk_index.push_back(ix);
+        return;
+      }
+
+      // Find the coordinate with the largest range
+      size_t jmax=0;
+      double range_max=0.0;
+      for(size_t j=0;j<this->n_params;j++) {
+        double xmin=this->x(ix[0],j), xmax=xmin;
+        for(size_t i=1;i<ix.size();i++) {
+          if (this->x(ix[i],j)<xmin) xmin=this->x(ix[i],j);
+          if (this->x(ix[i],j)>xmax) xmax=this->x(ix[i],j);
+        }
+        if (j==0 || xmax-xmin>range_max) {
+          jmax=j;
+          range_max=xmax-xmin;
+        }
+      }
+
+      // Sort along that coordinate and split in half
+      const mat_x_t &xr=this->x;
+      std::sort(ix.begin(),ix.end(),[&xr,jmax](size_t i1, size_t i2) {
+        return xr(i1,jmax)<xr(i2,jmax);
+      });
+      size_t half=ix.size()/2;
+      std::vector<size_t> left(ix.begin(),ix.begin()+half);
+      std::vector<size_t> right(ix.begin()+half,ix.end());
+      split_block(left);
+      split_block(right);
+      
+      return;
+    }
+
+    /// Return true if the block-diagonal approximation is in use
+    bool use_blocks() const {
+      return block_size>0 && this->n_points>block_size;
+    }
+    
+    /** \brief Compute the quality function using a block-diagonal
+        approximation to the covariance matrix
+
+        The likelihood and the leave-one-out cross validation both
+        separate into a sum over the blocks, so the matrix inversions
+        only involve matrices of size at most \ref block_size.
+        The brute-force leave-one-out mode is handled
+        with the same analytical expression as \ref mode_loo_cv.
+    */
+    double qual_fun_blocks(size_t iout,
+                           mcovar_base<vec_t,mat_x_row_t> &cov,
+                           mat_inv_t &mi_ws,
+                           std::vector<mat_inv_kxx_t> &blk_inv_ws,
+                           std::vector<ubvector> &blk_Kinvf_ws,
+                           int &success) {
+
+      mat_y_col_t yiout(this->y,iout);
+      
+      double ret=0.0;
+      success=0;
+      
+      size_t nblk=blk_index.size();
+      blk_inv_ws.resize(nblk);
+      blk_Kinvf_ws.resize(nblk);
+      
+      for(size_t ib=0;ib<nblk;ib++) {
+
+        const std::vector<size_t> &ix=blk_index[ib];
+        size_t nb=ix.size();
+
+        // Construct the covariance matrix for this block
+        mat_inv_kxx_t KXX(nb,nb);
+        ubvector yb(nb);
+        for(size_t irow=0;irow<nb;irow++) {
+          yb[irow]=yiout[ix[irow]];
+          mat_x_row_t xrow(this->x,ix[irow]);
+          for(size_t icol=0;icol<nb;icol++) {
+            mat_x_row_t xcol(this->x,ix[icol]);
+            if (irow>icol) {
+              KXX(irow,icol)=KXX(icol,irow);
+            } else {
+              KXX(irow,icol)=cov.covar2(xrow,xcol);
+            }
+          }
+        }
+
+        mat_inv_kxx_t &inv=blk_inv_ws[ib];
+        ubvector &Kinvf_b=blk_Kinvf_ws[ib];
+        Kinvf_b.resize(nb);
+        
+        if (mode==mode_loo_cv || mode==mode_loo_cv_bf) {
+          
+          inv=KXX;
+          int cret=mi_ws.invert_inplace(nb,inv);
+          if (cret!=0) {
+            success=1;
+            return 1.0e99;
+          }
+          o2scl_cblas::dgemv(o2scl_cblas::o2cblas_RowMajor,
+                             o2scl_cblas::o2cblas_NoTrans,
+                             nb,nb,1.0,inv,yb,0.0,Kinvf_b);
+          
+          for(size_t ii=0;ii<nb;ii++) {
+            // Eqs. 5.10 and 5.12, as in qual_fun()
+            double sigma2=1.0/inv(ii,ii);
+            double ypred=yb[ii]-Kinvf_b[ii]*sigma2;
+            ret+=pow(yb[ii]-ypred,2.0)/sigma2/2.0;
+            ret+=0.5*log(sigma2);
+          }
+          
+        } else {
+
+          double lndet;
+          inv.resize(nb,nb);
+          int cret=mi_ws.invert_det(nb,KXX,inv,lndet);
+          if (cret!=0) {
+            success=2;
+            return 1.0e99;
+          }
+          lndet=log(lndet);
+          if (mode!=mode_final && !std::isfinite(lndet)) {
+            success=5;
+            return 1.0e99;
+          }
+          o2scl_cblas::dgemv(o2scl_cblas::o2cblas_RowMajor,
+                             o2scl_cblas::o2cblas_NoTrans,
+                             nb,nb,1.0,inv,yb,0.0,Kinvf_b);
+          
+          if (mode==mode_max_lml) {
+            for(size_t i=0;i<nb;i++) {
+              ret+=0.5*yb[i]*Kinvf_b[i];
+            }
+            ret+=0.5*lndet;
+          }
+          
+        }
+        
+      }
+
+      if (this->verbose>2) {
+        std::cout << "interpm_krige_optim::qual_fun_blocks(): ";
+        std::cout << "ret: " << ret << " with " << nblk
+                  << " blocks." << std::endl;
+      }
+      
+      return ret;
+    }
+
+    /** \brief Combine the local experts at point \c x0 for
+        output \c iout using the robust Bayesian committee machine
+
+        The prediction from each block is weighted by the difference
+        in entropy between the prior and the posterior of that block,
+        following Deisenroth and Ng (2015). On output, \c mean and
+        \c var contain the (unscaled) mean and variance. If
+        \c weights is not zero, it is filled with the weight of each
+        block in the combined mean, which is used for derivatives.
+    */
+    void blocks_pred(const vec_t &x0, size_t iout, double &mean,
+                     double &var, std::vector<double> *weights=0) const {
+
+      double kx0x0=cf[iout]->covar(x0,x0);
+      size_t nblk=blk_index.size();
+      
+      double sum_beta=0.0, prec=0.0, wmean=0.0;
+      if (weights!=0) weights->resize(nblk);
+      
+      for(size_t ib=0;ib<nblk;ib++) {
+        
+        const std::vector<size_t> &ix=blk_index[ib];
+        size_t nb=ix.size();
+        
+        ubvector kxx0(nb), prod(nb);
+        double mu=0.0;
+        for(size_t i=0;i<nb;i++) {
+          mat_x_row_t xrow(x,ix[i]);
+          kxx0[i]=(*cf[iout])(x0,xrow);
+          mu+=kxx0[i]*blk_Kinvf[iout][ib][i];
+        }
+        o2scl_cblas::dgemv(o2scl_cblas::o2cblas_RowMajor,
+                           o2scl_cblas::o2cblas_NoTrans,
+                           nb,nb,1.0,blk_inv_KXX[iout][ib],kxx0,0.0,prod);
+        double s2=kx0x0-o2scl_cblas::ddot(nb,kxx0,prod);
+        if (s2<=0.0) s2=kx0x0*std::numeric_limits<double>::epsilon();
+        
+        double beta=0.5*(log(kx0x0)-log(s2));
+        sum_beta+=beta;
+        prec+=beta/s2;
+        wmean+=beta*mu/s2;
+        if (weights!=0) (*weights)[ib]=beta/s2;
+      }
+      
+      prec+=(1.0-sum_beta)/kx0x0;
+      var=1.0/prec;
+      mean=var*wmean;
+      if (weights!=0) {
+        for(size_t ib=0;ib<nblk;ib++) (*weights)[ib]*=var;
+      }
+      
+      return;
+    }
+    //@}
+
+    /// \name Incremental updates
+    //@{
+    /** \brief The Cholesky decomposition of the covariance matrix
+        for each output quantity, used by \ref update_data()
+    */
+    std::vector<ubmatrix> chol_KXX;
+
+    /** \brief The Cholesky decomposition of the covariance matrix
+        for each output quantity and each block, used by \ref
+        update_data()
+    */
+    std::vector<std::vector<ubmatrix>> blk_chol_KXX;
+
+    /** \brief Number of points added, removed, or replaced by \ref
+        update_data() and \ref replace_data() since the last fit
+    */
+    size_t n_since_fit;
+
+    /** \brief Compute the Cholesky decomposition \c L and the
+        inverse \c inv of the covariance matrix for the points
+        listed in \c ix from scratch
+
+        If the covariance matrix is not positive definite, then
+        \c L is cleared and a nonzero value is returned.
+    */
+    int chol_full(mcovar_base<vec_t,mat_x_row_t> &cov,
+                  const std::vector<size_t> &ix, ubmatrix &L,
+                  mat_inv_kxx_t &inv) {
+
+      size_t n=ix.size();
+      L.resize(n,n);
+      for(size_t irow=0;irow<n;irow++) {
+        mat_x_row_t xrow(this->x,ix[irow]);
+        for(size_t icol=0;icol<=irow;icol++) {
+          mat_x_row_t xcol(this->x,ix[icol]);
+          L(irow,icol)=cov.covar2(xrow,xcol);
+        }
+      }
+      int cret=o2scl_linalg::cholesky_decomp(n,L,false);
+      if (cret!=0) {
+        L.resize(0,0);
+        return cret;
+      }
+
+      ubmatrix S=L;
+      o2scl_linalg::cholesky_invert<ubmatrix>(n,S);
+      inv.resize(n,n);
+      for(size_t i=0;i<n;i++) {
+        for(size_t j=0;j<n;j++) {
+          inv(i,j)=S(i,j);
+        }
+      }
+
+      return 0;
+    }
+
+    /** \brief Remove row and column \c r from the Cholesky
+        decomposition \c L and the inverse \c inv
+
+        Removing row and column \c r leaves the leading block and
+        the lower-left block of \c L unchanged, and the trailing
+        block \f$ L_{33} \f$ becomes the decomposition of \f$ L_{33}
+        L_{33}^{T} + l_{32} l_{32}^{T} \f$, which is a rank-one
+        update. The inverse is given by the Schur complement of the
+        removed diagonal element. This requires \f$ {\cal O}(n^2)
+        \f$ operations.
+    */
+    void chol_remove(size_t r, ubmatrix &L, mat_inv_kxx_t &inv) {
+
+      size_t n=L.size1();
+      size_t m=n-r-1;
+      if (m>0) {
+        ubmatrix L33(m,m);
+        ubvector v(m);
+        for(size_t i=0;i<m;i++) {
+          v[i]=L(r+1+i,r);
+          for(size_t j=0;j<m;j++) {
+            L33(i,j)=L(r+1+i,r+1+j);
+          }
+        }
+        o2scl_linalg::cholesky_update_rank1(m,L33,v);
+        for(size_t i=0;i<m;i++) {
+          for(size_t j=0;j<m;j++) {
+            L(r+1+i,r+1+j)=L33(i,j);
+          }
+        }
+      }
+
+      ubmatrix L2(n-1,n-1);
+      mat_inv_kxx_t inv2(n-1,n-1);
+      for(size_t i=0;i<n-1;i++) {
+        size_t i2=i;
+        if (i>=r) i2++;
+        for(size_t j=0;j<n-1;j++) {
+          size_t j2=j;
+          if (j>=r) j2++;
+          L2(i,j)=L(i2,j2);
+          inv2(i,j)=inv(i2,j2)-inv(i2,r)*inv(r,j2)/inv(r,r);
+        }
+      }
+      std::swap(L,L2);
+      std::swap(inv,inv2);
+
+      return;
+    }
+
+    /** \brief Extend the Cholesky decomposition \c L and the
+        inverse \c inv for the first \c n_old points listed in \c ix
+        to all of the points listed in \c ix
+
+        The new off-diagonal block is \f$ L_{21}=K_{21} L_{11}^{-T}
+        \f$ and the new diagonal block is the decomposition of \f$
+        K_{22}-L_{21} L_{21}^{T} \f$. The inverse is updated using
+        the Schur complement. Adding \f$ k \f$ points to \f$ n \f$
+        requires \f$ {\cal O}(n^2 k) \f$ operations. If the
+        extended matrix is not positive definite, then a nonzero
+        value is returned.
+    */
+    int chol_append(mcovar_base<vec_t,mat_x_row_t> &cov,
+                    const std::vector<size_t> &ix, size_t n_old,
+                    ubmatrix &L, mat_inv_kxx_t &inv) {
+
+      if (n_old==0) return chol_full(cov,ix,L,inv);
+
+      size_t n_pts=ix.size();
+      size_t n_new=n_pts-n_old;
+      if (n_new==0) return 0;
+
+      ubmatrix L2(n_pts,n_pts), W(n_old,n_new), S(n_new,n_new);
+      for(size_t irow=0;irow<n_old;irow++) {
+        for(size_t icol=0;icol<n_old;icol++) {
+          L2(irow,icol)=L(irow,icol);
+        }
+      }
+
+      ubvector w(n_old);
+      for(size_t j=0;j<n_new;j++) {
+        mat_x_row_t xnew(this->x,ix[n_old+j]);
+        for(size_t i=0;i<n_old;i++) {
+          mat_x_row_t xrow(this->x,ix[i]);
+          w[i]=cov.covar2(xrow,xnew);
+        }
+        o2scl_cblas::dtrsv(o2scl_cblas::o2cblas_RowMajor,
+                           o2scl_cblas::o2cblas_Lower,
+                           o2scl_cblas::o2cblas_NoTrans,
+                           o2scl_cblas::o2cblas_NonUnit,
+                           n_old,n_old,L2,w);
+        for(size_t i=0;i<n_old;i++) {
+          L2(n_old+j,i)=w[i];
+          L2(i,n_old+j)=w[i];
+        }
+        // Store L11^{-T} L21^{T}=K11^{-1} K12 for the update
+        // of the inverse below
+        o2scl_cblas::dtrsv(o2scl_cblas::o2cblas_RowMajor,
+                           o2scl_cblas::o2cblas_Upper,
+                           o2scl_cblas::o2cblas_NoTrans,
+                           o2scl_cblas::o2cblas_NonUnit,
+                           n_old,n_old,L2,w);
+        for(size_t i=0;i<n_old;i++) {
+          W(i,j)=w[i];
+        }
+      }
+
+      for(size_t a=0;a<n_new;a++) {
+        mat_x_row_t xa(this->x,ix[n_old+a]);
+        for(size_t b=0;b<=a;b++) {
+          mat_x_row_t xb(this->x,ix[n_old+b]);
+          double sum=cov.covar2(xa,xb);
+          for(size_t i=0;i<n_old;i++) {
+            sum-=L2(n_old+a,i)*L2(n_old+b,i);
+          }
+          S(a,b)=sum;
+        }
+      }
+      int cret=o2scl_linalg::cholesky_decomp(n_new,S,false);
+      if (cret!=0) return cret;
+      for(size_t a=0;a<n_new;a++) {
+        for(size_t b=0;b<n_new;b++) {
+          L2(n_old+a,n_old+b)=S(a,b);
+        }
+      }
+
+      // Update the inverse using the Schur complement, whose
+      // inverse is the inverse of S
+      o2scl_linalg::cholesky_invert<ubmatrix>(n_new,S);
+      ubmatrix WS(n_old,n_new);
+      for(size_t i=0;i<n_old;i++) {
+        for(size_t a=0;a<n_new;a++) {
+          WS(i,a)=0.0;
+          for(size_t b=0;b<n_new;b++) {
+            WS(i,a)+=W(i,b)*S(b,a);
+          }
+        }
+      }
+      mat_inv_kxx_t inv2(n_pts,n_pts);
+      for(size_t i=0;i<n_old;i++) {
+        for(size_t j=0;j<n_old;j++) {
+          double sum=inv(i,j);
+          for(size_t a=0;a<n_new;a++) {
+            sum+=WS(i,a)*W(j,a);
+          }
+          inv2(i,j)=sum;
+        }
+        for(size_t a=0;a<n_new;a++) {
+          inv2(i,n_old+a)=-WS(i,a);
+          inv2(n_old+a,i)=-WS(i,a);
+        }
+      }
+      for(size_t a=0;a<n_new;a++) {
+        for(size_t b=0;b<n_new;b++) {
+          inv2(n_old+a,n_old+b)=S(a,b);
+        }
+      }
+      std::swap(inv,inv2);
+      std::swap(L,L2);
+
+      return 0;
+    }
+
+    /** \brief Insert the point <tt>ix[p]</tt> into the Cholesky
+        decomposition \c L and the inverse \c inv for the other
+        points listed in \c ix
+
+        Inserting a point leaves the leading block and the
+        lower-left block of \c L unchanged, the new row follows from
+        the leading block, and the trailing block \f$ L_{33} \f$
+        becomes the decomposition of \f$ L_{33} L_{33}^{T} - l_{32}
+        l_{32}^{T} \f$, which is a rank-one downdate. The inverse is
+        bordered with the Schur complement of the new diagonal
+        element, as in \ref chol_append(). This requires \f$ {\cal
+        O}(n^2) \f$ operations. If the new matrix is not positive
+        definite, then a nonzero value is returned and \c L and \c
+        inv are undefined.
+    */
+    int chol_insert(mcovar_base<vec_t,mat_x_row_t> &cov,
+                    const std::vector<size_t> &ix, size_t p,
+                    ubmatrix &L, mat_inv_kxx_t &inv) {
+
+      size_t n=ix.size();
+      if (n==1) return chol_full(cov,ix,L,inv);
+      size_t m=n-1;
+
+      // The covariance of the new point with the other points
+      mat_x_row_t xp(this->x,ix[p]);
+      double d=cov.covar2(xp,xp);
+      ubvector c(m), w(m);
+      for(size_t i=0;i<m;i++) {
+        size_t i2=i;
+        if (i>=p) i2++;
+        mat_x_row_t xrow(this->x,ix[i2]);
+        c[i]=cov.covar2(xrow,xp);
+        w[i]=c[i];
+      }
+
+      // The new row of the decomposition in the leading block
+      o2scl_cblas::dtrsv(o2scl_cblas::o2cblas_RowMajor,
+                         o2scl_cblas::o2cblas_Lower,
+                         o2scl_cblas::o2cblas_NoTrans,
+                         o2scl_cblas::o2cblas_NonUnit,
+                         m,m,L,w);
+      double l_pp2=d;
+      for(size_t k=0;k<p;k++) l_pp2-=w[k]*w[k];
+      double s=d-o2scl_cblas::ddot(m,w,w);
+      if (l_pp2<=0.0 || s<=0.0) return 1;
+      double l_pp=sqrt(l_pp2);
+
+      // Downdate the trailing block
+      size_t m3=m-p;
+      ubmatrix L33(m3,m3);
+      ubvector v(m3);
+      for(size_t i=0;i<m3;i++) {
+        v[i]=c[p+i];
+        for(size_t k=0;k<p;k++) {
+          v[i]-=L(p+i,k)*w[k];
+        }
+        v[i]/=l_pp;
+        for(size_t j=0;j<m3;j++) {
+          L33(i,j)=L(p+i,p+j);
+        }
+      }
+      ubvector v3=v;
+      int cret=o2scl_linalg::cholesky_downdate_rank1(m3,L33,v3,false);
+      if (cret!=0) return cret;
+
+      ubmatrix L2(n,n);
+      for(size_t i=0;i<p;i++) {
+        for(size_t j=0;j<p;j++) {
+          L2(i,j)=L(i,j);
+        }
+        L2(p,i)=w[i];
+        L2(i,p)=w[i];
+        for(size_t j=0;j<m3;j++) {
+          L2(p+1+j,i)=L(p+j,i);
+          L2(i,p+1+j)=L(p+j,i);
+        }
+      }
+      L2(p,p)=l_pp;
+      for(size_t i=0;i<m3;i++) {
+        L2(p+1+i,p)=v[i];
+        L2(p,p+1+i)=v[i];
+        for(size_t j=0;j<m3;j++) {
+          L2(p+1+i,p+1+j)=L33(i,j);
+        }
+      }
+
+      // Border the inverse: with K^{-1} c in w, the new diagonal
+      // element is 1/s and the new column is -w/s
+      o2scl_cblas::dtrsv(o2scl_cblas::o2cblas_RowMajor,
+                         o2scl_cblas::o2cblas_Upper,
+                         o2scl_cblas::o2cblas_NoTrans,
+                         o2scl_cblas::o2cblas_NonUnit,
+                         m,m,L,w);
+      mat_inv_kxx_t inv2(n,n);
+      for(size_t i=0;i<m;i++) {
+        size_t i2=i;
+        if (i>=p) i2++;
+        for(size_t j=0;j<m;j++) {
+          size_t j2=j;
+          if (j>=p) j2++;
+          inv2(i2,j2)=inv(i,j)+w[i]*w[j]/s;
+        }
+        inv2(i2,p)=-w[i]/s;
+        inv2(p,i2)=-w[i]/s;
+      }
+      inv2(p,p)=1.0/s;
+
+      std::swap(L,L2);
+      std::swap(inv,inv2);
+
+      return 0;
+    }
+
+    /** \brief Update the Cholesky decomposition \c L and the
+        inverse \c inv for a set of points after points have been
+        removed and added
+
+        Before the update, \c L has one row for each of the first
+        \c n_kept points in \c ix and for each of the removed points,
+        whose positions are given in increasing order in \c rem_pos.
+        The remaining points in \c ix are new. If \c L does not
+        have this size, or if \c fresh is true, then the
+        decomposition is computed from scratch.
+    */
+    int chol_update(mcovar_base<vec_t,mat_x_row_t> &cov,
+                    const std::vector<size_t> &ix,
+                    const std::vector<size_t> &rem_pos, size_t n_kept,
+                    bool fresh, ubmatrix &L, mat_inv_kxx_t &inv) {
+
+      if (fresh || L.size1()!=n_kept+rem_pos.size()) {
+        return chol_full(cov,ix,L,inv);
+      }
+      for(size_t k=rem_pos.size();k>0;k--) {
+        chol_remove(rem_pos[k-1],L,inv);
+      }
+      return chol_append(cov,ix,n_kept,L,inv);
+    }
+
+    /** \brief Update the Cholesky decomposition \c L and the
+        inverse \c inv for the points in \c ix after the points at
+        the positions listed in \c rep_pos have been replaced
+
+        The old points are removed with \ref chol_remove() and the
+        new points are inserted at the same positions with \ref
+        chol_insert(). If \c L does not have the correct size, or
+        if one of the downdates fails, then the decomposition is
+        computed from scratch.
+    */
+    int chol_replace_set(mcovar_base<vec_t,mat_x_row_t> &cov,
+                         const std::vector<size_t> &ix,
+                         const std::vector<size_t> &rep_pos,
+                         ubmatrix &L, mat_inv_kxx_t &inv) {
+
+      if (L.size1()!=ix.size()) return chol_full(cov,ix,L,inv);
+      if (rep_pos.size()==0) return 0;
+
+      std::vector<size_t> ix2;
+      for(size_t i=0,k=0;i<ix.size();i++) {
+        if (k<rep_pos.size() && rep_pos[k]==i) {
+          k++;
+        } else {
+          ix2.push_back(ix[i]);
+        }
+      }
+      for(size_t k=rep_pos.size();k>0;k--) {
+        chol_remove(rep_pos[k-1],L,inv);
+      }
+      
+      // Insert the new points in increasing order, so that all
+      // of the points before each insertion are present
+      for(size_t k=0;k<rep_pos.size();k++) {
+        ix2.insert(ix2.begin()+rep_pos[k],ix[rep_pos[k]]);
+        if (chol_insert(cov,ix2,rep_pos[k],L,inv)!=0) {
+          return chol_full(cov,ix,L,inv);
+        }
+      }
+      return 0;
+    }
+
+    /** \brief Compute the inverse covariance matrix times the
+        function vector for output \c iout and the points listed
+        in \c ix from the Cholesky decomposition \c L, and return
+        the corresponding contribution to the negative log
+        marginal likelihood
+    */
+    double chol_Kinvf(size_t iout, const std::vector<size_t> &ix,
+                      const ubmatrix &L, ubvector &Kinvf_b) {
+
+      size_t n=ix.size();
+      mat_y_col_t yiout(this->y,iout);
+      ubvector yv(n);
+      for(size_t i=0;i<n;i++) yv[i]=yiout[ix[i]];
+      Kinvf_b.resize(n);
+      o2scl_linalg::cholesky_solve(n,L,yv,Kinvf_b);
+
+      double q=0.0;
+      for(size_t i=0;i<n;i++) {
+        q+=0.5*yv[i]*Kinvf_b[i];
+        q+=log(L(i,i));
+      }
+      return q;
+    }
+
+    /** \brief Undo the rescaling of the output data in all rows
+        of the current data except those listed in \c skip
+
+        This is used before \ref set_data() is called by \ref
+        update_data() or \ref replace_data(), since \ref set_data()
+        will rescale all of the points again.
+    */
+    void undo_rescale(size_t n_rows, const std::vector<size_t> &skip) {
+      if (rescale) {
+        for(size_t i=0;i<n_rows;i++) {
+          if (!std::binary_search(skip.begin(),skip.end(),i)) {
+            for(size_t j=0;j<this->n_outputs;j++) {
+              this->y(i,j)=this->y(i,j)*std_y[j]+mean_y[j];
+            }
+          }
+        }
+      }
+      return;
+    }
+    //@}
   
   public:
 
@@ -470,6 +1223,35 @@ namespace o2scl {
     
     /// If true, keep \f$ K^{-1} \f$ (default true)
     bool keep_matrix;
+
+    /** \brief If nonzero, the maximum number of points in each
+        block for the block-diagonal local experts approximation
+        (default 0)
+
+        When this is nonzero and smaller than the number of
+        points, the data is divided into spatially local blocks of at
+        most this size, the hyperparameters are optimized using a
+        block-diagonal approximation to the covariance matrix, and
+        predictions from the blocks are combined using the robust
+        Bayesian committee machine. This reduces the cost of each
+        hyperparameter trial from \f$ {\cal O}(n^3) \f$ to \f$
+        {\cal O}(n b^2) \f$ where \f$ b \f$ is the block size.
+        The matrices for each block are always stored, so
+        \ref sigma() is available even when \ref keep_matrix is
+        false.
+    */
+    size_t block_size;
+
+    /** \brief Number of OpenMP threads to use for the grid
+        search over covariance parameters (default 1)
+
+        Each thread uses a copy of the covariance function obtained
+        from \ref mcovar_base::clone() and its own workspace
+        matrices. If the covariance function does not support
+        copies, or if OpenMP support was not enabled, then
+        the search is performed with only one thread.
+    */
+    size_t n_threads;
     //@}
 
     /// \name Minimizers and settings
@@ -482,6 +1264,28 @@ namespace o2scl {
 
     /// If true, use the alternate minimizer
     bool use_alt_mmin;
+
+    /// Gradient minimizer
+    mmin_bfgs2<> grad_mmin;
+
+    /** \brief If true and \ref full_min is true, use \ref grad_mmin
+        with the analytical gradient of the log marginal likelihood
+        (default false)
+
+        This requires that \ref mode is \ref mode_max_lml and that
+        the covariance function implements 
+        \ref mcovar_base::deriv_param() . 
+    */
+    bool use_grad_mmin;
+    
+    /** \brief The number of points which can be added, removed,
+        or replaced with \ref update_data() and \ref replace_data()
+        before the covariance parameters are re-optimized (default 0)
+
+        If this is zero, then \ref update_data() and \ref
+        replace_data() never re-optimize the covariance parameters.
+    */
+    size_t refit_interval;
     
     /// Set the minimizer to use
     void set_mmin(mmin_base<multi_funct,multi_funct,ubvector> &mb) {
@@ -501,6 +1305,25 @@ namespace o2scl {
     /** \brief Function to optimize the covariance parameters
      */
     virtual double qual_fun(size_t iout, int &success) {
+      return qual_fun_ws(iout,*cf[iout],this->mi,this->inv_KXX[iout],
+                         this->Kinvf[iout],blk_inv_KXX[iout],
+                         blk_Kinvf[iout],success);
+    }
+    
+    /** \brief Compute the quality function using the covariance
+        function \c cov and the specified workspace
+
+        This function only modifies its arguments, so it can be
+        called simultaneously from several threads as long as each
+        thread has its own covariance function and workspace (and
+        \ref addl_const() is thread-safe).
+     */
+    double qual_fun_ws(size_t iout, mcovar_base<vec_t,mat_x_row_t> &cov,
+                       mat_inv_t &mi_ws, mat_inv_kxx_t &inv_ws,
+                       ubvector &Kinvf_ws,
+                       std::vector<mat_inv_kxx_t> &blk_inv_ws,
+                       std::vector<ubvector> &blk_Kinvf_ws,
+                       int &success) {
 
       // Select the row of the data matrix
       mat_y_col_t yiout2(this->y,iout);
@@ -513,7 +1336,13 @@ namespace o2scl {
 
       time_t t1=0, t2=0, t3=0, t4=0;
 
-      if (mode==mode_loo_cv_bf) {
+      if (use_blocks()) {
+
+        ret=qual_fun_blocks(iout,cov,mi_ws,blk_inv_ws,blk_Kinvf_ws,
+                              success);
+        if (success!=0) return ret;
+        
+      } else if (mode==mode_loo_cv_bf) {
 
         for(size_t k=0;k<size;k++) {
           // Leave one observation out
@@ -538,13 +1367,13 @@ namespace o2scl {
               if (irow2>icol2) {
                 inv_KXX2(irow,icol)=inv_KXX2(icol,irow);
               } else {
-                inv_KXX2(irow,icol)=cf[iout]->covar2(xrow,xcol);
+                inv_KXX2(irow,icol)=cov.covar2(xrow,xcol);
               }
             }
           }
           
           // Construct the inverse of KXX
-          this->mi.invert_inplace(size-1,inv_KXX2);
+          mi_ws.invert_inplace(size-1,inv_KXX2);
           
           // Inverse covariance matrix times function vector
           ubvector Kinvf2(size-1);
@@ -564,7 +1393,7 @@ namespace o2scl {
             size_t i2=i;
             if (i>=k) i2++;        
             mat_x_row_t xi2(this->x,i2);
-            kxx0[i]=cf[iout]->covar2(xk,xi2);
+            kxx0[i]=cov.covar2(xk,xi2);
             ypred+=kxx0[i]*Kinvf2[i];
           }
 
@@ -579,15 +1408,15 @@ namespace o2scl {
       } else if (mode==mode_loo_cv) {
 
         // Construct the KXX matrix
-        this->inv_KXX[iout].resize(size,size);
+        inv_ws.resize(size,size);
         for(size_t irow=0;irow<size;irow++) {
           mat_x_row_t xrow(this->x,irow);
           for(size_t icol=0;icol<size;icol++) {
             mat_x_row_t xcol(this->x,icol);
             if (irow<icol) {
-              this->inv_KXX[iout](irow,icol)=this->inv_KXX[iout](icol,irow);
+              inv_ws(irow,icol)=inv_ws(icol,irow);
             } else {
-              this->inv_KXX[iout](irow,icol)=cf[iout]->covar2(xrow,xcol);
+              inv_ws(irow,icol)=cov.covar2(xrow,xcol);
             }
           }
         }
@@ -608,7 +1437,7 @@ namespace o2scl {
           std::cout << "Performing matrix inversion with size "
                     << size << std::endl;
         }
-        int cret=this->mi.invert_inplace(size,this->inv_KXX[iout]);
+        int cret=mi_ws.invert_inplace(size,inv_ws);
         if (cret!=0) {
           success=1;
           return 1.0e99;
@@ -628,11 +1457,11 @@ namespace o2scl {
         }
         
         // Inverse covariance matrix times function vector
-        this->Kinvf[iout].resize(size);
+        Kinvf_ws.resize(size);
         o2scl_cblas::dgemv(o2scl_cblas::o2cblas_RowMajor,
                            o2scl_cblas::o2cblas_NoTrans,
-                           size,size,1.0,this->inv_KXX[iout],
-                           yiout2,0.0,this->Kinvf[iout]);
+                           size,size,1.0,inv_ws,
+                           yiout2,0.0,Kinvf_ws);
         
         if (timing) {
           t3=time(0);          
@@ -651,8 +1480,8 @@ namespace o2scl {
           double yact=yiout[ii];
           
           // Compute sigma and ypred from Eq. 5.12
-          double sigma2=1.0/this->inv_KXX[iout](ii,ii);
-          double ypred=yact-this->Kinvf[iout][ii]*sigma2;
+          double sigma2=1.0/inv_ws(ii,ii);
+          double ypred=yact-Kinvf_ws[ii]*sigma2;
           
           // Then use Eq. 5.10
           ret+=pow(yact-ypred,2.0)/sigma2/2.0;
@@ -689,7 +1518,7 @@ namespace o2scl {
             if (irow>icol) {
               KXX(irow,icol)=KXX(icol,irow);
             } else {
-              KXX(irow,icol)=cf[iout]->covar2(xrow,xrow2);
+              KXX(irow,icol)=cov.covar2(xrow,xrow2);
             }
           }
         }
@@ -714,8 +1543,8 @@ namespace o2scl {
           std::cout << "Performing matrix inversion with size "
                     << size << std::endl;
         }
-        this->inv_KXX[iout].resize(size,size);
-        int cret=this->mi.invert_det(size,KXX,this->inv_KXX[iout],lndet);
+        inv_ws.resize(size,size);
+        int cret=mi_ws.invert_det(size,KXX,inv_ws,lndet);
         if (cret!=0) {
           success=2;
           return 1.0e99;
@@ -744,11 +1573,11 @@ namespace o2scl {
         }
         
         // Inverse covariance matrix times function vector
-        this->Kinvf[iout].resize(size);
+        Kinvf_ws.resize(size);
         o2scl_cblas::dgemv(o2scl_cblas::o2cblas_RowMajor,
                            o2scl_cblas::o2cblas_NoTrans,
-                           size,size,1.0,this->inv_KXX[iout],
-                           yiout2,0.0,this->Kinvf[iout]);
+                           size,size,1.0,inv_ws,
+                           yiout2,0.0,Kinvf_ws);
 	
         if (timing) {
           t3=time(0);          
@@ -761,7 +1590,7 @@ namespace o2scl {
           // Compute the log of the marginal likelihood, without
           // the constant term
           for(size_t i=0;i<size;i++) {
-            ret+=0.5*yiout2[i]*this->Kinvf[iout][i];
+            ret+=0.5*yiout2[i]*Kinvf_ws[i];
           }
           ret+=0.5*lndet;
         }
@@ -799,6 +1628,181 @@ namespace o2scl {
       }
       return ret;
     }
+
+    /** \brief Add the contribution from the points in \c ix to the
+        gradient of the quality function
+        
+        This uses 
+        \f[
+        \frac{\partial q}{\partial \theta} = \frac{1}{2}
+        \mathrm{Tr} \left[ \left(K^{-1} - \alpha \alpha^{T}\right)
+        \frac{\partial K}{\partial \theta} \right]
+        \f]
+        where \f$ \alpha = K^{-1} y \f$. 
+    */
+    void grad_block(size_t iout, const std::vector<size_t> &ix,
+                    const mat_inv_kxx_t &inv, const ubvector &alpha,
+                    ubvector &grad) {
+      size_t np=grad.size();
+      for(size_t i=0;i<ix.size();i++) {
+        mat_x_row_t xi(this->x,ix[i]);
+        for(size_t j=0;j<=i;j++) {
+          mat_x_row_t xj(this->x,ix[j]);
+          // Off-diagonal elements are counted twice
+          double w=inv(i,j)-alpha[i]*alpha[j];
+          if (i==j) w/=2.0;
+          for(size_t ip=0;ip<np;ip++) {
+            grad[ip]+=w*cf[iout]->deriv_param(xi,xj,ip);
+          }
+        }
+      }
+      return;
+    }
+    
+    /** \brief Compute the quality function and its gradient
+        with respect to the covariance parameters
+
+        This function requires that \ref mode is equal to \ref
+        mode_max_lml, and uses the present parameters in the
+        covariance function. The gradient does not include any
+        contribution from \ref addl_const(). The value returned is
+        the value of \c success from \ref qual_fun() .
+    */
+    int qual_grad(size_t iout, double &qual_val, ubvector &grad) {
+      
+      if (mode!=mode_max_lml) {
+        O2SCL_ERR2("Gradient only available for mode_max_lml in ",
+                   "interpm_krige_optim::qual_grad().",
+                   o2scl::exc_einval);
+      }
+      
+      int success;
+      qual_val=qual_fun(iout,success);
+      
+      size_t np=cf[iout]->get_n_params();
+      grad.resize(np);
+      for(size_t ip=0;ip<np;ip++) grad[ip]=0.0;
+      if (success!=0) return success;
+      
+      if (use_blocks()) {
+        for(size_t ib=0;ib<blk_index.size();ib++) {
+          grad_block(iout,blk_index[ib],blk_inv_KXX[iout][ib],
+                     blk_Kinvf[iout][ib],grad);
+        }
+      } else {
+        std::vector<size_t> ix(this->n_points);
+        for(size_t i=0;i<this->n_points;i++) ix[i]=i;
+        grad_block(iout,ix,this->inv_KXX[iout],this->Kinvf[iout],grad);
+      }
+      
+      return 0;
+    }
+
+    /** \brief Perform the grid search over the covariance
+        parameters in parallel
+
+        The grid points are ordered in the same way as in the
+        serial search in \ref set_data(), so that ties are resolved
+        identically. This function returns false (and does nothing) 
+        if only one thread is available or if the covariance
+        function does not support \ref mcovar_base::clone() .
+    */
+    bool grid_search_threads(size_t iout, vec_t &min_params,
+                             double &min_qual, bool &min_set) {
+
+      size_t nt=n_threads;
+#ifndef O2SCL_SET_OPENMP
+      nt=1;
+#endif
+      if (nt<=1) return false;
+      
+      // Create a copy of the covariance function for each thread
+      std::vector<std::shared_ptr<mcovar_base<vec_t,mat_x_row_t>>>
+        cov_thr(nt);
+      for(size_t it=0;it<nt;it++) {
+        cov_thr[it]=cf[iout]->clone();
+        if (!cov_thr[it]) {
+          if (this->verbose>0) {
+            std::cout << "interpm_krige_optim::grid_search_threads(): "
+                      << "Covariance function does not support "
+                      << "clone().\n  Using one thread." << std::endl;
+          }
+          return false;
+        }
+      }
+
+      // Workspace for each thread
+      std::vector<mat_inv_t> mi_thr(nt);
+      std::vector<mat_inv_kxx_t> inv_thr(nt);
+      std::vector<ubvector> Kinvf_thr(nt);
+      std::vector<std::vector<mat_inv_kxx_t>> blk_inv_thr(nt);
+      std::vector<std::vector<ubvector>> blk_Kinvf_thr(nt);
+
+      size_t np_covar=cf[iout]->get_n_params();
+      size_t n_grid=1;
+      for(size_t k=0;k<np_covar;k++) {
+        n_grid*=plists[iout][k].size();
+      }
+      std::vector<double> qual_grid(n_grid);
+      std::vector<int> success_grid(n_grid);
+
+      if (this->verbose>0) {
+        std::cout << "interpm_krige_optim::grid_search_threads(): "
+                  << "Searching " << n_grid << " points with "
+                  << nt << " threads." << std::endl;
+      }
+      
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(dynamic)
+#endif
+      for(size_t ig=0;ig<n_grid;ig++) {
+
+        size_t it=0;
+#ifdef O2SCL_SET_OPENMP
+        it=omp_get_thread_num();
+#endif
+
+        // The first parameter index varies fastest
+        ubvector params(np_covar);
+        size_t rem=ig;
+        for(size_t k=0;k<np_covar;k++) {
+          size_t nk=plists[iout][k].size();
+          params[k]=plists[iout][k][rem % nk];
+          rem/=nk;
+        }
+        cov_thr[it]->set_params(params);
+        
+        qual_grid[ig]=qual_fun_ws(iout,*cov_thr[it],mi_thr[it],
+                                  inv_thr[it],Kinvf_thr[it],
+                                  blk_inv_thr[it],blk_Kinvf_thr[it],
+                                  success_grid[ig]);
+      }
+
+      // Find the minimum
+      for(size_t ig=0;ig<n_grid;ig++) {
+        if (success_grid[ig]==0 &&
+            (min_set==false || qual_grid[ig]<min_qual)) {
+          size_t rem=ig;
+          for(size_t k=0;k<np_covar;k++) {
+            size_t nk=plists[iout][k].size();
+            min_params[k]=plists[iout][k][rem % nk];
+            rem/=nk;
+          }
+          min_qual=qual_grid[ig];
+          min_set=true;
+        }
+      }
+      
+      return true;
+    }
+    
+    /** \brief Gradient function for the covariance parameters
+     */
+    int min_grad(size_t iout, size_t n, ubvector &v, ubvector &g) {
+      cf[iout]->set_params(v);
+      double qtmp;
+      return qual_grad(iout,qtmp,g);
+    }
     //@}
 
     /// \name Constructor and destructor
@@ -814,6 +1818,11 @@ namespace o2scl {
       use_alt_mmin=false;
       skip_optim=false;
       rescale=true;
+      block_size=0;
+      n_threads=1;
+      use_grad_mmin=false;
+      refit_interval=0;
+      n_since_fit=0;
     }
 
     virtual ~interpm_krige_optim() {
@@ -955,6 +1964,26 @@ namespace o2scl {
 
       this->Kinvf.resize(n_out);
       this->inv_KXX.resize(n_out);
+      chol_KXX.clear();
+      chol_KXX.resize(n_out);
+      n_since_fit=0;
+      blk_chol_KXX.clear();
+      blk_chol_KXX.resize(n_out);
+
+      blk_index.clear();
+      blk_inv_KXX.resize(n_out);
+      blk_Kinvf.resize(n_out);
+      if (use_blocks()) {
+        std::vector<size_t> ix(this->n_points);
+        for(size_t i=0;i<this->n_points;i++) ix[i]=i;
+        split_block(ix);
+        if (this->verbose>0) {
+          std::cout << "interpm_krige_optim::set_data(): "
+                    << "Using " << blk_index.size()
+                    << " blocks with at most " << block_size
+                    << " points." << std::endl;
+        }
+      }
 
       if (skip_optim) return 0;
       
@@ -1062,7 +2091,25 @@ namespace o2scl {
              (&class_t::min_fun),this,iout,
              std::placeholders::_1,std::placeholders::_2,max_val);
 
-          if (use_alt_mmin==false) {
+          if (use_grad_mmin && mode==mode_max_lml) {
+            
+            grad_funct gf=std::bind
+              (std::mem_fn<int(size_t,size_t,ubvector &,ubvector &)>
+               (&class_t::min_grad),this,iout,std::placeholders::_1,
+               std::placeholders::_2,std::placeholders::_3);
+            for(size_t j=0;j<np_covar;j++) {
+              sv[j]=plists[iout][j][plists[iout][j].size()/2];
+            }
+            int mret=grad_mmin.mmin_de(np_covar,sv,min_qual,mf,gf);
+            for(size_t j=0;j<np_covar;j++) {
+              min_params[j]=sv[j];
+            }
+            if (mret!=0) {
+              O2SCL_CONV_RET("Gradient minimizer failed in optim.",
+                             o2scl::exc_einval,this->err_nonconv);
+            }
+            
+          } else if (use_alt_mmin==false) {
             int mret=def_mmin.mmin_simplex(np_covar,sx,min_qual,mf);
             if (mret!=0) {
               mret=def_mmin.mmin_simplex(np_covar,sx,min_qual,mf);
@@ -1106,6 +2153,11 @@ namespace o2scl {
           
           std::vector<size_t> index_list(np_covar);
           vector_set_all(np_covar,index_list,0);
+
+          if (n_threads>1 && grid_search_threads(iout,min_params,
+                                                 min_qual,min_set)) {
+            done=true;
+          }
           
           while (done==false) {
             
@@ -1195,6 +2247,444 @@ namespace o2scl {
       return 0;
     }
     
+    /** \brief Add or remove points without re-optimizing the
+        covariance parameters
+
+        The objects \c user_x and \c user_y must contain all \c n_pts
+        points. The first rows must be the points currently held by
+        this object, except for those whose indices are listed in \c
+        ix_removed, in their original order and including the
+        in-place rescaling performed by \ref set_data(). The
+        remaining rows are the new points. A point can thus be
+        replaced by removing it and appending its new value (see
+        also \ref replace_data()). As in \ref set_data(), the views
+        are swapped into this object.
+
+        The Cholesky decomposition of the covariance matrix is
+        extended by the new rows, so that adding \f$ k \f$ points
+        to \f$ n \f$ requires \f$ {\cal O}(n^2 k) \f$ operations
+        rather than the \f$ {\cal O}(n^3) \f$ operations for a new
+        fit. Each removed point requires a rank-one update of the
+        decomposition in \f$ {\cal O}(n^2) \f$ operations. The
+        Cholesky decomposition is computed once, the first time
+        this function is called after \ref set_data(). The quality
+        factor is updated only when \ref mode is \ref mode_max_lml.
+
+        When the block-diagonal approximation is in use (see \ref
+        block_size), the decomposition of each block is updated
+        separately. Removed points are deleted from their block and
+        each new point is added to the block which contains the
+        nearest remaining point. A block which grows larger than
+        \ref block_size is divided again, and the decompositions of
+        the new blocks are computed from scratch. If the number of
+        points crosses \ref block_size, then all of the
+        decompositions are computed from scratch with the current
+        covariance parameters.
+
+        If \ref refit_interval is nonzero and at least that many
+        points have been added, removed, or replaced since the last
+        fit, then \ref set_data() is called instead to re-optimize
+        the covariance parameters.
+    */
+    virtual int update_data(size_t n_pts, mat_x_t &user_x,
+                            mat_y_t &user_y,
+                            const std::vector<size_t> &ix_removed=
+                            std::vector<size_t>()) {
+
+      if (data_set==false) {
+        O2SCL_ERR2("Data not set in ",
+                   "interpm_krige_optim::update_data().",exc_einval);
+      }
+
+      size_t n_old=this->n_points;
+      std::vector<size_t> rem=ix_removed;
+      std::sort(rem.begin(),rem.end());
+      rem.erase(std::unique(rem.begin(),rem.end()),rem.end());
+      if (rem.size()>0 && rem.back()>=n_old) {
+        O2SCL_ERR2("Index of removed point out of range in ",
+                   "interpm_krige_optim::update_data().",exc_einval);
+      }
+      size_t n_kept=n_old-rem.size();
+      if (n_pts<n_kept || n_pts<2) {
+        O2SCL_ERR2("Too few points in ",
+                   "interpm_krige_optim::update_data().",exc_einval);
+      }
+      if (user_x.size1()!=n_pts || user_x.size2()!=this->n_params) {
+        O2SCL_ERR2("Size of x not correct in ",
+                   "interpm_krige_optim::update_data().",
+                   o2scl::exc_efailed);
+      }
+      if (user_y.size1()!=n_pts || user_y.size2()!=this->n_outputs) {
+        O2SCL_ERR2("Size of y not correct in ",
+                   "interpm_krige_optim::update_data().",
+                   o2scl::exc_efailed);
+      }
+
+      size_t n_new=n_pts-n_kept;
+
+      std::swap(this->x,user_x);
+      std::swap(this->y,user_y);
+
+      bool old_blk=(blk_index.size()>0);
+
+      bool refit=false;
+      if (refit_interval>0 &&
+          n_since_fit+n_new+rem.size()>=refit_interval) {
+        refit=true;
+      }
+      for(size_t iout=0;iout<this->n_outputs;iout++) {
+        if (old_blk) {
+          if (blk_Kinvf[iout].size()!=blk_index.size()) refit=true;
+        } else {
+          if (Kinvf[iout].size()!=n_old) refit=true;
+        }
+      }
+
+      if (refit) {
+
+        if (this->verbose>0) {
+          std::cout << "interpm_krige_optim::update_data(): "
+                    << "Full refit with " << n_pts << " points."
+                    << std::endl;
+        }
+
+        undo_rescale(n_kept,std::vector<size_t>());
+
+        mat_x_t x2;
+        mat_y_t y2;
+        std::swap(x2,this->x);
+        std::swap(y2,this->y);
+        return set_data(this->n_params,this->n_outputs,n_pts,x2,y2);
+      }
+
+      if (n_new==0 && rem.size()==0) return 0;
+
+      if (rescale) {
+        for(size_t i=n_kept;i<n_pts;i++) {
+          for(size_t j=0;j<this->n_outputs;j++) {
+            this->y(i,j)=(this->y(i,j)-mean_y[j])/std_y[j];
+          }
+        }
+      }
+
+      this->n_points=n_pts;
+      bool new_blk=use_blocks();
+
+      // The new blocks, the index of the corresponding old block
+      // (or 'fresh' if the decomposition must be computed from
+      // scratch), and the positions of the removed points in the
+      // old block
+      const size_t fresh=std::numeric_limits<size_t>::max();
+      std::vector<std::vector<size_t>> old_index;
+      std::swap(old_index,blk_index);
+      std::vector<size_t> src;
+      std::vector<std::vector<size_t>> rem_pos;
+
+      if (new_blk && (old_blk==false || n_kept==0)) {
+
+        std::vector<size_t> ix(n_pts);
+        for(size_t i=0;i<n_pts;i++) ix[i]=i;
+        split_block(ix);
+        src.resize(blk_index.size(),fresh);
+        rem_pos.resize(blk_index.size());
+
+      } else if (new_blk) {
+
+        // Delete the removed points from each block and renumber
+        // the remaining points
+        size_t nob=old_index.size();
+        std::vector<std::vector<size_t>> kept(nob), rp(nob);
+        std::vector<size_t> blk_of(n_kept);
+        for(size_t ib=0;ib<nob;ib++) {
+          for(size_t p=0;p<old_index[ib].size();p++) {
+            size_t i=old_index[ib][p];
+            std::vector<size_t>::iterator it=
+              std::lower_bound(rem.begin(),rem.end(),i);
+            if (it!=rem.end() && *it==i) {
+              rp[ib].push_back(p);
+            } else {
+              size_t i_new=i-(it-rem.begin());
+              blk_of[i_new]=ib;
+              kept[ib].push_back(i_new);
+            }
+          }
+        }
+
+        // Add each new point to the block of the nearest
+        // remaining point
+        for(size_t i=n_kept;i<n_pts;i++) {
+          mat_x_row_t xi(this->x,i);
+          size_t jmin=0;
+          double dmin=0.0;
+          for(size_t j=0;j<n_kept;j++) {
+            mat_x_row_t xj(this->x,j);
+            double d=0.0;
+            for(size_t k=0;k<this->n_params;k++) {
+              d+=(xi[k]-xj[k])*(xi[k]-xj[k]);
+            }
+            if (j==0 || d<dmin) {
+              jmin=j;
+              dmin=d;
+            }
+          }
+          kept[blk_of[jmin]].push_back(i);
+        }
+
+        for(size_t ib=0;ib<nob;ib++) {
+          if (kept[ib].size()>block_size) {
+            split_block(kept[ib]);
+            src.resize(blk_index.size(),fresh);
+            rem_pos.resize(blk_index.size());
+          } else if (kept[ib].size()>0) {
+            blk_index.push_back(kept[ib]);
+            src.push_back(ib);
+            rem_pos.push_back(rp[ib]);
+          }
+        }
+
+      }
+
+      if (this->verbose>0 && new_blk) {
+        std::cout << "interpm_krige_optim::update_data(): "
+                  << "Using " << blk_index.size()
+                  << " blocks with at most " << block_size
+                  << " points." << std::endl;
+      }
+
+      for(size_t iout=0;iout<this->n_outputs;iout++) {
+
+        mcovar_base<vec_t,mat_x_row_t> &cov=*cf[iout];
+        double q=0.0;
+
+        if (new_blk) {
+
+          size_t nblk=blk_index.size();
+          std::vector<ubmatrix> L(nblk);
+          std::vector<mat_inv_kxx_t> inv(nblk);
+          std::vector<ubvector> Kinvf_b(nblk);
+          bool have_chol=(blk_chol_KXX[iout].size()==old_index.size());
+
+          for(size_t ib=0;ib<nblk;ib++) {
+            size_t n_kept_b=0;
+            if (src[ib]!=fresh) {
+              if (have_chol) std::swap(L[ib],blk_chol_KXX[iout][src[ib]]);
+              std::swap(inv[ib],blk_inv_KXX[iout][src[ib]]);
+              n_kept_b=old_index[src[ib]].size()-rem_pos[ib].size();
+            }
+            int cret=chol_update(cov,blk_index[ib],rem_pos[ib],n_kept_b,
+                                 src[ib]==fresh,L[ib],inv[ib]);
+            if (cret!=0) {
+              O2SCL_ERR2("Updated covariance matrix not positive ",
+                         "definite in interpm_krige_optim::update_data().",
+                         o2scl::exc_efailed);
+            }
+            q+=chol_Kinvf(iout,blk_index[ib],L[ib],Kinvf_b[ib]);
+          }
+
+          std::swap(blk_chol_KXX[iout],L);
+          std::swap(blk_inv_KXX[iout],inv);
+          std::swap(blk_Kinvf[iout],Kinvf_b);
+          chol_KXX[iout].resize(0,0);
+          inv_KXX[iout].resize(0,0);
+          Kinvf[iout].resize(0);
+
+        } else {
+
+          std::vector<size_t> ix(n_pts);
+          for(size_t i=0;i<n_pts;i++) ix[i]=i;
+          int cret=chol_update(cov,ix,rem,n_kept,old_blk,chol_KXX[iout],
+                               inv_KXX[iout]);
+          if (cret!=0) {
+            O2SCL_ERR2("Updated covariance matrix not positive ",
+                       "definite in interpm_krige_optim::update_data().",
+                       o2scl::exc_efailed);
+          }
+          q=chol_Kinvf(iout,ix,chol_KXX[iout],Kinvf[iout]);
+          blk_chol_KXX[iout].clear();
+          blk_inv_KXX[iout].clear();
+          blk_Kinvf[iout].clear();
+
+        }
+
+        if (mode==mode_max_lml) {
+          double qual_ac=0.0;
+          addl_const(iout,qual_ac);
+          qual[iout]=q+qual_ac;
+        }
+
+      }
+
+      n_since_fit+=n_new+rem.size();
+
+      if (this->verbose>0) {
+        std::cout << "interpm_krige_optim::update_data(): "
+                  << "Added " << n_new << " and removed " << rem.size()
+                  << " points for a total of " << n_pts << "."
+                  << std::endl;
+      }
+
+      return 0;
+    }
+
+    /** \brief Replace points without re-optimizing the covariance
+        parameters
+
+        The objects \c user_x and \c user_y must contain the same
+        number of points as the data currently held by this object.
+        The rows whose indices are listed in \c ix_replaced are the
+        new values of those points, and the other rows must be
+        identical to the current data (including the in-place
+        rescaling performed by \ref set_data()). As in \ref
+        set_data(), the views are swapped into this object.
+
+        Each replaced point is removed from the Cholesky
+        decomposition with a rank-one update and then inserted with
+        a rank-one downdate, requiring \f$ {\cal O}(n^2) \f$
+        operations rather than the \f$ {\cal O}(n^3) \f$
+        operations for a new fit. When the block-diagonal
+        approximation is in use, each point remains in its block
+        and only the decompositions of the blocks which contain
+        replaced points are modified. The quality factor is updated
+        only when \ref mode is \ref mode_max_lml, and \ref
+        refit_interval is handled as in \ref update_data().
+    */
+    virtual int replace_data(mat_x_t &user_x, mat_y_t &user_y,
+                             const std::vector<size_t> &ix_replaced) {
+
+      if (data_set==false) {
+        O2SCL_ERR2("Data not set in ",
+                   "interpm_krige_optim::replace_data().",exc_einval);
+      }
+
+      size_t n=this->n_points;
+      std::vector<size_t> rep=ix_replaced;
+      std::sort(rep.begin(),rep.end());
+      rep.erase(std::unique(rep.begin(),rep.end()),rep.end());
+      if (rep.size()>0 && rep.back()>=n) {
+        O2SCL_ERR2("Index of replaced point out of range in ",
+                   "interpm_krige_optim::replace_data().",exc_einval);
+      }
+      if (user_x.size1()!=n || user_x.size2()!=this->n_params) {
+        O2SCL_ERR2("Size of x not correct in ",
+                   "interpm_krige_optim::replace_data().",
+                   o2scl::exc_efailed);
+      }
+      if (user_y.size1()!=n || user_y.size2()!=this->n_outputs) {
+        O2SCL_ERR2("Size of y not correct in ",
+                   "interpm_krige_optim::replace_data().",
+                   o2scl::exc_efailed);
+      }
+
+      std::swap(this->x,user_x);
+      std::swap(this->y,user_y);
+
+      bool blk=(blk_index.size()>0);
+
+      bool refit=false;
+      if (refit_interval>0 && n_since_fit+rep.size()>=refit_interval) {
+        refit=true;
+      }
+      for(size_t iout=0;iout<this->n_outputs;iout++) {
+        if (blk) {
+          if (blk_Kinvf[iout].size()!=blk_index.size()) refit=true;
+        } else {
+          if (Kinvf[iout].size()!=n) refit=true;
+        }
+      }
+
+      if (refit) {
+
+        if (this->verbose>0) {
+          std::cout << "interpm_krige_optim::replace_data(): "
+                    << "Full refit with " << n << " points."
+                    << std::endl;
+        }
+
+        undo_rescale(n,rep);
+
+        mat_x_t x2;
+        mat_y_t y2;
+        std::swap(x2,this->x);
+        std::swap(y2,this->y);
+        return set_data(this->n_params,this->n_outputs,n,x2,y2);
+      }
+
+      if (rep.size()==0) return 0;
+
+      if (rescale) {
+        for(size_t k=0;k<rep.size();k++) {
+          for(size_t j=0;j<this->n_outputs;j++) {
+            this->y(rep[k],j)=(this->y(rep[k],j)-mean_y[j])/std_y[j];
+          }
+        }
+      }
+
+      // The positions of the replaced points in each block
+      size_t nblk=blk_index.size();
+      std::vector<std::vector<size_t>> rep_pos(nblk);
+      for(size_t ib=0;ib<nblk;ib++) {
+        for(size_t p=0;p<blk_index[ib].size();p++) {
+          if (std::binary_search(rep.begin(),rep.end(),
+                                 blk_index[ib][p])) {
+            rep_pos[ib].push_back(p);
+          }
+        }
+      }
+
+      for(size_t iout=0;iout<this->n_outputs;iout++) {
+
+        mcovar_base<vec_t,mat_x_row_t> &cov=*cf[iout];
+        double q=0.0;
+
+        if (blk) {
+
+          blk_chol_KXX[iout].resize(nblk);
+          for(size_t ib=0;ib<nblk;ib++) {
+            int cret=chol_replace_set(cov,blk_index[ib],rep_pos[ib],
+                                      blk_chol_KXX[iout][ib],
+                                      blk_inv_KXX[iout][ib]);
+            if (cret!=0) {
+              O2SCL_ERR2("Updated covariance matrix not positive ",
+                         "definite in interpm_krige_optim::replace_data().",
+                         o2scl::exc_efailed);
+            }
+            q+=chol_Kinvf(iout,blk_index[ib],blk_chol_KXX[iout][ib],
+                          blk_Kinvf[iout][ib]);
+          }
+
+        } else {
+
+          std::vector<size_t> ix(n);
+          for(size_t i=0;i<n;i++) ix[i]=i;
+          int cret=chol_replace_set(cov,ix,rep,chol_KXX[iout],
+                                    inv_KXX[iout]);
+          if (cret!=0) {
+            O2SCL_ERR2("Updated covariance matrix not positive ",
+                       "definite in interpm_krige_optim::replace_data().",
+                       o2scl::exc_efailed);
+          }
+          q=chol_Kinvf(iout,ix,chol_KXX[iout],Kinvf[iout]);
+
+        }
+
+        if (mode==mode_max_lml) {
+          double qual_ac=0.0;
+          addl_const(iout,qual_ac);
+          qual[iout]=q+qual_ac;
+        }
+
+      }
+
+      n_since_fit+=rep.size();
+
+      if (this->verbose>0) {
+        std::cout << "interpm_krige_optim::replace_data(): "
+                  << "Replaced " << rep.size() << " points." << std::endl;
+      }
+
+      return 0;
+    }
+
     /** \brief Evaluate the interpolation at point \c x,
         returning \c y
     */
@@ -1225,10 +2715,15 @@ namespace o2scl {
       // Evaluate the interpolated result
       for(size_t iout=0;iout<this->n_outputs;iout++) {
         y0[iout]=0.0;
-        for(size_t ipoints=0;ipoints<this->n_points;ipoints++) {
-          mat_x_row_t xrow(x,ipoints);
-          double covar_val=(*cf[iout])(x0,xrow);
-          y0[iout]+=covar_val*Kinvf[iout][ipoints];
+        if (use_blocks()) {
+          double var;
+          blocks_pred(x0,iout,y0[iout],var);
+        } else {
+          for(size_t ipoints=0;ipoints<this->n_points;ipoints++) {
+            mat_x_row_t xrow(x,ipoints);
+            double covar_val=(*cf[iout])(x0,xrow);
+            y0[iout]+=covar_val*Kinvf[iout][ipoints];
+          }
         }
         if (rescale) {
           y0[iout]*=std_y[iout];
@@ -1252,13 +2747,22 @@ namespace o2scl {
         O2SCL_ERR("Data not set in interpm_krige::sigma_covar().",
                   exc_einval);
       }
-      if (!keep_matrix) {
+      if (!keep_matrix && !use_blocks()) {
         O2SCL_ERR2("Matrix information missing (keep_matrix==false) in ",
                    "interpm_krige::sigma_covar().",o2scl::exc_einval);
       }
       
       // Evaluate the interpolated result
       for(size_t iout=0;iout<this->n_outputs;iout++) {
+
+        if (use_blocks()) {
+          double mean;
+          blocks_pred(x0,iout,mean,dy0[iout]);
+          if (rescale) {
+            dy0[iout]*=std_y[iout];
+          }
+          continue;
+        }
         
         double kx0x0=cf[iout]->covar(x0,x0);
         
@@ -1285,6 +2789,10 @@ namespace o2scl {
     
     /** \brief Given input vector \c x
         store the result of the interpolation in \c y
+
+        When \ref block_size is nonzero, the weights of the local
+        experts are held fixed, so the result is only an
+        approximation to the derivative of \ref eval().
     */
     template<class vec2_t, class vec4_t>
     void deriv(const vec2_t &x0, vec4_t &y0, size_t ix) {
@@ -1292,10 +2800,23 @@ namespace o2scl {
       // Evaluate the interpolated result
       for(size_t iout=0;iout<this->n_outputs;iout++) {
         y0[iout]=0.0;
-        for(size_t ipoints=0;ipoints<this->n_points;ipoints++) {
-          mat_x_row_t xrow(this->x,ipoints);
-          double covar_val=(*cf[iout]).deriv(x0,xrow,ix);
-          y0[iout]+=covar_val*this->Kinvf[iout][ipoints];
+        if (use_blocks()) {
+          double mean, var;
+          std::vector<double> wgts;
+          blocks_pred(x0,iout,mean,var,&wgts);
+          for(size_t ib=0;ib<blk_index.size();ib++) {
+            for(size_t i=0;i<blk_index[ib].size();i++) {
+              mat_x_row_t xrow(this->x,blk_index[ib][i]);
+              y0[iout]+=wgts[ib]*(*cf[iout]).deriv(x0,xrow,ix)*
+                blk_Kinvf[iout][ib][i];
+            }
+          }
+        } else {
+          for(size_t ipoints=0;ipoints<this->n_points;ipoints++) {
+            mat_x_row_t xrow(this->x,ipoints);
+            double covar_val=(*cf[iout]).deriv(x0,xrow,ix);
+            y0[iout]+=covar_val*this->Kinvf[iout][ipoints];
+          }
         }
         if (this->rescale) {
           y0[iout]*=this->std_y[iout];
@@ -1314,10 +2835,23 @@ namespace o2scl {
       // Evaluate the interpolated result
       for(size_t iout=0;iout<this->n_outputs;iout++) {
         y0[iout]=0.0;
-        for(size_t ipoints=0;ipoints<this->n_points;ipoints++) {
-          mat_x_row_t xrow(this->x,ipoints);
-          double covar_val=(*cf[iout]).deriv2(x0,xrow,ix,iy);
-          y0[iout]+=covar_val*this->Kinvf[iout][ipoints];
+        if (use_blocks()) {
+          double mean, var;
+          std::vector<double> wgts;
+          blocks_pred(x0,iout,mean,var,&wgts);
+          for(size_t ib=0;ib<blk_index.size();ib++) {
+            for(size_t i=0;i<blk_index[ib].size();i++) {
+              mat_x_row_t xrow(this->x,blk_index[ib][i]);
+              y0[iout]+=wgts[ib]*(*cf[iout]).deriv2(x0,xrow,ix,iy)*
+                blk_Kinvf[iout][ib][i];
+            }
+          }
+        } else {
+          for(size_t ipoints=0;ipoints<this->n_points;ipoints++) {
+            mat_x_row_t xrow(this->x,ipoints);
+            double covar_val=(*cf[iout]).deriv2(x0,xrow,ix,iy);
+            y0[iout]+=covar_val*this->Kinvf[iout][ipoints];
+          }
         }
         if (this->rescale) {
           y0[iout]*=this->std_y[iout];
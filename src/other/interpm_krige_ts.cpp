@@ -687,8 +687,410 @@ int main(void) {
     t.set_output_level(1);
     cout << endl;
   }
-  
-#ifdef O2SCL_SET_EIGEN  
+
+  if (true) {
+
+    cout << "--------------------------------------------" << endl;
+    cout << "interpm_krige_optim, rescaled, max_lml, blocks\n" << endl;
+
+    vector<std::shared_ptr<mcovar_base<ubvector,mat_x_row_t>>> vmfrn;
+    vmfrn.resize(1);
+    std::shared_ptr<mcovar_funct_rbf_noise<
+      ubvector,mat_x_row_t>> mfrn(new mcovar_funct_rbf_noise<ubvector,
+                                  mat_x_row_t>);
+    vmfrn[0]=mfrn;
+    mfrn->len.resize(2);
+
+    interpm_krige_optim
+      <ubvector,mat_x_t,mat_x_row_t,mat_y_t,mat_y_col_t,ubmatrix> iko;
+    iko.mode=iko.mode_max_lml;
+    iko.block_size=100;
+
+    table<> tab3;
+    generate_table(tab3,400);
+
+    const_matrix_view_table<> mvt_x3(tab3,col_list_x);
+    matrix_view_table<> mvt_y3(tab3,col_list_y);
+
+    gen_test_number<> gtn_x3;
+    gtn_x3.set_radix(1.9);
+
+    vector<double> len_list={0.3,0.7,0.9,1.0,1.5,2.0,3.0,7.0};
+    vector<double> l10_list={-15,-13,-11,-9};
+    vector<vector<double> > ptemp;
+    ptemp.push_back(len_list);
+    ptemp.push_back(len_list);
+    ptemp.push_back(l10_list);
+    vector<vector<vector<double>>> param_lists;
+    param_lists.push_back(ptemp);
+
+    iko.set_covar(vmfrn,param_lists);
+    iko.rescale=true;
+    iko.verbose=1;
+    iko.set_data(2,1,tab3.get_nlines(),mvt_x3,mvt_y3);
+    cout << endl;
+
+    for(size_t j=0;j<20;j++) {
+      ubvector point(2), out(1), unc(1);
+      point[0]=gtn_x3.gen();
+      point[1]=gtn_x3.gen();
+
+      if (fabs(point[0])<3.0 && fabs(point[1])<5.0) {
+        iko.eval_unc(point,out,unc);
+        cout.setf(ios::showpos);
+        cout << point[0] << " " << point[1] << " "
+             << out[0] << " " << ft(point[0],point[1]) << " "
+             << unc[0] << endl;
+        cout.unsetf(ios::showpos);
+        t.test_rel(out[0],ft(point[0],point[1]),6.0,
+                   "optim, rescaled, max_lml, blocks");
+        t.test_gen(unc[0]>=0.0,"optim, rescaled, max_lml, blocks, unc");
+      }
+
+    }
+    cout << endl;
+
+  }
+
+  if (true) {
+
+    cout << "--------------------------------------------" << endl;
+    cout << "interpm_krige_optim, gradient and threads\n" << endl;
+
+    vector<std::shared_ptr<mcovar_base<ubvector,mat_x_row_t>>> vmfrn;
+    vmfrn.resize(1);
+    std::shared_ptr<mcovar_funct_rbf_noise<
+      ubvector,mat_x_row_t>> mfrn(new mcovar_funct_rbf_noise<ubvector,
+                                  mat_x_row_t>);
+    vmfrn[0]=mfrn;
+    mfrn->len.resize(2);
+
+    interpm_krige_optim
+      <ubvector,mat_x_t,mat_x_row_t,mat_y_t,mat_y_col_t,ubmatrix> iko;
+    iko.mode=iko.mode_max_lml;
+
+    table<> tab3;
+    generate_table(tab3);
+
+    const_matrix_view_table<> mvt_x3(tab3,col_list_x);
+    matrix_view_table<> mvt_y3(tab3,col_list_y);
+
+    vector<double> len_list={0.3,0.7,0.9,1.0,1.5,2.0,3.0,7.0};
+    vector<double> l10_list={-15,-13,-11,-9};
+    vector<vector<double> > ptemp;
+    ptemp.push_back(len_list);
+    ptemp.push_back(len_list);
+    ptemp.push_back(l10_list);
+    vector<vector<vector<double>>> param_lists;
+    param_lists.push_back(ptemp);
+
+    iko.set_covar(vmfrn,param_lists);
+    iko.rescale=true;
+    iko.set_data(2,1,tab3.get_nlines(),mvt_x3,mvt_y3);
+
+    // Ensure the threaded grid search gives the same result
+    ubvector point(2), out1(1), out2(1);
+    point[0]=0.5;
+    point[1]=1.5;
+    iko.eval(point,out1);
+
+    interpm_krige_optim
+      <ubvector,mat_x_t,mat_x_row_t,mat_y_t,mat_y_col_t,ubmatrix> iko2;
+    iko2.mode=iko2.mode_max_lml;
+    iko2.n_threads=2;
+
+    table<> tab4;
+    generate_table(tab4);
+    const_matrix_view_table<> mvt_x4(tab4,col_list_x);
+    matrix_view_table<> mvt_y4(tab4,col_list_y);
+
+    iko2.set_covar(vmfrn,param_lists);
+    iko2.rescale=true;
+    iko2.set_data(2,1,tab4.get_nlines(),mvt_x4,mvt_y4);
+    iko2.eval(point,out2);
+    t.test_rel(out1[0],out2[0],1.0e-10,"threaded grid search");
+
+    // Compare the analytical gradient of the log marginal
+    // likelihood with a finite-difference approximation
+    ubvector p(3), grad(3);
+    p[0]=1.2;
+    p[1]=1.7;
+    p[2]=-4.0;
+    mfrn->set_params(p);
+    double q0;
+    iko.qual_grad(0,q0,grad);
+    for(size_t ip=0;ip<3;ip++) {
+      int success;
+      ubvector p2=p;
+      p2[ip]+=1.0e-5;
+      mfrn->set_params(p2);
+      double q1=iko.qual_fun(0,success);
+      p2[ip]-=2.0e-5;
+      mfrn->set_params(p2);
+      double q2=iko.qual_fun(0,success);
+      cout << ip << " " << grad[ip] << " " << (q1-q2)/2.0e-5 << endl;
+      t.test_rel(grad[ip],(q1-q2)/2.0e-5,1.0e-4,"qual_grad");
+    }
+    mfrn->set_params(p);
+    cout << endl;
+
+  }
+
+  if (true) {
+
+    cout << "--------------------------------------------" << endl;
+    cout << "interpm_krige_optim, incremental update\n" << endl;
+
+    vector<std::shared_ptr<mcovar_base<ubvector,mat_x_row_t>>> vmfrn;
+    vmfrn.resize(1);
+    std::shared_ptr<mcovar_funct_rbf_noise<
+      ubvector,mat_x_row_t>> mfrn(new mcovar_funct_rbf_noise<ubvector,
+                                  mat_x_row_t>);
+    vmfrn[0]=mfrn;
+    mfrn->len.resize(2);
+
+    // Use a single set of covariance parameters so that the
+    // incremental and full fits are directly comparable
+    vector<vector<double> > ptemp={{1.0},{1.0},{-6.0}};
+    vector<vector<vector<double>>> param_lists;
+    param_lists.push_back(ptemp);
+    
+    // The full fit with 100 points
+    interpm_krige_optim
+      <ubvector,mat_x_t,mat_x_row_t,mat_y_t,mat_y_col_t,ubmatrix> iko;
+    iko.mode=iko.mode_max_lml;
+    iko.rescale=false;
+    iko.set_covar(vmfrn,param_lists);
+    
+    table<> tab3;
+    generate_table(tab3);
+
+    // Start with the first 80 points
+    table<> tab4;
+    generate_table(tab4,80);
+    
+    const_matrix_view_table<> mvt_x3(tab3,col_list_x);
+    matrix_view_table<> mvt_y3(tab3,col_list_y);
+    iko.set_data(2,1,tab3.get_nlines(),mvt_x3,mvt_y3);
+    
+    interpm_krige_optim
+      <ubvector,mat_x_t,mat_x_row_t,mat_y_t,mat_y_col_t,ubmatrix> iko2;
+    iko2.mode=iko2.mode_max_lml;
+    iko2.rescale=false;
+    iko2.set_covar(vmfrn,param_lists);
+    
+    const_matrix_view_table<> mvt_x4(tab4,col_list_x);
+    matrix_view_table<> mvt_y4(tab4,col_list_y);
+    iko2.set_data(2,1,tab4.get_nlines(),mvt_x4,mvt_y4);
+
+    // Add the remaining points to the table in two batches
+    for(size_t k=80;k<100;k+=10) {
+      for(size_t i=k;i<k+10;i++) {
+        vector<double> line={tab3.get("x",i),tab3.get("y",i),
+                             tab3.get("z",i)};
+        tab4.line_of_data(3,line);
+      }
+      const_matrix_view_table<> mvt_x5(tab4,col_list_x);
+      matrix_view_table<> mvt_y5(tab4,col_list_y);
+      iko2.update_data(tab4.get_nlines(),mvt_x5,mvt_y5);
+    }
+
+    ubvector point(2), out1(1), out2(1), unc1(1), unc2(1);
+    point[0]=0.5;
+    point[1]=1.5;
+    iko.eval_unc(point,out1,unc1);
+    iko2.eval_unc(point,out2,unc2);
+    t.test_rel(out1[0],out2[0],1.0e-8,"update_data() eval");
+    t.test_rel(unc1[0],unc2[0],1.0e-6,"update_data() sigma");
+
+    // Remove three points and replace a fourth by removing it and
+    // appending its new value, which requires rank-one updates
+    // of the Cholesky decomposition
+    vector<double> line={0.3,-1.2,ft(0.3,-1.2)};
+    tab4.delete_row(63);
+    tab4.delete_row(17);
+    tab4.delete_row(5);
+    tab4.delete_row(2);
+    tab4.line_of_data(3,line);
+    {
+      const_matrix_view_table<> mvt_x5(tab4,col_list_x);
+      matrix_view_table<> mvt_y5(tab4,col_list_y);
+      iko2.update_data(tab4.get_nlines(),mvt_x5,mvt_y5,{2,5,17,63});
+    }
+
+    // Compare with a fresh fit using the same covariance parameters
+    table<> tab5=tab4;
+    const_matrix_view_table<> mvt_x6(tab5,col_list_x);
+    matrix_view_table<> mvt_y6(tab5,col_list_y);
+    iko.set_data(2,1,tab5.get_nlines(),mvt_x6,mvt_y6);
+
+    iko.eval_unc(point,out1,unc1);
+    iko2.eval_unc(point,out2,unc2);
+    t.test_rel(out1[0],out2[0],1.0e-8,"update_data() remove eval");
+    t.test_rel(unc1[0],unc2[0],1.0e-6,"update_data() remove sigma");
+
+    // Replace two points in place, which requires a rank-one
+    // update and a rank-one downdate for each point
+    tab4.set("x",10,-0.7);
+    tab4.set("y",10,2.1);
+    tab4.set("z",10,ft(-0.7,2.1));
+    tab4.set("x",40,1.4);
+    tab4.set("y",40,0.2);
+    tab4.set("z",40,ft(1.4,0.2));
+    {
+      const_matrix_view_table<> mvt_x5(tab4,col_list_x);
+      matrix_view_table<> mvt_y5(tab4,col_list_y);
+      iko2.replace_data(mvt_x5,mvt_y5,{10,40});
+    }
+
+    tab5=tab4;
+    const_matrix_view_table<> mvt_x7(tab5,col_list_x);
+    matrix_view_table<> mvt_y7(tab5,col_list_y);
+    iko.set_data(2,1,tab5.get_nlines(),mvt_x7,mvt_y7);
+
+    iko.eval_unc(point,out1,unc1);
+    iko2.eval_unc(point,out2,unc2);
+    t.test_rel(out1[0],out2[0],1.0e-8,"replace_data() eval");
+    t.test_rel(unc1[0],unc2[0],1.0e-6,"replace_data() sigma");
+    cout << endl;
+
+  }
+
+  if (true) {
+
+    cout << "--------------------------------------------" << endl;
+    cout << "interpm_krige_optim, incremental update with blocks\n"
+         << endl;
+
+    vector<std::shared_ptr<mcovar_base<ubvector,mat_x_row_t>>> vmfrn;
+    vmfrn.resize(1);
+    std::shared_ptr<mcovar_funct_rbf_noise<
+      ubvector,mat_x_row_t>> mfrn(new mcovar_funct_rbf_noise<ubvector,
+                                  mat_x_row_t>);
+    vmfrn[0]=mfrn;
+    mfrn->len.resize(2);
+
+    vector<vector<double> > ptemp={{1.0},{1.0},{-6.0}};
+    vector<vector<vector<double>>> param_lists;
+    param_lists.push_back(ptemp);
+
+    interpm_krige_optim
+      <ubvector,mat_x_t,mat_x_row_t,mat_y_t,mat_y_col_t,ubmatrix> iko;
+    iko.mode=iko.mode_max_lml;
+    iko.rescale=false;
+    iko.block_size=30;
+    iko.set_covar(vmfrn,param_lists);
+
+    interpm_krige_optim
+      <ubvector,mat_x_t,mat_x_row_t,mat_y_t,mat_y_col_t,ubmatrix> iko2;
+    iko2.mode=iko2.mode_max_lml;
+    iko2.rescale=false;
+    iko2.block_size=30;
+    iko2.set_covar(vmfrn,param_lists);
+
+    table<> tab3, tab4;
+    generate_table(tab3,120);
+    generate_table(tab4,25);
+
+    const_matrix_view_table<> mvt_x4(tab4,col_list_x);
+    matrix_view_table<> mvt_y4(tab4,col_list_y);
+    iko2.set_data(2,1,tab4.get_nlines(),mvt_x4,mvt_y4);
+
+    // Add points so that the block-diagonal approximation is
+    // required, and compare with a fresh fit which divides the
+    // points into the same blocks
+    for(size_t i=25;i<70;i++) {
+      vector<double> line={tab3.get("x",i),tab3.get("y",i),
+                           tab3.get("z",i)};
+      tab4.line_of_data(3,line);
+    }
+    {
+      const_matrix_view_table<> mvt_x5(tab4,col_list_x);
+      matrix_view_table<> mvt_y5(tab4,col_list_y);
+      iko2.update_data(tab4.get_nlines(),mvt_x5,mvt_y5);
+    }
+
+    table<> tab5=tab4;
+    const_matrix_view_table<> mvt_x6(tab5,col_list_x);
+    matrix_view_table<> mvt_y6(tab5,col_list_y);
+    iko.set_data(2,1,tab5.get_nlines(),mvt_x6,mvt_y6);
+
+    ubvector point(2), out1(1), out2(1), unc1(1), unc2(1);
+    point[0]=0.5;
+    point[1]=1.5;
+    iko.eval_unc(point,out1,unc1);
+    iko2.eval_unc(point,out2,unc2);
+    t.test_rel(out1[0],out2[0],1.0e-8,"update_data() to blocks eval");
+    t.test_rel(unc1[0],unc2[0],1.0e-6,"update_data() to blocks sigma");
+
+    // Add and remove points within the existing blocks. Each new
+    // point is added to a nearby block, so the interpolation
+    // should reproduce the new points.
+    for(size_t i=70;i<120;i++) {
+      vector<double> line={tab3.get("x",i),tab3.get("y",i),
+                           tab3.get("z",i)};
+      tab4.line_of_data(3,line);
+    }
+    tab4.delete_row(33);
+    tab4.delete_row(4);
+    {
+      const_matrix_view_table<> mvt_x5(tab4,col_list_x);
+      matrix_view_table<> mvt_y5(tab4,col_list_y);
+      iko2.update_data(tab4.get_nlines(),mvt_x5,mvt_y5,{4,33});
+    }
+    for(size_t i=70;i<120;i+=7) {
+      ubvector xi(2);
+      xi[0]=tab3.get("x",i);
+      xi[1]=tab3.get("y",i);
+      iko2.eval_unc(xi,out2,unc2);
+      t.test_abs(out2[0],tab3.get("z",i),1.0e-2,
+                 "update_data() in blocks eval");
+      t.test_gen(unc2[0]<1.0e-2,"update_data() in blocks sigma");
+    }
+
+    // Replace the output value of a point in place. This does not
+    // change the division into blocks, so the result can be
+    // compared with a fresh fit.
+    tab4.set("z",50,tab4.get("z",50)+1.0);
+    {
+      const_matrix_view_table<> mvt_x5(tab4,col_list_x);
+      matrix_view_table<> mvt_y5(tab4,col_list_y);
+      iko2.replace_data(mvt_x5,mvt_y5,{50});
+    }
+    ubvector x50(2);
+    x50[0]=tab4.get("x",50);
+    x50[1]=tab4.get("y",50);
+    iko2.eval(x50,out2);
+    t.test_abs(out2[0],tab4.get("z",50),1.0e-2,
+               "replace_data() in blocks");
+
+    // Remove points so that the block-diagonal approximation is no
+    // longer required, and compare with a fresh fit
+    vector<size_t> rem;
+    for(size_t i=0;i<tab4.get_nlines();i++) {
+      if (i%5!=0) rem.push_back(i);
+    }
+    for(size_t k=rem.size();k>0;k--) tab4.delete_row(rem[k-1]);
+    {
+      const_matrix_view_table<> mvt_x5(tab4,col_list_x);
+      matrix_view_table<> mvt_y5(tab4,col_list_y);
+      iko2.update_data(tab4.get_nlines(),mvt_x5,mvt_y5,rem);
+    }
+
+    tab5=tab4;
+    const_matrix_view_table<> mvt_x7(tab5,col_list_x);
+    matrix_view_table<> mvt_y7(tab5,col_list_y);
+    iko.set_data(2,1,tab5.get_nlines(),mvt_x7,mvt_y7);
+
+    iko.eval_unc(point,out1,unc1);
+    iko2.eval_unc(point,out2,unc2);
+    t.test_rel(out1[0],out2[0],1.0e-8,"update_data() from blocks eval");
+    t.test_rel(unc1[0],unc2[0],1.0e-6,"update_data() from blocks sigma");
+    cout << endl;
+
+  }
+
+#ifdef O2SCL_SET_EIGEN
 
   {
 
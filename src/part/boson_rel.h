@@ -555,6 +555,83 @@ namespace o2scl {
       return;
     }
     
+    /** \brief Copy the numerical settings from \c br
+
+        This copies the parameters of this class and the
+        tolerances of the integrators and the solver. The
+        integrator and solver objects themselves are not shared, so
+        this object can be used in a different thread than \c br.
+    */
+    void copy_settings(const boson_rel_tl &br) {
+      verify_ti=br.verify_ti;
+      verbose=br.verbose;
+      use_expansions=br.use_expansions;
+      deg_limit=br.deg_limit;
+      upper_limit_fac=br.upper_limit_fac;
+      def_nit.tol_rel=br.nit->tol_rel;
+      def_nit.tol_abs=br.nit->tol_abs;
+      def_nit.err_nonconv=br.nit->err_nonconv;
+      def_dit.tol_rel=br.dit->tol_rel;
+      def_dit.tol_abs=br.dit->tol_abs;
+      def_dit.err_nonconv=br.dit->err_nonconv;
+      def_density_mroot.tol_rel=br.density_mroot->tol_rel;
+      def_density_mroot.tol_abs=br.density_mroot->tol_abs;
+      def_density_mroot.ntrial=br.density_mroot->ntrial;
+      def_density_mroot.err_nonconv=br.density_mroot->err_nonconv;
+      return;
+    }
+
+    /// \name Batch functions
+    //@{
+    /** \brief Calculate properties as a function of chemical
+        potential at each point in \c b
+
+        The mass, degeneracy, and flags are taken from \c bo, and
+        the temperature and the chemical potential from \c b.
+        The points are computed in parallel using \c n_threads
+        threads if OpenMP is enabled. The additional threads use
+        separate objects with the default integrators and solver,
+        with the tolerances taken from this object (see \ref
+        copy_settings()). See \ref o2scl::part_batch_loop() for
+        more details.
+    */
+    void calc_mu_batch(const boson_tl<fp_t> &bo, part_batch_tl<fp_t> &b,
+                       size_t n_threads=1) {
+      std::vector<std::shared_ptr<boson_rel_tl> > thr;
+      batch_threads(n_threads,thr);
+      std::function<int(size_t,boson_tl<fp_t> &,fp_t)> func=
+        std::bind(std::mem_fn<int(size_t,boson_tl<fp_t> &,fp_t,
+                                  std::vector<std::shared_ptr<boson_rel_tl> > &)>
+                  (&boson_rel_tl::batch_mu_point),this,
+                  std::placeholders::_1,std::placeholders::_2,
+                  std::placeholders::_3,std::ref(thr));
+      part_batch_loop(bo,b,false,n_threads,func);
+      return;
+    }
+
+    /** \brief Calculate properties as a function of density
+        at each point in \c b
+
+        This function works as \ref calc_mu_batch() except that
+        the density is taken from \c b and the chemical potential
+        is computed. The chemical potential from each point is used
+        as the initial guess for the next point in the same thread.
+    */
+    void calc_density_batch(const boson_tl<fp_t> &bo,
+                            part_batch_tl<fp_t> &b, size_t n_threads=1) {
+      std::vector<std::shared_ptr<boson_rel_tl> > thr;
+      batch_threads(n_threads,thr);
+      std::function<int(size_t,boson_tl<fp_t> &,fp_t)> func=
+        std::bind(std::mem_fn<int(size_t,boson_tl<fp_t> &,fp_t,
+                                  std::vector<std::shared_ptr<boson_rel_tl> > &)>
+                  (&boson_rel_tl::batch_density_point),this,
+                  std::placeholders::_1,std::placeholders::_2,
+                  std::placeholders::_3,std::ref(thr));
+      part_batch_loop(bo,b,true,n_threads,func);
+      return;
+    }
+    //@}
+    
     /** \brief Calculate the maximum density as a function of temperature
      */
     virtual void calc_max_density(boson &b, fp_t temper) {
@@ -737,6 +814,39 @@ namespace o2scl {
     
   protected:
 
+    /// Compute one point for \ref calc_mu_batch()
+    int batch_mu_point(size_t it, boson_tl<fp_t> &bo, fp_t temper,
+                       std::vector<std::shared_ptr<boson_rel_tl> > &thr) {
+      if (it==0) calc_mu(bo,temper);
+      else thr[it-1]->calc_mu(bo,temper);
+      return 0;
+    }
+    
+    /// Compute one point for \ref calc_density_batch()
+    int batch_density_point(size_t it, boson_tl<fp_t> &bo, fp_t temper,
+                            std::vector<std::shared_ptr<boson_rel_tl> > &thr) {
+      if (it==0) calc_density(bo,temper);
+      else thr[it-1]->calc_density(bo,temper);
+      return 0;
+    }
+
+    /** \brief Create the objects for the additional threads in
+        the batch functions
+    */
+    void batch_threads(size_t n_threads, std::vector<std::shared_ptr<boson_rel_tl> > &thr) {
+#ifndef O2SCL_SET_OPENMP
+      n_threads=1;
+#endif
+      if (n_threads>1) {
+        thr.resize(n_threads-1);
+        for(size_t i=0;i<n_threads-1;i++) {
+          thr[i]=std::make_shared<boson_rel_tl>();
+          thr[i]->copy_settings(*this);
+        }
+      }
+      return;
+    }
+    
     /// The non-degenerate integrator
     inte<> *nit;
     /// The degenerate integrator
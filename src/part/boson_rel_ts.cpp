@@ -112,6 +112,36 @@ int main(void) {
     rb.def_dit.tol_abs*=1.0e2;
   */
 
+  // Batch functions, compared with the scalar versions
+  {
+    boson b4(1.0,2.0);
+    b4.non_interacting=true;
+    b4.mu=0.5;
+    part_batch pb;
+    pb.T.resize(6);
+    pb.mu.resize(6);
+    for(size_t i=0;i<6;i++) {
+      pb.T[i]=0.3;
+      pb.mu[i]=0.5+0.08*i;
+    }
+    rb.calc_mu_batch(b4,pb,2);
+    for(size_t i=0;i<6;i++) {
+      b3.m=1.0;
+      b3.mu=pb.mu[i];
+      rb.calc_mu(b3,0.3);
+      t.test_gen(pb.ret[i]==0,"batch ret");
+      t.test_rel(pb.n[i],b3.n,1.0e-12,"batch calc_mu n");
+      t.test_rel(pb.pr[i],b3.pr,1.0e-12,"batch calc_mu pr");
+    }
+    double mu_old[6];
+    for(size_t i=0;i<6;i++) mu_old[i]=pb.mu[i];
+    rb.calc_density_batch(b4,pb,2);
+    for(size_t i=0;i<6;i++) {
+      t.test_gen(pb.ret[i]==0,"batch ret 2");
+      t.test_rel(pb.mu[i],mu_old[i],1.0e-6,"batch calc_density mu");
+    }
+  }
+
   if (0) {
     part_calibrate_class pcc;
     double v1=pcc.part_calibrate<boson,boson_rel>
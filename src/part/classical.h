@@ -185,8 +185,60 @@ namespace o2scl {
   }
 
 
+  /// \name Batch functions
+  //@{
+  /** \brief Calculate properties as a function of chemical
+      potential at each point in \c b
+
+      The mass, degeneracy, and flags are taken from \c p, and
+      the temperature and the chemical potential from \c b. The
+      points are computed in parallel using \c n_threads threads
+      if OpenMP is enabled. This class has no internal state, so
+      all threads share this object. See \ref
+      o2scl::part_batch_loop() for more details.
+  */
+  void calc_mu_batch(const part_tl<fp_t> &p, part_batch_tl<fp_t> &b,
+                     size_t n_threads=1) {
+    std::function<int(size_t,part_tl<fp_t> &,fp_t)> func=
+      std::bind(std::mem_fn<int(size_t,part_tl<fp_t> &,fp_t)>
+                (&classical_thermo_tl::batch_mu_point),this,
+                std::placeholders::_1,std::placeholders::_2,
+                std::placeholders::_3);
+    part_batch_loop(p,b,false,n_threads,func);
+    return;
+  }
+
+  /** \brief Calculate properties as a function of density at
+      each point in \c b
+  */
+  void calc_density_batch(const part_tl<fp_t> &p, part_batch_tl<fp_t> &b,
+                          size_t n_threads=1) {
+    std::function<int(size_t,part_tl<fp_t> &,fp_t)> func=
+      std::bind(std::mem_fn<int(size_t,part_tl<fp_t> &,fp_t)>
+                (&classical_thermo_tl::batch_density_point),this,
+                std::placeholders::_1,std::placeholders::_2,
+                std::placeholders::_3);
+    part_batch_loop(p,b,true,n_threads,func);
+    return;
+  }
+  //@}
+
   /// Return string denoting type ("classical_thermo")
   virtual const char *type() { return "classical_thermo"; }
+
+  protected:
+
+  /// Compute one point for \ref calc_mu_batch()
+  int batch_mu_point(size_t it, part_tl<fp_t> &p, fp_t temper) {
+    calc_mu(p,temper);
+    return 0;
+  }
+
+  /// Compute one point for \ref calc_density_batch()
+  int batch_density_point(size_t it, part_tl<fp_t> &p, fp_t temper) {
+    calc_density(p,temper);
+    return 0;
+  }
     
   };
 
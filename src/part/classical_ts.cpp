@@ -58,6 +58,27 @@ int main(void) {
   ct_cdf.calc_density(p_cdf,0.1);
   cout << p_cdf.mu << endl;
 
+  // Batch functions
+  part_batch pb;
+  pb.T.resize(10);
+  pb.n.resize(10);
+  for(size_t i=0;i<10;i++) {
+    pb.T[i]=0.1+0.01*i;
+    pb.n[i]=0.1*(i+1);
+  }
+  cl.calc_density_batch(n,pb,2);
+  for(size_t i=0;i<10;i++) {
+    n.n=pb.n[i];
+    cl.calc_density(n,pb.T[i]);
+    t.test_gen(pb.ret[i]==0,"batch ret");
+    t.test_rel(pb.mu[i],n.mu,1.0e-14,"batch mu");
+    t.test_rel(pb.en[i],n.en,1.0e-14,"batch en");
+  }
+  cl.calc_mu_batch(n,pb,2);
+  for(size_t i=0;i<10;i++) {
+    t.test_rel(pb.n[i],0.1*(i+1),1.0e-12,"batch n");
+  }
+
   t.report();
   return 0;
 }
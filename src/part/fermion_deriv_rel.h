@@ -31,12 +31,16 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <o2scl/constants.h>
 #include <o2scl/root_cern.h>
 #include <o2scl/inte.h>
 #include <o2scl/inte_qag_gsl.h>
 #include <o2scl/inte_qagiu_gsl.h>
 #include <o2scl/inte_double_exp_boost.h>
+#include <o2scl/inte_qag_vec.h>
 
 #include <o2scl/part_deriv.h>
 #include <o2scl/fermion_rel.h>
@@ -373,6 +377,57 @@ namespace o2scl {
       }
       return ret;
     }
+    //@}
+
+    /** \brief The integrands for \f$ dn/dT \f$, \f$ dn/d\mu \f$,
+        \f$ ds/dT \f$, \f$ n \f$, \f$ \varepsilon \f$, and \f$ s
+        \f$ as a function of momentum, computed together
+
+        The first three integrands are identical to those in \ref
+        deg_density_T_fun(), \ref deg_density_mu_fun(), and \ref
+        deg_entropy_T_fun(), and are stored in <tt>y[0]</tt>,
+        <tt>y[1]</tt>, and <tt>y[2]</tt>, respectively. The
+        integrands for the density, the energy density, and the
+        entropy density are stored in <tt>y[3]</tt>, <tt>y[4]</tt>,
+        and <tt>y[5]</tt>. The energy and the Fermi-Dirac
+        distribution are computed only once.
+    */
+    void deg_deriv_funs(fp_t k, fp_t m, fp_t ms, fp_t nu, fp_t T,
+                        bool inc_rest_mass, std::vector<fp_t> &y) {
+
+      fp_t nuf=nu;
+      if (inc_rest_mass==false) nuf+=m;
+      
+      fp_t E=hypot(k,ms);
+      fp_t x=(E-nuf)/T;
+      fp_t ff=fermi_function(x);
+      fp_t k2=k*k;
+      
+      if (intl_method==direct) {
+        fp_t kff=k2*ff*(1-ff)/T;
+        y[0]=kff*x;
+        y[1]=kff;
+        y[2]=kff*x*x;
+      } else {
+        y[0]=(2*k2/T+E*E/T-E*nuf/T-k2*nuf/T/E)*ff;
+        y[1]=(E*E+k2)/E*ff;
+        y[2]=(E-nuf)/E/T/T*(E*E*E+3*E*k2-(E*E+k2)*nuf)*ff;
+      }
+
+      y[3]=k2*ff;
+      if (inc_rest_mass) {
+        y[4]=k2*E*ff;
+      } else {
+        y[4]=k2*(E-m)*ff;
+      }
+      // The entropy integrand is symmetric in x, and this form
+      // avoids the cancellation in -f ln f - (1-f) ln (1-f)
+      fp_t ax=fabs(x);
+      fp_t ex=exp(-ax);
+      y[5]=k2*(log1p(ex)+ax*ex/(1+ex));
+      
+      return;
+    }
     
   };
 
@@ -617,6 +672,7 @@ namespace o2scl {
 
       verbose=0;
       multip=false;
+      fused=false;
       tol_expan=1e-14;
     }
   
@@ -649,6 +705,25 @@ namespace o2scl {
     */
     bool multip;
     
+    /** \brief If true, compute all of the integrals in a single
+        adaptive pass (default false)
+
+        When this is true (and \ref multip is false), the integrals
+        for \f$ dn/dT \f$, \f$ dn/d\mu \f$, \f$ ds/dT \f$, the
+        density, the energy density, and the entropy density are
+        computed simultaneously by \ref vit using the integrand \ref
+        o2scl::fermion_deriv_rel_integ::deg_deriv_funs(), so the
+        distribution function is evaluated only once for each
+        abscissa. The interval is subdivided where the component
+        furthest from its tolerance requires it, until all of the
+        integrals have converged. The tolerances are taken from \ref
+        nit in the non-degenerate case and from \ref dit in the
+        degenerate case. The expansions are used as usual, and \ref
+        fr is not used when the expansions are not sufficiently
+        accurate.
+    */
+    bool fused;
+    
     /// If true, verify the thermodynamic identity (default false)
     bool verify_ti;
     
@@ -671,6 +746,12 @@ namespace o2scl {
 	- 6: degenerate integrand, using \ref by_parts
 	- 7: degenerate integrand, using user-specified 
 	value for \ref method
+	- 8: degenerate integrand, using \ref fused
+	- 9: nondegenerate integrand, using \ref fused
+
+	When \ref fused is true and the expansions are not used,
+	\ref o2scl::fermion_rel::calc_mu() is not called, so the
+	value is a single digit.
 
 	The function \ref nu_from_n() sets this value equal to
 	100 times the value reported by 
@@ -697,11 +778,18 @@ namespace o2scl {
 
       last_method=0;
       last_method_s="";
-      
-      fr.calc_mu(f,temper);
-      last_method=fr.last_method*10;
-      last_method_s=((std::string)"base: ")+fr.last_method_s+
-	" deriv: ";
+
+      // In the fused mode, the density, energy density and entropy
+      // are computed by calc_mu_fused() or the expansions instead
+      bool use_fused=(fused==true && multip==false && temper>0);
+      if (use_fused==false) {
+        fr.calc_mu(f,temper);
+        last_method=fr.last_method*10;
+        last_method_s=((std::string)"base: ")+fr.last_method_s+
+          " deriv: ";
+      } else {
+        last_method_s="deriv: ";
+      }
   
       int iret;
 
@@ -773,6 +861,10 @@ namespace o2scl {
 	}
       }
 
+      if (use_fused) {
+        return calc_mu_fused(f,temper,prefac,deg);
+      }
+
       if (deg==false) {
     
 	// Set integration method
@@ -1258,6 +1350,98 @@ namespace o2scl {
       return ret;
     }
 
+    /** \brief Copy the numerical settings from \c fdr
+
+        This copies the parameters of this class, the tolerances of
+        the integrators, and the settings of \ref fr (see \ref
+        o2scl::fermion_rel_tl::copy_settings()). The integrator
+        objects themselves are not shared, so this object can be
+        used in a different thread than \c fdr.
+    */
+    void copy_settings(const fermion_deriv_rel_tl &fdr) {
+      deg_limit=fdr.deg_limit;
+      upper_limit_fac=fdr.upper_limit_fac;
+      verbose=fdr.verbose;
+      multip=fdr.multip;
+      fused=fdr.fused;
+      verify_ti=fdr.verify_ti;
+      tol_expan=fdr.tol_expan;
+      err_nonconv=fdr.err_nonconv;
+      this->method=fdr.method;
+      fr.copy_settings(fdr.fr);
+      nit.tol_rel=fdr.nit.tol_rel;
+      nit.tol_abs=fdr.nit.tol_abs;
+      nit.err_nonconv=fdr.nit.err_nonconv;
+      dit.tol_rel=fdr.dit.tol_rel;
+      dit.tol_abs=fdr.dit.tol_abs;
+      dit.err_nonconv=fdr.dit.err_nonconv;
+      it_multip.tol_rel=fdr.it_multip.tol_rel;
+      it_multip.err_nonconv=fdr.it_multip.err_nonconv;
+      vit.limit=fdr.vit.limit;
+      vit.err_nonconv=fdr.vit.err_nonconv;
+      return;
+    }
+
+    /// \name Thread-safe functions
+    //@{
+    /** \brief Return the workspace object for the current thread
+
+        This works in the same way as \ref
+        o2scl::fermion_rel_tl::thread_ws(). The functions in this
+        group may be called at the same time from several threads
+        on the same object, as long as the settings are not
+        modified at the same time. The uncertainties and the value
+        of \ref last_method for each thread are stored in the
+        workspace.
+    */
+    fermion_deriv_rel_tl &thread_ws() {
+      std::lock_guard<std::mutex> lock(ws_mutex());
+      if (fr.fast_mode && !fr.fast_table.is_built()) {
+        fr.fast_table.build();
+      }
+      std::shared_ptr<fermion_deriv_rel_tl> &ws=
+        ws_map[std::this_thread::get_id()];
+      if (!ws) ws=std::make_shared<fermion_deriv_rel_tl>();
+      ws->copy_settings(*this);
+      return *ws;
+    }
+
+    /** \brief Thread-safe version of \ref calc_mu()
+     */
+    int calc_mu_ts(fermion_deriv_t &f, fp_t temper) {
+      return thread_ws().calc_mu(f,temper);
+    }
+    
+    /** \brief Thread-safe version of \ref calc_density()
+     */
+    int calc_density_ts(fermion_deriv_t &f, fp_t temper) {
+      return thread_ws().calc_density(f,temper);
+    }
+    
+    /** \brief Thread-safe version of \ref pair_mu()
+     */
+    int pair_mu_ts(fermion_deriv_t &f, fp_t temper) {
+      return thread_ws().pair_mu(f,temper);
+    }
+    
+    /** \brief Thread-safe version of \ref pair_density()
+     */
+    int pair_density_ts(fermion_deriv_t &f, fp_t temper) {
+      return thread_ws().pair_density(f,temper);
+    }
+    
+    /** \brief Delete the workspaces for all threads
+
+        This function should not be called while another thread
+        is using this object.
+    */
+    void clear_ws() {
+      std::lock_guard<std::mutex> lock(ws_mutex());
+      ws_map.clear();
+      return;
+    }
+    //@}
+
     /// \name Integration objects
     //@{
     /** \brief Set inte objects
@@ -1283,11 +1467,141 @@ namespace o2scl {
 
     /// Adaptive multiprecision integrator
     inte_double_exp_boost<> it_multip;
+
+    /** \brief Integrator for the fused derivative integrals (see
+        \ref fused)
+    */
+    inte_qag_vec<fp_t> vit;
     //@}
     
     /// Return string denoting type ("fermion_deriv_rel")
     virtual const char *type() { return "fermion_deriv_rel"; };
 
+  protected:
+
+    /** \brief Compute the density, energy density, entropy, and
+        their derivatives with one vector integration (see \ref fused)
+
+        If \c deg is false, the integral is over \f$ u=k/T \f$ from
+        zero to infinity, otherwise it is over \f$ k \f$ from zero
+        to the same upper limit as the degenerate integrals in \ref
+        calc_mu(). The lower limit used for the derivatives in the
+        degenerate case is not used here, since the density and the
+        energy density are not small below it.
+    */
+    int calc_mu_fused(fermion_deriv_t &f, fp_t temper, fp_t prefac,
+                      bool deg) {
+
+      std::vector<fp_t> res(6), err(6);
+      int iret;
+
+      if (deg) {
+
+        if (this->method==this->automatic) {
+          if ((!f.inc_rest_mass && (f.nu+f.m-f.ms)/temper>1e3) ||
+              (f.inc_rest_mass && (f.nu-f.ms)/temper>1e3)) {
+            this->intl_method=this->direct;
+          } else {
+            this->intl_method=this->by_parts;
+          }
+        } else {
+          this->intl_method=this->method;
+        }
+        last_method+=8;
+        last_method_s+="deg. fused integ.";
+
+        fp_t arg;
+        if (f.inc_rest_mass) {
+          arg=pow(upper_limit_fac*temper+f.nu,2)-f.ms*f.ms;
+        } else {
+          arg=pow(upper_limit_fac*temper+f.nu+f.m,2)-f.ms*f.ms;
+        }
+        if (arg<=0) {
+          O2SCL_ERR2("Zero density in degenerate limit in fermion_deriv",
+                     "_rel::calc_mu_fused(). Variable deg_limit set "
+                     "improperly?",
+                     exc_efailed);
+        }
+        fp_t ul=sqrt(arg);
+        
+        vit.tol_rel=dit.tol_rel;
+        vit.tol_abs=dit.tol_abs;
+        
+        auto func=[this,&f,temper](fp_t k, std::vector<fp_t> &y) {
+          this->deg_deriv_funs(k,f.m,f.ms,f.nu,temper,f.inc_rest_mass,y);
+          return 0;
+        };
+
+        fp_t zero=0;
+        iret=vit.integ_err(func,6,zero,ul,res,err);
+        
+      } else {
+
+        if (this->method==this->automatic) {
+          this->intl_method=this->by_parts;
+        } else {
+          this->intl_method=this->method;
+        }
+        last_method+=9;
+        last_method_s+="nondeg. fused integ.";
+        
+        vit.tol_rel=nit.tol_rel;
+        vit.tol_abs=nit.tol_abs;
+        
+        auto func=[this,&f,temper](fp_t u, std::vector<fp_t> &y) {
+          this->deg_deriv_funs(u*temper,f.m,f.ms,f.nu,temper,
+                               f.inc_rest_mass,y);
+          for(size_t i=0;i<6;i++) y[i]*=temper;
+          return 0;
+        };
+
+        fp_t zero=0;
+        iret=vit.integ_iu_err(func,6,zero,res,err);
+        
+      }
+      
+      if (iret!=0) {
+        O2SCL_ERR2("Fused integration failed in ",
+                   "fermion_deriv_rel::calc_mu_fused().",
+                   exc_efailed);
+      }
+
+      f.dndT=res[0]*prefac;
+      unc.dndT=err[0]*prefac;
+      f.dndmu=res[1]*prefac;
+      unc.dndmu=err[1]*prefac;
+      f.dsdT=res[2]*prefac;
+      unc.dsdT=err[2]*prefac;
+      f.n=res[3]*prefac;
+      unc.n=err[3]*prefac;
+      f.ed=res[4]*prefac;
+      unc.ed=err[4]*prefac;
+      f.en=res[5]*prefac;
+      unc.en=err[5]*prefac;
+
+      if (!isfinite(f.en)) {
+	O2SCL_ERR2("Entropy not finite in fermion_deriv_rel_tl",
+		   "<fermion_deriv_t,fp_t>::calc_mu_fused().",
+		   exc_efailed);
+      }
+      f.pr=-f.ed+temper*f.en+f.nu*f.n;
+      
+      // Pressure uncertainties are not computed
+      unc.pr=0;
+      
+      return 0;
+    }
+
+    /// The workspaces for the thread-safe functions
+    std::map<std::thread::id,
+             std::shared_ptr<fermion_deriv_rel_tl> > ws_map;
+
+    /// The mutex which protects \ref ws_map
+    static std::mutex &ws_mutex() {
+      static std::mutex m;
+      return m;
+    }
+    
   };
 
   /** \brief Double-precision version of 
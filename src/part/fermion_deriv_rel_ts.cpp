@@ -218,6 +218,66 @@ int main(int argc, char *argv[]) {
   fermion_deriv_rel_ld fdrl;
 
 #endif
+
+  {
+    // Thread-safe interface, compared with the usual interface
+    fermion_deriv_rel fdr;
+    fermion_deriv fd1(1.0,2.0), fd2(1.0,2.0);
+    double T[4]={0.01,0.1,0.5,1.0};
+    double dndmu[4];
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for num_threads(2)
+#endif
+    for(size_t i=0;i<4;i++) {
+      fermion_deriv fdx(1.0,2.0);
+      fdx.mu=1.2;
+      fdr.calc_mu_ts(fdx,T[i]);
+      dndmu[i]=fdx.dndmu;
+    }
+    for(size_t i=0;i<4;i++) {
+      fd1.mu=1.2;
+      fdr.calc_mu(fd1,T[i]);
+      t.test_rel(dndmu[i],fd1.dndmu,1.0e-12,"calc_mu_ts");
+    }
+  }
+  
+  {
+    // Fused integrals, compared with the separate integrations, in
+    // the nondegenerate (psi=-2,0) and degenerate (psi=5,15)
+    // regimes for both integration methods
+    fermion_deriv_rel fdr1, fdr2;
+    fdr2.fused=true;
+    fermion_deriv fd1(1.0,2.0), fd2(1.0,2.0);
+    double psi[4]={-2.0,0.0,5.0,15.0};
+    for(int meth=1;meth<=2;meth++) {
+      fdr1.method=meth;
+      fdr2.method=meth;
+      for(size_t irm=0;irm<2;irm++) {
+        fd1.inc_rest_mass=(irm==0);
+        fd2.inc_rest_mass=(irm==0);
+        for(size_t i=0;i<4;i++) {
+          double T=0.1;
+          fd1.mu=fd1.m+psi[i]*T;
+          if (irm==1) fd1.mu-=fd1.m;
+          fd2.mu=fd1.mu;
+          fdr1.calc_mu(fd1,T);
+          fdr2.calc_mu(fd2,T);
+          t.test_rel(fd2.dndT,fd1.dndT,1.0e-7,"fused dndT");
+          t.test_rel(fd2.dndmu,fd1.dndmu,1.0e-7,"fused dndmu");
+          t.test_rel(fd2.dsdT,fd1.dsdT,1.0e-7,"fused dsdT");
+          t.test_rel(fd2.n,fd1.n,1.0e-7,"fused n");
+          t.test_rel(fd2.ed,fd1.ed,1.0e-7,"fused ed");
+          t.test_rel(fd2.en,fd1.en,1.0e-7,"fused en");
+          t.test_rel(fd2.pr,fd1.pr,1.0e-7,"fused pr");
+          if (fdr1.last_method%10>=5) {
+            t.test_gen(fdr2.last_method==8,"fused last_method deg");
+          } else {
+            t.test_gen(fdr2.last_method==9,"fused last_method ndeg");
+          }
+        }
+      }
+    }
+  }
   
   t.report();
 
@@ -30,6 +30,9 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <thread>
 
 #ifdef O2SCL_MULTIP
 #include <boost/multiprecision/cpp_dec_float.hpp>
@@ -337,6 +340,430 @@ namespace o2scl {
     
   };
   
+  /** \brief Piecewise Chebyshev approximation of the dimensionless
+      Fermi-Dirac integrals for \ref o2scl::fermion_rel_tl
+
+      This class approximates the functions
+      \f[
+      N(\psi,\eta) = \int_0^{\infty} u^2 f~du \, , \quad
+      E(\psi,\eta) = \int_0^{\infty} u^2 
+      \left(\sqrt{u^2+\eta^2}-\eta\right) f~du \, , 
+      \f]
+      \f[
+      S(\psi,\eta) = -\int_0^{\infty} u^2 \left[ f \ln f + 
+      (1-f) \ln (1-f) \right]~du
+      \f]
+      where \f$ f = \{ 1+\exp[\sqrt{u^2+\eta^2}-\eta-\psi] \}^{-1}
+      \f$, \f$ \psi = (\nu-m^{*})/T \f$, and \f$ \eta = m^{*}/T \f$.
+      The number density, the energy density (without the rest mass),
+      and the entropy density are \f$ g T^3/(2 \pi^2) \f$ times
+      \f$ N \f$, \f$ T E \f$, and \f$ S \f$, respectively.
+
+      The logarithm of each function is approximated by a
+      tensor-product Chebyshev series of order \ref order in \f$ \psi
+      \f$ and \f$ z \equiv \ln (1+\eta) \f$. The domain, \f$ \psi_{
+      \mathrm{min}} \leq \psi \leq \psi_{\mathrm{max}} \f$ and \f$ 0
+      \leq \eta \leq \eta_{\mathrm{max}} \f$, is recursively divided
+      into four patches until the relative deviation from the
+      quadrature at an \ref n_check by \ref n_check grid of points
+      between the Chebyshev nodes is smaller than \ref tol_rel in
+      every function. Patches which do not meet this tolerance after
+      \ref max_depth divisions are marked as inaccurate, and \ref
+      eval() returns false for points inside them, as it does for
+      points outside the domain.
+
+      The table is computed by \ref build(), and the quadratures are
+      performed with \ref qag, with the interval divided at the Fermi
+      momentum when \f$ \psi>0 \f$.
+  */
+  class fermion_rel_fast_table {
+
+  protected:
+    
+    /// A rectangular patch in \f$ (\psi,z) \f$
+    class patch {
+      
+    public:
+      
+      /// The lower limit in \f$ \psi \f$
+      double psi_lo;
+      /// The upper limit in \f$ \psi \f$
+      double psi_hi;
+      /// The lower limit in \f$ z \f$
+      double z_lo;
+      /// The upper limit in \f$ z \f$
+      double z_hi;
+      /// The index of the first of the four children, or zero
+      size_t child;
+      /// If true, the approximation satisfies the tolerance
+      bool accurate;
+      /// The Chebyshev coefficients for the three functions
+      std::vector<double> coeffs;
+      
+    };
+    
+    /// The list of patches used in \ref build_patch()
+    std::vector<patch> patches;
+
+    /** \brief The completed list of patches, the first is the
+        full domain
+
+        This is shared between copies of the table and is not
+        modified after \ref build().
+    */
+    std::shared_ptr<const std::vector<patch> > table;
+
+    /// The value of \f$ \psi \f$ used in \ref integrand()
+    double i_psi;
+
+    /// The value of \f$ \eta \f$ used in \ref integrand()
+    double i_eta;
+
+    /** \brief The integrand for function \c ix at dimensionless
+        momentum \c u
+    */
+    double integrand(double u, size_t ix) {
+      double u2=u*u;
+      // Kinetic energy, computed to avoid cancellation
+      double ek=u2/(sqrt(u2+i_eta*i_eta)+i_eta);
+      double x=ek-i_psi;
+      if (ix==0) {
+        return u2/(1.0+exp(x));
+      } else if (ix==1) {
+        return u2*ek/(1.0+exp(x));
+      }
+      double ex=exp(-fabs(x));
+      return u2*(log1p(ex)+fabs(x)*ex/(1.0+ex));
+    }
+
+    /** \brief Compute the three functions using quadrature
+     */
+    void exact(double psi, double eta, double vals[3]) {
+
+      i_psi=psi;
+      i_eta=eta;
+      
+      // The upper limit for the momentum integration
+      double ek_max=psi+upper_limit_fac;
+      if (ek_max<upper_limit_fac) ek_max=upper_limit_fac;
+      double ul=sqrt(ek_max*(ek_max+2.0*eta));
+      
+      // The Fermi momentum, if psi is positive
+      double kf=0.0;
+      if (psi>0.0) kf=sqrt(psi*(psi+2.0*eta));
+      
+      for(size_t ix=0;ix<3;ix++) {
+        funct fx=std::bind(std::mem_fn<double(double,size_t)>
+                           (&fermion_rel_fast_table::integrand),
+                           this,std::placeholders::_1,ix);
+        double res, err;
+        if (kf>0.0) {
+          double res2;
+          qag.integ_err(fx,0.0,kf,res,err);
+          qag.integ_err(fx,kf,ul,res2,err);
+          res+=res2;
+        } else {
+          qag.integ_err(fx,0.0,ul,res,err);
+        }
+        vals[ix]=res;
+      }
+      
+      return;
+    }
+
+    /** \brief Evaluate the Chebyshev series for patch \c p at
+        \f$ (\psi,z) \f$, storing the logarithms of the three functions
+        in \c lvals
+    */
+    void eval_patch(const patch &p, double psi, double z,
+                    double lvals[3]) const {
+      
+      double x=(2.0*psi-p.psi_lo-p.psi_hi)/(p.psi_hi-p.psi_lo);
+      double y=(2.0*z-p.z_lo-p.z_hi)/(p.z_hi-p.z_lo);
+      
+      std::vector<double> tx(order), ty(order);
+      tx[0]=1.0;
+      ty[0]=1.0;
+      if (order>1) {
+        tx[1]=x;
+        ty[1]=y;
+      }
+      for(size_t i=2;i<order;i++) {
+        tx[i]=2.0*x*tx[i-1]-tx[i-2];
+        ty[i]=2.0*y*ty[i-1]-ty[i-2];
+      }
+
+      size_t n2=order*order;
+      for(size_t k=0;k<3;k++) {
+        lvals[k]=0.0;
+        for(size_t i=0;i<order;i++) {
+          double sum=0.0;
+          for(size_t j=0;j<order;j++) {
+            sum+=p.coeffs[k*n2+i*order+j]*ty[j];
+          }
+          lvals[k]+=sum*tx[i];
+        }
+      }
+      
+      return;
+    }
+    
+    /** \brief Compute the Chebyshev coefficients for patch \c ip,
+        dividing it if necessary
+    */
+    void build_patch(size_t ip, size_t depth) {
+
+      size_t n2=order*order;
+      
+      // The function values at the Chebyshev nodes
+      std::vector<double> fv(3*n2), nodes(order);
+      for(size_t i=0;i<order;i++) {
+        nodes[i]=cos(o2scl_const::pi*(i+0.5)/order);
+      }
+      for(size_t i=0;i<order;i++) {
+        double psi=(patches[ip].psi_lo+patches[ip].psi_hi)/2.0+
+          nodes[i]*(patches[ip].psi_hi-patches[ip].psi_lo)/2.0;
+        for(size_t j=0;j<order;j++) {
+          double z=(patches[ip].z_lo+patches[ip].z_hi)/2.0+
+            nodes[j]*(patches[ip].z_hi-patches[ip].z_lo)/2.0;
+          double vals[3];
+          exact(psi,expm1(z),vals);
+          for(size_t k=0;k<3;k++) {
+            fv[k*n2+i*order+j]=log(vals[k]);
+          }
+        }
+      }
+      
+      // Compute the coefficients with the discrete orthogonality
+      // relation for the Chebyshev polynomials
+      patches[ip].coeffs.resize(3*n2);
+      for(size_t k=0;k<3;k++) {
+        for(size_t a=0;a<order;a++) {
+          for(size_t b=0;b<order;b++) {
+            double sum=0.0;
+            for(size_t i=0;i<order;i++) {
+              double ta=cos(o2scl_const::pi*a*(i+0.5)/order);
+              for(size_t j=0;j<order;j++) {
+                double tb=cos(o2scl_const::pi*b*(j+0.5)/order);
+                sum+=fv[k*n2+i*order+j]*ta*tb;
+              }
+            }
+            sum*=4.0/n2;
+            if (a==0) sum/=2.0;
+            if (b==0) sum/=2.0;
+            patches[ip].coeffs[k*n2+a*order+b]=sum;
+          }
+        }
+      }
+
+      // Check the approximation between the nodes
+      double max_err=0.0;
+      for(size_t i=0;i<n_check;i++) {
+        double psi=patches[ip].psi_lo+(i+0.5)/n_check*
+          (patches[ip].psi_hi-patches[ip].psi_lo);
+        for(size_t j=0;j<n_check;j++) {
+          double z=patches[ip].z_lo+(j+0.5)/n_check*
+            (patches[ip].z_hi-patches[ip].z_lo);
+          double vals[3], lvals[3];
+          exact(psi,expm1(z),vals);
+          eval_patch(patches[ip],psi,z,lvals);
+          for(size_t k=0;k<3;k++) {
+            double err=fabs(expm1(lvals[k]-log(vals[k])));
+            if (!(err<max_err)) max_err=err;
+          }
+        }
+      }
+
+      if (verbose>0) {
+        std::cout << "fermion_rel_fast_table::build_patch(): "
+                  << "depth " << depth << " psi: [" << patches[ip].psi_lo
+                  << "," << patches[ip].psi_hi << "] z: ["
+                  << patches[ip].z_lo << "," << patches[ip].z_hi
+                  << "] error: " << max_err << std::endl;
+      }
+      
+      if (max_err<tol_rel) {
+        patches[ip].accurate=true;
+        return;
+      }
+      if (depth>=max_depth) {
+        patches[ip].accurate=false;
+        return;
+      }
+
+      // Divide into four patches
+      patches[ip].coeffs.clear();
+      size_t ic=patches.size();
+      patches[ip].child=ic;
+      double psi_mid=(patches[ip].psi_lo+patches[ip].psi_hi)/2.0;
+      double z_mid=(patches[ip].z_lo+patches[ip].z_hi)/2.0;
+      for(size_t k=0;k<4;k++) {
+        patch pc;
+        pc.psi_lo=(k%2==0) ? patches[ip].psi_lo : psi_mid;
+        pc.psi_hi=(k%2==0) ? psi_mid : patches[ip].psi_hi;
+        pc.z_lo=(k/2==0) ? patches[ip].z_lo : z_mid;
+        pc.z_hi=(k/2==0) ? z_mid : patches[ip].z_hi;
+        pc.child=0;
+        pc.accurate=false;
+        patches.push_back(pc);
+      }
+      for(size_t k=0;k<4;k++) {
+        build_patch(ic+k,depth+1);
+      }
+      
+      return;
+    }
+    
+  public:
+
+    fermion_rel_fast_table() {
+      psi_min=-4.0;
+      psi_max=20.0;
+      eta_max=1.0e3;
+      order=12;
+      n_check=4;
+      tol_rel=1.0e-10;
+      max_depth=6;
+      upper_limit_fac=50.0;
+      verbose=0;
+      qag.tol_rel=1.0e-13;
+      qag.tol_abs=0.0;
+      qag.err_nonconv=false;
+    }
+
+    /** \brief Copy constructor
+
+        The settings are copied and the table is shared, but the
+        integrator is not shared, so that copies can be used in
+        different threads.
+    */
+    fermion_rel_fast_table(const fermion_rel_fast_table &ft) {
+      qag.err_nonconv=false;
+      *this=ft;
+    }
+
+    /// Copy the settings and share the table with operator=()
+    fermion_rel_fast_table &operator=(const fermion_rel_fast_table &ft) {
+      if (this!=&ft) {
+        psi_min=ft.psi_min;
+        psi_max=ft.psi_max;
+        eta_max=ft.eta_max;
+        order=ft.order;
+        n_check=ft.n_check;
+        tol_rel=ft.tol_rel;
+        max_depth=ft.max_depth;
+        upper_limit_fac=ft.upper_limit_fac;
+        verbose=ft.verbose;
+        qag.tol_rel=ft.qag.tol_rel;
+        qag.tol_abs=ft.qag.tol_abs;
+        table=ft.table;
+      }
+      return *this;
+    }
+    
+    /// \name Settings (must be set before \ref build())
+    //@{
+    /// The smallest value of \f$ \psi \f$ (default -4)
+    double psi_min;
+    /// The largest value of \f$ \psi \f$ (default 20)
+    double psi_max;
+    /// The largest value of \f$ \eta \f$ (default \f$ 10^{3} \f$)
+    double eta_max;
+    /// The order of the Chebyshev series in each direction (default 12)
+    size_t order;
+    /** \brief The number of points in each direction used to
+        check the approximation in each patch (default 4)
+    */
+    size_t n_check;
+    /// The relative tolerance (default \f$ 10^{-10} \f$)
+    double tol_rel;
+    /// The maximum number of patch divisions (default 6)
+    size_t max_depth;
+    /** \brief The value of \f$ \sqrt{u^2+\eta^2}-\eta-\psi \f$ at
+        the upper limit of the quadrature (default 50)
+    */
+    double upper_limit_fac;
+    /// Verbosity parameter (default 0)
+    int verbose;
+    /// The integrator
+    inte_qag_gsl<> qag;
+    //@}
+
+    /// Return true if the table has been computed
+    bool is_built() const {
+      return table!=0;
+    }
+
+    /// Clear the table
+    void clear() {
+      table.reset();
+      return;
+    }
+    
+    /** \brief Compute the table
+     */
+    void build() {
+      patches.clear();
+      patch p;
+      p.psi_lo=psi_min;
+      p.psi_hi=psi_max;
+      p.z_lo=0.0;
+      p.z_hi=log1p(eta_max);
+      p.child=0;
+      p.accurate=false;
+      patches.push_back(p);
+      build_patch(0,0);
+      if (verbose>0) {
+        std::cout << "fermion_rel_fast_table::build(): "
+                  << patches.size() << " patches." << std::endl;
+      }
+      table=std::make_shared<const std::vector<patch> >(patches);
+      patches.clear();
+      return;
+    }
+
+    /** \brief Compute the functions \f$ N \f$, \f$ E \f$, and
+        \f$ S \f$ at \f$ (\psi,\eta) \f$
+
+        This function returns false if the point is outside the
+        domain or inside a patch which did not meet the tolerance.
+    */
+    bool eval(double psi, double eta, double &N, double &E,
+              double &S) const {
+      
+      if (!table || !(psi>=psi_min) || psi>psi_max ||
+          !(eta>=0.0) || eta>eta_max) {
+        return false;
+      }
+
+      const std::vector<patch> &pl=*table;
+      double z=log1p(eta);
+      size_t ip=0;
+      while (pl[ip].child!=0) {
+        size_t ic=pl[ip].child;
+        if (psi>=pl[ic].psi_hi) ic++;
+        if (z>=pl[ic].z_hi) ic+=2;
+        ip=ic;
+      }
+      if (!pl[ip].accurate) return false;
+      
+      double lvals[3];
+      eval_patch(pl[ip],psi,z,lvals);
+      N=exp(lvals[0]);
+      E=exp(lvals[1]);
+      S=exp(lvals[2]);
+      
+      return true;
+    }
+
+    /// Return the number of patches
+    size_t get_n_patches() const {
+      if (!table) return 0;
+      return table->size();
+    }
+    
+  };
+  
   /** \brief Equation of state for a relativistic fermion
 
       This class computes the thermodynamics of a relativistic fermion
@@ -565,6 +992,23 @@ namespace o2scl {
 
     /// If true, verify the thermodynamic identity (default false)
     bool verify_ti;
+
+    /** \brief If true, use \ref fast_table when possible
+        (default false)
+
+        When this is true, \ref calc_mu(), \ref calc_density(),
+        and the density solver use the Chebyshev approximations in
+        \ref fast_table for points inside its domain, computing the
+        table on the first call if necessary. Points outside the
+        domain, or inside a patch which did not meet the tolerance,
+        use the usual expansions and quadratures. The pressure is
+        computed from the thermodynamic identity and the
+        uncertainties are set using the tolerance of the table.
+    */
+    bool fast_mode;
+
+    /// The table of Fermi-Dirac integrals for \ref fast_mode
+    fermion_rel_fast_table fast_table;
     
     /** \brief Set inte objects
 	
@@ -618,6 +1062,7 @@ namespace o2scl {
       alt_solver.test_form=2;
 
       multip=false;
+      fast_mode=false;
     }
 
     virtual ~fermion_rel_tl() {
@@ -648,6 +1093,7 @@ namespace o2scl {
 	- 8: exact integration, degenerate integrands, full
 	entropy integration
 	- 9: T=0 result
+	- 10: precomputed table (see \ref fast_mode)
 
 	In \ref calc_density(), the integer is a two-digit
 	number. The first digit (1 to 3) is the method used by \ref
@@ -659,6 +1105,7 @@ namespace o2scl {
 	on entropy integration
 	- 5: exact integration, degenerate integrands, full
 	entropy integration
+	- 6: precomputed table (see \ref fast_mode)
 	If \ref calc_density() uses the T=0 code, then
 	last_method is 40. 
 
@@ -685,6 +1132,67 @@ namespace o2scl {
     /// String detailing last method used
     std::string last_method_s;
 
+  protected:
+    
+    /** \brief Compute the thermodynamics using \ref fast_table
+        given the degeneracy parameter \c psi, returning false if
+        the table does not apply
+
+        If \c density_only is true, only the density is computed.
+    */
+    bool fast_eval(fermion_t &f, fp_t temper, fp_t psi,
+                   bool density_only) {
+      
+      if (!fast_table.is_built()) fast_table.build();
+      
+      double N, E, S;
+      fp_t eta=f.ms/temper;
+      if (!fast_table.eval(static_cast<double>(psi),
+                           static_cast<double>(eta),N,E,S)) {
+        return false;
+      }
+      
+      fp_t prefac=f.g*pow(temper,3)/2/this->pi2;
+      fp_t tol=fast_table.tol_rel;
+      
+      f.n=prefac*N;
+      unc.n=f.n*tol;
+      if (density_only) return true;
+      
+      f.ed=prefac*temper*(E+eta*N);
+      if (!f.inc_rest_mass) f.ed-=f.n*f.m;
+      f.en=prefac*S;
+      f.pr=-f.ed+temper*f.en+f.nu*f.n;
+      
+      unc.ed=fabs(f.ed)*tol;
+      unc.en=f.en*tol;
+      unc.pr=sqrt(unc.ed*unc.ed+temper*unc.en*temper*unc.en+
+                  f.nu*unc.n*f.nu*unc.n);
+      
+      return true;
+    }
+
+    /// The workspaces for the thread-safe functions
+    std::map<std::thread::id,std::shared_ptr<fermion_rel_tl> > ws_map;
+
+    /// The mutex which protects \ref ws_map and \ref fast_table
+    static std::mutex &ws_mutex() {
+      static std::mutex m;
+      return m;
+    }
+    
+    /// Compute one point for \ref calc_mu_batch()
+    int batch_mu_point(size_t it, fermion_t &f, fp_t temper) {
+      return calc_mu_ts(f,temper);
+    }
+    
+    /// Compute one point for \ref calc_density_batch()
+    int batch_density_point(size_t it, fermion_t &f, fp_t temper) {
+      return calc_density_ts(f,temper);
+    }
+    
+  public:
+    
     /// \name Template versions of base functions
     //@{
     /** \brief Calculate the chemical potential from the density
@@ -835,6 +1343,13 @@ namespace o2scl {
 	std::cout << "fermion_rel::calc_mu(): psi,deg,deg_limit: " << psi << " "
 		  << deg << " " << deg_limit << std::endl;
       }
+
+      // Try the precomputed table
+      if (fast_mode && fast_eval(f,temper,psi,false)) {
+        last_method=10;
+        last_method_s="fast table";
+        return 0;
+      }
       
       // Try the non-degenerate expansion if psi is small enough
       if (use_expansions && psi<min_psi) {
@@ -1476,6 +1991,14 @@ namespace o2scl {
       }
       if (psi<deg_limit) deg=false;
 
+      // Try the precomputed table
+      if (fast_mode && fast_eval(f,temper,psi,false)) {
+        f.n=density_temp;
+        last_method+=6;
+        last_method_s+=" : fast table in calc_density";
+        return 0;
+      }
+      
       // Try the non-degenerate expansion if psi is small enough
       if (use_expansions && psi<min_psi) {
 	bool acc=this->calc_mu_ndeg(f,temper,tol_expan);
@@ -1780,6 +2303,155 @@ namespace o2scl {
       return 0;
     }
 
+    /** \brief Copy the numerical settings from \c fr
+
+        This copies the parameters of this class, the tolerances of
+        the integrators and solvers, and the table used by \ref
+        fast_mode. The integrator and solver objects themselves are
+        not shared, so this object can be used in a different
+        thread than \c fr.
+    */
+    void copy_settings(const fermion_rel_tl &fr) {
+      min_psi=fr.min_psi;
+      deg_limit=fr.deg_limit;
+      upper_limit_fac=fr.upper_limit_fac;
+      verbose=fr.verbose;
+      multip=fr.multip;
+      use_expansions=fr.use_expansions;
+      tol_expan=fr.tol_expan;
+      verify_ti=fr.verify_ti;
+      fast_mode=fr.fast_mode;
+      fast_table=fr.fast_table;
+      this->err_nonconv=fr.err_nonconv;
+      this->exp_limit=fr.exp_limit;
+      this->deg_entropy_fac=fr.deg_entropy_fac;
+      nit.tol_rel=fr.nit.tol_rel;
+      nit.tol_abs=fr.nit.tol_abs;
+      nit.err_nonconv=fr.nit.err_nonconv;
+      dit.tol_rel=fr.dit.tol_rel;
+      dit.tol_abs=fr.dit.tol_abs;
+      dit.err_nonconv=fr.dit.err_nonconv;
+      it_multip.tol_rel=fr.it_multip.tol_rel;
+      it_multip.err_nonconv=fr.it_multip.err_nonconv;
+      density_root.tol_rel=fr.density_root.tol_rel;
+      density_root.tol_abs=fr.density_root.tol_abs;
+      density_root.ntrial=fr.density_root.ntrial;
+      density_root.err_nonconv=fr.density_root.err_nonconv;
+      alt_solver.tol_rel=fr.alt_solver.tol_rel;
+      alt_solver.tol_abs=fr.alt_solver.tol_abs;
+      alt_solver.err_nonconv=fr.alt_solver.err_nonconv;
+      return;
+    }
+
+    /// \name Thread-safe functions
+    //@{
+    /** \brief Return the workspace object for the current thread
+
+        The functions in this group may be called at the same time
+        from several threads (with OpenMP or otherwise) on the same
+        object, as long as the settings of this object are not
+        modified at the same time. Each thread uses a separate
+        workspace object which holds the integrators and solvers
+        and, after each call, the uncertainties in \ref unc and the
+        value of \ref last_method for that thread. The workspace is
+        created on the first call from each thread. The settings
+        are copied from this object to the workspace at the
+        beginning of each call (see \ref copy_settings()) and the
+        table for \ref fast_mode is shared rather than copied.
+    */
+    fermion_rel_tl &thread_ws() {
+      std::lock_guard<std::mutex> lock(ws_mutex());
+      if (fast_mode && !fast_table.is_built()) fast_table.build();
+      std::shared_ptr<fermion_rel_tl> &ws=
+        ws_map[std::this_thread::get_id()];
+      if (!ws) ws=std::make_shared<fermion_rel_tl>();
+      ws->copy_settings(*this);
+      return *ws;
+    }
+
+    /** \brief Thread-safe version of \ref calc_mu()
+     */
+    int calc_mu_ts(fermion_t &f, fp_t temper) {
+      return thread_ws().calc_mu(f,temper);
+    }
+    
+    /** \brief Thread-safe version of \ref calc_density()
+     */
+    int calc_density_ts(fermion_t &f, fp_t temper) {
+      return thread_ws().calc_density(f,temper);
+    }
+    
+    /** \brief Thread-safe version of \ref pair_mu()
+     */
+    int pair_mu_ts(fermion_t &f, fp_t temper) {
+      return thread_ws().pair_mu(f,temper);
+    }
+    
+    /** \brief Thread-safe version of \ref pair_density()
+     */
+    int pair_density_ts(fermion_t &f, fp_t temper) {
+      return thread_ws().pair_density(f,temper);
+    }
+    
+    /** \brief Delete the workspaces for all threads
+
+        This function should not be called while another thread
+        is using this object.
+    */
+    void clear_ws() {
+      std::lock_guard<std::mutex> lock(ws_mutex());
+      ws_map.clear();
+      return;
+    }
+    //@}
+
+    /// \name Batch functions
+    //@{
+    /** \brief Calculate properties as a function of chemical
+        potential at each point in \c b
+
+        The mass, degeneracy, and flags are taken from \c f, and
+        the temperature and the chemical potential from \c b.
+        The points are computed in parallel using \c n_threads
+        threads if OpenMP is enabled, each thread using its own
+        workspace (see \ref thread_ws()). See \ref
+        o2scl::part_batch_loop() for more details.
+    */
+    void calc_mu_batch(const fermion_t &f, part_batch_tl<fp_t> &b,
+                       size_t n_threads=1) {
+      std::function<int(size_t,fermion_t &,fp_t)> func=
+        std::bind(std::mem_fn<int(size_t,fermion_t &,fp_t)>
+                  (&fermion_rel_tl::batch_mu_point),this,
+                  std::placeholders::_1,std::placeholders::_2,
+                  std::placeholders::_3);
+      part_batch_loop(f,b,false,n_threads,func);
+      return;
+    }
+
+    /** \brief Calculate properties as a function of density
+        at each point in \c b
+
+        This function works as \ref calc_mu_batch() except that
+        the density is taken from \c b and the chemical potential
+        is computed. The chemical potential from each point is used
+        as the initial guess for the next point in the same
+        thread, so the points should be ordered so that neighboring
+        points have similar densities and temperatures. The initial
+        guess for the first point is the chemical potential in
+        \c f.
+    */
+    void calc_density_batch(const fermion_t &f, part_batch_tl<fp_t> &b,
+                            size_t n_threads=1) {
+      std::function<int(size_t,fermion_t &,fp_t)> func=
+        std::bind(std::mem_fn<int(size_t,fermion_t &,fp_t)>
+                  (&fermion_rel_tl::batch_density_point),this,
+                  std::placeholders::_1,std::placeholders::_2,
+                  std::placeholders::_3);
+      part_batch_loop(f,b,true,n_threads,func);
+      return;
+    }
+    //@}
+    
     /** \brief Calculate properties with antiparticles as function of
 	chemical potential
     */
@@ -2118,6 +2790,16 @@ namespace o2scl {
       }
       if (psi<deg_limit) deg=false;
 
+      // Try the precomputed table
+      if (fast_mode) {
+        fp_t ntemp=f.n;
+        if (fast_eval(f,T,psi,true)) {
+          yy=(ntemp-f.n)/ntemp;
+          f.n=ntemp;
+          return yy;
+        }
+      }
+      
       // Try the non-degenerate expansion if psi is small enough
       if (use_expansions && psi<min_psi) {
         fp_t ntemp=f.n;
@@ -1039,6 +1039,121 @@ int main(int argc, char *argv[]) {
 
 #endif
 #endif
+
+  {
+    // Compare the fast mode with a tighter quadrature
+    fermion_rel fr2, fr3;
+    fr2.use_expansions=false;
+    fr2.upper_limit_fac=50.0;
+    fr2.nit.tol_rel=1.0e-13;
+    fr2.nit.tol_abs=0.0;
+    fr2.dit.tol_rel=1.0e-13;
+    fr2.dit.tol_abs=0.0;
+    fr3.fast_mode=true;
+    fr3.fast_table.build();
+    t.test_gen(fr3.fast_table.is_built(),"fast table built");
+
+    fermion f2(1.0,2.0), f3(1.0,2.0);
+    f2.inc_rest_mass=true;
+    f3.inc_rest_mass=true;
+    
+    double T_list[3]={0.01,0.1,1.0};
+    double psi_list[4]={-3.0,0.0,3.0,15.0};
+    for(size_t iT=0;iT<3;iT++) {
+      for(size_t ip=0;ip<4;ip++) {
+        double T=T_list[iT];
+        f2.mu=f2.m+psi_list[ip]*T;
+        f3.mu=f2.mu;
+        fr2.calc_mu(f2,T);
+        fr3.calc_mu(f3,T);
+        t.test_gen(fr3.last_method==10,"fast mode calc_mu method");
+        t.test_rel(f3.n,f2.n,1.0e-8,"fast mode calc_mu n");
+        t.test_rel(f3.ed,f2.ed,1.0e-8,"fast mode calc_mu ed");
+        t.test_rel(f3.pr,f2.pr,1.0e-8,"fast mode calc_mu pr");
+        t.test_rel(f3.en,f2.en,1.0e-8,"fast mode calc_mu en");
+        
+        f3.mu=f2.mu*1.1;
+        fr3.calc_density(f3,T);
+        t.test_gen(fr3.last_method%10==6,"fast mode calc_density method");
+        t.test_rel(f3.mu,f2.mu,1.0e-8,"fast mode calc_density mu");
+        t.test_rel(f3.ed,f2.ed,1.0e-8,"fast mode calc_density ed");
+      }
+    }
+
+    // Outside of the domain of the table, the quadrature is used
+    f2.mu=f2.m+50.0*0.1;
+    f3.mu=f2.mu;
+    fr2.calc_mu(f2,0.1);
+    fr3.calc_mu(f3,0.1);
+    t.test_gen(fr3.last_method!=10,"fast mode fallback");
+    t.test_rel(f3.n,f2.n,1.0e-6,"fast mode fallback n");
+  }
+
+  {
+    // Batch functions, compared with the scalar versions
+    fermion_rel fr2;
+    fermion f2(1.0,2.0);
+    f2.mu=1.1;
+    
+    part_batch pb;
+    size_t np=20;
+    pb.T.resize(np);
+    pb.n.resize(np);
+    for(size_t i=0;i<np;i++) {
+      pb.T[i]=0.1;
+      pb.n[i]=0.01*pow(1.5,((double)i));
+    }
+    fr2.calc_density_batch(f2,pb,3);
+    
+    fermion f3(1.0,2.0);
+    for(size_t i=0;i<np;i++) {
+      f3.n=pb.n[i];
+      f3.mu=1.1;
+      fr2.calc_density(f3,pb.T[i]);
+      t.test_gen(pb.ret[i]==0,"batch calc_density ret");
+      t.test_rel(pb.mu[i],f3.mu,1.0e-8,"batch calc_density mu");
+      t.test_rel(pb.pr[i],f3.pr,1.0e-8,"batch calc_density pr");
+      t.test_rel(pb.en[i],f3.en,1.0e-8,"batch calc_density en");
+    }
+    
+    std::vector<double> mu_ref=pb.mu;
+    fr2.calc_mu_batch(f2,pb,3);
+    for(size_t i=0;i<np;i++) {
+      t.test_gen(pb.ret[i]==0,"batch calc_mu ret");
+      t.test_rel(pb.n[i],0.01*pow(1.5,((double)i)),1.0e-8,
+                 "batch calc_mu n");
+    }
+
+    // The fast mode tables are shared with the other threads
+    fr2.fast_mode=true;
+    fr2.calc_density_batch(f2,pb,3);
+    for(size_t i=0;i<np;i++) {
+      t.test_rel(pb.mu[i],mu_ref[i],1.0e-8,"batch calc_density fast");
+    }
+  }
+
+  {
+    // Thread-safe interface, compared with the usual interface
+    fermion_rel fr2;
+    double mu_ts[8];
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for num_threads(4)
+#endif
+    for(size_t i=0;i<8;i++) {
+      fermion fx(1.0,2.0);
+      fx.n=0.01*(i+1);
+      fx.mu=1.1;
+      fr2.calc_density_ts(fx,0.1);
+      mu_ts[i]=fx.mu;
+    }
+    fermion f3(1.0,2.0);
+    for(size_t i=0;i<8;i++) {
+      f3.n=0.01*(i+1);
+      f3.mu=1.1;
+      fr2.calc_density(f3,0.1);
+      t.test_rel(mu_ts[i],f3.mu,1.0e-10,"calc_density_ts");
+    }
+  }
   
   t.report();
 
@@ -26,6 +26,10 @@
 #include <string>
 #include <iostream>
 #include <cmath>
+#include <vector>
+#include <limits>
+#include <functional>
+#include <memory>
 
 #ifdef O2SCL_MULTIP
 #include <boost/multiprecision/number.hpp>
@@ -41,6 +45,12 @@
 #include <o2scl/mroot.h>
 #include <o2scl/test_mgr.h>
 
+#include <o2scl/set_openmp.h>
+
+#ifdef O2SCL_SET_OPENMP
+#include <omp.h>
+#endif
+
 // To get directories for calibrate function
 #include <o2scl/lib_settings.h>
 // To read tables in calibrate function
@@ -257,6 +267,162 @@ namespace o2scl {
    */
   extern thermo operator-(const thermo &left, const part &right);
 
+  /** \brief Storage for the thermodynamics of a particle at
+      several points
+
+      This class stores the inputs and results of the batch
+      functions, e.g. \ref o2scl::fermion_rel_tl::calc_mu_batch(),
+      as a structure of arrays. The temperature, \ref T, is
+      always an input. The chemical potential, \ref mu, is an input
+      for the functions which compute the thermodynamics from the
+      chemical potential and an output for those which compute the
+      thermodynamics from the density, \ref n. For particles which
+      are not non-interacting, \ref mu stores the effective
+      chemical potential, \f$ \nu \f$, and the effective mass
+      is taken from the particle object given to the batch
+      function.
+  */
+  template<class fp_t=double> class part_batch_tl {
+
+  public:
+
+    /// Temperature
+    std::vector<fp_t> T;
+    /// Chemical potential (or effective chemical potential)
+    std::vector<fp_t> mu;
+    /// Number density
+    std::vector<fp_t> n;
+    /// Energy density
+    std::vector<fp_t> ed;
+    /// Pressure
+    std::vector<fp_t> pr;
+    /// Entropy density
+    std::vector<fp_t> en;
+    /// The return value for each point (zero for success)
+    std::vector<int> ret;
+
+    /// Resize all of the arrays to hold \c np points
+    void resize(size_t np) {
+      T.resize(np);
+      mu.resize(np);
+      n.resize(np);
+      ed.resize(np);
+      pr.resize(np);
+      en.resize(np);
+      ret.resize(np);
+      return;
+    }
+
+    /// Return the number of points
+    size_t size() const {
+      return T.size();
+    }
+    
+  };
+
+  /** \brief Double-precision batch storage
+   */
+  typedef part_batch_tl<double> part_batch;
+
+  /** \brief Compute the thermodynamics of a particle at all
+      of the points in a batch
+
+      The function \c func is called for each point with the
+      thread index, a copy of the particle \c p for that thread,
+      and the temperature, and should return zero for success.
+      If \c density is true, the density for each point is taken
+      from \c b.n and the chemical potential is stored in \c b.mu,
+      otherwise the chemical potential is taken from \c b.mu and
+      the density is stored in \c b.n.
+
+      The points are divided into \c n_threads contiguous blocks
+      which are computed in parallel if OpenMP is enabled. Within
+      each block, the chemical potential from the previous point
+      is used as the initial guess for the next, so the points
+      should be ordered so that neighbors have similar values. The
+      initial guess for the first point in each block, and for any
+      point following a failure, is taken from \c p. Exceptions
+      thrown by \c func are caught and the corresponding entry in
+      \c b.ret is set to \ref o2scl::exc_efailed. The
+      thermodynamic quantities for points which failed are set to
+      NaN.
+  */
+  template<class part_t, class fp_t>
+  void part_batch_loop(const part_t &p, part_batch_tl<fp_t> &b,
+                       bool density, size_t n_threads,
+                       std::function<int(size_t,part_t &,fp_t)> &func) {
+
+    size_t np=b.T.size();
+    if ((density && b.n.size()!=np) || (!density && b.mu.size()!=np)) {
+      O2SCL_ERR2("Input arrays have different sizes in ",
+                 "part_batch_loop().",o2scl::exc_einval);
+    }
+    b.resize(np);
+    if (np==0) return;
+
+    size_t nt=n_threads;
+#ifndef O2SCL_SET_OPENMP
+    nt=1;
+#endif
+    if (nt==0) nt=1;
+    if (nt>np) nt=np;
+
+    fp_t nan=std::numeric_limits<fp_t>::quiet_NaN();
+    
+#ifdef O2SCL_SET_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(static,1)
+#endif
+    for(size_t it=0;it<nt;it++) {
+
+      part_t pt=p;
+      bool warm=false;
+      
+      for(size_t i=it*np/nt;i<(it+1)*np/nt;i++) {
+
+        if (density) {
+          pt.n=b.n[i];
+          if (!warm) {
+            pt.mu=p.mu;
+            pt.nu=p.nu;
+          }
+        } else if (pt.non_interacting) {
+          pt.mu=b.mu[i];
+        } else {
+          pt.nu=b.mu[i];
+        }
+
+        int ret;
+        try {
+          ret=func(it,pt,b.T[i]);
+        } catch (std::exception &e) {
+          ret=o2scl::exc_efailed;
+        }
+        b.ret[i]=ret;
+        warm=(ret==0);
+
+        if (ret==0) {
+          if (density) {
+            if (pt.non_interacting) b.mu[i]=pt.mu;
+            else b.mu[i]=pt.nu;
+          } else {
+            b.n[i]=pt.n;
+          }
+          b.ed[i]=pt.ed;
+          b.pr[i]=pt.pr;
+          b.en[i]=pt.en;
+        } else {
+          if (density) b.mu[i]=nan;
+          else b.n[i]=nan;
+          b.ed[i]=nan;
+          b.pr[i]=nan;
+          b.en[i]=nan;
+        }
+      }
+    }
+    
+    return;
+  }
+
   /** \brief Calibrate particle classes by comparing double to
       multiprecision
   */